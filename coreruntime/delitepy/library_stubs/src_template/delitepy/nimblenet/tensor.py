@@ -2,6 +2,8 @@
 #
 # SPDX-License-Identifier: Apache-2.0
 
+from typing import Callable
+
 class Tensor:
     def shape(self)->list[int]:
         """
@@ -46,9 +48,9 @@ class Tensor:
         """
         return self
 
-    def topk(self, num:int, order:str):
+    def topk(self, num:int, order:str, axis:int = -1):
         """
-        Return the indices of topk elements of the tensor are sorting based on order. For topk to work the tensor should be 1 dimensional.
+        Return the indices along the axis of the topk elements of the tensor sorted based on order. Equal elements keep their order in the tensor.
         Does not modify the existing tensor.
 
         Parameters
@@ -57,23 +59,51 @@ class Tensor:
             Number of indices to be returned.
         order : str
             Order of sorting. Allowed values are "asc" and "desc"
+        axis : int
+            Axis to select the elements along, the last one by default. Negative values count from the end.
+            String tensors have to be 1 dimensional, so the axis can only be 0 or -1.
 
         Returns
         ----------
         topkIndices : Tensor
-            Indices of the topk elements of the tensor, based on sorting order.
+            Indices of the topk elements of the tensor, based on sorting order. Same shape as the tensor with num elements along the axis.
+        """
+        return self
+
+    def topk_values(self, num:int, order:str, axis:int = -1):
+        """
+        Return the topk elements of the tensor along the axis sorted based on order, without computing their indices.
+        Does not modify the existing tensor.
+
+        Parameters
+        ----------
+        num : int
+            Number of elements to be returned.
+        order : str
+            Order of sorting. Allowed values are "asc" and "desc"
+        axis : int
+            Axis to select the elements along, the last one by default. Negative values count from the end.
+            String tensors have to be 1 dimensional, so the axis can only be 0 or -1.
+
+        Returns
+        ----------
+        topkValues : Tensor
+            The topk elements of the tensor, based on sorting order. Same shape as the tensor with num elements along the axis.
         """
         return self
 
-    def argsort(self, order:str):
+    def argsort(self, order:str, axis:int = -1):
         """
-        List of indices of the sorted tensor based on the order specified. For argsort to work, the tensor should be 1 dimensional.
+        List of indices of the sorted tensor along the axis based on the order specified. Equal elements keep their order in the tensor.
         Does not modify the existing tensor.
 
         Parameters
         ----------
         order : str
             Sorting order of tensor. Allowed values are "asc" and "desc"
+        axis : int
+            Axis to sort along, the last one by default. Negative values count from the end.
+            String tensors have to be 1 dimensional, so the axis can only be 0 or -1.
 
         Returns
         ----------
@@ -99,5 +129,7 @@ class Tensor:
             Returns the tensor with values arranged based on indices.
         """
         return self
+{{ extract_delitepy_doc_blocks("nimblenet/data_variable/include/cache_data_variable.hpp") }}
+{{ extract_delitepy_doc_blocks("nimblenet/data_variable/include/background_job_data_variable.hpp") }}
 {{ extract_delitepy_doc_blocks("nimblenet/data_variable/include/nimble_net_data_variable.hpp") }}
 {{ extract_delitepy_doc_blocks("nimblenet/data_variable/include/list_data_variable.hpp") }}
@@ -76,44 +76,118 @@ def is_string(s : object) -> bool:
         true if object passed is an string, false otherwise
     """
 
-def min(tensor : Tensor) -> int|float:
+def min(tensor : Tensor, axis : int|list[int]|tuple[int] = None, keepdims : bool = False) -> int|float|bool|str|Tensor:
     """
-    Returns the minimum element in the tensor
+    Returns the minimum of the elements of the tensor, over all its elements or along the axes given,
+    like numpy.min.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Tensor of numbers or booleans, or of strings compared lexicographically when axis is None.
+    axis : int|list[int]|tuple[int]
+        Axis or axes to reduce, negative axes count from the end. None reduces all the axes.
+    keepdims : bool
+        Whether the reduced axes are kept in the result with size 1.
+
+    Returns
+    ----------
+    result : int|float|bool|str|Tensor
+        Minimum of the elements, a tensor unless all the axes are reduced without keepdims
+    """
+
+def max(tensor : Tensor, axis : int|list[int]|tuple[int] = None, keepdims : bool = False) -> int|float|bool|str|Tensor:
+    """
+    Returns the maximum of the elements of the tensor, over all its elements or along the axes given,
+    like numpy.max.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Tensor of numbers or booleans, or of strings compared lexicographically when axis is None.
+    axis : int|list[int]|tuple[int]
+        Axis or axes to reduce, negative axes count from the end. None reduces all the axes.
+    keepdims : bool
+        Whether the reduced axes are kept in the result with size 1.
+
+    Returns
+    ----------
+    result : int|float|bool|str|Tensor
+        Maximum of the elements, a tensor unless all the axes are reduced without keepdims
+    """
+
+def sum(tensor : Tensor, axis : int|list[int]|tuple[int] = None, keepdims : bool = False) -> int|float|Tensor:
+    """
+    Returns the sum of the elements of the tensor, over all its elements or along the axes given,
+    like numpy.sum.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Tensor of numbers or booleans.
+    axis : int|list[int]|tuple[int]
+        Axis or axes to reduce, negative axes count from the end. None reduces all the axes.
+    keepdims : bool
+        Whether the reduced axes are kept in the result with size 1.
 
     Returns
     ----------
-    result : int|float
-        Minimum element in the tensor
+    result : int|float|Tensor
+        Sum of the elements, a tensor unless all the axes are reduced without keepdims
     """
 
-def max(tensor : Tensor) -> int|float:
+def mean(tensor : Tensor, axis : int|list[int]|tuple[int] = None, keepdims : bool = False) -> float|Tensor:
     """
-    Returns the maximum element in the tensor
+    Returns the mean of the elements of the tensor, over all its elements or along the axes given,
+    like numpy.mean.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Tensor of numbers or booleans.
+    axis : int|list[int]|tuple[int]
+        Axis or axes to reduce, negative axes count from the end. None reduces all the axes.
+    keepdims : bool
+        Whether the reduced axes are kept in the result with size 1.
 
     Returns
     ----------
-    result : int|float
-        Maximum element in the tensor
+    result : float|Tensor
+        Mean of the elements, a tensor unless all the axes are reduced without keepdims
     """
 
-def sum(tensor: Tensor) -> int|float:
+def minimum(x : Tensor|int|float, y : Tensor|int|float) -> Tensor:
     """
-    Returns the sum of all elements of the tensor
+    Returns the elementwise minimum of x and y, broadcast against each other like NumPy arrays.
+
+    Parameters
+    ----------
+    x : Tensor|int|float
+        Tensor or number, at least one of x and y is a tensor.
+    y : Tensor|int|float
+        Tensor or number, at least one of x and y is a tensor.
 
     Returns
     ----------
-    result : int|float
-        Sum of all elements of the tensor
+    result : Tensor
+        Tensor holding the smaller of each pair of elements
     """
 
-def mean(tensor: Tensor) -> int|float:
+def maximum(x : Tensor|int|float, y : Tensor|int|float) -> Tensor:
     """
-    Returns the mean of all elements of the tensor
+    Returns the elementwise maximum of x and y, broadcast against each other like NumPy arrays.
+
+    Parameters
+    ----------
+    x : Tensor|int|float
+        Tensor or number, at least one of x and y is a tensor.
+    y : Tensor|int|float
+        Tensor or number, at least one of x and y is a tensor.
 
     Returns
     ----------
-    result : int|float
-        Mean of all elements of the tensor
+    result : Tensor
+        Tensor holding the larger of each pair of elements
     """
 
 def parse_json(s : str) -> dict:
@@ -5,7 +5,10 @@
  */
 
 #pragma once
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "config_manager.hpp"
 #include "core_sdk_structs.hpp"
@@ -28,6 +31,7 @@ struct MetricsAgent;
 class Database;
 class Task;
 class ScriptReadyJob;
+class BackgroundScriptJob;
 
 /**
  * @brief Central coordinator for managing resources, inferences, logger, scheduler etc. Basically
@@ -55,6 +59,9 @@ class CommandCenter {
   bool _taskLoaded = false;
   Deployment _deployment;
   std::shared_ptr<ScriptReadyJob> _scriptReadyJob = nullptr;
+  std::atomic<int> _numRunningMethods = 0; /**< Calls of run_task in progress */
+  std::mutex _backgroundJobsMutex;
+  std::vector<std::shared_ptr<BackgroundScriptJob>> _backgroundJobs; /**< Cancelled on destruction */
 
   bool _currentState = true;
 
@@ -92,6 +99,12 @@ class CommandCenter {
                 std::shared_ptr<Logger> externalLogger = nullptr, bool currentState = true,
                 const Deployment& deployment = Deployment());
 
+  /**
+   * @brief Cancels the background jobs registered by the script, waiting for their runs in
+   * progress to finish.
+   */
+  ~CommandCenter();
+
   /** @brief Gets the current deployment ETag string. */
   std::string get_deployment_eTag() const { return _deployment.eTag; }
 
@@ -177,9 +190,12 @@ class CommandCenter {
 
   /**
    * @brief Runs the task with raw tensor input/output.
+   *
+   * @param borrowInputs Whether numeric input tensors use the data of inputs without copying it,
+   * see ::run_method_zero_copy().
    */
   NimbleNetStatus* run_task(const char* taskName, const char* functionName, const CTensors inputs,
-                            CTensors* outputs);
+                            CTensors* outputs, bool borrowInputs = false);
 
   /**
    * @brief Runs the task with MapDataVariable input/output.
@@ -188,6 +204,16 @@ class CommandCenter {
                             std::shared_ptr<MapDataVariable> inputs,
                             std::shared_ptr<MapDataVariable> outputs);
 
+  /** @brief Returns true if no call of run_task is in progress. */
+  bool is_idle() const noexcept { return _numRunningMethods.load() == 0; }
+
+  /**
+   * @brief Registers a background job of the script and adds it to the job scheduler.
+   *
+   * @param job The job, cancelled when this CommandCenter is destroyed.
+   */
+  void add_background_script_job(std::shared_ptr<BackgroundScriptJob> job);
+
   /** @brief Try to achieve a valid state in offline mode i.e. try to load the script and models
    * defined in the deployment by reading them from disk. */
   void achieve_state_in_offline_mode();
@@ -6,6 +6,7 @@
 
 #include "command_center.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <memory>
 
@@ -15,6 +16,7 @@
 #include "logger.hpp"
 #include "nimble_net_util.hpp"
 #include "resource_manager.hpp"
+#include "run_arena.hpp"
 #include "script_load_job.hpp"
 #include "server_api.hpp"
 #include "server_api_structs.hpp"
@@ -23,14 +25,78 @@
 #ifdef SCRIPTING
 #include "map_data_variable.hpp"
 #include "task.hpp"
+#include "tensor_data_variable.hpp"
 
 #endif
+#include "background_script_job.hpp"
 #include "resource_downloader.hpp"
 #include "resource_loader.hpp"
 #include "script_ready_job.hpp"
 #include "user_events_manager.hpp"
 using namespace std;
 
+namespace {
+
+/**
+ * @brief Counts a call of run_task for the lifetime of the object, used by CommandCenter::is_idle()
+ */
+class RunningMethodScope {
+  std::atomic<int>& _numRunningMethods;
+
+ public:
+  explicit RunningMethodScope(std::atomic<int>& numRunningMethods)
+      : _numRunningMethods(numRunningMethods) {
+    _numRunningMethods++;
+  }
+
+  ~RunningMethodScope() { _numRunningMethods--; }
+};
+
+#ifdef SCRIPTING
+/**
+ * @brief Tensors of run_task inputs which borrow the data of the caller.
+ *
+ * The data is only valid until run_task returns. Tensors escaping to other threads, e.g. stored in
+ * a global, a cache or a returned output, are given a copy of their data by
+ * TensorVariable::mark_shared() when they escape. The tensors which are not shared but still
+ * referenced once the script returns, e.g. kept in a closure, are given a copy on release().
+ */
+class BorrowedInputs {
+  std::shared_ptr<MapDataVariable>& _inputs;
+  std::vector<std::shared_ptr<TensorVariable>> _tensors;
+
+ public:
+  explicit BorrowedInputs(std::shared_ptr<MapDataVariable>& inputs) : _inputs(inputs) {
+    for (const auto& it : inputs->get_map()) {
+      auto tensor = std::dynamic_pointer_cast<TensorVariable>(it.second);
+      if (tensor && tensor->is_borrowed()) {
+        _tensors.push_back(std::move(tensor));
+      }
+    }
+  }
+
+  /**
+   * @brief Releases the inputs and copies the data of the tensors still referenced elsewhere.
+   *
+   * Only tensors which were not shared can still be borrowed here, so they are used by this thread
+   * alone. Also called on destruction, so that inputs kept by a script which threw are detached too.
+   */
+  void release() {
+    _inputs.reset();
+    for (auto& tensor : _tensors) {
+      if (tensor.use_count() > 1) {
+        tensor->detach();
+      }
+    }
+    _tensors.clear();
+  }
+
+  ~BorrowedInputs() { release(); }
+};
+#endif  // SCRIPTING
+
+}  // namespace
+
 CommandCenter::CommandCenter(std::shared_ptr<ServerAPI> serverAPI, std::shared_ptr<Config> config,
                              MetricsAgent* metricsAgent, Database* database,
                              std::shared_ptr<JobScheduler> jobScheduler,
@@ -65,6 +131,31 @@ CommandCenter::CommandCenter(std::shared_ptr<ServerAPI> serverAPI, std::shared_p
   DeviceTime::setConfig(timeManagerConfig);
 }
 
+CommandCenter::~CommandCenter() {
+  std::vector<std::shared_ptr<BackgroundScriptJob>> backgroundJobs;
+  {
+    std::lock_guard<std::mutex> locker(_backgroundJobsMutex);
+    backgroundJobs.swap(_backgroundJobs);
+  }
+  // Jobs can outlive the CommandCenter in the scheduler, wait for their runs using it to finish
+  for (auto& job : backgroundJobs) {
+    job->cancel_and_wait();
+  }
+}
+
+void CommandCenter::add_background_script_job(std::shared_ptr<BackgroundScriptJob> job) {
+  {
+    std::lock_guard<std::mutex> locker(_backgroundJobsMutex);
+    // Forget the jobs which have stopped
+    _backgroundJobs.erase(
+        std::remove_if(_backgroundJobs.begin(), _backgroundJobs.end(),
+                       [](const auto& backgroundJob) { return backgroundJob->is_cancelled(); }),
+        _backgroundJobs.end());
+    _backgroundJobs.push_back(job);
+  }
+  job->init();
+}
+
 void CommandCenter::updated_pegged_device_time(const PeggedDeviceTime& peggedDeviceTime) {
   _peggedDeviceTime = peggedDeviceTime;
 }
@@ -155,27 +246,49 @@ void CommandCenter::prepare_task() {
   static_cast<void>(_jobScheduler->add_job(std::static_pointer_cast<Job<void>>(_scriptReadyJob)));
 }
 
+// Logs the memory of a run_task call which was served by its arena
+static void log_arena_stats(const char* functionName, const RunArenaScope& arenaScope) {
+  [[maybe_unused]] auto stats = arenaScope.stats();
+  LOG_VERBOSE("run_task %s arena allocations=%lld bytes=%lld peakBytes=%lld heapBlocks=%lld",
+              functionName, (long long)stats.allocations, (long long)stats.bytes,
+              (long long)stats.peakBytes, (long long)stats.heapBlocks);
+}
+
 NimbleNetStatus* CommandCenter::run_task(const char* taskName, const char* functionName,
-                                         const CTensors input, CTensors* outputs) {
+                                         const CTensors input, CTensors* outputs,
+                                         bool borrowInputs) {
 #ifdef SCRIPTING
-  auto inputTensor = std::make_shared<MapDataVariable>(input);
+  RunningMethodScope runningMethodScope(_numRunningMethods);
+  RunArenaScope arenaScope;
+  auto inputTensor = std::make_shared<MapDataVariable>(
+      input, borrowInputs ? CreateTensorType::BORROW : CreateTensorType::COPY);
+  if (borrowInputs) {
+    // The script runs on this thread. Sharing the inputs later, e.g. storing them in a global,
+    // then marks the borrowed tensors in them as shared too, which detaches them
+    inputTensor->set_thread_local();
+  }
+  BorrowedInputs borrowedInputs(inputTensor);
   auto outputDataVariable = std::make_shared<MapDataVariable>();
   try {
     // Store MapDataVariable, so as to deallocate later
     // Note that this is always stored so that the frontend can always access even in case of error.
     // This can be used by the script to return more information to the frontend
-    _outputs[_outputIndex] = outputDataVariable;
     // Set outputIndex in CTensors, which will be used to call deallocate_output_memory2 function
     {
+      // run_task can be called from several threads at once
       std::lock_guard<std::mutex> locker(_tensorStoreMutex);
+      _outputs[_outputIndex] = outputDataVariable;
       outputs->outputIndex = _outputIndex;
+      _outputIndex++;
     }
 
     outputs->numTensors = 0;
     outputs->tensors = nullptr;
-    _outputIndex++;
 
     _task->operate(functionName, inputTensor, outputDataVariable);
+    log_arena_stats(functionName, arenaScope);
+    // Outputs have to point to the copy of borrowed inputs returned by the script
+    borrowedInputs.release();
 
     NimbleNetStatus* retStatus = nullptr;
     {
@@ -204,8 +317,11 @@ NimbleNetStatus* CommandCenter::run_task(const char* taskName, const char* funct
                                          std::shared_ptr<MapDataVariable> inputTensor,
                                          std::shared_ptr<MapDataVariable> outputDataVariable) {
 #ifdef SCRIPTING
+  RunningMethodScope runningMethodScope(_numRunningMethods);
+  RunArenaScope arenaScope;
   try {
     _task->operate(functionName, inputTensor, outputDataVariable);
+    log_arena_stats(functionName, arenaScope);
 
     NimbleNetStatus* retStatus = nullptr;
     {
@@ -89,6 +89,44 @@ class Config {
   /** Flag to indicate whether assets should be fetched from cloud or provided from disk. */
   bool online = false;
 
+  /**
+   * @brief Flag to compile script functions to bytecode when the script is loaded.
+   * Functions keep running on the AST interpreter when this is disabled.
+   */
+  bool compileScript = false;
+
+  /**
+   * @brief Flag to run the optimizer over the script when it is loaded. It folds constant
+   * expressions, removes dead branches and resolves names bound once to a constant.
+   */
+  bool optimizeScript = false;
+
+  /**
+   * @brief Flag to cache the parsed script next to the script asset in a binary format, so that
+   * later loads of the same script version skip parsing the JSON AST.
+   */
+  bool cacheScriptAst = false;
+
+  /**
+   * @brief Flag to profile the calls of script functions and the executed lines of the script, see
+   * ScriptProfiler. Functions compiled to bytecode are profiled per function only.
+   */
+  bool profileScript = false;
+
+  /**
+   * @brief Flag to release the script lock while a model runs, so that other methods of the script
+   * are not blocked by a slow inference. Read-modify-write sequences of module variables that span
+   * a run call are then not atomic.
+   */
+  bool concurrentModelRun = false;
+
+  /**
+   * @brief Flag to register TensorBufferPool as the CPU allocator of the ONNX Runtime environment
+   * and have sessions use it instead of their own arena, so that model outputs dropped by the
+   * script go back to the pool.
+   */
+  bool pooledModelAllocator = false;
+
 #ifdef SIMULATION_MODE
   /**
    * @brief Flag indicating whether time is simulated.
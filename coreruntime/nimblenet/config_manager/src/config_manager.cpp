@@ -45,6 +45,24 @@ void Config::init(const nlohmann::json& j) {
   if (j.find("online") != j.end()) {
     j.at("online").get_to(online);
   }
+  if (j.find("compileScript") != j.end()) {
+    j.at("compileScript").get_to(compileScript);
+  }
+  if (j.find("optimizeScript") != j.end()) {
+    j.at("optimizeScript").get_to(optimizeScript);
+  }
+  if (j.find("cacheScriptAst") != j.end()) {
+    j.at("cacheScriptAst").get_to(cacheScriptAst);
+  }
+  if (j.find("profileScript") != j.end()) {
+    j.at("profileScript").get_to(profileScript);
+  }
+  if (j.find("concurrentModelRun") != j.end()) {
+    j.at("concurrentModelRun").get_to(concurrentModelRun);
+  }
+  if (j.find("pooledModelAllocator") != j.end()) {
+    j.at("pooledModelAllocator").get_to(pooledModelAllocator);
+  }
 
   if (j.find("maxDBSizeKBs") != j.end()) {
     j.at("maxDBSizeKBs").get_to(maxDBSizeKBs);
@@ -291,9 +291,11 @@ class CoreSDK {
 
   /**
    * @brief Runs a task with raw C-style tensors.
+   *
+   * @param borrowInputs Whether numeric input tensors use the data of inputs without copying it.
    */
   NimbleNetStatus* run_task(const char* taskName, const char* functionName, const CTensors inputs,
-                            CTensors* outputs);
+                            CTensors* outputs, bool borrowInputs = false);
 
   /**
    * @brief Runs a task using map-style inputs and outputs.
@@ -313,6 +315,16 @@ class CoreSDK {
 
   NimbleNetStatus* load_modules(const nlohmann::json assetsJson, const std::string& homeDir);
 
+  /**
+   * @brief Returns the profile of the script in the given format, see ScriptProfiler.
+   */
+  NimbleNetStatus* get_script_profile(const char* format, char** profile);
+
+  /**
+   * @brief Writes the profile of the script in the given format to filePath.
+   */
+  NimbleNetStatus* write_script_profile(const char* format, const char* filePath);
+
   /**
    * @brief Reloads a model with a given execution provider config.
    */
@@ -31,6 +31,10 @@
 #include "time_manager.hpp"
 #include "util.hpp"
 
+#ifdef SCRIPTING
+#include "script_profiler.hpp"
+#endif  // SCRIPTING
+
 using namespace std;
 
 #if defined(__APPLE__) && defined(__MACH__)
@@ -419,6 +423,23 @@ void CoreSDK::write_run_method_metric(const char* methodName, long long int andr
   LOG_TO_ERROR("%s", "Scripting not enabled");
 }
 
+NimbleNetStatus* CoreSDK::get_script_profile(const char* format, char** profile) {
+#ifdef SCRIPTING
+  auto scriptProfile = ScriptProfiler::get_profile(ScriptProfiler::parse_format(format));
+  *profile = strdup(scriptProfile.c_str());
+  return nullptr;
+#endif
+  return util::nimblestatus(STATUS::RESOURCE_NOT_FOUND_ERR, "%s", "Not built for Tasks.");
+}
+
+NimbleNetStatus* CoreSDK::write_script_profile(const char* format, const char* filePath) {
+#ifdef SCRIPTING
+  ScriptProfiler::write_profile(ScriptProfiler::parse_format(format), filePath);
+  return nullptr;
+#endif
+  return util::nimblestatus(STATUS::RESOURCE_NOT_FOUND_ERR, "%s", "Not built for Tasks.");
+}
+
 template <typename T>
 using CoreSDKResult = ne::Result<T, NimbleNetStatus*>;
 
@@ -504,13 +525,13 @@ bool CoreSDK::load_task(const std::string& taskName, const std::string& taskVers
 }
 
 NimbleNetStatus* CoreSDK::run_task(const char* taskName, const char* functionName,
-                                   const CTensors input, CTensors* outputs) {
+                                   const CTensors input, CTensors* outputs, bool borrowInputs) {
   if (!_commandCenterReady.load()) {
     return util::nimblestatus(1, "%s", "NimbleNet is not initialized");
   }
   auto commandCenter = command_center();
   if (commandCenter->is_ready()) {
-    return command_center()->run_task(taskName, functionName, input, outputs);
+    return command_center()->run_task(taskName, functionName, input, outputs, borrowInputs);
   }
   return util::nimblestatus(400, "Cannot run method %s since NimbleEdge is not ready",
                             functionName);
@@ -13,6 +13,7 @@
 #include <list>
 #include <vector>
 
+#include "background_script_job.hpp"
 #include "core_sdk.hpp"
 #include "core_sdk_constants.hpp"
 #include "data_variable.hpp"
@@ -82,6 +83,11 @@ bool CoreSDK::run_task_upto_timestamp(const char* taskName, const char* function
                              " failed!");
   }
   Time::set_time(timestamp);
+  if (!_config->online) {
+    // There is no background thread running the jobs offline, run the background jobs of the
+    // script due by the timestamp
+    _jobScheduler->do_jobs(BackgroundScriptJob::JOB_NAME);
+  }
   auto t = run_task(taskName, functionName, input, output);
   if (t == nullptr) {
     return true;
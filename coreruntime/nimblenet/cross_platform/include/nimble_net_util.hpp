@@ -68,6 +68,8 @@ enum DATATYPE {
   FUNCTION = 682,
   CONCURRENT_EXECUTOR = 683,
   EXCEPTION = 684,
+  NIMBLENET_CACHE = 685,
+  BACKGROUND_JOB = 686,
   UNKNOWN = 0,
   FLOAT = 1,
   BOOLEAN = 9,
@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "background_script_job.hpp"
+#include "data_variable.hpp"
+
+/*
+DELITEPY_DOC_BLOCK_BEGIN
+
+class BackgroundJob:
+    """
+    Handle of a background job of the script, returned by nm.schedule_job(). Dropping the handle does not stop the job.
+    """
+
+    def cancel(self) -> None:
+        """
+        Stops the job. A run in progress, if any, is not interrupted.
+        """
+        pass
+DELITEPY_DOC_BLOCK_END
+*/
+/**
+ * @brief Handle of a background job of the script, returned by nm.schedule_job()
+ *
+ * Supports cancel(), which stops the job after its run in progress, if any. Dropping the handle
+ * does not stop the job.
+ */
+class BackgroundJobDataVariable final : public DataVariable {
+  std::shared_ptr<BackgroundScriptJob> _job; /**< The job of the scheduler */
+
+ public:
+  explicit BackgroundJobDataVariable(std::shared_ptr<BackgroundScriptJob> job)
+      : _job(std::move(job)) {}
+
+  int get_dataType_enum() const override { return DATATYPE::BACKGROUND_JOB; }
+
+  int get_containerType() const override { return CONTAINERTYPE::SINGLE; }
+
+  bool get_bool() override { return !_job->is_cancelled(); }
+
+  std::string print() override { return fallback_print(); }
+
+  nlohmann::json to_json() const override { return "[BackgroundJob]"; }
+
+  OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
+                             CallStack& stack) override {
+    switch (memberFuncIndex) {
+      case MemberFuncType::CANCEL:
+        THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 0, memberFuncIndex);
+        _job->cancel();
+        return std::make_shared<NoneVariable>();
+    }
+    THROW("%s not implemented for background job",
+          DataVariable::get_member_func_string(memberFuncIndex));
+  }
+};
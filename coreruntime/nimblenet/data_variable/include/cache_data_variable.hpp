@@ -0,0 +1,229 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "data_variable.hpp"
+
+/*
+DELITEPY_DOC_BLOCK_BEGIN
+
+class Cache:
+    """
+    Memoization cache created with nm.cache(), evicting the least recently used entries once it
+    is full.
+    """
+
+    def get(self, key, default=None):
+        """
+        Returns the value stored for key and marks the entry most recently used.
+
+        Parameters
+        ----------
+        key : str | int | float | bool | None | Tensor | list | tuple
+            Key of the entry.
+        default : Any
+            Value returned when the key is missing or its entry expired.
+
+        Returns
+        ----------
+        value : Any
+            The stored value, default if there is none.
+        """
+        pass
+
+    def put(self, key, value) -> None:
+        """
+        Stores value for key, evicting the least recently used entries over the limits of the cache.
+
+        Parameters
+        ----------
+        key : str | int | float | bool | None | Tensor | list | tuple
+            Key of the entry.
+        value : Any
+            Value to store.
+        """
+        pass
+
+    def get_or_compute(self, key, fn: Callable):
+        """
+        Returns the value stored for key. When the key is missing or its entry expired, calls
+        fn(key) and stores its result for key.
+
+        fn runs without the cache being locked, so threads missing the same key at the same time
+        may both call it.
+
+        Parameters
+        ----------
+        key : str | int | float | bool | None | Tensor | list | tuple
+            Key of the entry.
+        fn : Callable
+            Function called with key to compute the missing value.
+
+        Returns
+        ----------
+        value : Any
+            The stored or the computed value.
+        """
+        pass
+
+    def pop(self, key, default=None):
+        """
+        Removes the entry of key and returns its value.
+
+        Parameters
+        ----------
+        key : str | int | float | bool | None | Tensor | list | tuple
+            Key of the entry.
+        default : Any
+            Value returned when the key is missing or its entry expired.
+
+        Returns
+        ----------
+        value : Any
+            The removed value, default if there is none.
+        """
+        pass
+
+    def clear(self) -> None:
+        """
+        Removes all the entries of the cache. The counters returned by stats() are kept.
+        """
+        pass
+
+    def stats(self) -> dict:
+        """
+        Returns the counters of the cache.
+
+        Returns
+        ----------
+        stats : dict
+            Dict with hits, misses, evictions, expirations, entries, bytes and hitRate.
+        """
+        pass
+DELITEPY_DOC_BLOCK_END
+*/
+/**
+ * @brief A memoization cache for scripts, created with nm.cache(maxEntries, ttlSecs, maxBytes)
+ * @details Entries are evicted in least recently used order once the cache holds more than
+ *          maxEntries entries or more than maxBytes bytes, and expire ttlSecs seconds after they
+ *          were stored. Expiry follows Time::get_time(), so that the simulator controls it with
+ *          the timestamps of run_method. As Time::get_time() counts whole seconds, ttlSecs is
+ *          rounded up to whole seconds, and an entry lives between ttlSecs - 1 and ttlSecs
+ *          seconds depending on when in the second it was stored. Keys can be strings, numbers,
+ *          booleans, None, tensors and lists or tuples of those, two keys are the same if they
+ *          have the same type and contents. Like in a dict, numbers are the same key if they are
+ *          equal, so 1 and 1.0 are one key. The size of an entry is an estimate of the memory held
+ *          by its key and value.
+ *
+ *          All the functions lock the cache, so that it can be used from the workers of a
+ *          ConcurrentExecutor. get_or_compute() calls the function without holding the lock, so
+ *          threads missing the same key at the same time may both compute the value.
+ */
+class CacheDataVariable final : public DataVariable {
+  struct Entry {
+    std::string key; /**< Canonical bytes of the key */
+    OpReturnType value;
+    int64_t bytes = 0;
+    int64_t expiry = 0; /**< Time::get_time() in seconds at which the entry expires */
+  };
+
+  const int64_t _maxEntries;
+  const int64_t _maxBytes;      /**< 0 for no limit on the bytes */
+  const int64_t _ttlSecs;       /**< Whole seconds, 0 for entries which never expire */
+  std::mutex _mutex;            /**< Guards all the members below */
+  std::list<Entry> _entries;    /**< Most recently used first */
+  std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+  int64_t _bytes = 0;
+  int64_t _hits = 0;
+  int64_t _misses = 0;
+  int64_t _evictions = 0;
+  int64_t _expirations = 0;
+
+  /**
+   * @brief Returns the canonical bytes of a key, throws if the key is not hashable
+   */
+  static std::string get_key_bytes(const OpReturnType& key);
+
+  /**
+   * @brief Estimated bytes held by a value
+   */
+  static int64_t get_value_bytes(const OpReturnType& value);
+
+  /**
+   * @brief Looks up a key and marks it most recently used, expired entries are dropped
+   * @return The value, nullptr if the key is missing. Called with _mutex held.
+   */
+  OpReturnType find(const std::string& key);
+
+  /**
+   * @brief Stores a value for a key and evicts entries over the limits. Called with _mutex held.
+   */
+  void insert(std::string&& key, const OpReturnType& value);
+
+  void erase(std::list<Entry>::iterator it);
+
+  /**
+   * @brief Drops all the expired entries. Called with _mutex held.
+   */
+  void drop_expired();
+
+  bool is_expired(const Entry& entry) const;
+
+  OpReturnType get(const std::vector<OpReturnType>& arguments);
+
+  OpReturnType put(const std::vector<OpReturnType>& arguments);
+
+  OpReturnType get_or_compute(const std::vector<OpReturnType>& arguments, CallStack& stack);
+
+  OpReturnType pop(const std::vector<OpReturnType>& arguments);
+
+  OpReturnType clear(const std::vector<OpReturnType>& arguments);
+
+  OpReturnType stats(const std::vector<OpReturnType>& arguments);
+
+ public:
+  /**
+   * @brief Constructor
+   * @param maxEntries Maximum number of entries, at least 1
+   * @param ttlSecs Seconds after which an entry expires, rounded up to whole seconds, 0 for no
+   *        expiry
+   * @param maxBytes Maximum estimated bytes of all entries, 0 for no limit
+   * @throws std::runtime_error if a limit is negative or maxEntries is 0
+   */
+  CacheDataVariable(int64_t maxEntries, double ttlSecs, int64_t maxBytes);
+
+  int get_dataType_enum() const override { return DATATYPE::NIMBLENET_CACHE; }
+
+  int get_containerType() const override { return CONTAINERTYPE::SINGLE; }
+
+  bool get_bool() override { return true; }
+
+  /**
+   * @brief Number of entries, expired entries are dropped first
+   */
+  int get_size() override;
+
+  bool in(const OpReturnType& elem) override;
+
+  std::string print() override { return fallback_print(); }
+
+  nlohmann::json to_json() const override { return "[Cache]"; }
+
+  /**
+   * @brief Call a member function by index
+   * @details Supports get(key, default=None), put(key, value), get_or_compute(key, fn), pop(key,
+   *          default=None), clear() and stats()
+   */
+  OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
+                             CallStack& stack) override;
+};
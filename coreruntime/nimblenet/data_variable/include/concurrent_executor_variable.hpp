@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "data_variable.hpp"
 #include "list_data_variable.hpp"
 #include "thread_pool.hpp"
@@ -22,10 +24,32 @@
 class ConcurrentExecutorVariable final : public DataVariable {
   static std::unique_ptr<ThreadPool> _threadpool; /**< Static thread pool for parallel execution */
   static int _numThreads; /**< Number of threads in the thread pool */
+  static std::vector<int> _cpuAffinity; /**< CPUs the threads are pinned to, empty for none */
   // mutex to implement sync calls
   std::mutex _mutex; /**< Mutex for thread-safe synchronous execution */
   static bool init_threadpool();
 
+  /**
+   * @brief Function executing the items [begin, end) of a chunk on the given stack
+   */
+  using ChunkFunction = std::function<void(int begin, int end, CallStack& stack)>;
+
+  /**
+   * @brief Returns the chunk size to use for numItems items
+   * @param chunkSizeArg Chunk size given by the script, None or 0 to pick one from the number of
+   *        threads
+   */
+  static int get_chunk_size(const OpReturnType& chunkSizeArg, int numItems);
+
+  /**
+   * @brief Runs numItems items split in chunks of chunkSize on the thread pool and the calling
+   *        thread
+   * @details Each participating thread copies the stack once and claims chunks until none are
+   *          left, so there is no task or future per item. Returns when all chunks are done.
+   * @throws std::runtime_error with the error of the first failed chunk, in chunk order
+   */
+  void run_chunks(int numItems, int chunkSize, CallStack& stack, const ChunkFunction& runChunk);
+
  public:
   /**
    * @brief Default constructor
@@ -36,9 +60,11 @@ class ConcurrentExecutorVariable final : public DataVariable {
   /**
    * @brief Set the number of threads in the thread pool
    * @param threadCount Number of threads (must be >= 1)
-   * @throws std::runtime_error if thread pool is already created or threadCount < 1
+   * @param cpuAffinity CPUs to pin the threads to in round robin order, empty to not pin them
+   * @throws std::runtime_error if thread pool is already created, threadCount < 1 or a cpu is
+   *         negative
    */
-  static void set_threadpool_threads(int threadCount);
+  static void set_threadpool_threads(int threadCount, const std::vector<int>& cpuAffinity = {});
 
   /**
    * @brief Get the data type enum
@@ -86,6 +112,31 @@ class ConcurrentExecutorVariable final : public DataVariable {
    */
   OpReturnType run_parallel(const std::vector<OpReturnType>& arguments, CallStack& stack);
 
+  /**
+   * @brief Map a function over an iterable in parallel, processing the items in chunks
+   * @details Same results as run_parallel, but the items are split in ranges of chunk size which
+   *          are executed by the worker threads without a task per item. Faster than run_parallel
+   *          when the function does little work per item.
+   * @param arguments Vector of arguments (first: function, second: iterable, third: chunk size or
+   *        None to pick one, rest: additional args passed after the item)
+   * @param stack Call stack for execution context
+   * @return ListDataVariable containing the results in the order of the items
+   */
+  OpReturnType map_chunked(const std::vector<OpReturnType>& arguments, CallStack& stack);
+
+  /**
+   * @brief Map a function over an iterable and reduce the results in parallel
+   * @details Every chunk reduces the mapped values of its items from left to right, and the results
+   *          of the chunks are reduced in order on the calling thread. The reduce function has to be
+   *          associative.
+   * @param arguments Vector of arguments (first: map function, second: reduce function taking two
+   *        values, third: non empty iterable, optional fourth: chunk size or None to pick one, rest:
+   *        additional args passed to the map function after the item)
+   * @param stack Call stack for execution context
+   * @return Reduced value
+   */
+  OpReturnType parallel_reduce(const std::vector<OpReturnType>& arguments, CallStack& stack);
+
   /**
    * @brief Call a member function by index
    * @param memberFuncIndex Index of the member function to call
@@ -101,4 +152,10 @@ class ConcurrentExecutorVariable final : public DataVariable {
    * @details Destroys the current thread pool instance
    */
   static void reset_threadpool() { _threadpool.reset(); }
+
+  /**
+   * @brief Get the thread pool
+   * @return The thread pool, nullptr if no concurrent executor was created yet
+   */
+  static ThreadPool* get_threadpool() { return _threadpool.get(); }
 };
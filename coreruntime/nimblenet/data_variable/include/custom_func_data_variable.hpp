@@ -93,6 +93,15 @@ class CustomFuncDataVariable final : public DataVariable {
   OpReturnType execute_function(const std::vector<OpReturnType>& arguments,
                                 CallStack& stack) override;
 
+  /**
+   * @brief Get the function pointer the function was created from
+   * @return The CustomFuncPtr, nullptr if the function was created from another callable
+   */
+  CustomFuncPtr get_function_pointer() const {
+    auto ptr = _func.target<CustomFuncPtr>();
+    return ptr ? *ptr : nullptr;
+  }
+
   /**
    * @brief Get a string representation of this function
    * @return String representation using the fallback print method
@@ -14,6 +14,7 @@
 
 #include "data_variable_enums.hpp"
 #include "executor_structs.h"
+#include "interned_key.hpp"
 #include "json.hpp"
 #include "ne_fwd.hpp"
 #include "ne_type_traits.hpp"
@@ -108,7 +109,13 @@ constexpr inline bool is_integer();
     }                                                                                            \
   } while (0)
 
-enum class CreateTensorType { MOVE, COPY };
+/**
+ * @brief How a tensor created from existing data treats it
+ *
+ * MOVE takes ownership of data allocated with malloc, COPY copies it, and BORROW uses it in place
+ * without owning it, see TensorVariable::detach().
+ */
+enum class CreateTensorType { MOVE, COPY, BORROW };
 
 /**
  * @brief Base class for all data variables in the NimbleNet system
@@ -127,10 +134,14 @@ class DataVariable : public std::enable_shared_from_this<DataVariable> {
   /* std::enable_shared_from_this<DataVariable> so that shared_ptr can be returned in member
    function call using shared_from_this() */
 
-  static std::map<std::string, int> _memberFuncMap;        /**< Mapping from function names to indices */
-  static std::map<int, std::string> _inverseMemberFuncMap; /**< Mapping from indices to function names */
-
  public:
+  /**
+   * @brief Returns the index of a member name, registering names which are not a MemberFuncType.
+   *
+   * @details Member functions of MemberFuncType are looked up in the constant MemberFuncNames
+   * table, other names, e.g. functions of script classes, get indices after LASTTYPE. Called when
+   * the script is parsed, so that calls dispatch on the index.
+   */
   static int add_and_get_member_func_index(const std::string& memberFuncString);
   static int get_member_func_index(const std::string& memberFuncString);
   static const char* get_member_func_string(int funcIndex);
@@ -161,12 +172,18 @@ class DataVariable : public std::enable_shared_from_this<DataVariable> {
 
   virtual OpReturnType sort(const OpReturnType argument) { THROW_UNSUPPORTED("sort"); }
 
-  virtual OpReturnType argsort(const OpReturnType argument) { THROW_UNSUPPORTED("argsort"); }
+  virtual OpReturnType argsort(const std::vector<OpReturnType>& arguments) {
+    THROW_UNSUPPORTED("argsort");
+  }
 
   virtual OpReturnType topk(const std::vector<OpReturnType>& arguments) {
     THROW_UNSUPPORTED("topk");
   }
 
+  virtual OpReturnType topk_values(const std::vector<OpReturnType>& arguments) {
+    THROW_UNSUPPORTED("topk_values");
+  }
+
   virtual OpReturnType arrange(const OpReturnType argument) { THROW_UNSUPPORTED("arrange"); }
 
   virtual void init() { THROW_UNSUPPORTED("init"); }
@@ -227,6 +244,25 @@ class DataVariable : public std::enable_shared_from_this<DataVariable> {
     THROW_UNSUPPORTED("set_subscript");
   }
 
+  /**
+   * @brief Same as get_string_subscript(), for keys interned with InternedKey::intern()
+   */
+  virtual OpReturnType get_interned_subscript(const InternedKey& key);
+
+  /**
+   * @brief Same as set_subscript() with a string subscript, for keys interned with
+   * InternedKey::intern()
+   */
+  virtual void set_interned_subscript(const InternedKey& key, const OpReturnType& d);
+
+  /**
+   * @brief Called before the variable becomes reachable by threads other than the one using it.
+   *
+   * Containers which skip locking while they are used by a single thread lock from then on, and
+   * pass the call on to the variables they contain.
+   */
+  virtual void mark_shared() {}
+
   virtual int get_dataType_enum() const = 0;
 
   template <typename T>
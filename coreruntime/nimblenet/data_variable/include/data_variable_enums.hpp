@@ -34,8 +34,8 @@ enum CONTAINERTYPE {
   CLASS = 9,
 };
 
-// when adding a new member function it should be placed in _memberFuncMap,_inverseMemberFuncMap for
-// appropriate calling
+// when adding a new member function its name should be placed in MemberFuncNames of
+// member_func_table.hpp for appropriate calling
 /**
  * @brief Enumeration defining all member function types supported by data variables
  *
@@ -58,7 +58,7 @@ enum MemberFuncType {
   CREATE_GROUPBY_COLUMNS_PROCESSOR,
   ADD_COMPUTATION_PROCESSOR,
   GET_PROCESSOR_OUTPUT,
-  GET_PROCESSOR_OUTPUT_FOR_GROUP,
+  GET_BY_KEY,
   CREATE_PROCESSOR,
   APPEND,
   TO_TENSOR,
@@ -130,5 +130,17 @@ enum MemberFuncType {
   CLEAR_CONTEXT,
   ADD_CONTEXT,
   LIST_COMPATIBLE_LLMS,
+  INLINE_CACHE_STATS,
+  MAP_CHUNKED,
+  PARALLEL_REDUCE,
+  CREATE_CACHE,
+  CACHE_PUT,
+  CACHE_GET_OR_COMPUTE,
+  CACHE_CLEAR,
+  CACHE_STATS,
+  SCHEDULE_JOB,
+  MINIMUM,
+  MAXIMUM,
+  TOPK_VALUES,
   LASTTYPE,  // should be last
 };
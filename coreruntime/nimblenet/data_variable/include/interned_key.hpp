@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief String key whose hash is computed once, e.g. the constant key of d["key"] in a script.
+ *
+ * Interned keys are unique per string and live till the process exits, so two interned keys are
+ * equal iff their addresses are. Only strings known when the script is loaded should be interned,
+ * keys computed at runtime would grow the table without bound.
+ */
+struct InternedKey {
+  std::string str;
+  uint64_t hash;
+
+  static uint64_t hash_of(std::string_view key) { return std::hash<std::string_view>{}(key); }
+
+  /**
+   * @brief Returns the interned key for str, creating it on first use. Thread safe.
+   */
+  static const InternedKey* intern(const std::string& str);
+};
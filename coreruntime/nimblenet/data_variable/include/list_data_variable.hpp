@@ -5,12 +5,14 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <type_traits>
 
 #include "binary_operators.hpp"
 #include "data_variable.hpp"
 #include "single_variable.hpp"
 #include "tensor_data_variable.hpp"
+#include "value.hpp"
 
 // think of better way to do this, if required
 template <class T>
@@ -53,8 +55,11 @@ class ListOperators {
   template <class T>
   static OpReturnType operate(OpReturnType list, std::vector<int64_t>&& shape, int size) {
     T* data = (T*)malloc(size * sizeof(T));
-    for (int i = 0; i < size; i++) {
-      data[i] = get_element<T>(list, shape, i, size);
+    T* end = data;
+    if (!copy_unboxed<T>(list, shape, 0, end)) {
+      for (int i = 0; i < size; i++) {
+        data[i] = get_element<T>(list, shape, i, size);
+      }
     }
     return OpReturnType(new TensorVariable(data, static_cast<DATATYPE>(get_dataType_enum<T>()),
                                            shape, CreateTensorType::MOVE));
@@ -62,37 +67,204 @@ class ListOperators {
 
   static OpReturnType operate_string(OpReturnType list, std::vector<int64_t>&& shape, int size);
   static OpReturnType create_tensor(int dataType, OpReturnType list);
+
+  /**
+   * @brief Copies the elements of a list, whose innermost lists have unboxed storage, to data
+   * @param list The list, or the nested list at dimension dim
+   * @param data Position to copy the elements of list to, advanced past them
+   * @return false if an innermost list stores boxed elements, or elements which are not converted
+   * to T implicitly, in which case the elements have to be read one by one
+   */
+  template <class T>
+  static bool copy_unboxed(const OpReturnType& list, const std::vector<int64_t>& shape, int dim,
+                           T*& data);
+};
+
+/**
+ * @brief Representation of the elements of a ListDataVariable
+ */
+enum class ListStorage : uint8_t {
+  EMPTY,   /**< No element added yet, the first appended element picks the storage */
+  INT64,   /**< Unboxed int64 scalars */
+  DOUBLE,  /**< Unboxed double scalars */
+  STRING,  /**< Unboxed strings */
+  GENERIC, /**< Boxed elements of any type */
 };
 
 class ListDataVariable : public DataVariable {
   int get_containerType() const override { return CONTAINERTYPE::LIST; }
 
-  std::vector<OpReturnType> _members; /**< Vector containing the list elements */
+  /*
+   * Lists whose elements are all int64s, doubles or strings keep them unboxed in a contiguous
+   * vector, the storage is picked by the first appended element. Storing an element of another
+   * type converts the list to boxed elements in _members for good.
+   *
+   * The box of an unboxed element is kept in _boxes once there is one, i.e. the box handed to
+   * append() or set_subscript(), or the one made when the element is first read. The tree walking
+   * interpreter allocates a box for every value it appends and reads list elements through
+   * get_int_subscript(), so keeping the boxes makes its reads as cheap as with boxed elements.
+   * Lists built without boxes, e.g. by slicing or from a std::vector, hold no boxes until read.
+   */
+  ListStorage _storage = ListStorage::EMPTY;
+  std::vector<OpReturnType> _members; /**< Elements of a GENERIC list */
+  std::vector<int64_t> _int64s;       /**< Elements of an INT64 list */
+  std::vector<double> _doubles;       /**< Elements of a DOUBLE list */
+  std::vector<std::string> _strings;  /**< Elements of a STRING list */
+  /** Boxes of the elements of an unboxed list, nullptr for elements not boxed yet */
+  mutable std::vector<OpReturnType> _boxes;
   std::vector<int64_t> _shape;        /**< Shape information for the list */
+  bool _shared = false;               /**< Whether mark_shared() was called */
 
   int get_dataType_enum() const override { return DATATYPE::EMPTY; }
 
-  OpReturnType get_int_subscript(int index) override {
+  /**
+   * @brief Returns the unboxed storage d can be kept in, GENERIC if there is none
+   */
+  static ListStorage storage_of(const OpReturnType& d) {
+    if (d->get_containerType() != CONTAINERTYPE::SINGLE) {
+      return ListStorage::GENERIC;
+    }
+    switch (d->get_dataType_enum()) {
+      case DATATYPE::INT64:
+        return ListStorage::INT64;
+      case DATATYPE::DOUBLE:
+        return ListStorage::DOUBLE;
+      case DATATYPE::STRING:
+        return ListStorage::STRING;
+      default:
+        return ListStorage::GENERIC;
+    }
+  }
+
+  OpReturnType make_box(int index) const {
+    switch (_storage) {
+      case ListStorage::INT64:
+        return OpReturnType(new SingleVariable<int64_t>(_int64s[index]));
+      case ListStorage::DOUBLE:
+        return OpReturnType(new SingleVariable<double>(_doubles[index]));
+      default:
+        return OpReturnType(new SingleVariable<std::string>(_strings[index]));
+    }
+  }
+
+  OpReturnType box(int index) const {
+    if (_storage == ListStorage::GENERIC) {
+      return _members[index];
+    }
+    if (_boxes[index]) {
+      return _boxes[index];
+    }
+    // Other threads can read a shared list, so boxes made by reads are only kept while it is private
+    if (_shared) {
+      return make_box(index);
+    }
+    return _boxes[index] = make_box(index);
+  }
+
+  /**
+   * @brief Boxes the elements of an unboxed list into _members
+   */
+  void make_generic() {
+    if (_storage == ListStorage::GENERIC) return;
+    int size = get_size();
+    std::vector<OpReturnType> members;
+    members.reserve(size);
+    for (int i = 0; i < size; i++) {
+      members.push_back(box(i));
+    }
+    _members = std::move(members);
+    std::vector<OpReturnType>().swap(_boxes);
+    std::vector<int64_t>().swap(_int64s);
+    std::vector<double>().swap(_doubles);
+    std::vector<std::string>().swap(_strings);
+    _storage = ListStorage::GENERIC;
+  }
+
+  template <class T>
+  static std::vector<T> slice_vector(const std::vector<T>& input, int start, int stop, int step,
+                                     int sliceSize) {
+    std::vector<T> sliced;
+    sliced.reserve(sliceSize);
+    const int size = input.size();
+    if (step > 0) {
+      for (int i = start; i < stop; i += step) {
+        if (i >= 0 && i < size) {
+          sliced.push_back(input[i]);
+        }
+      }
+    } else {
+      for (int i = start; i > stop; i += step) {
+        if (i >= 0 && i < size) {
+          sliced.push_back(input[i]);
+        }
+      }
+    }
+    return sliced;
+  }
+
+  int checked_index(int index) {
+    int size = get_size();
     int index_ = index;
     if (index_ < 0) {
-      index_ += _members.size();
+      index_ += size;
     }
-    if (index_ >= _members.size() || index_ < 0) {
-      THROW("trying to access %d index for list of size=%d", index, _members.size());
+    if (index_ >= size || index_ < 0) {
+      THROW("trying to access %d index for list of size=%d", index, size);
     }
-    return _members[index_];
+    return index_;
   }
 
-  int get_size() override { return _members.size(); }
+  OpReturnType get_int_subscript(int index) override { return box(checked_index(index)); }
+
+  int get_size() override {
+    switch (_storage) {
+      case ListStorage::INT64:
+        return _int64s.size();
+      case ListStorage::DOUBLE:
+        return _doubles.size();
+      case ListStorage::STRING:
+        return _strings.size();
+      default:
+        return _members.size();
+    }
+  }
 
   void set_subscript(const OpReturnType& subscriptVal, const OpReturnType& d) override {
     int index = subscriptVal->get_int32();
-    if (index >= _members.size() || index < 0) {
-      THROW("trying to set %d index for list of size=%d", index, _members.size());
+    if (index >= get_size() || index < 0) {
+      THROW("trying to set %d index for list of size=%d", index, get_size());
+    }
+    if (_storage != ListStorage::GENERIC && storage_of(d) == _storage) {
+      switch (_storage) {
+        case ListStorage::INT64:
+          _int64s[index] = d->get_int64();
+          break;
+        case ListStorage::DOUBLE:
+          _doubles[index] = d->get_double();
+          break;
+        default:
+          _strings[index] = d->get_string();
+      }
+      if (_shared) d->mark_shared();
+      _boxes[index] = d;
+      return;
     }
+    make_generic();
+    if (_shared) d->mark_shared();
     _members[index] = d;
   }
 
+  void mark_shared() override {
+    if (_shared) return;
+    _shared = true;
+    for (const auto& member : _members) {
+      member->mark_shared();
+    }
+    for (const auto& cached : _boxes) {
+      if (cached) cached->mark_shared();
+    }
+  }
+
   // Override get_subscript to handle both integer indices and slice objects
   OpReturnType get_subscript(const OpReturnType& subscriptVal) override {
     // If the subscript is a SliceVariable, handle slicing
@@ -119,14 +291,12 @@ class ListDataVariable : public DataVariable {
     const ListSliceVariable* slice = static_cast<const ListSliceVariable*>(sliceObj.get());
 
     // Extract slice parameters (start, stop, step)
-    const int size = _members.size();
+    const int size = get_size();
     int start = slice->get_start(size);
     int stop = slice->get_stop(size);
     int step = slice->get_step();
 
     // Optimize: Calculate slice size to pre-allocate memory
-    std::vector<OpReturnType> slicedMembers;
-
     int sliceSize = 0;
     if (step > 0) {
       // For positive step
@@ -137,21 +307,22 @@ class ListDataVariable : public DataVariable {
     }
 
     sliceSize = std::max(0, std::min(sliceSize, size));
-    slicedMembers.reserve(sliceSize);
 
-    if (step > 0) {
-      for (int i = start; i < stop; i += step) {
-        if (i >= 0 && i < size) {
-          slicedMembers.push_back(_members[i]);
-        }
-      }
-    } else {
-      for (int i = start; i > stop; i += step) {
-        if (i >= 0 && i < size) {
-          slicedMembers.push_back(_members[i]);
-        }
-      }
+    // Unboxed lists are sliced into a list with the same storage
+    switch (_storage) {
+      case ListStorage::INT64:
+        return std::make_shared<ListDataVariable>(
+            slice_vector(_int64s, start, stop, step, sliceSize));
+      case ListStorage::DOUBLE:
+        return std::make_shared<ListDataVariable>(
+            slice_vector(_doubles, start, stop, step, sliceSize));
+      case ListStorage::STRING:
+        return std::make_shared<ListDataVariable>(
+            slice_vector(_strings, start, stop, step, sliceSize));
+      default:
+        break;
     }
+    auto slicedMembers = slice_vector(_members, start, stop, step, sliceSize);
 
     // Create a new list with the sliced elements - move semantics to avoid copying
     return OpReturnType(new ListDataVariable(std::move(slicedMembers)));
@@ -159,15 +330,25 @@ class ListDataVariable : public DataVariable {
 
   std::string print() override {
     std::string output = "[";
-    for (int i = 0; i < _members.size(); i++) {
+    for (int i = 0; i < get_size(); i++) {
       if (i != 0) output += ",";
-      output += _members[i]->print();
+      output += box(i)->print();
     }
     output += "]";
     return output;
   }
 
   nlohmann::json to_json() const override {
+    switch (_storage) {
+      case ListStorage::INT64:
+        return _int64s;
+      case ListStorage::DOUBLE:
+        return _doubles;
+      case ListStorage::STRING:
+        return _strings;
+      default:
+        break;
+    }
     auto output = nlohmann::json::array();
     for (const auto& member : _members) {
       output.push_back(member->to_json());
@@ -210,14 +391,16 @@ class ListDataVariable : public DataVariable {
       if (index->get_int32() < 0 || index->get_int32() >= _shape[0]) {
         THROW("Tried to access %d index of the tensor.", index->get_int32());
       }
-      list->append(_members[index->get_int32()]);
+      list->append(box(index->get_int32()));
     }
     return list;
   }
 
-  int get_numElements() override { return _members.size(); }
+  int get_numElements() override { return get_size(); }
 
   JsonIterator* get_json_iterator() override {
+    // The C API hands out pointers into the elements, so they have to be boxed for good
+    make_generic();
     return new JsonIterator(_members.begin(), _members.end());
   }
 
@@ -227,11 +410,26 @@ class ListDataVariable : public DataVariable {
       case MemberFuncType::POP: {
         THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, memberFuncIndex);
         int index = arguments[0]->get_int32();
-        if (index >= _members.size() || index < 0) {
-          THROW("Trying to delete %d index of list of size=%d", index, _members.size());
+        if (index >= get_size() || index < 0) {
+          THROW("Trying to delete %d index of list of size=%d", index, get_size());
+        }
+        auto value = box(index);
+        switch (_storage) {
+          case ListStorage::INT64:
+            _int64s.erase(_int64s.begin() + index);
+            _boxes.erase(_boxes.begin() + index);
+            break;
+          case ListStorage::DOUBLE:
+            _doubles.erase(_doubles.begin() + index);
+            _boxes.erase(_boxes.begin() + index);
+            break;
+          case ListStorage::STRING:
+            _strings.erase(_strings.begin() + index);
+            _boxes.erase(_boxes.begin() + index);
+            break;
+          default:
+            _members.erase(_members.begin() + index);
         }
-        auto value = _members[index];
-        _members.erase(_members.begin() + index);
         return value;
       }
       default: {
@@ -241,27 +439,100 @@ class ListDataVariable : public DataVariable {
   }
 
  public:
+  /**
+   * @brief Creates a list of already boxed elements, which keeps them boxed
+   */
   ListDataVariable(std::vector<OpReturnType>&& members) {
     _members = std::move(members);
+    _storage = _members.empty() ? ListStorage::EMPTY : ListStorage::GENERIC;
     _shape.push_back(_members.size());
   }
 
   ListDataVariable() { _shape.push_back(0); }
 
   template <class T, class = std::enable_if_t<!std::is_same_v<T, OpReturnType>>>
-  ListDataVariable(const std::vector<T>& input) {
-    for (int i = 0; i < input.size(); i++) {
-      _members.push_back(OpReturnType(new SingleVariable<T>(input[i])));
+  ListDataVariable(std::vector<T> input) {
+    _shape.push_back(input.size());
+    if (input.empty()) return;
+    if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double> ||
+                  std::is_same_v<T, std::string>) {
+      _boxes.resize(input.size());
+    }
+    if constexpr (std::is_same_v<T, int64_t>) {
+      _storage = ListStorage::INT64;
+      _int64s = std::move(input);
+    } else if constexpr (std::is_same_v<T, double>) {
+      _storage = ListStorage::DOUBLE;
+      _doubles = std::move(input);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      _storage = ListStorage::STRING;
+      _strings = std::move(input);
+    } else {
+      _storage = ListStorage::GENERIC;
+      for (int i = 0; i < input.size(); i++) {
+        _members.push_back(OpReturnType(new SingleVariable<T>(input[i])));
+      }
     }
-    _shape.push_back(_members.size());
   }
 
   bool get_bool() override { return get_size() > 0; }
 
-  std::vector<OpReturnType> get_members() { return _members; }
+  std::vector<OpReturnType> get_members() {
+    if (_storage == ListStorage::GENERIC) return _members;
+    std::vector<OpReturnType> members;
+    for (int i = 0; i < get_size(); i++) {
+      members.push_back(box(i));
+    }
+    return members;
+  }
+
+  /**
+   * @brief Same as get_int_subscript(), but returns the elements of INT64 and DOUBLE lists without
+   * boxing them
+   */
+  Value get_int_subscript_value(int index) {
+    index = checked_index(index);
+    switch (_storage) {
+      case ListStorage::INT64:
+        return Value(_int64s[index]);
+      case ListStorage::DOUBLE:
+        return Value(_doubles[index]);
+      default:
+        return Value::unbox(box(index));
+    }
+  }
+
+  ListStorage get_storage() const { return _storage; }
+
+  const std::vector<int64_t>& get_int64s() const { return _int64s; }
+
+  const std::vector<double>& get_doubles() const { return _doubles; }
+
+  const std::vector<std::string>& get_strings() const { return _strings; }
 
   OpReturnType append(OpReturnType d) override {
-    _members.push_back(d);
+    ListStorage storage = storage_of(d);
+    if (_storage == ListStorage::EMPTY) {
+      _storage = storage;
+    }
+    if (storage == _storage && storage != ListStorage::GENERIC) {
+      switch (storage) {
+        case ListStorage::INT64:
+          _int64s.push_back(d->get_int64());
+          break;
+        case ListStorage::DOUBLE:
+          _doubles.push_back(d->get_double());
+          break;
+        default:
+          _strings.push_back(d->get_string());
+      }
+      if (_shared) d->mark_shared();
+      _boxes.push_back(d);
+    } else {
+      make_generic();
+      if (_shared) d->mark_shared();
+      _members.push_back(d);
+    }
     _shape.back()++;
     return shared_from_this();
   }
@@ -302,8 +573,25 @@ def tensor(list: list[any], dtype: str) -> Tensor:
   }
 
   bool in(const OpReturnType& elem) override {
-    for (int i = 0; i < _members.size(); i++) {
-      if (BaseBinOp::compare_equal(get_int_subscript(i), elem)) {
+    // Like BaseBinOp::compare_equal, elements only match values of the same type, so 20.0 is not
+    // in [10, 20]. Unboxed elements all have the type of the storage.
+    if (_storage != ListStorage::GENERIC && _storage != ListStorage::EMPTY) {
+      if (storage_of(elem) != _storage) {
+        return false;
+      }
+      switch (_storage) {
+        case ListStorage::INT64:
+          return std::find(_int64s.begin(), _int64s.end(), elem->get_int64()) != _int64s.end();
+        case ListStorage::DOUBLE:
+          return std::find(_doubles.begin(), _doubles.end(), elem->get_double()) !=
+                 _doubles.end();
+        default:
+          return std::find(_strings.begin(), _strings.end(), elem->get_string()) !=
+                 _strings.end();
+      }
+    }
+    for (const auto& member : _members) {
+      if (BaseBinOp::compare_equal(member, elem)) {
         return true;
       }
     }
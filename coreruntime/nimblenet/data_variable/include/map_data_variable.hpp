@@ -6,9 +6,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "data_variable.hpp"
 #include "tuple_data_variable.hpp"
@@ -18,6 +22,58 @@
 class MapDataVariable;
 typedef std::shared_ptr<MapDataVariable> MapVariablePtr;
 
+/**
+ * @brief Open addressing hash index over the entries of a std::map with string keys.
+ *
+ * Slots store the hash of the key, so probing compares hashes and only compares strings on a hash
+ * match. Keys inserted or looked up as InternedKey are matched by pointer. Uses linear probing with
+ * backward shift deletion, so there are no tombstones. Entries of a std::map are never moved, so
+ * the index stays valid until an entry is erased from both.
+ *
+ * Inserts and erases update both the std::map and the index, which makes filling a small dict
+ * slightly slower. Lookups, which scripts do far more often, no longer walk the tree comparing
+ * strings at every level.
+ */
+class MapIndex {
+ public:
+  using Entry = std::map<std::string, OpReturnType>::value_type;
+
+ private:
+  struct Slot {
+    uint64_t hash = 0;
+    Entry* entry = nullptr;                /**< nullptr for an empty slot */
+    const InternedKey* interned = nullptr; /**< Interned key the entry was inserted with, if any */
+  };
+
+  std::vector<Slot> _slots; /**< Power of two number of slots, empty till the first insert */
+  size_t _size = 0;
+
+  size_t find_slot(uint64_t hash, std::string_view key, const InternedKey* interned) const;
+  void grow();
+
+ public:
+  /**
+   * @brief Returns the entry with the given key, nullptr if there is none
+   * @param interned Interned key, if key was interned, to match entries by pointer
+   */
+  Entry* find(uint64_t hash, std::string_view key, const InternedKey* interned = nullptr) const;
+
+  /**
+   * @brief Adds an entry, whose key must not be in the index yet.
+   */
+  void insert(uint64_t hash, Entry* entry, const InternedKey* interned = nullptr);
+
+  /**
+   * @brief Removes an entry which is in the index.
+   */
+  void erase(uint64_t hash, const Entry* entry);
+
+  /**
+   * @brief Indexes all the entries of map, replacing the current contents.
+   */
+  void rebuild(std::map<std::string, OpReturnType>& map);
+};
+
 /**
  * @brief Thread-safe map data variable implementation for key-value storage
  *
@@ -26,13 +82,69 @@ typedef std::shared_ptr<MapDataVariable> MapVariablePtr;
  * It uses a read-write lock (shared_mutex) to allow concurrent reads while
  * ensuring exclusive access for writes.
  *
+ * Entries are kept in an ordered std::map, which get_map() and iteration expose, and are looked up
+ * through a MapIndex hash index. Dicts created by the script belong to the creating thread and are
+ * accessed without locking till mark_shared() is called, which happens before they become
+ * reachable from other threads: when the frames holding them are shared, when they are stored in a
+ * shared frame or map, passed to the ConcurrentExecutor or returned by its workers, cached, or
+ * reachable from a scheduled job or an event hook. Another thread accessing a map which is not
+ * shared marks it shared, see is_thread_local(). Maps created by the runtime are shared from the
+ * start.
+ *
  * The class supports standard map operations like insertion, lookup, removal,
  * and iteration. It also provides JSON serialization capabilities and
  * integration with the NimbleNet tensor system through CTensors conversion.
  */
 class MapDataVariable final : public DataVariable {
   std::map<std::string, OpReturnType> _map; /**< Internal map storing key-value pairs */
+  MapIndex _index;                          /**< Hash index over the entries of _map */
   mutable std::shared_mutex _mutex;         /**< Read-write lock for thread safety */
+  std::thread::id _owner;                   /**< Thread using the map without locking */
+  std::atomic<bool> _shared = true;         /**< Whether accesses have to take _mutex */
+
+  /**
+   * @brief Returns true if the calling thread can access the map without locking
+   *
+   * A map which reaches another thread without being shared is marked shared by that thread, so
+   * that all later accesses lock. This is a fallback: the owner could be in the middle of an
+   * unlocked access at that moment, so the map should still be marked shared before it escapes its
+   * thread.
+   */
+  bool is_thread_local() const {
+    if (_shared.load(std::memory_order_acquire)) {
+      return false;
+    }
+    if (_owner != std::this_thread::get_id()) {
+      const_cast<MapDataVariable*>(this)->mark_shared();
+      return false;
+    }
+    return true;
+  }
+
+  std::shared_lock<std::shared_mutex> read_lock() const {
+    std::shared_lock<std::shared_mutex> lock(_mutex, std::defer_lock);
+    if (!is_thread_local()) lock.lock();
+    return lock;
+  }
+
+  std::unique_lock<std::shared_mutex> write_lock() {
+    std::unique_lock<std::shared_mutex> lock(_mutex, std::defer_lock);
+    if (!is_thread_local()) lock.lock();
+    return lock;
+  }
+
+  /**
+   * @brief Inserts or assigns the value of key, the caller holds the write lock
+   */
+  void set_entry(const std::string& key, uint64_t hash, const InternedKey* interned,
+                 const OpReturnType& d);
+
+  /**
+   * @brief Marks d as shared if this map is, has to be called before d is stored
+   */
+  void share_value(const OpReturnType& d) const {
+    if (_shared.load(std::memory_order_acquire)) d->mark_shared();
+  }
 
   int get_containerType() const override { return CONTAINERTYPE::MAP; }
 
@@ -47,6 +159,22 @@ class MapDataVariable final : public DataVariable {
  public:
   void set_value_in_map(const std::string& key, const OpReturnType& d) override;
 
+  OpReturnType get_interned_subscript(const InternedKey& key) override;
+
+  void set_interned_subscript(const InternedKey& key, const OpReturnType& d) override;
+
+  void mark_shared() override;
+
+  /**
+   * @brief Lets the calling thread access the map without locking till mark_shared() is called.
+   *
+   * Has to be called by the thread that created the map, before any other thread can reach it.
+   */
+  void set_thread_local() {
+    _owner = std::this_thread::get_id();
+    _shared.store(false, std::memory_order_release);
+  }
+
   bool in(const OpReturnType& elem) override;
 
   JsonIterator* get_json_iterator() override;
@@ -85,14 +213,18 @@ class MapDataVariable final : public DataVariable {
   /**
    * @brief Constructs a map from CTensors structure
    * @param inputs CTensors structure containing named tensors and variables
+   * @param type COPY or BORROW, how the data of numeric tensors is used
    */
-  MapDataVariable(const CTensors& inputs);
+  MapDataVariable(const CTensors& inputs, CreateTensorType type = CreateTensorType::COPY);
 
   /**
    * @brief Move constructor from an existing map
    * @param m R-value reference to a map to move from
    */
-  MapDataVariable(std::map<std::string, OpReturnType>&& m) { _map = std::move(m); }
+  MapDataVariable(std::map<std::string, OpReturnType>&& m) {
+    _map = std::move(m);
+    _index.rebuild(_map);
+  }
 
   /**
    * @brief Merges another map variable into this one
@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <string_view>
+
+#include "data_variable_enums.hpp"
+
+/**
+ * @brief Name of a member function and its MemberFuncType.
+ */
+struct MemberFuncName {
+  std::string_view name;
+  int index;
+};
+
+/**
+ * @brief Names of all member functions, sorted by name so that they are found by binary search.
+ *
+ * When adding a new MemberFuncType, add its name here, keeping the order. The static_asserts below
+ * fail the build if the table is not sorted or if a MemberFuncType is missing or repeated.
+ */
+inline constexpr MemberFuncName MemberFuncNames[] = {
+    {"ConcurrentExecutor", MemberFuncType::CREATE_CONCURRENT_EXECUTOR},
+    {"Dataframe", MemberFuncType::GET_DATAFRAME},
+    {"JsonDocument", MemberFuncType::JSON_DOCUMENT},
+    {"Model", MemberFuncType::LOADMODEL},
+    {"RawEventStore", MemberFuncType::GET_RAW_EVENTS_STORE},
+    {"Retriever", MemberFuncType::RETRIEVER},
+    {"__init__", MemberFuncType::CONSTRUCTOR},
+    {"add_computation", MemberFuncType::ADD_COMPUTATION_PROCESSOR},
+    {"add_context", MemberFuncType::ADD_CONTEXT},
+    {"append", MemberFuncType::APPEND},
+    {"argsort", MemberFuncType::ARGSORT},
+    {"arrange", MemberFuncType::ARRANGE},
+    {"cache", MemberFuncType::CREATE_CACHE},
+    {"cancel", MemberFuncType::CANCEL},
+    {"clear", MemberFuncType::CACHE_CLEAR},
+    {"clear_context", MemberFuncType::CLEAR_CONTEXT},
+    {"create", MemberFuncType::CREATE_PROCESSOR},
+    {"create_simulated_char_stream", MemberFuncType::CREATE_SIM_CHAR_STREAM},
+    {"end", MemberFuncType::REGEX_MATCHOBJECT_END},
+    {"exp", MemberFuncType::EXP},
+    {"fetch", MemberFuncType::FEATURE_FETCH},
+    {"filter", MemberFuncType::FEATURE_FILTER},
+    {"filter_all", MemberFuncType::FEATURE_FILTER_ALL},
+    {"filter_by_function", MemberFuncType::FEATURE_FILTER_FUNCTION},
+    {"findall", MemberFuncType::REGEX_FINDALL},
+    {"finditer", MemberFuncType::REGEX_FINDITER},
+    {"finished", MemberFuncType::FINISHED},
+    {"fullmatch", MemberFuncType::REGEX_FULLMATCH},
+    {"get", MemberFuncType::GET_BY_KEY},
+    {"get_blocking", MemberFuncType::GET_BLOCKING},
+    {"get_blocking_str", MemberFuncType::GET_BLOCKING_STR},
+    {"get_chrono_time", MemberFuncType::GET_CHRONO_TIME},
+    {"get_config", MemberFuncType::GET_CONFIG},
+    {"get_for_items", MemberFuncType::GET_PROCESSOR_OUTPUT},
+    {"get_inline_cache_stats", MemberFuncType::INLINE_CACHE_STATS},
+    {"get_or_compute", MemberFuncType::CACHE_GET_OR_COMPUTE},
+    {"group", MemberFuncType::REGEX_MATCHOBJECT_GROUP},
+    {"groupBy", MemberFuncType::CREATE_GROUPBY_COLUMNS_PROCESSOR},
+    {"groups", MemberFuncType::REGEX_MATCHOBJECT_GROUPS},
+    {"is_float", MemberFuncType::ISFLOAT},
+    {"is_integer", MemberFuncType::ISINTEGER},
+    {"is_string", MemberFuncType::ISSTRING},
+    {"iterator", MemberFuncType::ITERATOR},
+    {"join", MemberFuncType::STRING_JOIN},
+    {"keys", MemberFuncType::KEYS},
+    {"list_compatible_llms", MemberFuncType::LIST_COMPATIBLE_LLMS},
+    {"llm", MemberFuncType::LLM},
+    {"log", MemberFuncType::LOG},
+    {"lower", MemberFuncType::STRING_LOWER},
+    {"map_chunked", MemberFuncType::MAP_CHUNKED},
+    {"match", MemberFuncType::REGEX_MATCH},
+    {"max", MemberFuncType::MAX},
+    {"max_input_num_tokens", MemberFuncType::MAX_INPUT_NUM_TOKENS},
+    {"maximum", MemberFuncType::MAXIMUM},
+    {"mean", MemberFuncType::MEAN},
+    {"min", MemberFuncType::MIN},
+    {"minimum", MemberFuncType::MINIMUM},
+    {"next", MemberFuncType::NEXT},
+    {"next_available", MemberFuncType::NEXT_AVAILABLE},
+    {"next_blocking", MemberFuncType::NEXT_BLOCKING},
+    {"num_keys", MemberFuncType::NUM_KEYS},
+    {"parallel_reduce", MemberFuncType::PARALLEL_REDUCE},
+    {"parse_json", MemberFuncType::PARSE_JSON},
+    {"pop", MemberFuncType::POP},
+    {"pow", MemberFuncType::POW},
+    {"processor", MemberFuncType::CREATE_PROCESSOR_INIT},
+    {"prompt", MemberFuncType::PROMPT},
+    {"put", MemberFuncType::CACHE_PUT},
+    {"reshape", MemberFuncType::RESHAPE},
+    {"rollingWindow", MemberFuncType::CREATE_ROLLINGWINDOW_PROCESSOR},
+    {"run", MemberFuncType::RUNMODEL},
+    {"run_parallel", MemberFuncType::RUNPARALLEL},
+    {"schedule_job", MemberFuncType::SCHEDULE_JOB},
+    {"search", MemberFuncType::REGEX_SEARCH},
+    {"set_threadpool_threads", MemberFuncType::SET_THREADS},
+    {"shape", MemberFuncType::GETSHAPE},
+    {"skip_text_and_get_json_stream", MemberFuncType::SKIP_TEXT_AND_GET_JSON_STREAM},
+    {"sort", MemberFuncType::SORT},
+    {"span", MemberFuncType::REGEX_MATCHOBJECT_SPAN},
+    {"split", MemberFuncType::REGEX_SPLIT},
+    {"start", MemberFuncType::REGEX_MATCHOBJECT_START},
+    {"stats", MemberFuncType::CACHE_STATS},
+    {"status", MemberFuncType::GETMODELSTATUS},
+    {"strip", MemberFuncType::STRING_STRIP},
+    {"sub", MemberFuncType::REGEX_SUB},
+    {"subn", MemberFuncType::REGEX_SUBN},
+    {"sum", MemberFuncType::SUM},
+    {"sync", MemberFuncType::SYNC},
+    {"tensor", MemberFuncType::TO_TENSOR},
+    {"time", MemberFuncType::GET_TIME},
+    {"to_json_stream", MemberFuncType::TO_JSON_STREAM},
+    {"topk", MemberFuncType::TOPK},
+    {"topk_values", MemberFuncType::TOPK_VALUES},
+    {"unicode", MemberFuncType::UNICODE},
+    {"upper", MemberFuncType::STRING_UPPER},
+    {"wait_for_completion", MemberFuncType::WAIT_FOR_COMPLETION},
+    {"zeros", MemberFuncType::CREATETENSOR},
+};
+
+inline constexpr int NumMemberFuncNames = sizeof(MemberFuncNames) / sizeof(MemberFuncNames[0]);
+
+namespace member_func_table {
+
+constexpr bool is_sorted() {
+  for (int i = 1; i < NumMemberFuncNames; i++) {
+    if (!(MemberFuncNames[i - 1].name < MemberFuncNames[i].name)) return false;
+  }
+  return true;
+}
+
+constexpr std::array<std::string_view, MemberFuncType::LASTTYPE> build_names_by_index() {
+  std::array<std::string_view, MemberFuncType::LASTTYPE> names{};
+  for (const auto& entry : MemberFuncNames) {
+    names[entry.index] = entry.name;
+  }
+  return names;
+}
+
+constexpr bool covers_all_types() {
+  auto names = build_names_by_index();
+  for (const auto& name : names) {
+    if (name.empty()) return false;
+  }
+  return NumMemberFuncNames == MemberFuncType::LASTTYPE;
+}
+
+}  // namespace member_func_table
+
+static_assert(member_func_table::is_sorted(), "MemberFuncNames has to be sorted by name");
+static_assert(member_func_table::covers_all_types(),
+              "MemberFuncNames has to contain every MemberFuncType exactly once");
+
+/**
+ * @brief Names of the member functions indexed by their MemberFuncType.
+ */
+inline constexpr auto MemberFuncNamesByIndex = member_func_table::build_names_by_index();
+
+/**
+ * @brief Returns the MemberFuncType of a member function name, -1 if it is not a member function.
+ */
+constexpr int find_member_func(std::string_view name) {
+  int low = 0;
+  int high = NumMemberFuncNames;
+  while (low < high) {
+    int mid = (low + high) / 2;
+    if (MemberFuncNames[mid].name < name) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (low < NumMemberFuncNames && MemberFuncNames[low].name == name) {
+    return MemberFuncNames[low].index;
+  }
+  return -1;
+}
+
+static_assert(find_member_func("append") == MemberFuncType::APPEND);
+static_assert(find_member_func("__init__") == MemberFuncType::CONSTRUCTOR);
+static_assert(find_member_func("not_a_member_function") == -1);
@@ -61,6 +61,10 @@ class ModelNimbleNetVariable final : public DataVariable {
         ----------
         modelOutput : tuple[Tensor, ...]
             Returns the output tensors of model as a tuple. The order of tensors is the same as defined during model construction.
+
+        Notes
+        ----------
+        When the script is loaded with "concurrentModelRun": true in the config, other functions of the script can run while the model runs. A sequence of statements that reads and updates module variables before and after a call to run is then not atomic, e.g. `count = count + 1` split across a run call can lose updates made by other functions in the meantime.
         """
         pass
   DELITEPY_DOC_BLOCK_END
@@ -97,17 +101,15 @@ class ModelNimbleNetVariable final : public DataVariable {
     return OpReturnType(new SingleVariable<bool>(true));
   }
 
+  /**
+   * @brief Calls a member function of the model.
+   *
+   * @details With the concurrentModelRun flag of the config the script lock is released while the
+   * model runs, the model guards its own state, so that other functions of the script are not
+   * blocked by a slow inference.
+   */
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
-                             CallStack& stack) override {
-    switch (memberFuncIndex) {
-      case MemberFuncType::RUNMODEL:
-        return run_model(arguments);
-      case MemberFuncType::GETMODELSTATUS:
-        return get_model_status(arguments);
-    }
-    THROW("%s not implemented for nimblenet",
-          DataVariable::get_member_func_string(memberFuncIndex));
-  }
+                             CallStack& stack) override;
 
   nlohmann::json to_json() const override { return "[Model]"; }
 
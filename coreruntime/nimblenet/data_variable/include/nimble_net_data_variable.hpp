@@ -9,6 +9,8 @@
 #include <memory>
 #include <type_traits>
 
+#include "background_job_data_variable.hpp"
+#include "cache_data_variable.hpp"
 #include "dataframe_variable.hpp"
 #include "model_nimble_net_variable.hpp"
 #include "nimble_net_util.hpp"
@@ -17,6 +19,7 @@
 #include "raw_event_store_data_variable.hpp"
 #include "single_variable.hpp"
 #include "tensor_data_variable.hpp"
+#include "tensor_operators.hpp"
 
 #ifndef MINIMAL_BUILD
 #include "concurrent_executor_variable.hpp"
@@ -35,10 +38,13 @@ class CommandCenter;
  * The class implements a comprehensive set of operations including:
  * - Tensor creation and manipulation
  * - Model and LLM loading with async support
- * - Mathematical functions (exp, pow, min, max, sum, mean, log)
+ * - Mathematical functions (exp, pow, minimum, maximum, log)
+ * - Tensor reductions along axes (min, max, sum, mean)
  * - Data storage and retrieval (raw events, dataframes)
  * - System utilities (time, configuration access)
  * - Concurrent execution support
+ * - Memoization caches
+ * - Background jobs of the script
  *
  * All operations are dispatched through the call_function method using
  * member function indices, providing a unified interface for script execution.
@@ -89,13 +95,17 @@ def zeros(shape: list[int], dtype: str) -> Tensor:
 
   OpReturnType get_dataframe(const std::vector<OpReturnType>& arguments);
 
-  OpReturnType min(const std::vector<OpReturnType>& args);
+  /**
+   * @brief Reduces a tensor given as (tensor[, axis[, keepdims]]), see TensorOperators::reduce()
+   */
+  OpReturnType reduce(TensorReduction reduction, const std::vector<OpReturnType>& args,
+                      int memberFuncIndex);
 
-  OpReturnType max(const std::vector<OpReturnType>& args);
-
-  OpReturnType sum(const std::vector<OpReturnType>& args);
-
-  OpReturnType mean(const std::vector<OpReturnType>& args);
+  /**
+   * @brief Computes op elementwise on two operands, at least one of them being a tensor
+   */
+  OpReturnType elementwise(ElementwiseOp op, const std::vector<OpReturnType>& args,
+                           int memberFuncIndex);
 
   OpReturnType log(const std::vector<OpReturnType>& args);
 
@@ -113,6 +123,79 @@ def zeros(shape: list[int], dtype: str) -> Tensor:
 
   OpReturnType set_threads(const std::vector<OpReturnType>& arguments);
 
+  /*
+  DELITEPY_DOC_BLOCK_BEGIN
+
+def cache(max_entries: int, ttl_secs: float = None, max_bytes: int = None) -> Cache:
+    """
+    Creates a memoization cache, evicting the least recently used entries once it is full.
+
+    The cache supports get(key, default=None), put(key, value), get_or_compute(key, fn),
+    pop(key, default=None), clear(), stats(), len() and the in operator. Keys can be strings,
+    numbers, booleans, None, tensors and lists or tuples of those. get_or_compute calls fn(key)
+    on a miss and stores its result. The cache can be used by the functions run by a
+    ConcurrentExecutor.
+
+    Parameters
+    ----------
+    max_entries : int
+        Maximum number of entries in the cache.
+    ttl_secs : float
+        Seconds after which an entry expires, rounded up to whole seconds, None or 0 for entries
+        which never expire.
+    max_bytes : int
+        Maximum estimated size of the keys and values in bytes, None or 0 for no limit.
+
+    Returns
+    ----------
+    cache : Cache
+        The cache. stats() returns a dict with hits, misses, evictions, expirations, entries,
+        bytes and hitRate.
+    """
+    pass
+  DELITEPY_DOC_BLOCK_END
+  */
+  OpReturnType create_cache(const std::vector<OpReturnType>& arguments);
+
+  /*
+  DELITEPY_DOC_BLOCK_BEGIN
+
+def schedule_job(fn: Callable[[], None], interval_secs: float, high_priority: bool = False,
+                 max_run_secs: float = None, when_idle: bool = False) -> BackgroundJob:
+    """
+    Runs a function of the script periodically in the background, outside of the calls of the
+    methods of the script. Useful to precompute features, refresh caches or compact stores ahead of
+    the methods needing them.
+
+    The function is first run soon after it is scheduled, then at most once every interval_secs.
+    Errors raised by the function are logged and the job keeps running. Background jobs run on the
+    thread of the SDK doing its background work, in simulation they run when run_method is called
+    with a timestamp, following the simulated time.
+
+    Parameters
+    ----------
+    fn : Callable[[], None]
+        Function taking no arguments.
+    interval_secs : float
+        Minimum number of seconds between the starts of two runs.
+    high_priority : bool
+        Run the job before the other background work of the SDK.
+    max_run_secs : float
+        Stop the job once a run takes longer than this, None or 0 for no limit. Must not be
+        negative. Runs are not interrupted.
+    when_idle : bool
+        Defer the runs while methods of the script are running.
+
+    Returns
+    ----------
+    job : BackgroundJob
+        Handle of the job, job.cancel() stops it.
+    """
+    pass
+  DELITEPY_DOC_BLOCK_END
+  */
+  OpReturnType schedule_job(const std::vector<OpReturnType>& arguments);
+
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) override;
 
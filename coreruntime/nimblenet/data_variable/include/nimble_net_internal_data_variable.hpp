@@ -63,6 +63,8 @@ class NimbleNetInternalDataVariable final : public DataVariable {
         return create_sim_char_stream(arguments, stack);
       case MemberFuncType::RETRIEVER:
         return create_retriever(arguments, stack);
+      case MemberFuncType::INLINE_CACHE_STATS:
+        return get_inline_cache_stats();
     }
     THROW("%s not implemented for nimblenetInternalTesting",
           DataVariable::get_member_func_string(memberFuncIndex));
@@ -98,6 +100,12 @@ class NimbleNetInternalDataVariable final : public DataVariable {
    */
   OpReturnType create_retriever(const std::vector<OpReturnType>& arguments, CallStack& stack);
 
+  /**
+   * @brief Returns the hits and misses of the inline caches of member function calls
+   * @return OpReturnType containing a map with keys "hits" and "misses"
+   */
+  OpReturnType get_inline_cache_stats();
+
   nlohmann::json to_json() const override { return "[NimbleNetInternal]"; }
 
  public:
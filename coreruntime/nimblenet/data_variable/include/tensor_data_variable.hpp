@@ -12,6 +12,7 @@
 #include "data_variable.hpp"
 #include "data_variable_enums.hpp"
 #include "ne_fwd.hpp"
+#include "tensor_buffer_pool.hpp"
 #include "util.hpp"
 
 /**
@@ -78,12 +79,21 @@ class BaseTypedTensorVariable : public BaseTensorVariable {
   OpReturnType get_int_subscript(int index) final;
   OpReturnType get_string_subscript(const std::string& key) override;
   OpReturnType sort(const OpReturnType argument) override;
-  OpReturnType argsort(const OpReturnType argument) override;
+  OpReturnType argsort(const std::vector<OpReturnType>& arguments) override;
 
   OpReturnType topk(const std::vector<OpReturnType>& arguments) override;
+  OpReturnType topk_values(const std::vector<OpReturnType>& arguments) override;
   OpReturnType arrange(const OpReturnType argument) override;
 
  private:
+  /**
+   * @brief Selects the (k, order[, axis]) first elements along the axis, the last one by default
+   *
+   * @return Positions of the elements along the axis, or their values if returnValues is set
+   */
+  OpReturnType select_topk(const std::vector<OpReturnType>& arguments, int memberFuncIndex,
+                           bool returnValues);
+
   void set_json_subscript(const OpReturnType& subscriptVal, const OpReturnType& d);
 
  public:
@@ -122,6 +132,11 @@ class SliceVariable : public BaseTypedTensorVariable {
  public:
   SliceVariable(std::shared_ptr<BaseTypedTensorVariable> origTensor_, DATATYPE dataType,
                 const std::vector<int64_t>& shape_, int startIndex_, int size_);
+
+  /**
+   * @brief Detaches the original tensor if it is borrowed, as the slice reads its data.
+   */
+  void mark_shared() override { origTensor->mark_shared(); }
 };
 
 /**
@@ -129,10 +144,13 @@ class SliceVariable : public BaseTypedTensorVariable {
  *
  * This class represents a complete tensor with its own memory allocation.
  * It handles memory management through construction and destruction, supporting
- * both copy and move semantics for data initialization.
+ * both copy and move semantics for data initialization. Data allocated by the tensor comes from
+ * TensorBufferPool, data moved into it is malloc'd by the caller.
  */
 class TensorVariable : public BaseTypedTensorVariable {
   void* variable = nullptr; /**< Raw pointer to tensor data */
+  bool pooled = false;      /**< Whether variable is owned by TensorBufferPool, else by malloc */
+  bool borrowed = false;    /**< Whether variable is owned by the creator of the tensor */
 
  public:
   void* get_raw_ptr() final { return variable; }
@@ -157,7 +175,33 @@ class TensorVariable : public BaseTypedTensorVariable {
 
   TensorVariable(const std::vector<int64_t>& shape_, DATATYPE dataType);
 
-  virtual ~TensorVariable() { free(variable); }
+  bool is_borrowed() const { return borrowed; }
+
+  /**
+   * @brief Gives a borrowed tensor its own copy of the data, before the owner frees it.
+   *
+   * Has no effect on tensors owning their data. Must not run concurrently with other accesses to
+   * the tensor, so it is called by the thread using the tensor before the tensor escapes to other
+   * threads, see mark_shared(), or once the call which borrowed the data returns.
+   */
+  void detach();
+
+  /**
+   * @brief Detaches a borrowed tensor, since other threads may use it after the call which
+   * borrowed the data has returned, e.g. from a global, a cache or a background job.
+   */
+  void mark_shared() override { detach(); }
+
+  virtual ~TensorVariable() {
+    if (borrowed) {
+      return;
+    }
+    if (pooled) {
+      TensorBufferPool::instance().release(variable);
+    } else {
+      free(variable);
+    }
+  }
 };
 
 /**
@@ -178,6 +222,14 @@ class StringTensorVariable : public DataVariable {
 
   const void* get_raw_ptr() const { return (const void*)_data.data(); }
 
+  /**
+   * @brief Selects the (k, order[, axis]) first elements of the 1 dimensional tensor
+   *
+   * @return Positions of the elements, equal elements keep their order in the tensor
+   */
+  std::vector<int32_t> select_topk(const std::vector<OpReturnType>& arguments,
+                                   int memberFuncIndex);
+
   char** get_string_ptr() final;
 
   bool get_bool() final { return _numElements; }
@@ -212,10 +264,12 @@ class StringTensorVariable : public DataVariable {
 
   OpReturnType sort(const OpReturnType argument) override;
 
-  OpReturnType argsort(const OpReturnType argument) override;
+  OpReturnType argsort(const std::vector<OpReturnType>& arguments) override;
 
   OpReturnType topk(const std::vector<OpReturnType>& arguments) override;
 
+  OpReturnType topk_values(const std::vector<OpReturnType>& arguments) override;
+
   OpReturnType arrange(const OpReturnType argument) override;
 
   bool is_integer() override { return false; }
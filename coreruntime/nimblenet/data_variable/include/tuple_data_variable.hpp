@@ -53,6 +53,12 @@ class TupleDataVariable final : public DataVariable {
     _members[index] = d;
   }
 
+  void mark_shared() override {
+    for (const auto& member : _members) {
+      member->mark_shared();
+    }
+  }
+
   /**
    * @brief Converts the tuple to a string representation
    * @return String representation in the format "(element1, element2, ...)"
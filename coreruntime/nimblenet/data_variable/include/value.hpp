@@ -0,0 +1,204 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "data_variable.hpp"
+#include "single_variable.hpp"
+
+/**
+ * @brief Tagged value which keeps scalars off the heap.
+ *
+ * A Value holds either an unboxed int32/int64/float/double/bool or a boxed DataVariable. Scalars
+ * produced by arithmetic and comparisons stay unboxed while they move between interpreter
+ * registers and stack frame slots. They are boxed into a SingleVariable only when they escape,
+ * i.e. into a container, a function call, the tree walker or the C API. The box is cached, so a
+ * scalar is allocated at most once however many times it escapes.
+ */
+class Value {
+ public:
+  /**
+   * @brief Kind of the value held. Numeric tags are ordered in the same way as the type promotion
+   * done by get_max_dataType, so the promoted type of two numeric scalars is the larger tag.
+   */
+  enum class Tag : uint8_t {
+    EMPTY, /**< No value, equivalent to a null OpReturnType */
+    BOXED, /**< Value is a DataVariable which is not an unboxed scalar */
+    BOOL,
+    INT32,
+    INT64,
+    FLOAT,
+    DOUBLE,
+  };
+
+ private:
+  Tag _tag = Tag::EMPTY;
+
+  union {
+    bool _bool;
+    int32_t _int32;
+    int64_t _int64;
+    float _float;
+    double _double;
+  };
+
+  mutable OpReturnType _box; /**< Boxed form of the value, created lazily for scalars */
+
+  template <typename T>
+  static Value unbox_as(const OpReturnType& data) {
+    auto single = dynamic_cast<SingleVariable<T>*>(data.get());
+    if (single == nullptr) {
+      return Value(data);
+    }
+    Value ret(*static_cast<T*>(single->get_raw_ptr()));
+    ret._box = data;
+    return ret;
+  }
+
+ public:
+  Value() : _int64(0) {}
+
+  Value(OpReturnType data)
+      : _tag(data ? Tag::BOXED : Tag::EMPTY), _int64(0), _box(std::move(data)) {}
+
+  explicit Value(bool val) : _tag(Tag::BOOL), _bool(val) {}
+
+  explicit Value(int32_t val) : _tag(Tag::INT32), _int32(val) {}
+
+  explicit Value(int64_t val) : _tag(Tag::INT64), _int64(val) {}
+
+  explicit Value(float val) : _tag(Tag::FLOAT), _float(val) {}
+
+  explicit Value(double val) : _tag(Tag::DOUBLE), _double(val) {}
+
+  /**
+   * @brief Creates a Value from a DataVariable, unboxing it if it is a bool or numeric
+   * SingleVariable. The DataVariable is kept as the cached box of the scalar.
+   */
+  static Value unbox(const OpReturnType& data) {
+    if (data == nullptr || data->get_containerType() != CONTAINERTYPE::SINGLE) {
+      return Value(data);
+    }
+    switch (data->get_dataType_enum()) {
+      case DATATYPE::BOOLEAN:
+        return unbox_as<bool>(data);
+      case DATATYPE::INT32:
+        return unbox_as<int32_t>(data);
+      case DATATYPE::INT64:
+        return unbox_as<int64_t>(data);
+      case DATATYPE::FLOAT:
+        return unbox_as<float>(data);
+      case DATATYPE::DOUBLE:
+        return unbox_as<double>(data);
+      default:
+        return Value(data);
+    }
+  }
+
+  Tag tag() const noexcept { return _tag; }
+
+  bool empty() const noexcept { return _tag == Tag::EMPTY; }
+
+  bool is_scalar() const noexcept { return _tag >= Tag::BOOL; }
+
+  bool is_numeric() const noexcept { return _tag >= Tag::INT32; }
+
+  /**
+   * @brief Returns the scalar converted to T, same as DataVariable::get<T>() on the boxed value.
+   * Should only be called if is_scalar() is true.
+   */
+  template <typename T>
+  T get() const {
+    switch (_tag) {
+      case Tag::BOOL:
+        return T(_bool);
+      case Tag::INT32:
+        return T(_int32);
+      case Tag::INT64:
+        return T(_int64);
+      case Tag::FLOAT:
+        return T(_float);
+      default:
+        return T(_double);
+    }
+  }
+
+  /**
+   * @brief Returns a copy which does not share the cached box, so that copying it around does not
+   * touch the reference count of the box.
+   */
+  Value without_box() const {
+    switch (_tag) {
+      case Tag::BOOL:
+        return Value(_bool);
+      case Tag::INT32:
+        return Value(_int32);
+      case Tag::INT64:
+        return Value(_int64);
+      case Tag::FLOAT:
+        return Value(_float);
+      case Tag::DOUBLE:
+        return Value(_double);
+      default:
+        return *this;
+    }
+  }
+
+  /**
+   * @brief Truthiness of the value, same as DataVariable::get_bool() on the boxed value. Throws
+   * for an EMPTY value, which has no DataVariable to test.
+   */
+  bool get_bool() const {
+    if (is_scalar()) {
+      return get<bool>();
+    }
+    if (_tag == Tag::EMPTY) {
+      THROW("%s", "cannot evaluate truthiness of an empty value");
+    }
+    return _box->get_bool();
+  }
+
+  /**
+   * @brief Returns the value as a DataVariable, boxing the scalar on first use.
+   */
+  const OpReturnType& box() const {
+    if (_box == nullptr) {
+      switch (_tag) {
+        case Tag::BOOL:
+          _box = OpReturnType(new SingleVariable<bool>(_bool));
+          break;
+        case Tag::INT32:
+          _box = OpReturnType(new SingleVariable<int32_t>(_int32));
+          break;
+        case Tag::INT64:
+          _box = OpReturnType(new SingleVariable<int64_t>(_int64));
+          break;
+        case Tag::FLOAT:
+          _box = OpReturnType(new SingleVariable<float>(_float));
+          break;
+        case Tag::DOUBLE:
+          _box = OpReturnType(new SingleVariable<double>(_double));
+          break;
+        default:
+          break;
+      }
+    }
+    return _box;
+  }
+
+  /**
+   * @brief Moves the boxed value out, leaving this Value empty.
+   */
+  OpReturnType take_box() {
+    box();
+    _tag = Tag::EMPTY;
+    return std::move(_box);
+  }
+};
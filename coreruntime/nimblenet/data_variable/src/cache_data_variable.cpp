@@ -0,0 +1,364 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cache_data_variable.hpp"
+
+#include <cmath>
+
+#include "map_data_variable.hpp"
+#include "single_variable.hpp"
+#include "tensor_data_variable.hpp"
+#include "time_manager.hpp"
+
+namespace {
+
+/**
+ * @brief Approximate bytes taken by a variable besides its contents
+ */
+constexpr int64_t VariableOverheadBytes = 64;
+
+template <typename T>
+void append_pod(std::string& bytes, T value) {
+  bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void append_string(std::string& bytes, const std::string& value) {
+  append_pod<uint64_t>(bytes, value.size());
+  bytes.append(value);
+}
+
+void append_key_bytes(const OpReturnType& key, std::string& bytes) {
+  if (key->is_none()) {
+    bytes.push_back('N');
+    return;
+  }
+  int dataType = key->get_dataType_enum();
+  switch (key->get_containerType()) {
+    case CONTAINERTYPE::SINGLE:
+      switch (dataType) {
+        case DATATYPE::BOOLEAN:
+          bytes.push_back('b');
+          bytes.push_back(key->get_bool());
+          return;
+        case DATATYPE::INT32:
+        case DATATYPE::INT64:
+          bytes.push_back('i');
+          append_pod<int64_t>(bytes, key->get_int64());
+          return;
+        case DATATYPE::FLOAT:
+        case DATATYPE::DOUBLE: {
+          // Integral numbers are the same key as the integer, like 1 and 1.0 in a dict
+          double value = key->get_double();
+          if (value == std::trunc(value) && std::abs(value) < std::ldexp(1.0, 63)) {
+            bytes.push_back('i');
+            append_pod<int64_t>(bytes, static_cast<int64_t>(value));
+            return;
+          }
+          bytes.push_back('f');
+          append_pod<double>(bytes, value);
+          return;
+        }
+        case DATATYPE::STRING:
+          bytes.push_back('s');
+          append_string(bytes, key->get_string());
+          return;
+      }
+      break;
+    case CONTAINERTYPE::VECTOR: {
+      bytes.push_back('t');
+      append_pod<int32_t>(bytes, dataType);
+      const auto& shape = key->get_shape();
+      append_pod<uint64_t>(bytes, shape.size());
+      for (auto dim : shape) {
+        append_pod<int64_t>(bytes, dim);
+      }
+      int numElements = key->get_numElements();
+      if (dataType == DATATYPE::STRING) {
+        auto strings = static_cast<const std::string*>(key->get_raw_ptr());
+        for (int i = 0; i < numElements; i++) {
+          append_string(bytes, strings[i]);
+        }
+        return;
+      }
+      auto tensor = dynamic_cast<BaseTypedTensorVariable*>(key.get());
+      if (tensor == nullptr) {
+        break;
+      }
+      bytes.append(static_cast<const char*>(key->get_raw_ptr()),
+                   static_cast<size_t>(numElements) * tensor->get_elem_size());
+      return;
+    }
+    case CONTAINERTYPE::LIST:
+    case CONTAINERTYPE::TUPLE: {
+      // Lists and tuples with the same items are the same key, like in the key of a dict
+      int size = key->get_size();
+      bytes.push_back('l');
+      append_pod<int32_t>(bytes, size);
+      for (int i = 0; i < size; i++) {
+        append_key_bytes(key->get_int_subscript(i), bytes);
+      }
+      return;
+    }
+  }
+  THROW("%s(%s) cannot be used as a key of a cache", key->get_containerType_string(),
+        util::get_string_from_enum(dataType));
+}
+
+}  // namespace
+
+std::string CacheDataVariable::get_key_bytes(const OpReturnType& key) {
+  std::string bytes;
+  append_key_bytes(key, bytes);
+  return bytes;
+}
+
+int64_t CacheDataVariable::get_value_bytes(const OpReturnType& value) {
+  if (value->is_none()) {
+    return VariableOverheadBytes;
+  }
+  int dataType = value->get_dataType_enum();
+  switch (value->get_containerType()) {
+    case CONTAINERTYPE::SINGLE:
+      if (dataType == DATATYPE::STRING) {
+        return VariableOverheadBytes + value->get_string().size();
+      }
+      return VariableOverheadBytes;
+    case CONTAINERTYPE::VECTOR: {
+      int numElements = value->get_numElements();
+      if (dataType == DATATYPE::STRING) {
+        int64_t bytes = VariableOverheadBytes;
+        auto strings = static_cast<const std::string*>(value->get_raw_ptr());
+        for (int i = 0; i < numElements; i++) {
+          bytes += sizeof(std::string) + strings[i].size();
+        }
+        return bytes;
+      }
+      auto tensor = dynamic_cast<BaseTypedTensorVariable*>(value.get());
+      int elemSize = tensor ? tensor->get_elem_size() : 0;
+      return VariableOverheadBytes + static_cast<int64_t>(numElements) * elemSize;
+    }
+    case CONTAINERTYPE::LIST:
+    case CONTAINERTYPE::TUPLE: {
+      int64_t bytes = VariableOverheadBytes;
+      int size = value->get_size();
+      for (int i = 0; i < size; i++) {
+        bytes += get_value_bytes(value->get_int_subscript(i));
+      }
+      return bytes;
+    }
+    case CONTAINERTYPE::MAP: {
+      int64_t bytes = VariableOverheadBytes;
+      for (const auto& [key, item] : value->get_map()) {
+        bytes += key.size() + get_value_bytes(item);
+      }
+      return bytes;
+    }
+  }
+  return VariableOverheadBytes;
+}
+
+CacheDataVariable::CacheDataVariable(int64_t maxEntries, double ttlSecs, int64_t maxBytes)
+    : _maxEntries(maxEntries),
+      _maxBytes(maxBytes),
+      _ttlSecs(static_cast<int64_t>(std::ceil(ttlSecs))) {
+  if (maxEntries < 1) {
+    THROW("cache expects maxEntries to be at least 1, given %lld", (long long)maxEntries);
+  }
+  if (ttlSecs < 0) {
+    THROW("cache expects ttlSecs to be non negative, given %f", ttlSecs);
+  }
+  if (maxBytes < 0) {
+    THROW("cache expects maxBytes to be non negative, given %lld", (long long)maxBytes);
+  }
+}
+
+bool CacheDataVariable::is_expired(const Entry& entry) const {
+  return _ttlSecs > 0 && Time::get_time() >= entry.expiry;
+}
+
+void CacheDataVariable::erase(std::list<Entry>::iterator it) {
+  _bytes -= it->bytes;
+  _index.erase(it->key);
+  _entries.erase(it);
+}
+
+void CacheDataVariable::drop_expired() {
+  if (_ttlSecs == 0) {
+    return;
+  }
+  for (auto it = _entries.begin(); it != _entries.end();) {
+    auto next = std::next(it);
+    if (is_expired(*it)) {
+      _expirations++;
+      erase(it);
+    }
+    it = next;
+  }
+}
+
+OpReturnType CacheDataVariable::find(const std::string& key) {
+  auto indexIt = _index.find(key);
+  if (indexIt == _index.end()) {
+    return nullptr;
+  }
+  auto it = indexIt->second;
+  if (is_expired(*it)) {
+    _expirations++;
+    erase(it);
+    return nullptr;
+  }
+  _entries.splice(_entries.begin(), _entries, it);
+  return it->value;
+}
+
+void CacheDataVariable::insert(std::string&& key, const OpReturnType& value) {
+  // Workers of a ConcurrentExecutor can read the value while other threads use it
+  value->mark_shared();
+  int64_t bytes = key.size() + get_value_bytes(value);
+  int64_t expiry = Time::get_time() + _ttlSecs;
+
+  auto indexIt = _index.find(key);
+  if (indexIt != _index.end()) {
+    auto it = indexIt->second;
+    _bytes += bytes - it->bytes;
+    it->value = value;
+    it->bytes = bytes;
+    it->expiry = expiry;
+    _entries.splice(_entries.begin(), _entries, it);
+  } else {
+    _entries.push_front(Entry{std::move(key), value, bytes, expiry});
+    _index.emplace(_entries.front().key, _entries.begin());
+    _bytes += bytes;
+  }
+
+  // The entry just stored is kept even if it is bigger than maxBytes on its own
+  while (_entries.size() > 1 &&
+         (int64_t(_entries.size()) > _maxEntries || (_maxBytes > 0 && _bytes > _maxBytes))) {
+    _evictions++;
+    erase(std::prev(_entries.end()));
+  }
+}
+
+OpReturnType CacheDataVariable::get(const std::vector<OpReturnType>& arguments) {
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(arguments.size(), 1, 2, MemberFuncType::GET_BY_KEY);
+  auto key = get_key_bytes(arguments[0]);
+  std::lock_guard<std::mutex> locker(_mutex);
+  if (auto value = find(key)) {
+    _hits++;
+    return value;
+  }
+  _misses++;
+  return arguments.size() == 2 ? arguments[1] : std::make_shared<NoneVariable>();
+}
+
+OpReturnType CacheDataVariable::put(const std::vector<OpReturnType>& arguments) {
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 2, MemberFuncType::CACHE_PUT);
+  auto key = get_key_bytes(arguments[0]);
+  std::lock_guard<std::mutex> locker(_mutex);
+  insert(std::move(key), arguments[1]);
+  return std::make_shared<NoneVariable>();
+}
+
+OpReturnType CacheDataVariable::get_or_compute(const std::vector<OpReturnType>& arguments,
+                                               CallStack& stack) {
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 2, MemberFuncType::CACHE_GET_OR_COMPUTE);
+  auto key = get_key_bytes(arguments[0]);
+  {
+    std::lock_guard<std::mutex> locker(_mutex);
+    if (auto value = find(key)) {
+      _hits++;
+      return value;
+    }
+    _misses++;
+  }
+  // Not holding the lock, the function can use the cache and take as long as it needs
+  auto value = arguments[1]->execute_function({arguments[0]}, stack);
+  std::lock_guard<std::mutex> locker(_mutex);
+  insert(std::move(key), value);
+  return value;
+}
+
+OpReturnType CacheDataVariable::pop(const std::vector<OpReturnType>& arguments) {
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(arguments.size(), 1, 2, MemberFuncType::POP);
+  auto key = get_key_bytes(arguments[0]);
+  std::lock_guard<std::mutex> locker(_mutex);
+  if (auto value = find(key)) {
+    erase(_index.at(key));
+    return value;
+  }
+  return arguments.size() == 2 ? arguments[1] : std::make_shared<NoneVariable>();
+}
+
+OpReturnType CacheDataVariable::clear(const std::vector<OpReturnType>& arguments) {
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 0, MemberFuncType::CACHE_CLEAR);
+  std::lock_guard<std::mutex> locker(_mutex);
+  _entries.clear();
+  _index.clear();
+  _bytes = 0;
+  return std::make_shared<NoneVariable>();
+}
+
+OpReturnType CacheDataVariable::stats(const std::vector<OpReturnType>& arguments) {
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 0, MemberFuncType::CACHE_STATS);
+  std::lock_guard<std::mutex> locker(_mutex);
+  // Entries counts only the ones get() can still return
+  drop_expired();
+  auto lookups = _hits + _misses;
+  auto map = std::make_shared<MapDataVariable>();
+  map->set_value_in_map("hits", std::make_shared<SingleVariable<int64_t>>(_hits));
+  map->set_value_in_map("misses", std::make_shared<SingleVariable<int64_t>>(_misses));
+  map->set_value_in_map("evictions", std::make_shared<SingleVariable<int64_t>>(_evictions));
+  map->set_value_in_map("expirations", std::make_shared<SingleVariable<int64_t>>(_expirations));
+  map->set_value_in_map("entries",
+                        std::make_shared<SingleVariable<int64_t>>(int64_t(_entries.size())));
+  map->set_value_in_map("bytes", std::make_shared<SingleVariable<int64_t>>(_bytes));
+  map->set_value_in_map("hitRate", std::make_shared<SingleVariable<double>>(
+                                       lookups ? double(_hits) / lookups : 0.0));
+  return map;
+}
+
+int CacheDataVariable::get_size() {
+  std::lock_guard<std::mutex> locker(_mutex);
+  drop_expired();
+  return _entries.size();
+}
+
+bool CacheDataVariable::in(const OpReturnType& elem) {
+  auto key = get_key_bytes(elem);
+  std::lock_guard<std::mutex> locker(_mutex);
+  // Membership tests do not count as lookups in the statistics, expired entries are dropped like
+  // in get()
+  auto indexIt = _index.find(key);
+  if (indexIt == _index.end()) {
+    return false;
+  }
+  if (is_expired(*indexIt->second)) {
+    _expirations++;
+    erase(indexIt->second);
+    return false;
+  }
+  return true;
+}
+
+OpReturnType CacheDataVariable::call_function(int memberFuncIndex,
+                                              const std::vector<OpReturnType>& arguments,
+                                              CallStack& stack) {
+  switch (memberFuncIndex) {
+    case MemberFuncType::GET_BY_KEY:
+      return get(arguments);
+    case MemberFuncType::CACHE_PUT:
+      return put(arguments);
+    case MemberFuncType::CACHE_GET_OR_COMPUTE:
+      return get_or_compute(arguments, stack);
+    case MemberFuncType::POP:
+      return pop(arguments);
+    case MemberFuncType::CACHE_CLEAR:
+      return clear(arguments);
+    case MemberFuncType::CACHE_STATS:
+      return stats(arguments);
+  }
+  THROW("%s not implemented for cache", DataVariable::get_member_func_string(memberFuncIndex));
+}
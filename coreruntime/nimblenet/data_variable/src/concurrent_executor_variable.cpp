@@ -21,31 +21,39 @@ static inline int default_num_threads() {
 }
 
 int ConcurrentExecutorVariable::_numThreads = default_num_threads();
+std::vector<int> ConcurrentExecutorVariable::_cpuAffinity;
 
 /**
  * @brief Initialize the thread pool
  * @return Always returns true
- * @details Creates a new ThreadPool instance with the configured number of threads
+ * @details Creates a new ThreadPool instance with the configured number of threads and cpu affinity
  */
 bool ConcurrentExecutorVariable::init_threadpool() {
   // run once to init Threadpool
-  _threadpool = std::make_unique<ThreadPool>(_numThreads);
+  _threadpool = std::make_unique<ThreadPool>(_numThreads, _cpuAffinity);
   return true;
 }
 
-void ConcurrentExecutorVariable::set_threadpool_threads(int threadCount) {
+void ConcurrentExecutorVariable::set_threadpool_threads(int threadCount,
+                                                        const std::vector<int>& cpuAffinity) {
   if (_threadpool != nullptr) {
     THROW("Threadpool is already created can't set threads now");
   }
   if (threadCount < 1) {
     THROW("ThreadCount cannot be less than 1 given %d", threadCount);
   }
+  for (int cpu : cpuAffinity) {
+    if (cpu < 0) {
+      THROW("cpu index cannot be negative given %d", cpu);
+    }
+  }
   _numThreads = threadCount;
+  _cpuAffinity = cpuAffinity;
 }
 
 ConcurrentExecutorVariable::ConcurrentExecutorVariable() {
   if (_threadpool == nullptr) {
-    _threadpool = std::make_unique<ThreadPool>(_numThreads);
+    _threadpool = std::make_unique<ThreadPool>(_numThreads, _cpuAffinity);
   }
 }
 
@@ -61,6 +69,15 @@ OpReturnType ConcurrentExecutorVariable::run_sync(const std::vector<OpReturnType
   return functionDataVariable->execute_function(remainingArgs, stack);
 }
 
+/**
+ * @brief Marks the arguments shared, the workers access them and the items they contain
+ */
+static void share_arguments(const std::vector<OpReturnType>& arguments) {
+  for (const auto& argument : arguments) {
+    argument->mark_shared();
+  }
+}
+
 OpReturnType ConcurrentExecutorVariable::run_parallel(const std::vector<OpReturnType>& arguments,
                                                       CallStack& stack) {
   if (arguments.size() < 2) {
@@ -78,6 +95,9 @@ OpReturnType ConcurrentExecutorVariable::run_parallel(const std::vector<OpReturn
 
   // using atomic variable to early cancel other tasks if thread is complete.
   std::shared_ptr<std::atomic<bool>> toCancel = std::make_shared<std::atomic<bool>>(false);
+  // The workers copy this stack, its frames have to be shared before any worker starts
+  stack.share_frames();
+  share_arguments(arguments);
   for (int i = 0; i < totalParallelCalls; i++) {
     // set 1st argument of the remaining args with item in the iteratable
     remainingArgs[0] = iteratableArg->get_int_subscript(i);
@@ -89,7 +109,10 @@ OpReturnType ConcurrentExecutorVariable::run_parallel(const std::vector<OpReturn
       }
       // TODO: when we change script lock, ensure that newStack is captured by value in lambda
       auto newStack = stack.create_copy_with_deferred_lock();
-      return func->execute_function(args, newStack);
+      auto ret = func->execute_function(args, newStack);
+      // The calling thread reads the result
+      if (ret) ret->mark_shared();
+      return ret;
     };
     returnVals.emplace_back(_threadpool->enqueue(lambdaFunc));
   }
@@ -97,11 +120,8 @@ OpReturnType ConcurrentExecutorVariable::run_parallel(const std::vector<OpReturn
   std::optional<std::runtime_error> firstError;
   for (int i = 0; i < totalParallelCalls; i++) {
     OpReturnType ret;
-    std::future_status status;
-    while ((status = returnVals[i].wait_for(std::chrono::milliseconds(0))) !=
-           std::future_status::ready) {
-      _threadpool->run_threadpool_task();
-    }
+    // Executes the pending tasks while waiting, including the children of nested run_parallel calls
+    _threadpool->join(returnVals[i]);
     try {
       ret = returnVals[i].get();
     } catch (std::runtime_error& e) {
@@ -118,6 +138,145 @@ OpReturnType ConcurrentExecutorVariable::run_parallel(const std::vector<OpReturn
   return std::make_shared<ListDataVariable>(std::move(returnList));
 }
 
+int ConcurrentExecutorVariable::get_chunk_size(const OpReturnType& chunkSizeArg, int numItems) {
+  int chunkSize = chunkSizeArg->is_none() ? 0 : chunkSizeArg->get_int32();
+  if (chunkSize < 0) {
+    THROW("chunk size cannot be negative given %d", chunkSize);
+  }
+  if (chunkSize == 0) {
+    // A few chunks per thread, so that threads which finish early pick up the remaining work
+    int targetChunks = 4 * (_numThreads + 1);
+    chunkSize = std::max(1, (numItems + targetChunks - 1) / targetChunks);
+  }
+  return chunkSize;
+}
+
+void ConcurrentExecutorVariable::run_chunks(int numItems, int chunkSize, CallStack& stack,
+                                            const ChunkFunction& runChunk) {
+  int numChunks = (numItems + chunkSize - 1) / chunkSize;
+  std::atomic<int> nextChunk = 0;
+  std::atomic<bool> cancel = false;
+  std::vector<std::optional<std::runtime_error>> errors(numChunks);
+
+  // The workers copy this stack, its frames have to be shared before any worker starts
+  stack.share_frames();
+  auto claimChunks = [&]() {
+    auto chunkStack = stack.create_copy_with_deferred_lock();
+    int chunk;
+    while (!cancel && (chunk = nextChunk.fetch_add(1)) < numChunks) {
+      int begin = chunk * chunkSize;
+      try {
+        runChunk(begin, std::min(begin + chunkSize, numItems), chunkStack);
+      } catch (std::exception& e) {
+        errors[chunk] = std::runtime_error(e.what());
+        cancel = true;
+      }
+    }
+  };
+
+  std::vector<std::future<void>> workers;
+  int numWorkers = std::min(_numThreads, numChunks - 1);
+  for (int i = 0; i < numWorkers; i++) {
+    workers.emplace_back(_threadpool->enqueue(claimChunks));
+  }
+  // The calling thread works on the chunks as well instead of waiting
+  claimChunks();
+  for (auto& worker : workers) {
+    // A worker might not have started yet if the threads are busy, run queued tasks meanwhile
+    _threadpool->join(worker);
+    worker.get();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      throw *error;
+    }
+  }
+}
+
+static std::vector<OpReturnType> get_items(const OpReturnType& iterable) {
+  int size = iterable->get_size();
+  std::vector<OpReturnType> items(size);
+  for (int i = 0; i < size; i++) {
+    items[i] = iterable->get_int_subscript(i);
+  }
+  return items;
+}
+
+OpReturnType ConcurrentExecutorVariable::map_chunked(const std::vector<OpReturnType>& arguments,
+                                                     CallStack& stack) {
+  if (arguments.size() < 3) {
+    THROW(
+        "map_chunked requires atleast 3 arguments function, iteratable and chunk size got %d "
+        "arguments",
+        arguments.size());
+  }
+  const auto& function = arguments[0];
+  share_arguments(arguments);
+  // Items are read once on this thread, the iterable might not be safe to read concurrently
+  auto items = get_items(arguments[1]);
+  int chunkSize = get_chunk_size(arguments[2], items.size());
+  std::vector<OpReturnType> results(items.size());
+
+  run_chunks(items.size(), chunkSize, stack, [&](int begin, int end, CallStack& chunkStack) {
+    // 1st argument is the item, followed by the additional arguments
+    std::vector<OpReturnType> args(arguments.begin() + 2, arguments.end());
+    for (int i = begin; i < end; i++) {
+      args[0] = items[i];
+      results[i] = function->execute_function(args, chunkStack);
+      results[i]->mark_shared();
+    }
+  });
+  return std::make_shared<ListDataVariable>(std::move(results));
+}
+
+OpReturnType ConcurrentExecutorVariable::parallel_reduce(const std::vector<OpReturnType>& arguments,
+                                                         CallStack& stack) {
+  if (arguments.size() < 3) {
+    THROW(
+        "parallel_reduce requires atleast 3 arguments map function, reduce function, iteratable "
+        "and optional chunk size got %d arguments",
+        arguments.size());
+  }
+  const auto& mapFunction = arguments[0];
+  const auto& reduceFunction = arguments[1];
+  share_arguments(arguments);
+  auto items = get_items(arguments[2]);
+  if (items.empty()) {
+    THROW("%s", "parallel_reduce of an empty iteratable");
+  }
+  int chunkSize = get_chunk_size(
+      arguments.size() > 3 ? arguments[3] : OpReturnType(new NoneVariable()), items.size());
+  std::vector<OpReturnType> partials((items.size() + chunkSize - 1) / chunkSize);
+
+  run_chunks(items.size(), chunkSize, stack, [&](int begin, int end, CallStack& chunkStack) {
+    // 1st argument is the item, followed by the additional arguments
+    std::vector<OpReturnType> mapArgs = {items[begin]};
+    if (arguments.size() > 4) {
+      mapArgs.insert(mapArgs.end(), arguments.begin() + 4, arguments.end());
+    }
+    auto value = mapFunction->execute_function(mapArgs, chunkStack);
+    std::vector<OpReturnType> reduceArgs(2);
+    for (int i = begin + 1; i < end; i++) {
+      mapArgs[0] = items[i];
+      reduceArgs[0] = value;
+      reduceArgs[1] = mapFunction->execute_function(mapArgs, chunkStack);
+      value = reduceFunction->execute_function(reduceArgs, chunkStack);
+    }
+    // Partial results are reduced by the calling thread
+    value->mark_shared();
+    partials[begin / chunkSize] = value;
+  });
+
+  auto value = partials[0];
+  std::vector<OpReturnType> reduceArgs(2);
+  for (int i = 1; i < partials.size(); i++) {
+    reduceArgs[0] = value;
+    reduceArgs[1] = partials[i];
+    value = reduceFunction->execute_function(reduceArgs, stack);
+  }
+  return value;
+}
+
 OpReturnType ConcurrentExecutorVariable::call_function(int memberFuncIndex,
                                                        const std::vector<OpReturnType>& arguments,
                                                        CallStack& stack) {
@@ -126,6 +285,10 @@ OpReturnType ConcurrentExecutorVariable::call_function(int memberFuncIndex,
       return run_sync(arguments, stack);
     case MemberFuncType::RUNPARALLEL:
       return run_parallel(arguments, stack);
+    case MemberFuncType::MAP_CHUNKED:
+      return map_chunked(arguments, stack);
+    case MemberFuncType::PARALLEL_REDUCE:
+      return parallel_reduce(arguments, stack);
   }
   THROW("%s not implemented for nimblenet", DataVariable::get_member_func_string(memberFuncIndex));
 }
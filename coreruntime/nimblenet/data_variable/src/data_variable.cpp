@@ -6,217 +6,105 @@
 
 #include "data_variable.hpp"
 
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "frontend_data_variable.hpp"
 #include "list_data_variable.hpp"
 #include "map_data_variable.hpp"
+#include "member_func_table.hpp"
 #include "nimble_net_util.hpp"
 #include "nlohmann/json.hpp"
 #include "single_variable.hpp"
 #include "tensor_data_variable.hpp"
 #include "util.hpp"
 
-std::map<std::string, int> DataVariable::_memberFuncMap = {
-    {"Model", MemberFuncType::LOADMODEL},
-    {"run", MemberFuncType::RUNMODEL},
-    {"filter", MemberFuncType::FEATURE_FILTER},
-    {"fetch", MemberFuncType::FEATURE_FETCH},
-    {"reshape", MemberFuncType::RESHAPE},
-    {"zeros", MemberFuncType::CREATETENSOR},
-    {"shape", MemberFuncType::GETSHAPE},
-    {"status", MemberFuncType::GETMODELSTATUS},
-    {"processor", MemberFuncType::CREATE_PROCESSOR_INIT},
-    {"rollingWindow", MemberFuncType::CREATE_ROLLINGWINDOW_PROCESSOR},
-    {"groupBy", MemberFuncType::CREATE_GROUPBY_COLUMNS_PROCESSOR},
-    {"add_computation", MemberFuncType::ADD_COMPUTATION_PROCESSOR},
-    {"get_for_items", MemberFuncType::GET_PROCESSOR_OUTPUT},
-    {"get", MemberFuncType::GET_PROCESSOR_OUTPUT_FOR_GROUP},
-    {"create", MemberFuncType::CREATE_PROCESSOR},
-    {"append", MemberFuncType::APPEND},
-    {"tensor", MemberFuncType::TO_TENSOR},
-    {"filter_all", MemberFuncType::FEATURE_FILTER_ALL},
-    {"time", MemberFuncType::GET_TIME},
-    {"filter_by_function", MemberFuncType::FEATURE_FILTER_FUNCTION},
-    {"num_keys", MemberFuncType::NUM_KEYS},
-    {"get_config", MemberFuncType::GET_CONFIG},
-    {"get_chrono_time", MemberFuncType::GET_CHRONO_TIME},
-    {"RawEventStore", MemberFuncType::GET_RAW_EVENTS_STORE},
-    {"Dataframe", MemberFuncType::GET_DATAFRAME},
-    {"exp", MemberFuncType::EXP},
-    {"pow", MemberFuncType::POW},
-    {"sort", MemberFuncType::SORT},
-    {"argsort", MemberFuncType::ARGSORT},
-    {"topk", MemberFuncType::TOPK},
-    {"arrange", MemberFuncType::ARRANGE},
-    {"is_integer", MemberFuncType::ISINTEGER},
-    {"is_float", MemberFuncType::ISFLOAT},
-    {"is_string", MemberFuncType::ISSTRING},
-    {"min", MemberFuncType::MIN},
-    {"max", MemberFuncType::MAX},
-    {"sum", MemberFuncType::SUM},
-    {"mean", MemberFuncType::MEAN},
-    {"parse_json", MemberFuncType::PARSE_JSON},
-    {"log", MemberFuncType::LOG},
-    {"match", MemberFuncType::REGEX_MATCH},
-    {"search", MemberFuncType::REGEX_SEARCH},
-    {"fullmatch", MemberFuncType::REGEX_FULLMATCH},
-    {"split", MemberFuncType::REGEX_SPLIT},
-    {"findall", MemberFuncType::REGEX_FINDALL},
-    {"finditer", MemberFuncType::REGEX_FINDITER},
-    {"sub", MemberFuncType::REGEX_SUB},
-    {"subn", MemberFuncType::REGEX_SUBN},
-    {"group", MemberFuncType::REGEX_MATCHOBJECT_GROUP},
-    {"groups", MemberFuncType::REGEX_MATCHOBJECT_GROUPS},
-    {"start", MemberFuncType::REGEX_MATCHOBJECT_START},
-    {"end", MemberFuncType::REGEX_MATCHOBJECT_END},
-    {"span", MemberFuncType::REGEX_MATCHOBJECT_SPAN},
-    {"upper", MemberFuncType::STRING_UPPER},
-    {"lower", MemberFuncType::STRING_LOWER},
-    {"strip", MemberFuncType::STRING_STRIP},
-    {"join", MemberFuncType::STRING_JOIN},
-    {"create_simulated_char_stream", MemberFuncType::CREATE_SIM_CHAR_STREAM},
-    {"to_json_stream", MemberFuncType::TO_JSON_STREAM},
-    {"finished", MemberFuncType::FINISHED},
-    {"iterator", MemberFuncType::ITERATOR},
-    {"next", MemberFuncType::NEXT},
-    {"next_available", MemberFuncType::NEXT_AVAILABLE},
-    {"get_blocking", MemberFuncType::GET_BLOCKING},
-    {"next_blocking", MemberFuncType::NEXT_BLOCKING},
-    {"wait_for_completion", MemberFuncType::WAIT_FOR_COMPLETION},
-    {"get_blocking_str", MemberFuncType::GET_BLOCKING_STR},
-    {"llm", MemberFuncType::LLM},
-    {"prompt", MemberFuncType::PROMPT},
-    {"skip_text_and_get_json_stream", MemberFuncType::SKIP_TEXT_AND_GET_JSON_STREAM},
-    {"Retriever", MemberFuncType::RETRIEVER},
-    {"pop", MemberFuncType::POP},
-    {"keys", MemberFuncType::KEYS},
-    {"JsonDocument", MemberFuncType::JSON_DOCUMENT},
-    {"max_input_num_tokens", MemberFuncType::MAX_INPUT_NUM_TOKENS},
-    {"__init__", MemberFuncType::CONSTRUCTOR},
-    {"unicode", MemberFuncType::UNICODE},
-    {"sync", MemberFuncType::SYNC},
-    {"run_parallel", MemberFuncType::RUNPARALLEL},
-    {"ConcurrentExecutor", MemberFuncType::CREATE_CONCURRENT_EXECUTOR},
-    {"set_threadpool_threads", MemberFuncType::SET_THREADS},
-    {"cancel", MemberFuncType::CANCEL},
-    {"clear_context", MemberFuncType::CLEAR_CONTEXT},
-    {"add_context", MemberFuncType::ADD_CONTEXT},
-    {"list_compatible_llms", MemberFuncType::LIST_COMPATIBLE_LLMS},
-};
+namespace {
 
-std::map<int, std::string> DataVariable::_inverseMemberFuncMap = {
-    {MemberFuncType::LOADMODEL, "Model"},
-    {MemberFuncType::RUNMODEL, "run"},
-    {MemberFuncType::RESHAPE, "reshape"},
-    {MemberFuncType::CREATETENSOR, "zeros"},
-    {MemberFuncType::GETSHAPE, "shape"},
-    {MemberFuncType::FEATURE_FILTER, "filter"},
-    {MemberFuncType::FEATURE_FETCH, "fetch"},
-    {MemberFuncType::GETMODELSTATUS, "status"},
-    {MemberFuncType::CREATE_PROCESSOR_INIT, "processor"},
-    {MemberFuncType::CREATE_ROLLINGWINDOW_PROCESSOR, "rollingWindow"},
-    {MemberFuncType::CREATE_GROUPBY_COLUMNS_PROCESSOR, "groupBy"},
-    {MemberFuncType::ADD_COMPUTATION_PROCESSOR, "add_computation"},
-    {MemberFuncType::GET_PROCESSOR_OUTPUT, "get_for_items"},
-    {MemberFuncType::GET_PROCESSOR_OUTPUT_FOR_GROUP, "get"},
-    {MemberFuncType::CREATE_PROCESSOR, "create"},
-    {MemberFuncType::APPEND, "append"},
-    {MemberFuncType::TO_TENSOR, "tensor"},
-    {MemberFuncType::FEATURE_FILTER_ALL, "filter_all"},
-    {MemberFuncType::GET_TIME, "time"},
-    {MemberFuncType::FEATURE_FILTER_FUNCTION, "filter_by_function"},
-    {MemberFuncType::NUM_KEYS, "num_keys"},
-    {MemberFuncType::GET_CONFIG, "get_config"},
-    {MemberFuncType::GET_CHRONO_TIME, "get_chrono_time"},
-    {MemberFuncType::GET_RAW_EVENTS_STORE, "RawEventStore"},
-    {MemberFuncType::GET_DATAFRAME, "Dataframe"},
-    {MemberFuncType::EXP, "exp"},
-    {MemberFuncType::POW, "pow"},
-    {MemberFuncType::SORT, "sort"},
-    {MemberFuncType::ARGSORT, "argsort"},
-    {MemberFuncType::TOPK, "topk"},
-    {MemberFuncType::ARRANGE, "arrange"},
-    {MemberFuncType::ISINTEGER, "is_integer"},
-    {MemberFuncType::ISFLOAT, "is_float"},
-    {MemberFuncType::ISSTRING, "is_string"},
-    {MemberFuncType::MIN, "min"},
-    {MemberFuncType::MAX, "max"},
-    {MemberFuncType::SUM, "sum"},
-    {MemberFuncType::MEAN, "mean"},
-    {MemberFuncType::PARSE_JSON, "parse_json"},
-    {MemberFuncType::LOG, "log"},
-    {MemberFuncType::REGEX_MATCH, "match"},
-    {MemberFuncType::REGEX_SEARCH, "search"},
-    {MemberFuncType::REGEX_FULLMATCH, "fullmatch"},
-    {MemberFuncType::REGEX_SPLIT, "split"},
-    {MemberFuncType::REGEX_FINDALL, "findall"},
-    {MemberFuncType::REGEX_FINDITER, "finditer"},
-    {MemberFuncType::REGEX_SUB, "sub"},
-    {MemberFuncType::REGEX_SUBN, "subn"},
-    {MemberFuncType::REGEX_MATCHOBJECT_GROUP, "group"},
-    {MemberFuncType::REGEX_MATCHOBJECT_GROUPS, "groups"},
-    {MemberFuncType::REGEX_MATCHOBJECT_START, "start"},
-    {MemberFuncType::REGEX_MATCHOBJECT_END, "end"},
-    {MemberFuncType::REGEX_MATCHOBJECT_SPAN, "span"},
-    {MemberFuncType::STRING_UPPER, "upper"},
-    {MemberFuncType::STRING_LOWER, "lower"},
-    {MemberFuncType::STRING_STRIP, "strip"},
-    {MemberFuncType::STRING_JOIN, "join"},
-    {MemberFuncType::CREATE_SIM_CHAR_STREAM, "create_simulated_char_stream"},
-    {MemberFuncType::TO_JSON_STREAM, "to_json_stream"},
-    {MemberFuncType::FINISHED, "finished"},
-    {MemberFuncType::ITERATOR, "iterator"},
-    {MemberFuncType::NEXT, "next"},
-    {MemberFuncType::NEXT_AVAILABLE, "next_available"},
-    {MemberFuncType::GET_BLOCKING, "get_blocking"},
-    {MemberFuncType::NEXT_BLOCKING, "next_blocking"},
-    {MemberFuncType::WAIT_FOR_COMPLETION, "wait_for_completion"},
-    {MemberFuncType::GET_BLOCKING_STR, "get_blocking_str"},
-    {MemberFuncType::LLM, "llm"},
-    {MemberFuncType::PROMPT, "prompt"},
-    {MemberFuncType::SKIP_TEXT_AND_GET_JSON_STREAM, "skip_text_and_get_json_stream"},
-    {MemberFuncType::RETRIEVER, "Retriever"},
-    {MemberFuncType::POP, "pop"},
-    {MemberFuncType::KEYS, "keys"},
-    {MemberFuncType::JSON_DOCUMENT, "jsonDocument"},
-    {MemberFuncType::MAX_INPUT_NUM_TOKENS, "max_input_num_tokens"},
-    {MemberFuncType::CONSTRUCTOR, "__init__"},
-    {MemberFuncType::UNICODE, "unicode"},
-    {MemberFuncType::SYNC, "sync"},
-    {MemberFuncType::RUNPARALLEL, "run_parallel"},
-    {MemberFuncType::CREATE_CONCURRENT_EXECUTOR, "ConcurrentExecutor"},
-    {MemberFuncType::SET_THREADS, "set_threadpool_threads"},
-    {MemberFuncType::CANCEL, "cancel"},
-    {MemberFuncType::CLEAR_CONTEXT, "clear_context"},
-    {MemberFuncType::ADD_CONTEXT, "add_context"},
-    {MemberFuncType::LIST_COMPATIBLE_LLMS, "list_compatible_llms"},
+/**
+ * @brief Names of members defined by the script, e.g. functions of script classes, which are
+ * indexed after the member functions of MemberFuncType.
+ */
+struct ScriptMemberNames {
+  std::mutex mutex;
+  std::unordered_map<std::string, int> indices;
+  std::deque<std::string> names; /**< A deque keeps the strings in place as it grows */
 };
 
+ScriptMemberNames& script_member_names() {
+  static ScriptMemberNames scriptMemberNames;
+  return scriptMemberNames;
+}
+
+}  // namespace
+
 int DataVariable::add_and_get_member_func_index(const std::string& memberFuncString) {
-  if (_memberFuncMap.find(memberFuncString) != _memberFuncMap.end()) {
-    return _memberFuncMap[memberFuncString];
+  int index = find_member_func(memberFuncString);
+  if (index >= 0) {
+    return index;
   }
-  int newIndex = _memberFuncMap.size();
-  _memberFuncMap[memberFuncString] = newIndex;
-  _inverseMemberFuncMap[newIndex] = memberFuncString;
+  auto& scriptMembers = script_member_names();
+  std::lock_guard<std::mutex> locker(scriptMembers.mutex);
+  auto it = scriptMembers.indices.find(memberFuncString);
+  if (it != scriptMembers.indices.end()) {
+    return it->second;
+  }
+  int newIndex = MemberFuncType::LASTTYPE + scriptMembers.names.size();
+  scriptMembers.names.push_back(memberFuncString);
+  scriptMembers.indices.emplace(memberFuncString, newIndex);
   return newIndex;
 }
 
 int DataVariable::get_member_func_index(const std::string& memberFuncString) {
-  if (_memberFuncMap.find(memberFuncString) != _memberFuncMap.end()) {
-    return _memberFuncMap[memberFuncString];
+  int index = find_member_func(memberFuncString);
+  if (index >= 0) {
+    return index;
+  }
+  auto& scriptMembers = script_member_names();
+  std::lock_guard<std::mutex> locker(scriptMembers.mutex);
+  auto it = scriptMembers.indices.find(memberFuncString);
+  if (it != scriptMembers.indices.end()) {
+    return it->second;
   }
   return -1;
 }
 
 const char* DataVariable::get_member_func_string(int funcIndex) {
-  if (_inverseMemberFuncMap.find(funcIndex) != _inverseMemberFuncMap.end()) {
-    return _inverseMemberFuncMap[funcIndex].c_str();
+  if (funcIndex >= 0 && funcIndex < MemberFuncType::LASTTYPE) {
+    // The names are string literals, so they are null terminated
+    return MemberFuncNamesByIndex[funcIndex].data();
+  }
+  auto& scriptMembers = script_member_names();
+  std::lock_guard<std::mutex> locker(scriptMembers.mutex);
+  int scriptIndex = funcIndex - MemberFuncType::LASTTYPE;
+  if (scriptIndex >= 0 && scriptIndex < scriptMembers.names.size()) {
+    return scriptMembers.names[scriptIndex].c_str();
   }
   return "";
 }
 
+const InternedKey* InternedKey::intern(const std::string& str) {
+  static std::mutex mutex;
+  // Keys are never removed, so the pointers handed out stay valid
+  static std::unordered_map<std::string, std::unique_ptr<InternedKey>> keys;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& key = keys[str];
+  if (!key) {
+    key.reset(new InternedKey{str, hash_of(str)});
+  }
+  return key.get();
+}
+
+OpReturnType DataVariable::get_interned_subscript(const InternedKey& key) {
+  return get_string_subscript(key.str);
+}
+
+void DataVariable::set_interned_subscript(const InternedKey& key, const OpReturnType& d) {
+  set_subscript(std::make_shared<SingleVariable<std::string>>(key.str), d);
+}
+
 OpReturnType DataVariable::get_SingleVariableFrom_JSON(const nlohmann::json& value) {
   switch (value.type()) {
     case nlohmann::detail::value_t::number_integer:
@@ -419,13 +307,17 @@ OpReturnType DataVariable::call_function(int memberFuncIndex,
       return sort(arguments[0]);
     }
     case MemberFuncType::ARGSORT: {
-      THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, memberFuncIndex);
-      return argsort(arguments[0]);
+      THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(arguments.size(), 1, 2, memberFuncIndex);
+      return argsort(arguments);
     }
     case MemberFuncType::TOPK: {
-      THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 2, memberFuncIndex);
+      THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(arguments.size(), 2, 3, memberFuncIndex);
       return topk(arguments);
     }
+    case MemberFuncType::TOPK_VALUES: {
+      THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(arguments.size(), 2, 3, memberFuncIndex);
+      return topk_values(arguments);
+    }
     case MemberFuncType::ARRANGE: {
       THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, memberFuncIndex);
       return arrange(arguments[0]);
@@ -8,6 +8,51 @@
 
 #include "tensor_data_variable.hpp"
 
+template <class T>
+bool ListOperators::copy_unboxed(const OpReturnType& list, const std::vector<int64_t>& shape,
+                                 int dim, T*& data) {
+  if (list->get_containerType() != CONTAINERTYPE::LIST) {
+    return false;
+  }
+  if (shape[dim] != list->get_size()) {
+    THROW("%s", "Shape of list not consistent");
+  }
+  auto listVariable = static_cast<const ListDataVariable*>(list.get());
+  if (dim + 1 < shape.size()) {
+    for (int i = 0; i < shape[dim]; i++) {
+      if (!copy_unboxed<T>(list->get_int_subscript(i), shape, dim + 1, data)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if constexpr (std::is_same_v<T, std::string>) {
+    if (listVariable->get_storage() != ListStorage::STRING) {
+      return false;
+    }
+    const auto& strings = listVariable->get_strings();
+    data = std::copy(strings.begin(), strings.end(), data);
+    return true;
+  } else {
+    // Same conversions as get<T>() of the boxed elements, a memcpy if T is the unboxed type
+    switch (listVariable->get_storage()) {
+      case ListStorage::INT64: {
+        const auto& int64s = listVariable->get_int64s();
+        data = std::copy(int64s.begin(), int64s.end(), data);
+        return true;
+      }
+      case ListStorage::DOUBLE: {
+        const auto& doubles = listVariable->get_doubles();
+        data = std::copy(doubles.begin(), doubles.end(), data);
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+}
+
 OpReturnType ListOperators::create_tensor(int dataType, OpReturnType list) {
   // Create empty tensor, if the list is empty
   if (list->get_size() == 0) {
@@ -42,8 +87,11 @@ OpReturnType ListOperators::create_tensor(int dataType, OpReturnType list) {
 OpReturnType ListOperators::operate_string(OpReturnType list, std::vector<int64_t>&& shape,
                                            int size) {
   std::vector<std::string> stringVec(size);
-  for (int i = 0; i < size; i++) {
-    stringVec[i] = get_element<std::string>(list, shape, i, size);
+  std::string* end = stringVec.data();
+  if (!copy_unboxed<std::string>(list, shape, 0, end)) {
+    for (int i = 0; i < size; i++) {
+      stringVec[i] = get_element<std::string>(list, shape, i, size);
+    }
   }
   return OpReturnType(
       new StringTensorVariable(std::move(stringVec), std::move(shape), shape.size()));
@@ -10,45 +10,132 @@
 #include "task.hpp"
 #include "variable_scope.hpp"
 
+size_t MapIndex::find_slot(uint64_t hash, std::string_view key,
+                           const InternedKey* interned) const {
+  if (_slots.empty()) return _slots.size();
+  size_t mask = _slots.size() - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    const auto& slot = _slots[i];
+    if (slot.entry == nullptr) return _slots.size();
+    if (interned != nullptr && slot.interned == interned) return i;
+    if (slot.hash == hash && slot.entry->first == key) return i;
+  }
+}
+
+MapIndex::Entry* MapIndex::find(uint64_t hash, std::string_view key,
+                                const InternedKey* interned) const {
+  size_t i = find_slot(hash, key, interned);
+  return i == _slots.size() ? nullptr : _slots[i].entry;
+}
+
+void MapIndex::grow() {
+  std::vector<Slot> slots(_slots.empty() ? 8 : 2 * _slots.size());
+  std::swap(slots, _slots);
+  _size = 0;
+  for (const auto& slot : slots) {
+    if (slot.entry) insert(slot.hash, slot.entry, slot.interned);
+  }
+}
+
+void MapIndex::insert(uint64_t hash, Entry* entry, const InternedKey* interned) {
+  // Keep the load factor below 3/4 so that probe sequences stay short
+  if (4 * (_size + 1) > 3 * _slots.size()) grow();
+  size_t mask = _slots.size() - 1;
+  size_t i = hash & mask;
+  while (_slots[i].entry != nullptr) i = (i + 1) & mask;
+  _slots[i] = {hash, entry, interned};
+  _size++;
+}
+
+void MapIndex::erase(uint64_t hash, const Entry* entry) {
+  size_t mask = _slots.size() - 1;
+  size_t i = hash & mask;
+  while (_slots[i].entry != entry) i = (i + 1) & mask;
+  // Shift back the following slots of the probe sequence which could not use slot i
+  for (size_t j = (i + 1) & mask; _slots[j].entry != nullptr; j = (j + 1) & mask) {
+    size_t home = _slots[j].hash & mask;
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      _slots[i] = _slots[j];
+      i = j;
+    }
+  }
+  _slots[i] = Slot();
+  _size--;
+}
+
+void MapIndex::rebuild(std::map<std::string, OpReturnType>& map) {
+  _slots.clear();
+  _size = 0;
+  for (auto& entry : map) {
+    insert(InternedKey::hash_of(entry.first), &entry);
+  }
+}
+
 bool MapDataVariable::get_bool() {
-  std::shared_lock lock(_mutex);
+  auto lock = read_lock();
   return _map.size();
 }
 
 int MapDataVariable::get_size() {
-  std::shared_lock lock(_mutex);
+  auto lock = read_lock();
   return _map.size();
 }
 
+void MapDataVariable::set_entry(const std::string& key, uint64_t hash,
+                                const InternedKey* interned, const OpReturnType& d) {
+  if (auto entry = _index.find(hash, key, interned)) {
+    entry->second = d;
+    return;
+  }
+  auto it = _map.emplace(key, d).first;
+  _index.insert(hash, &*it, interned);
+}
+
 void MapDataVariable::set_subscript(const OpReturnType& subscriptVal, const OpReturnType& d) {
   auto key = subscriptVal->get_string();
-  std::unique_lock lock(_mutex);
-  _map[key] = d;
+  share_value(d);
+  auto lock = write_lock();
+  set_entry(key, InternedKey::hash_of(key), nullptr, d);
 }
 
 void MapDataVariable::set_value_in_map(const std::string& key, const OpReturnType& d) {
-  std::unique_lock lock(_mutex);
-  _map[key] = d;
+  share_value(d);
+  auto lock = write_lock();
+  set_entry(key, InternedKey::hash_of(key), nullptr, d);
 }
 
-bool MapDataVariable::in(const OpReturnType& elem) {
-  auto key = elem->get_string();
+void MapDataVariable::set_interned_subscript(const InternedKey& key, const OpReturnType& d) {
+  share_value(d);
+  auto lock = write_lock();
+  set_entry(key.str, key.hash, &key, d);
+}
+
+void MapDataVariable::mark_shared() {
+  if (_shared.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
   std::shared_lock lock(_mutex);
-  if (_map.find(key) != _map.end()) {
-    return true;
+  for (const auto& [key, val] : _map) {
+    val->mark_shared();
   }
-  return false;
+}
+
+bool MapDataVariable::in(const OpReturnType& elem) {
+  auto key = elem->get_string();
+  auto hash = InternedKey::hash_of(key);
+  auto lock = read_lock();
+  return _index.find(hash, key) != nullptr;
 }
 
 JsonIterator* MapDataVariable::get_json_iterator() {
-  std::shared_lock lock(_mutex);
+  auto lock = read_lock();
   // TODO: Will have to take a lock when getting json values in IOS
   return new JsonIterator(_map.begin(), _map.end());
 }
 
 nlohmann::json MapDataVariable::to_json() const {
   auto output = nlohmann::json::object();
-  std::shared_lock lock(_mutex);
+  auto lock = read_lock();
   for (const auto& [key, val] : _map) {
     output[key] = val->to_json();
   }
@@ -57,7 +144,7 @@ nlohmann::json MapDataVariable::to_json() const {
 
 std::string MapDataVariable::to_json_str() const {
   std::string output = "{";
-  std::shared_lock lock(_mutex);
+  auto lock = read_lock();
   bool first = true;
   for (const auto& [key, val] : _map) {
     if (!first) {
@@ -71,7 +158,7 @@ std::string MapDataVariable::to_json_str() const {
 }
 
 const std::map<std::string, OpReturnType>& MapDataVariable::get_map() {
-  std::shared_lock lock(_mutex);
+  auto lock = read_lock();
   return _map;
 }
 
@@ -82,19 +169,21 @@ OpReturnType MapDataVariable::call_function(int memberFuncIndex,
     case MemberFuncType::POP: {
       THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, memberFuncIndex);
       std::string key = arguments[0]->get_string();
-      std::unique_lock lock(_mutex);
-      auto it = _map.find(key);
-      if (it == _map.end()) {
+      auto hash = InternedKey::hash_of(key);
+      auto lock = write_lock();
+      auto entry = _index.find(hash, key);
+      if (entry == nullptr) {
         THROW("%s key not present in map.", key.c_str());
       }
-      OpReturnType value = std::move(it->second);
-      _map.erase(it);
+      OpReturnType value = std::move(entry->second);
+      _index.erase(hash, entry);
+      _map.erase(key);
       return value;
     }
     case MemberFuncType::KEYS: {
       THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 0, MemberFuncType::KEYS);
       OpReturnType list = OpReturnType(new ListDataVariable());
-      std::shared_lock lock(_mutex);
+      auto lock = read_lock();
       for (auto it : _map) {
         list->append(OpReturnType(new SingleVariable<std::string>(it.first)));
       }
@@ -105,30 +194,42 @@ OpReturnType MapDataVariable::call_function(int memberFuncIndex,
 }
 
 OpReturnType MapDataVariable::get_string_subscript(const std::string& key) {
-  std::shared_lock lock(_mutex);
-  if (_map.find(key) == _map.end()) {
+  auto hash = InternedKey::hash_of(key);
+  auto lock = read_lock();
+  auto entry = _index.find(hash, key);
+  if (entry == nullptr) {
     THROW("%s key not found in dict", key.c_str());
   }
-  return _map[key];
+  return entry->second;
+}
+
+OpReturnType MapDataVariable::get_interned_subscript(const InternedKey& key) {
+  auto lock = read_lock();
+  auto entry = _index.find(key.hash, key.str, &key);
+  if (entry == nullptr) {
+    THROW("%s key not found in dict", key.str.c_str());
+  }
+  return entry->second;
 }
 
 MapDataVariable::MapDataVariable(const std::vector<OpReturnType>& keys,
                                  const std::vector<OpReturnType>& values) {
   for (int i = 0; i < keys.size(); i++) {
     std::string key = keys[i]->get_string();
-    _map[key] = values[i];
+    set_entry(key, InternedKey::hash_of(key), nullptr, values[i]);
   }
 }
 
-MapDataVariable::MapDataVariable(const CTensors& inputs) {
+MapDataVariable::MapDataVariable(const CTensors& inputs, CreateTensorType type) {
   for (int i = 0; i < inputs.numTensors; i++) {
+    std::string key(inputs.tensors[i].name);
     // Input can contain both single variables and tensor
     if (inputs.tensors[i].shapeLength == 0) {
-      _map[std::string(inputs.tensors[i].name)] =
-          DataVariable::create_single_variable(inputs.tensors[i]);
+      set_entry(key, InternedKey::hash_of(key), nullptr,
+                DataVariable::create_single_variable(inputs.tensors[i]));
     } else {
-      _map[std::string(inputs.tensors[i].name)] =
-          DataVariable::create_tensor(inputs.tensors[i], CreateTensorType::COPY);
+      set_entry(key, InternedKey::hash_of(key), nullptr,
+                DataVariable::create_tensor(inputs.tensors[i], type));
     }
   }
 }
@@ -136,13 +237,17 @@ MapDataVariable::MapDataVariable(const CTensors& inputs) {
 bool MapDataVariable::add_or_update(OpReturnType mapVariable) {
   const auto& newMap = mapVariable->get_map();
   for (auto const& it : newMap) {
-    _map[it.first] = it.second;
+    share_value(it.second);
+  }
+  auto lock = write_lock();
+  for (auto const& it : newMap) {
+    set_entry(it.first, InternedKey::hash_of(it.first), nullptr, it.second);
   }
   return true;
 }
 
 void MapDataVariable::convert_to_cTensors(CTensors* cTensors) {
-  std::shared_lock lock(_mutex);
+  auto lock = read_lock();
   try {
     CTensor* allocatedCTensors = new CTensor[get_size()];
     int index = 0;
@@ -7,6 +7,7 @@
 #include "model_nimble_net_variable.hpp"
 
 #include "asset_load_job.hpp"
+#include "variable_scope.hpp"
 
 std::shared_ptr<FutureDataVariable> ModelNimbleNetVariable::load_async(
     const std::string& modelName, CommandCenter* commandCenter) {
@@ -47,3 +48,21 @@ OpReturnType ModelNimbleNetVariable::run_model(const std::vector<OpReturnType>&
   }
   return output;
 }
+
+OpReturnType ModelNimbleNetVariable::call_function(int memberFuncIndex,
+                                                   const std::vector<OpReturnType>& arguments,
+                                                   CallStack& stack) {
+  switch (memberFuncIndex) {
+    case MemberFuncType::RUNMODEL: {
+      if (!_commandCenter->get_config()->concurrentModelRun) {
+        return run_model(arguments);
+      }
+      // leave script lock and relock
+      auto scopedUnlocker = stack.scoped_unlock();
+      return run_model(arguments);
+    }
+    case MemberFuncType::GETMODELSTATUS:
+      return get_model_status(arguments);
+  }
+  THROW("%s not implemented for nimblenet", DataVariable::get_member_func_string(memberFuncIndex));
+}
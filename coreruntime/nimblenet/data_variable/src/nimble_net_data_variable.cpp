@@ -18,6 +18,7 @@
 #include "nlohmann/json_fwd.hpp"
 #include "pre_processor_nimble_net_variable.hpp"
 #include "raw_event_store_data_variable.hpp"
+#include "tensor_operators.hpp"
 
 #ifdef GENAI
 #include "llm_data_variable.hpp"
@@ -124,97 +125,43 @@ OpReturnType NimbleNetDataVariable::get_dataframe(const std::vector<OpReturnType
   return OpReturnType(new DataframeVariable(_commandCenter, schema));
 }
 
-OpReturnType NimbleNetDataVariable::min(const std::vector<OpReturnType>& args) {
-  THROW_ARGUMENTS_NOT_MATCH(args.size(), 1, MemberFuncType::MIN);
-
-  auto findMin = [tensor = args[0]](auto typeObj) -> OpReturnType {
-    using T = decltype(typeObj);
-    auto typedTensor = std::dynamic_pointer_cast<BaseTypedTensorVariable>(tensor);
-    if (!typedTensor) {
-      THROW("min expected a tensor, got %s", tensor->get_containerType_string());
-    }
-
-    const auto resultIt = std::min_element(typedTensor->begin<T>(), typedTensor->end<T>());
-    if (resultIt == typedTensor->end<T>()) {
-      THROW("%s", "Expected a non-empty tensor");
-    }
-    auto result = *resultIt;
-    return std::make_shared<SingleVariable<decltype(result)>>(result);
-  };
-
-  return util::call_function_for_dataType(findMin,
-                                          static_cast<DATATYPE>(args[0]->get_dataType_enum()));
-}
-
-OpReturnType NimbleNetDataVariable::max(const std::vector<OpReturnType>& args) {
-  THROW_ARGUMENTS_NOT_MATCH(args.size(), 1, MemberFuncType::MAX);
-
-  auto findMax = [tensor = args[0]](auto typeObj) -> OpReturnType {
-    using T = decltype(typeObj);
-    auto typedTensor = std::dynamic_pointer_cast<BaseTypedTensorVariable>(tensor);
-    if (!typedTensor) {
-      THROW("max expected a tensor, got %s", tensor->get_containerType_string());
-    }
-
-    const auto resultIt = std::max_element(typedTensor->begin<T>(), typedTensor->end<T>());
-    if (resultIt == typedTensor->end<T>()) {
-      THROW("%s", "Expected a non-empty tensor");
-    }
-    auto result = *resultIt;
-    return std::make_shared<SingleVariable<decltype(result)>>(result);
-  };
-
-  return util::call_function_for_dataType(findMax,
-                                          static_cast<DATATYPE>(args[0]->get_dataType_enum()));
-}
-
-OpReturnType NimbleNetDataVariable::sum(const std::vector<OpReturnType>& args) {
-  THROW_ARGUMENTS_NOT_MATCH(args.size(), 1, MemberFuncType::SUM);
-
-  auto findSum = [tensor = args[0]](auto typeObj) -> OpReturnType {
-    using ElementType = decltype(typeObj);
-
-    if constexpr (!std::is_integral_v<ElementType> && !std::is_floating_point_v<ElementType>) {
-      THROW("%s", "sum only supports integral and floating point tensors");
-    }
-
-    auto typedTensor = std::dynamic_pointer_cast<BaseTypedTensorVariable>(tensor);
-    if (!typedTensor) {
-      THROW("sum expected a tensor, got %s", tensor->get_containerType_string());
-    }
-
-    auto result = std::accumulate(typedTensor->begin<ElementType>(),
-                                  typedTensor->end<ElementType>(), ElementType{0});
-    return std::make_shared<SingleVariable<decltype(result)>>(result);
-  };
-
-  return util::call_function_for_dataType(findSum,
-                                          static_cast<DATATYPE>(args[0]->get_dataType_enum()));
+OpReturnType NimbleNetDataVariable::reduce(TensorReduction reduction,
+                                           const std::vector<OpReturnType>& args,
+                                           int memberFuncIndex) {
+  if (args.size() < 1 || args.size() > 3) {
+    THROW("%s expects 1 to 3 arguments, %d given", get_member_func_string(memberFuncIndex),
+          (int)args.size());
+  }
+  const OpReturnType axis = args.size() > 1 ? args[1] : nullptr;
+  if (axis && axis->get_containerType() == CONTAINERTYPE::VECTOR &&
+      (reduction == TensorReduction::MIN || reduction == TensorReduction::MAX)) {
+    const char* elementwiseName = reduction == TensorReduction::MIN ? "minimum" : "maximum";
+    THROW("%s reduces a single tensor, use nm.%s for the elementwise %s of two tensors",
+          get_member_func_string(memberFuncIndex), elementwiseName, elementwiseName);
+  }
+  const bool keepDims = args.size() > 2 && args[2]->get_bool();
+#ifndef MINIMAL_BUILD
+  ThreadPool* pool = ConcurrentExecutorVariable::get_threadpool();
+#else   // MINIMAL_BUILD
+  ThreadPool* pool = nullptr;
+#endif  // MINIMAL_BUILD
+  return TensorOperators::reduce(reduction, args[0], axis, keepDims, pool);
 }
 
-OpReturnType NimbleNetDataVariable::mean(const std::vector<OpReturnType>& args) {
-  THROW_ARGUMENTS_NOT_MATCH(args.size(), 1, MemberFuncType::MEAN);
-
-  auto findMean = [tensor = args[0]](auto typeObj) -> OpReturnType {
-    using ElementType = decltype(typeObj);
-    auto typedTensor = std::dynamic_pointer_cast<BaseTypedTensorVariable>(tensor);
-    if (!typedTensor) {
-      THROW("mean expected a tensor, got %s", tensor->get_containerType_string());
-    }
-
-    if constexpr (!std::is_integral_v<ElementType> && !std::is_floating_point_v<ElementType>) {
-      THROW("%s", "mean only supports integral and floating point tensors");
-    } else {
-      auto sum = std::accumulate(typedTensor->begin<ElementType>(), typedTensor->end<ElementType>(),
-                                 ElementType{0});
-      double mean = static_cast<double>(sum) / typedTensor->get_numElements();
-
-      return std::make_shared<SingleVariable<decltype(mean)>>(mean);
-    }
-  };
-
-  return util::call_function_for_dataType(findMean,
-                                          static_cast<DATATYPE>(args[0]->get_dataType_enum()));
+OpReturnType NimbleNetDataVariable::elementwise(ElementwiseOp op,
+                                                const std::vector<OpReturnType>& args,
+                                                int memberFuncIndex) {
+  THROW_ARGUMENTS_NOT_MATCH(args.size(), 2, memberFuncIndex);
+  auto result = TensorOperators::operate(args[0], args[1], op);
+  if (!result) {
+    THROW("%s expects a tensor and a tensor or number, got %s[%s] and %s[%s]",
+          get_member_func_string(memberFuncIndex),
+          util::get_string_from_enum(args[0]->get_dataType_enum()),
+          args[0]->get_containerType_string(),
+          util::get_string_from_enum(args[1]->get_dataType_enum()),
+          args[1]->get_containerType_string());
+  }
+  return result;
 }
 
 OpReturnType NimbleNetDataVariable::log(const std::vector<OpReturnType>& args) {
@@ -299,15 +246,75 @@ OpReturnType NimbleNetDataVariable::create_concurrent_executor(
 
 OpReturnType NimbleNetDataVariable::set_threads(const std::vector<OpReturnType>& arguments) {
 #ifndef MINIMAL_BUILD
-  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, MemberFuncType::SET_THREADS);
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(arguments.size(), 1, 2, MemberFuncType::SET_THREADS);
   int numThreads = arguments[0]->get_int32();
-  ConcurrentExecutorVariable::set_threadpool_threads(numThreads);
+  std::vector<int> cpuAffinity;
+  if (arguments.size() == 2) {
+    for (int i = 0; i < arguments[1]->get_size(); i++) {
+      cpuAffinity.push_back(arguments[1]->get_int_subscript(i)->get_int32());
+    }
+  }
+  ConcurrentExecutorVariable::set_threadpool_threads(numThreads, cpuAffinity);
   return std::make_shared<NoneVariable>();
 #else   // MINIMAL_BUILD
   THROW("Not supported in minimal build");
 #endif  // MINIMAL_BUILD
 }
 
+OpReturnType NimbleNetDataVariable::create_cache(const std::vector<OpReturnType>& arguments) {
+  if (arguments.size() < 1 || arguments.size() > 3) {
+    THROW("%s expects 1 to 3 arguments, %d given",
+          get_member_func_string(MemberFuncType::CREATE_CACHE), (int)arguments.size());
+  }
+  int64_t maxEntries = arguments[0]->get_int64();
+  double ttlSecs = 0;
+  if (arguments.size() > 1 && !arguments[1]->is_none()) {
+    ttlSecs = arguments[1]->get_double();
+  }
+  int64_t maxBytes = 0;
+  if (arguments.size() > 2 && !arguments[2]->is_none()) {
+    maxBytes = arguments[2]->get_int64();
+  }
+  return std::make_shared<CacheDataVariable>(maxEntries, ttlSecs, maxBytes);
+}
+
+OpReturnType NimbleNetDataVariable::schedule_job(const std::vector<OpReturnType>& arguments) {
+  if (arguments.size() < 2 || arguments.size() > 5) {
+    THROW("%s expects 2 to 5 arguments, %d given",
+          get_member_func_string(MemberFuncType::SCHEDULE_JOB), (int)arguments.size());
+  }
+  if (arguments[0]->get_containerType() != CONTAINERTYPE::FUNCTIONDEF) {
+    THROW("%s expects a function as first argument, given %s",
+          get_member_func_string(MemberFuncType::SCHEDULE_JOB),
+          arguments[0]->get_containerType_string());
+  }
+  BackgroundScriptJobConfig config;
+  config.intervalSecs = arguments[1]->get_double();
+  if (config.intervalSecs < 0) {
+    THROW("%s expects a non negative interval, given %f",
+          get_member_func_string(MemberFuncType::SCHEDULE_JOB), config.intervalSecs);
+  }
+  if (arguments.size() > 2) {
+    config.highPriority = arguments[2]->get_bool();
+  }
+  if (arguments.size() > 3 && !arguments[3]->is_none()) {
+    double maxRunSecs = arguments[3]->get_double();
+    if (maxRunSecs < 0) {
+      THROW("%s expects a non negative max_run_secs, given %f",
+            get_member_func_string(MemberFuncType::SCHEDULE_JOB), maxRunSecs);
+    }
+    config.maxRunMicros = maxRunSecs * Time::MICROS_IN_SECS;
+  }
+  if (arguments.size() > 4) {
+    config.whenIdle = arguments[4]->get_bool();
+  }
+  // The function runs on the thread of the JobScheduler
+  arguments[0]->mark_shared();
+  auto job = std::make_shared<BackgroundScriptJob>(_commandCenter, arguments[0], config);
+  _commandCenter->add_background_script_job(job);
+  return std::make_shared<BackgroundJobDataVariable>(job);
+}
+
 OpReturnType NimbleNetDataVariable::call_function(int memberFuncIndex,
                                                   const std::vector<OpReturnType>& arguments,
                                                   CallStack& stack) {
@@ -334,18 +341,26 @@ OpReturnType NimbleNetDataVariable::call_function(int memberFuncIndex,
       return create_concurrent_executor(arguments);
     case MemberFuncType::SET_THREADS:
       return set_threads(arguments);
+    case MemberFuncType::CREATE_CACHE:
+      return create_cache(arguments);
+    case MemberFuncType::SCHEDULE_JOB:
+      return schedule_job(arguments);
     case MemberFuncType::TO_TENSOR: {
       THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 2, memberFuncIndex);
       return arguments[0]->to_tensor(arguments[1]);
     }
     case MemberFuncType::MIN:
-      return min(arguments);
+      return reduce(TensorReduction::MIN, arguments, memberFuncIndex);
     case MemberFuncType::MAX:
-      return max(arguments);
+      return reduce(TensorReduction::MAX, arguments, memberFuncIndex);
     case MemberFuncType::SUM:
-      return sum(arguments);
+      return reduce(TensorReduction::SUM, arguments, memberFuncIndex);
     case MemberFuncType::MEAN:
-      return mean(arguments);
+      return reduce(TensorReduction::MEAN, arguments, memberFuncIndex);
+    case MemberFuncType::MINIMUM:
+      return elementwise(ElementwiseOp::MIN, arguments, memberFuncIndex);
+    case MemberFuncType::MAXIMUM:
+      return elementwise(ElementwiseOp::MAX, arguments, memberFuncIndex);
     case MemberFuncType::PARSE_JSON: {
       THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, memberFuncIndex);
       nlohmann::json j = nlohmann::json::parse(arguments[0]->get_string());
@@ -6,6 +6,9 @@
 
 #include "nimble_net_internal_data_variable.hpp"
 
+#include "map_data_variable.hpp"
+#include "member_cache.hpp"
+
 OpReturnType NimbleNetInternalDataVariable::create_retriever(
     const std::vector<OpReturnType>& arguments, CallStack& stack) {
 #ifdef GENAI
@@ -14,3 +17,11 @@ OpReturnType NimbleNetInternalDataVariable::create_retriever(
   THROW("%s", "Add GENAI flag to build Retriever");
 #endif  // GENAI
 }
+
+OpReturnType NimbleNetInternalDataVariable::get_inline_cache_stats() {
+  auto stats = MemberInlineCache::get_stats();
+  auto map = std::make_shared<MapDataVariable>();
+  map->set_value_in_map("hits", std::make_shared<SingleVariable<int64_t>>(stats.hits));
+  map->set_value_in_map("misses", std::make_shared<SingleVariable<int64_t>>(stats.misses));
+  return map;
+}
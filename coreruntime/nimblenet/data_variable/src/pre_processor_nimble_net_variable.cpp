@@ -159,7 +159,7 @@ OpReturnType PreProcessorNimbleNetVariable::get_processor_output(
 
 OpReturnType PreProcessorNimbleNetVariable::get_processor_output_by_group(
     const std::vector<OpReturnType>& arguments) {
-  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, MemberFuncType::GET_PROCESSOR_OUTPUT_FOR_GROUP);
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, MemberFuncType::GET_BY_KEY);
   if (!_isPreProcessorCreated) {
     THROW("%s", "Cannot get preProcessor result before it is created.");
   }
@@ -239,7 +239,7 @@ OpReturnType PreProcessorNimbleNetVariable::call_function(
       return add_computation(arguments);
     case MemberFuncType::GET_PROCESSOR_OUTPUT:
       return get_processor_output(arguments);
-    case MemberFuncType::GET_PROCESSOR_OUTPUT_FOR_GROUP:
+    case MemberFuncType::GET_BY_KEY:
       return get_processor_output_by_group(arguments);
     case MemberFuncType::CREATE_PROCESSOR:
       return create_processor(arguments);
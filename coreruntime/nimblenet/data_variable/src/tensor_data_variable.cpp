@@ -9,9 +9,48 @@
 #include <algorithm>
 #include <vector>
 
+#include "selection_kernels.hpp"
 #include "single_variable.hpp"
 #include "util.hpp"
 
+#ifndef MINIMAL_BUILD
+#include "concurrent_executor_variable.hpp"
+#endif  // MINIMAL_BUILD
+
+namespace {
+
+/**
+ * @brief Type the selection kernels compute the elements of a tensor of T as
+ */
+template <typename T>
+using SelectionType = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+
+/**
+ * @brief Axis given by the argument at index, the last one if there are fewer arguments
+ */
+int get_selection_axis(const std::vector<OpReturnType>& arguments, int index,
+                       const std::vector<int64_t>& shape, const char* name) {
+  const int numDims = shape.size();
+  if (numDims == 0) {
+    THROW("%s expects tensor to be of at least 1 dimension.", name);
+  }
+  const int axis = (int)arguments.size() > index ? arguments[index]->get_int32() : -1;
+  if (axis < -numDims || axis >= numDims) {
+    THROW("%s got axis %d, out of bounds for a tensor of %d dimensions.", name, axis, numDims);
+  }
+  return axis < 0 ? axis + numDims : axis;
+}
+
+ThreadPool* get_selection_threadpool() {
+#ifndef MINIMAL_BUILD
+  return ConcurrentExecutorVariable::get_threadpool();
+#else   // MINIMAL_BUILD
+  return nullptr;
+#endif  // MINIMAL_BUILD
+}
+
+}  // namespace
+
 bool BaseTensorVariable::reshape(const std::vector<int64_t>& shape_) {
   int size_ = 1;
   for (auto x : shape_) {
@@ -223,86 +262,78 @@ OpReturnType BaseTypedTensorVariable::sort(const OpReturnType argument) {
   return shared_from_this();
 }
 
-OpReturnType BaseTypedTensorVariable::argsort(const OpReturnType argument) {
-  if (shape.size() != 1) {
-    THROW("argsort expects tensor to be of 1 dimension. Given %d dimensions.", shape.size());
-  }
+OpReturnType BaseTypedTensorVariable::argsort(const std::vector<OpReturnType>& arguments) {
   if (_dataType == JSON) {
     THROW("%s", "argsort not available for JSON tensor.");
   }
+  const auto& argument = arguments[0];
   THROW_ARGUMENT_DATATYPE_NOT_MATCH(argument->get_dataType_enum(), DATATYPE::STRING, 0,
                                     MemberFuncType::ARGSORT);
   if (argument->get_string() != "asc" && argument->get_string() != "desc") {
     THROW("Argument of argsort should be either asc/desc. Given %s argument.",
           argument->get_string().c_str());
   }
-  int32_t* indices = (int32_t*)malloc(sizeof(int32_t) * shape[0]);
-  std::iota(indices, indices + shape[0], 0);
-  std::string sortType = argument->get_string();
+  const int axis = get_selection_axis(arguments, 1, shape, "argsort");
+  const bool descending = argument->get_string() == "desc";
 
-  auto func = [this, &sortType, indices](auto typeObj) {
-    using T = decltype(typeObj);
-    T* tensor_data = static_cast<T*>(get_raw_ptr());
-    if (sortType == "asc") {
-      std::stable_sort(indices, indices + shape[0], [tensor_data](size_t i1, size_t i2) {
-        return tensor_data[i1] < tensor_data[i2];
-      });
-    } else {
-      std::stable_sort(indices, indices + shape[0], [tensor_data](size_t i1, size_t i2) {
-        return tensor_data[i1] > tensor_data[i2];
-      });
+  auto result = DataVariable::create_tensor(INT32, shape);
+  auto func = [&](auto typeObj) {
+    using T = SelectionType<decltype(typeObj)>;
+    if constexpr (std::is_arithmetic_v<T>) {
+      SelectionKernels::argsort(static_cast<const T*>(get_raw_ptr()), shape, axis, descending,
+                                static_cast<int32_t*>(result->get_raw_ptr()),
+                                get_selection_threadpool());
     }
   };
   util::call_function_for_dataType(func, _dataType);
-  return OpReturnType(new TensorVariable(indices, INT32, shape, CreateTensorType::MOVE));
+  return result;
 }
 
 OpReturnType BaseTypedTensorVariable::topk(const std::vector<OpReturnType>& arguments) {
-  if (shape.size() != 1) {
-    THROW("topk expects tensor to be of 1 dimension. Given %d dimensions.", shape.size());
-  }
+  return select_topk(arguments, MemberFuncType::TOPK, false);
+}
+
+OpReturnType BaseTypedTensorVariable::topk_values(const std::vector<OpReturnType>& arguments) {
+  return select_topk(arguments, MemberFuncType::TOPK_VALUES, true);
+}
+
+OpReturnType BaseTypedTensorVariable::select_topk(const std::vector<OpReturnType>& arguments,
+                                                  int memberFuncIndex, bool returnValues) {
+  const char* name = get_member_func_string(memberFuncIndex);
   if (_dataType == JSON) {
-    THROW("%s", "topk not available for JSON tensor.");
+    THROW("%s not available for JSON tensor.", name);
   }
-
   THROW_ARGUMENT_DATATYPE_NOT_MATCH(arguments[1]->get_dataType_enum(), DATATYPE::STRING, 1,
-                                    MemberFuncType::TOPK);
+                                    memberFuncIndex);
   if (arguments[1]->get_string() != "asc" && arguments[1]->get_string() != "desc") {
-    THROW("Second argument of topk should be either asc/desc. Given %s argument.",
+    THROW("Second argument of %s should be either asc/desc. Given %s argument.", name,
           arguments[1]->get_string().c_str());
   }
+  const int axis = get_selection_axis(arguments, 2, shape, name);
+  const bool descending = arguments[1]->get_string() == "desc";
   int numOfElements = arguments[0]->get_int32();
-  if (numOfElements > shape[0]) {
+  if (numOfElements < 0 || numOfElements > shape[axis]) {
     THROW(
-        "First argument of topk cannot be greater than the size of tensor. Given %d argument "
-        "and size of tensor is: %d.",
-        numOfElements, shape[0]);
-  }
-  std::string sortType = arguments[1]->get_string();
-  // Using partial_sort for topk and stable_sort for argsort because partial_sort
-  // uses heapsort internally which is slower when comparing across the whole range of vector, but
-  // faster when sorting a smaller subset of vector
-  std::vector<int32_t> idx(shape[0]);
-  std::iota(idx.begin(), idx.end(), 0);
-
-  auto func = [this, &sortType, numOfElements, &idx](auto typeObj) {
-    using T = decltype(typeObj);
-    T* tensor_data = static_cast<T*>(get_raw_ptr());
-    if (sortType == "asc") {
-      std::partial_sort(
-          idx.begin(), idx.begin() + numOfElements, idx.end(),
-          [tensor_data](size_t i1, size_t i2) { return tensor_data[i1] < tensor_data[i2]; });
-    } else {
-      std::partial_sort(
-          idx.begin(), idx.begin() + numOfElements, idx.end(),
-          [tensor_data](size_t i1, size_t i2) { return tensor_data[i1] > tensor_data[i2]; });
+        "First argument of %s cannot be negative or greater than the size of tensor along axis "
+        "%d. Given %d argument and size of tensor is: %d.",
+        name, axis, numOfElements, (int)shape[axis]);
+  }
+
+  std::vector<int64_t> resultShape = shape;
+  resultShape[axis] = numOfElements;
+  auto result = DataVariable::create_tensor(returnValues ? _dataType : INT32, resultShape);
+  auto func = [&](auto typeObj) {
+    using T = SelectionType<decltype(typeObj)>;
+    if constexpr (std::is_arithmetic_v<T>) {
+      void* out = result->get_raw_ptr();
+      SelectionKernels::topk(static_cast<const T*>(get_raw_ptr()), shape, axis, numOfElements,
+                             descending, returnValues ? nullptr : static_cast<int32_t*>(out),
+                             returnValues ? static_cast<T*>(out) : nullptr,
+                             get_selection_threadpool());
     }
   };
   util::call_function_for_dataType(func, _dataType);
-
-  int32_t* indices = (int32_t*)malloc(sizeof(int32_t) * numOfElements);
-  memcpy(indices, idx.data(), numOfElements * sizeof(int32_t));
-  return OpReturnType(new TensorVariable(indices, INT32, numOfElements, CreateTensorType::MOVE));
+  return result;
 }
 
 OpReturnType BaseTypedTensorVariable::arrange(const OpReturnType argument) {
@@ -328,7 +359,8 @@ OpReturnType BaseTypedTensorVariable::arrange(const OpReturnType argument) {
   }
 
   char* tensor_data = static_cast<char*>(get_raw_ptr());
-  char* data = (char*)malloc(_elemSize * size);
+  auto tensor = DataVariable::create_tensor(_dataType, {size});
+  char* data = static_cast<char*>(tensor->get_raw_ptr());
   for (int i = 0; i < size; i++) {
     OpReturnType index = argument->get_int_subscript(i);
     if (!index->is_integer()) {
@@ -340,7 +372,7 @@ OpReturnType BaseTypedTensorVariable::arrange(const OpReturnType argument) {
     }
     memcpy(data + i * _elemSize, tensor_data + index->get_int32() * _elemSize, _elemSize);
   }
-  return OpReturnType(new TensorVariable(data, _dataType, size, CreateTensorType::MOVE));
+  return tensor;
 }
 
 void StringTensorVariable::set_subscript(const OpReturnType& subscriptVal, const OpReturnType& d) {
@@ -422,63 +454,91 @@ OpReturnType StringTensorVariable::sort(const OpReturnType argument) {
   return shared_from_this();
 }
 
-OpReturnType StringTensorVariable::argsort(const OpReturnType argument) {
+OpReturnType StringTensorVariable::argsort(const std::vector<OpReturnType>& arguments) {
   if (_shape.size() != 1) {
     THROW("argsort expects tensor to be of 1 dimension. Given %d dimensions.", _shape.size());
   }
+  const auto& argument = arguments[0];
   THROW_ARGUMENT_DATATYPE_NOT_MATCH(argument->get_dataType_enum(), DATATYPE::STRING, 0,
                                     MemberFuncType::ARGSORT);
   if (argument->get_string() != "asc" && argument->get_string() != "desc") {
     THROW("Argument of argsort should be either asc/desc. Given %s argument.",
           argument->get_string().c_str());
   }
-  int32_t* indices = (int32_t*)malloc(_shape[0] * sizeof(int32_t));
+  // Only the axis of a 1 dimensional tensor, 0 or -1, is accepted
+  get_selection_axis(arguments, 1, _shape, "argsort");
+  auto tensor = DataVariable::create_tensor(INT32, _shape);
+  int32_t* indices = static_cast<int32_t*>(tensor->get_raw_ptr());
   std::iota(indices, indices + _shape[0], 0);
   std::string sortType = argument->get_string();
-  std::vector<std::string> data = _data;
+  const auto& data = _data;
   if (sortType == "asc") {
     std::stable_sort(indices, indices + _shape[0],
-                     [data](size_t i1, size_t i2) { return data[i1] < data[i2]; });
+                     [&data](size_t i1, size_t i2) { return data[i1] < data[i2]; });
   } else {
     std::stable_sort(indices, indices + _shape[0],
-                     [data](size_t i1, size_t i2) { return data[i1] > data[i2]; });
+                     [&data](size_t i1, size_t i2) { return data[i1] > data[i2]; });
   }
 
-  return OpReturnType(new TensorVariable(indices, INT32, _shape, CreateTensorType::MOVE));
+  return tensor;
 }
 
-OpReturnType StringTensorVariable::topk(const std::vector<OpReturnType>& arguments) {
+std::vector<int32_t> StringTensorVariable::select_topk(const std::vector<OpReturnType>& arguments,
+                                                       int memberFuncIndex) {
+  const char* name = get_member_func_string(memberFuncIndex);
   if (_shape.size() != 1) {
-    THROW("topk expects tensor to be of 1 dimension. Given %d dimensions.", _shape.size());
+    THROW("%s expects tensor to be of 1 dimension. Given %d dimensions.", name, _shape.size());
   }
   THROW_ARGUMENT_DATATYPE_NOT_MATCH(arguments[1]->get_dataType_enum(), DATATYPE::STRING, 1,
-                                    MemberFuncType::TOPK);
+                                    memberFuncIndex);
   if (arguments[1]->get_string() != "asc" && arguments[1]->get_string() != "desc") {
-    THROW("Argument of topk should be either asc/desc. Given %s argument.",
+    THROW("Argument of %s should be either asc/desc. Given %s argument.", name,
           arguments[1]->get_string().c_str());
   }
+  get_selection_axis(arguments, 2, _shape, name);
 
   int numOfElements = arguments[0]->get_int32();
-  if (numOfElements > _shape[0]) {
+  if (numOfElements < 0 || numOfElements > _shape[0]) {
     THROW(
-        "First argument of topk cannot be greater than the shape of tensor. Given %d argument "
-        "and size of tensor is: %d.",
-        numOfElements, _shape[0]);
+        "First argument of %s cannot be negative or greater than the shape of tensor. Given %d "
+        "argument and size of tensor is: %d.",
+        name, numOfElements, (int)_shape[0]);
   }
   std::string sortType = arguments[1]->get_string();
   std::vector<int32_t> idx(_shape[0]);
   std::iota(idx.begin(), idx.end(), 0);
-  std::vector<std::string> data = _data;
+  const auto& data = _data;
+  // Ties are broken by position, so that equal elements keep their order like in argsort
   if (sortType == "asc") {
     std::partial_sort(idx.begin(), idx.begin() + numOfElements, idx.end(),
-                      [data](size_t i1, size_t i2) { return data[i1] < data[i2]; });
+                      [&data](int32_t i1, int32_t i2) {
+                        return data[i1] < data[i2] || (data[i1] == data[i2] && i1 < i2);
+                      });
   } else {
     std::partial_sort(idx.begin(), idx.begin() + numOfElements, idx.end(),
-                      [data](size_t i1, size_t i2) { return data[i1] > data[i2]; });
+                      [&data](int32_t i1, int32_t i2) {
+                        return data[i1] > data[i2] || (data[i1] == data[i2] && i1 < i2);
+                      });
   }
-  int32_t* indices = (int32_t*)malloc(sizeof(int32_t) * numOfElements);
-  memcpy(indices, idx.data(), numOfElements * sizeof(int32_t));
-  return OpReturnType(new TensorVariable(indices, INT32, numOfElements, CreateTensorType::MOVE));
+  idx.resize(numOfElements);
+  return idx;
+}
+
+OpReturnType StringTensorVariable::topk(const std::vector<OpReturnType>& arguments) {
+  auto idx = select_topk(arguments, MemberFuncType::TOPK);
+  auto tensor = DataVariable::create_tensor(INT32, {(int64_t)idx.size()});
+  std::copy(idx.begin(), idx.end(), (int32_t*)tensor->get_raw_ptr());
+  return tensor;
+}
+
+OpReturnType StringTensorVariable::topk_values(const std::vector<OpReturnType>& arguments) {
+  auto idx = select_topk(arguments, MemberFuncType::TOPK_VALUES);
+  auto tensor = DataVariable::create_tensor(STRING, {(int64_t)idx.size()});
+  auto values = static_cast<std::string*>(tensor->get_raw_ptr());
+  for (size_t i = 0; i < idx.size(); i++) {
+    values[i] = _data[idx[i]];
+  }
+  return tensor;
 }
 
 OpReturnType StringTensorVariable::arrange(const OpReturnType argument) {
@@ -545,9 +605,14 @@ TensorVariable::TensorVariable(void* data, DATATYPE dataType, const std::vector<
     case CreateTensorType::MOVE:
       variable = (void*)data;
       break;
+    case CreateTensorType::BORROW:
+      variable = (void*)data;
+      borrowed = true;
+      break;
     case CreateTensorType::COPY: {
       int totalBytes = BaseTensorVariable::numElements * _elemSize;
-      variable = malloc(totalBytes);
+      variable = TensorBufferPool::instance().allocate(totalBytes);
+      pooled = true;
       memcpy(variable, data, totalBytes);
       break;
     }
@@ -565,10 +630,23 @@ TensorVariable::TensorVariable(const std::vector<int64_t>& shape_, DATATYPE data
     BaseTensorVariable::numElements *= x;
   }
   int totalBytes = BaseTensorVariable::numElements * _elemSize;
-  variable = malloc(totalBytes);
+  variable = TensorBufferPool::instance().allocate(totalBytes);
+  pooled = true;
   memset(variable, 0, totalBytes);
 }
 
+void TensorVariable::detach() {
+  if (!borrowed) {
+    return;
+  }
+  size_t totalBytes = size_t(BaseTensorVariable::numElements) * _elemSize;
+  void* data = TensorBufferPool::instance().allocate(totalBytes);
+  memcpy(data, variable, totalBytes);
+  variable = data;
+  pooled = true;
+  borrowed = false;
+}
+
 char** StringTensorVariable::get_string_ptr() {
   stringPtrs.clear();
   for (int i = 0; i < _numElements; i++) {
@@ -31,6 +31,11 @@ class TaskONNXModel : public TaskBaseModel {
    */
   void load_model_meta_data();
 
+  /**
+   * @brief Whether sessions allocate from TensorBufferPool, see Config::pooledModelAllocator.
+   */
+  bool use_pooled_allocator() const;
+
   /**
    * @brief Loads the model from the internal buffer.
    */
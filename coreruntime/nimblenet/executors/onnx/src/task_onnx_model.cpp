@@ -9,6 +9,7 @@
 #include "data_variable.hpp"
 #include "nimble_net_util.hpp"
 #include "onnx_operators.hpp"
+#include "tensor_buffer_pool.hpp"
 #include "tensor_data_variable.hpp"
 
 Ort::Env TaskONNXModel::_myEnv =
@@ -162,13 +163,81 @@ int ORT_API_CALL GetActiveOrtAPIVersion();
 #endif  // __cplusplus
 #endif  // ORT_EXTENSIONS
 
-void add_common_session_options(Ort::SessionOptions& sessionOptions) {
+namespace {
+
+/**
+ * @brief CPU allocator of ONNX sessions backed by TensorBufferPool.
+ *
+ * Model outputs are wrapped by OrtTensorVariable and released to the pool once the script drops
+ * them, so that the next inference with the same shapes reuses their buffers.
+ */
+struct PooledOrtAllocator : OrtAllocator {
+  Ort::MemoryInfo memoryInfo =
+      Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtDeviceAllocator, OrtMemTypeDefault);
+
+  PooledOrtAllocator() : OrtAllocator{} {
+    version = ORT_API_VERSION;
+    Alloc = alloc;
+    Free = release;
+    Info = info;
+  }
+
+  static void* ORT_API_CALL alloc(OrtAllocator*, size_t size) {
+    try {
+      return TensorBufferPool::instance().allocate(size);
+    } catch (const std::bad_alloc&) {
+      return nullptr;
+    }
+  }
+
+  static void ORT_API_CALL release(OrtAllocator*, void* buffer) {
+    TensorBufferPool::instance().release(buffer);
+  }
+
+  static const OrtMemoryInfo* ORT_API_CALL info(const OrtAllocator* allocator) {
+    return static_cast<const PooledOrtAllocator*>(allocator)->memoryInfo;
+  }
+};
+
+/**
+ * @brief Registers PooledOrtAllocator with env the first time it is called.
+ *
+ * @return Whether the allocator is registered, sessions use the allocators of ONNX Runtime if not.
+ */
+bool register_pooled_allocator(Ort::Env& env) {
+  static const bool registered = [&env]() {
+    // Never destroyed, as env keeps using it till the end of the process
+    auto allocator = new PooledOrtAllocator();
+    OrtStatus* status = Ort::GetApi().RegisterAllocator(env, allocator);
+    if (status != nullptr) {
+      LOG_TO_CLIENT_INFO("Could not register tensor buffer pool with ONNX Runtime: %s",
+                         Ort::GetApi().GetErrorMessage(status));
+      Ort::GetApi().ReleaseStatus(status);
+      return false;
+    }
+    return true;
+  }();
+  return registered;
+}
+
+}  // namespace
+
+void add_common_session_options(Ort::SessionOptions& sessionOptions, Ort::Env& env,
+                                bool usePooledAllocator) {
   sessionOptions.AddConfigEntry("session.use_ort_model_bytes_directly", "1");
+  // Opt-in through the config, as sessions using the env allocator give up their own CPU arena
+  if (usePooledAllocator && register_pooled_allocator(env)) {
+    sessionOptions.AddConfigEntry("session.use_env_allocators", "1");
+  }
 #ifdef ORT_EXTENSIONS
   Ort::ThrowOnError(RegisterCustomOps((OrtSessionOptions*)sessionOptions, OrtGetApiBase()));
 #endif  // ORT_EXTENSIONS
 }
 
+bool TaskONNXModel::use_pooled_allocator() const {
+  return _commandCenter != nullptr && _commandCenter->get_config()->pooledModelAllocator;
+}
+
 void TaskONNXModel::load_model_from_buffer() {
   Ort::CustomOpDomain deliteai_operator_domain{"dev.deliteai"};
   register_custom_onnx_operators(deliteai_operator_domain);
@@ -203,7 +272,7 @@ void TaskONNXModel::load_model_from_buffer() {
         }
       }
       _sessionOptions = get_session_options_from_json(epConfig);
-      add_common_session_options(_sessionOptions);
+      add_common_session_options(_sessionOptions, _myEnv, use_pooled_allocator());
       _sessionOptions.Add(deliteai_operator_domain);
       _session =
           new Ort::Session(_myEnv, _modelBuffer.c_str(), _modelBuffer.length(), _sessionOptions);
@@ -222,7 +291,7 @@ void TaskONNXModel::load_model_from_buffer() {
   newSessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
   _sessionOptions = std::move(newSessionOptions);
   _sessionOptions.Add(deliteai_operator_domain);
-  add_common_session_options(_sessionOptions);
+  add_common_session_options(_sessionOptions, _myEnv, use_pooled_allocator());
   _session = new Ort::Session(_myEnv, _modelBuffer.c_str(), _modelBuffer.length(), _sessionOptions);
   //_modelBuffer is used directly by ONNX so we have to maintain it as long as the session exists
   load_model_meta_data();
@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "data_variable.hpp"
+#include "job.hpp"
+
+class CommandCenter;
+
+/**
+ * @brief Configuration of a background job registered by the script with nm.schedule_job().
+ */
+struct BackgroundScriptJobConfig {
+  double intervalSecs = 0;  /**< Minimum time between the starts of two runs, 0 to run every pass */
+  bool highPriority = false; /**< Run with the priority jobs of the scheduler */
+  int64_t maxRunMicros = 0;  /**< Runs taking longer stop the job, 0 for no limit */
+  bool whenIdle = false;     /**< Defer runs while methods of the script are running */
+};
+
+/**
+ * @brief A job running a function of the script periodically on the thread of the JobScheduler.
+ *
+ * The job stays in the scheduler by returning RETRY after every pass, and runs the function once
+ * intervalSecs have passed since its previous run. The first run happens on the first pass after
+ * the job is registered. Time is read with Time::get_time(), so that in simulation mode the jobs
+ * follow the clock set by run_task_upto_timestamp.
+ *
+ * Runs are not interrupted: a run exceeding maxRunMicros is logged and the job is stopped, so that
+ * a slow job cannot keep delaying the other jobs of the scheduler. Errors thrown by the function
+ * are logged and do not stop the job.
+ *
+ * The job completes once cancelled, either by the script or when its CommandCenter is destroyed.
+ * The CommandCenter waits with cancel_and_wait() for a run in progress to finish before it goes
+ * away.
+ */
+class BackgroundScriptJob : public Job<void> {
+ public:
+  static constexpr const char* JOB_NAME = "BackgroundScriptJob";
+
+ private:
+  CommandCenter* _commandCenter;
+  OpReturnType _function; /**< Released when the job completes */
+  const BackgroundScriptJobConfig _config;
+  std::atomic<bool> _cancelled = false;
+  std::recursive_mutex _runMutex; /**< Held by process(), recursive so a run can cancel its job */
+  double _nextRunTime = 0;
+  int64_t _numRuns = 0;
+
+ public:
+  BackgroundScriptJob(CommandCenter* commandCenter, OpReturnType function,
+                      const BackgroundScriptJobConfig& config);
+
+  /**
+   * @brief Adds the job to the scheduler of the CommandCenter.
+   */
+  void init();
+
+  /**
+   * @brief Stops the job, a run in progress finishes. Can be called from any thread.
+   */
+  void cancel() noexcept { _cancelled.store(true); }
+
+  /**
+   * @brief Stops the job and waits for a run in progress to finish, the function of the script is
+   * released before returning. The job does not use its CommandCenter afterwards.
+   */
+  void cancel_and_wait();
+
+  bool is_cancelled() const noexcept { return _cancelled.load(); }
+
+  Job::Status process() override;
+};
@@ -11,6 +11,8 @@
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "job.hpp"
@@ -33,8 +35,11 @@ class JobScheduler {
    */
   ne::LockedMPSCQueue<std::shared_ptr<BaseJob>> _jobs;
 
-  /** Jobs that have to be added back to the _jobs queue. Used in do_jobs() function */
-  std::queue<std::shared_ptr<BaseJob>> _attemptedJobs;
+  /**
+   * Jobs that have to be added back to the queues, with whether they are priority jobs. Used in
+   * do_jobs() function
+   */
+  std::queue<std::pair<std::shared_ptr<BaseJob>, bool>> _attemptedJobs;
 
   /** Queue of priority jobs that are ready to run i.e. don't have any pending dependencies */
   ne::LockedMPSCQueue<std::shared_ptr<BaseJob>> _priorityJobs;
@@ -74,6 +79,12 @@ class JobScheduler {
    * @brief Performs all jobs in the queue, exits when the queue is empty
    */
   void do_jobs();
+
+  /**
+   * @brief Performs the jobs named jobName which are in the queues, the other jobs are left in the
+   * queues.
+   */
+  void do_jobs(const std::string& jobName);
   void do_all_non_priority_jobs();
 
  private:
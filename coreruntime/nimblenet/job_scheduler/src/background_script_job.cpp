@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "background_script_job.hpp"
+
+#include <stdexcept>
+
+#include "command_center.hpp"
+#include "logger.hpp"
+#include "time_manager.hpp"
+
+BackgroundScriptJob::BackgroundScriptJob(CommandCenter* commandCenter, OpReturnType function,
+                                         const BackgroundScriptJobConfig& config)
+    : Job(JOB_NAME),
+      _commandCenter(commandCenter),
+      _function(std::move(function)),
+      _config(config) {
+  _nextRunTime = Time::get_time();
+}
+
+void BackgroundScriptJob::init() {
+  auto job = std::static_pointer_cast<BackgroundScriptJob>(shared_from_this());
+  // Ignoring the future returned by this job, as errors of the runs are logged
+  if (_config.highPriority) {
+    static_cast<void>(_commandCenter->job_scheduler()->add_priority_job<void>(job));
+  } else {
+    static_cast<void>(_commandCenter->job_scheduler()->add_job<void>(job));
+  }
+}
+
+void BackgroundScriptJob::cancel_and_wait() {
+  cancel();
+  std::lock_guard<std::recursive_mutex> locker(_runMutex);
+  _function = nullptr;
+}
+
+Job<void>::Status BackgroundScriptJob::process() {
+  std::lock_guard<std::recursive_mutex> locker(_runMutex);
+  if (is_cancelled()) {
+    LOG_TO_DEBUG("BackgroundScriptJob cancelled after %lld runs", (long long)_numRuns);
+    _function = nullptr;
+    return Job::Status::COMPLETE;
+  }
+  // Jobs of a CommandCenter loading a new deployment in the background wait till it is used
+  if (!_commandCenter->is_ready() || !_commandCenter->is_current()) {
+    return Job::Status::RETRY;
+  }
+  auto now = Time::get_time();
+  if (now < _nextRunTime) {
+    return Job::Status::RETRY;
+  }
+  if (_config.whenIdle && !_commandCenter->is_idle()) {
+    return Job::Status::RETRY;
+  }
+
+  auto start = Time::get_high_resolution_clock_time();
+  try {
+    _function->execute_function({});
+  } catch (const std::exception& e) {
+    LOG_TO_CLIENT_ERROR("Error in background job of the script: %s", e.what());
+  } catch (...) {
+    LOG_TO_CLIENT_ERROR("Unknown error in background job of the script");
+  }
+  auto elapsedMicros = Time::get_elapsed_time_in_micro(start);
+  _numRuns++;
+  _nextRunTime = now + _config.intervalSecs;
+
+  if (_config.maxRunMicros > 0 && elapsedMicros > _config.maxRunMicros) {
+    LOG_TO_CLIENT_ERROR(
+        "Background job of the script took %lld micros, more than its maximum of %lld micros, "
+        "stopping the job",
+        (long long)elapsedMicros, (long long)_config.maxRunMicros);
+    cancel();
+    _function = nullptr;
+    return Job::Status::COMPLETE;
+  }
+  return Job::Status::RETRY;
+}
@@ -46,6 +46,27 @@ void JobScheduler::do_jobs() {
   append_jobs_back_to_queue();
 }
 
+// Runs the jobs with the name which are initially present in the queues, the others are added back
+// to the queues in the same order
+void JobScheduler::do_jobs(const std::string& jobName) {
+  for (auto isPriority : {true, false}) {
+    auto& jobs = isPriority ? _priorityJobs : _jobs;
+    auto jobsCount = jobs.size();
+    while (jobsCount > 0) {
+      auto job = std::move(*jobs.front());
+      jobs.pop();
+      if (job->_name == jobName) {
+        do_job(std::move(job), isPriority);
+      } else {
+        _attemptedJobs.emplace(std::move(job), isPriority);
+      }
+      jobsCount--;
+    }
+  }
+
+  append_jobs_back_to_queue();
+}
+
 // Runs all the jobs till the queue is empty
 // Useful when trying to load the assets from main thread
 void JobScheduler::do_all_non_priority_jobs() {
@@ -71,7 +92,7 @@ void JobScheduler::do_job(std::shared_ptr<BaseJob>&& job, bool isPriority) {
 
     switch (status) {
       case BaseJob::Status::RETRY:
-        _attemptedJobs.push(job);
+        _attemptedJobs.emplace(job, isPriority);
         return;
       case BaseJob::Status::COMPLETE:
         job->_state = BaseJob::State::FINISHED;
@@ -155,9 +176,9 @@ void JobScheduler::add_job(std::shared_ptr<BaseJob>&& job, bool isPriority) {
 
 void JobScheduler::append_jobs_back_to_queue() {
   while (_attemptedJobs.size() != 0) {
-    auto job = _attemptedJobs.front();
+    auto [job, isPriority] = std::move(_attemptedJobs.front());
     _attemptedJobs.pop();
-    add_job(std::move(job), false);
+    add_job(std::move(job), isPriority);
   }
 }
 
@@ -58,6 +58,40 @@ NimbleNetStatus* is_ready();
  */
 NimbleNetStatus* run_method(const char* functionName, const CTensors inputs, CTensors* outputs);
 
+/**
+ * @brief Runs a method like run_method(), without copying the data of numeric input tensors.
+ *
+ * The data of inputs has to stay valid and unchanged till the call returns, and is written to if
+ * the script assigns to elements of the inputs. Tensors the script keeps past the call, e.g. in a
+ * global or as an output, get a copy of their data before it returns.
+ *
+ * As with run_method(), numeric output tensors point to the buffers of the script without copying
+ * them. They stay valid till outputs is released with deallocate_output_memory2().
+ */
+NimbleNetStatus* run_method_zero_copy(const char* functionName, const CTensors inputs,
+                                      CTensors* outputs);
+
+/**
+ * @brief Returns the time spent in the functions and lines of the delitepy script, recorded when
+ * the config sets profileScript to true.
+ *
+ * @param format  "collapsed" for one "frame;frame;frame microseconds" line per call path, the input
+ * format of flame graph tools, or "json" for the calls, inclusive and exclusive microseconds per
+ * function and per line.
+ * @param profile Set to the profile, allocated with malloc and to be freed by the caller.
+ * @return NimbleNetStatus* indicating success/failure.
+ */
+NimbleNetStatus* get_script_profile(const char* format, char** profile);
+
+/**
+ * @brief Writes the profile of the delitepy script to a file, see get_script_profile().
+ *
+ * @param format   "collapsed" or "json".
+ * @param filePath Path of the file to write, it is overwritten.
+ * @return NimbleNetStatus* indicating success/failure.
+ */
+NimbleNetStatus* write_script_profile(const char* format, const char* filePath);
+
 /**
  * @brief Updates the session context with the given session ID string.
  */
@@ -68,6 +102,12 @@ void update_session(const char* sessionIdString);
  */
 void deallocate_nimblenet();
 
+/**
+ * @brief Frees the tensor buffers kept for reuse by NimbleNet. To be called when the OS signals
+ * memory pressure, buffers are allocated again as needed.
+ */
+void trim_memory();
+
 /**
  * @brief Copies assets provided from disk into homeDirectory.
  */
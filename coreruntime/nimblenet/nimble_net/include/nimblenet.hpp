@@ -125,6 +125,11 @@ bool send_events(const std::string& params, const std::string& homeDirectory);
  * @brief Indicates to NimbleNet that network access is restored.
  */
 void internet_switched_on();
+
+/**
+ * @brief Frees the tensor buffers kept for reuse, see ::trim_memory().
+ */
+void trim_memory();
 }  // namespace nimblenet
 
 namespace nimblenetInternal {
@@ -13,6 +13,7 @@
 #include "executor_structs.h"
 #include "native_interface.hpp"
 #include "nimblenet.hpp"
+#include "tensor_buffer_pool.hpp"
 #include "util.hpp"
 
 #ifndef MINIMAL_BUILD
@@ -78,8 +79,11 @@ void deallocate_nimblenet() {
 #ifndef MINIMAL_BUILD
   ConcurrentExecutorVariable::reset_threadpool();
 #endif  // MINIMAL_BUILD
+  TensorBufferPool::instance().trim();
 }
 
+void trim_memory() { TensorBufferPool::instance().trim(); }
+
 void internet_switched_on() { TRY_CATCH_RETURN_VOID(coreSDK->internet_switched_on()); }
 
 bool save_labels_for_inference_input(const char* modelId, const InferenceRequest inputs,
@@ -95,6 +99,20 @@ NimbleNetStatus* run_method(const char* functionName, const CTensors inputs, CTe
   TRY_CATCH_RETURN_NIMBLESTATUS(coreSDK->run_task(GLOBALTASKNAME, functionName, inputs, outputs));
 }
 
+NimbleNetStatus* run_method_zero_copy(const char* functionName, const CTensors inputs,
+                                      CTensors* outputs) {
+  TRY_CATCH_RETURN_NIMBLESTATUS(
+      coreSDK->run_task(GLOBALTASKNAME, functionName, inputs, outputs, true));
+}
+
+NimbleNetStatus* get_script_profile(const char* format, char** profile) {
+  TRY_CATCH_RETURN_NIMBLESTATUS(coreSDK->get_script_profile(format, profile));
+}
+
+NimbleNetStatus* write_script_profile(const char* format, const char* filePath) {
+  TRY_CATCH_RETURN_NIMBLESTATUS(coreSDK->write_script_profile(format, filePath));
+}
+
 bool deallocate_output_memory2(CTensors* output) {
   TRY_CATCH_RETURN_DEFAULT(coreSDK->deallocate_output_memory(output), false);
 }
@@ -255,6 +273,8 @@ void send_crash_log(const std::string& errorMessage) {
 
 void internet_switched_on() { return ::internet_switched_on(); }
 
+void trim_memory() { return ::trim_memory(); }
+
 void write_metric(const std::string& metricType, const std::string& metricJson) {
   return ::write_metric(metricType.c_str(), metricJson.c_str());
 }
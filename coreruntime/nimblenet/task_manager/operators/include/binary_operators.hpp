@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <memory>
@@ -18,7 +19,22 @@
 #include "operator_types.hpp"
 #include "single_variable.hpp"
 #include "tensor_data_variable.hpp"
+#include "tensor_operators.hpp"
 #include "util.hpp"
+#include "value.hpp"
+
+/**
+ * @brief Binary operation resolved from its name in the script
+ */
+enum class BinaryOpType {
+  ADD,
+  SUB,
+  MULT,
+  DIV,
+  POW,
+  MOD,
+  UNKNOWN, /**< Any other operation, not supported by the numeric operators */
+};
 
 /**
  * @brief Base class for binary operations on DataVariable objects
@@ -117,24 +133,26 @@ class BaseBinOp {
    *
    * @param val1 First operand
    * @param val2 Second operand
-   * @param opType String identifier for the operation ("Add", "Sub", "Mult", "Div", "Pow", "Mod")
+   * @param opType Resolved operation type
    * @return Result of the operation or nullptr if operation is not supported
    */
-  OpReturnType perform_operation(OpReturnType val1, OpReturnType val2, std::string& opType) {
-    if (opType == "Add") {
-      return add(val1, val2);
-    } else if (opType == "Sub") {
-      return sub(val1, val2);
-    } else if (opType == "Mult") {
-      return mult(val1, val2);
-    } else if (opType == "Div") {
-      return div(val1, val2);
-    } else if (opType == "Pow") {
-      return pow(val1, val2);
-    } else if (opType == "Mod") {
-      return mod(val1, val2);
+  OpReturnType perform_operation(OpReturnType val1, OpReturnType val2, BinaryOpType opType) {
+    switch (opType) {
+      case BinaryOpType::ADD:
+        return add(val1, val2);
+      case BinaryOpType::SUB:
+        return sub(val1, val2);
+      case BinaryOpType::MULT:
+        return mult(val1, val2);
+      case BinaryOpType::DIV:
+        return div(val1, val2);
+      case BinaryOpType::POW:
+        return pow(val1, val2);
+      case BinaryOpType::MOD:
+        return mod(val1, val2);
+      default:
+        return nullptr;
     }
-    return nullptr;
   }
 
   /** @brief Virtual method for addition operation */
@@ -237,6 +255,54 @@ class NumericBinOp : public BaseBinOp {
   }
 };
 
+/**
+ * @brief Numeric binary operations on unboxed scalars
+ *
+ * Mirrors NumericBinOp, including its error messages, but works on Value so that the result
+ * does not need to be allocated.
+ */
+template <typename T,
+          typename = std::enable_if_t<ne::is_one_of_v<T, float, int32_t, double, int64_t>>>
+struct ScalarBinOp {
+  /**
+   * @brief Performs the binary operation on two numeric scalars promoted to T
+   *
+   * @return false if the operation is not supported
+   */
+  static bool compute(const Value& val1, const Value& val2, BinaryOpType opType, Value& result) {
+    T a = val1.get<T>();
+    T b = val2.get<T>();
+    switch (opType) {
+      case BinaryOpType::ADD:
+        result = Value(T(a + b));
+        return true;
+      case BinaryOpType::SUB:
+        result = Value(T(a - b));
+        return true;
+      case BinaryOpType::MULT:
+        result = Value(T(a * b));
+        return true;
+      case BinaryOpType::DIV:
+        if (b == (T)0) {
+          THROW("%s", "Division by zero will result in undefined behaviour.");
+        }
+        result = Value(T(a / b));
+        return true;
+      case BinaryOpType::POW:
+        result = Value(T(std::pow(a, b)));
+        return true;
+      case BinaryOpType::MOD:
+        if (b == (T)0) {
+          THROW("%s", "Modulo by zero error.");
+        }
+        result = Value(ModOperator<T>::compute(a, b));
+        return true;
+      default:
+        return false;
+    }
+  }
+};
+
 /**
  * @brief Binary operations for string types
  *
@@ -277,25 +343,38 @@ class BinaryOperators {
    *
    * Automatically selects the appropriate operation handler based on operand types:
    * - Lists: Uses ListBinOp
-   * - Tensors: Currently throws exception (not supported)
+   * - Numeric tensors, with another tensor or a scalar: Uses TensorOperators
    * - Numeric: Uses NumericBinOp with appropriate type promotion
    * - Strings: Uses StringBinOp
    *
    * @param v1 First operand
    * @param v2 Second operand
-   * @param opType Operation type string
+   * @param opType Resolved operation type, see get_op_type()
    * @return Result of operation or nullptr if operation is not supported
    */
-  static OpReturnType operate(OpReturnType v1, OpReturnType v2, std::string& opType) {
+  static OpReturnType operate(OpReturnType v1, OpReturnType v2, BinaryOpType opType) {
     // First, check for list operations
     if (v1->get_containerType() == CONTAINERTYPE::LIST ||
         v2->get_containerType() == CONTAINERTYPE::LIST) {
       static ListBinOp listOp;
       return listOp.perform_operation(v1, v2, opType);
-    } else if (auto t1 = std::dynamic_pointer_cast<BaseTensorVariable>(v1),
-               t2 = std::dynamic_pointer_cast<BaseTensorVariable>(v2);
-               t1 && t2) {
-      THROW("%s", "tensor ops not supported");
+    } else if (TensorOperators::is_numeric_tensor(v1) || TensorOperators::is_numeric_tensor(v2)) {
+      switch (opType) {
+        case BinaryOpType::ADD:
+          return TensorOperators::operate(v1, v2, ElementwiseOp::ADD);
+        case BinaryOpType::SUB:
+          return TensorOperators::operate(v1, v2, ElementwiseOp::SUB);
+        case BinaryOpType::MULT:
+          return TensorOperators::operate(v1, v2, ElementwiseOp::MULT);
+        case BinaryOpType::DIV:
+          return TensorOperators::operate(v1, v2, ElementwiseOp::DIV);
+        case BinaryOpType::POW:
+          return TensorOperators::operate(v1, v2, ElementwiseOp::POW);
+        case BinaryOpType::MOD:
+          return TensorOperators::operate(v1, v2, ElementwiseOp::MOD);
+        default:
+          return nullptr;
+      }
     } else if (v1->is_numeric() && v2->is_numeric()) {
       auto returnType = get_max_dataType(v1->get_dataType_enum(), v2->get_dataType_enum());
       switch (returnType) {
@@ -323,4 +402,56 @@ class BinaryOperators {
 
     return nullptr;
   }
+
+  /**
+   * @brief Resolves the name of a binary operation, so that it is not compared on every call
+   *
+   * @param opType Operation type string
+   * @return Resolved operation, BinaryOpType::UNKNOWN if the name is not a numeric operation
+   */
+  static BinaryOpType get_op_type(const std::string& opType) {
+    if (opType == "Add") {
+      return BinaryOpType::ADD;
+    } else if (opType == "Sub") {
+      return BinaryOpType::SUB;
+    } else if (opType == "Mult") {
+      return BinaryOpType::MULT;
+    } else if (opType == "Div") {
+      return BinaryOpType::DIV;
+    } else if (opType == "Pow") {
+      return BinaryOpType::POW;
+    } else if (opType == "Mod") {
+      return BinaryOpType::MOD;
+    }
+    return BinaryOpType::UNKNOWN;
+  }
+
+  /**
+   * @brief Performs binary operation on two unboxed numeric scalars without allocating
+   *
+   * Type promotion and errors are the same as in operate().
+   *
+   * @param v1 First operand
+   * @param v2 Second operand
+   * @param opType Resolved operation type
+   * @param result Set to the result of the operation
+   * @return false if the operands are not both numeric scalars or the operation is not supported,
+   * the caller should then fall back to operate() on the boxed operands
+   */
+  static bool operate_scalar(const Value& v1, const Value& v2, BinaryOpType opType,
+                             Value& result) {
+    if (!v1.is_numeric() || !v2.is_numeric()) {
+      return false;
+    }
+    switch (std::max(v1.tag(), v2.tag())) {
+      case Value::Tag::INT32:
+        return ScalarBinOp<int32_t>::compute(v1, v2, opType, result);
+      case Value::Tag::INT64:
+        return ScalarBinOp<int64_t>::compute(v1, v2, opType, result);
+      case Value::Tag::FLOAT:
+        return ScalarBinOp<float>::compute(v1, v2, opType, result);
+      default:
+        return ScalarBinOp<double>::compute(v1, v2, opType, result);
+    }
+  }
 };
@@ -5,12 +5,30 @@
  */
 
 #pragma once
+#include <algorithm>
+
 #include "data_variable.hpp"
 #include "operator_types.hpp"
 #include "single_variable.hpp"
+#include "tensor_operators.hpp"
+#include "value.hpp"
 
 typedef OpReturnType (*CompareFuncPtr)(OpReturnType, OpReturnType);
 
+/**
+ * @brief Comparison operation resolved from its name in the script
+ */
+enum class CompareOpType {
+  EQ,
+  NOT_EQ,
+  GT,
+  GTE,
+  LT,
+  LTE,
+  IN,
+  NOT_IN,
+};
+
 /**
  * @brief Template class for comparison operations
  *
@@ -41,6 +59,9 @@ class CompareOp {
 template <typename T>
 class EqualOp {
  public:
+  /** @brief Elementwise comparison used for tensors */
+  static constexpr ElementwiseOp elementwiseOp = ElementwiseOp::EQ;
+
   /**
    * @brief Compares two values for equality
    *
@@ -61,6 +82,9 @@ class EqualOp {
 template <typename T>
 class GreaterOp {
  public:
+  /** @brief Elementwise comparison used for tensors */
+  static constexpr ElementwiseOp elementwiseOp = ElementwiseOp::GT;
+
   /**
    * @brief Compares if first value is greater than second
    *
@@ -81,6 +105,9 @@ class GreaterOp {
 template <typename T>
 class GreaterEqualOp {
  public:
+  /** @brief Elementwise comparison used for tensors */
+  static constexpr ElementwiseOp elementwiseOp = ElementwiseOp::GTE;
+
   /**
    * @brief Compares if first value is greater than or equal to second
    *
@@ -101,6 +128,9 @@ class GreaterEqualOp {
 template <typename T>
 class LessThanOp {
  public:
+  /** @brief Elementwise comparison used for tensors */
+  static constexpr ElementwiseOp elementwiseOp = ElementwiseOp::LT;
+
   /**
    * @brief Compares if first value is less than second
    *
@@ -121,6 +151,9 @@ class LessThanOp {
 template <typename T>
 class LessThanEqualOp {
  public:
+  /** @brief Elementwise comparison used for tensors */
+  static constexpr ElementwiseOp elementwiseOp = ElementwiseOp::LTE;
+
   /**
    * @brief Compares if first value is less than or equal to second
    *
@@ -141,6 +174,9 @@ class LessThanEqualOp {
 template <typename T>
 class NotEqualOp {
  public:
+  /** @brief Elementwise comparison used for tensors */
+  static constexpr ElementwiseOp elementwiseOp = ElementwiseOp::NOT_EQ;
+
   /**
    * @brief Compares if two values are not equal
    *
@@ -161,13 +197,36 @@ class NotEqualOp {
  */
 class CompareOperators {
   static std::map<std::string, CompareFuncPtr> _compareOpMap;
+  static std::map<std::string, CompareOpType> _compareOpTypeMap;
 
  public:
+  /**
+   * @brief Compares two values of the same type, opType must not be a membership test
+   */
+  template <typename T>
+  static bool compare_single(T val1, T val2, CompareOpType opType) {
+    switch (opType) {
+      case CompareOpType::EQ:
+        return val1 == val2;
+      case CompareOpType::NOT_EQ:
+        return val1 != val2;
+      case CompareOpType::GT:
+        return val1 > val2;
+      case CompareOpType::GTE:
+        return val1 >= val2;
+      case CompareOpType::LT:
+        return val1 < val2;
+      default:
+        return val1 <= val2;
+    }
+  }
+
   /**
    * @brief Performs comparison operation between two operands
    *
    * Automatically handles type promotion for numeric comparisons and
    * routes to appropriate comparison implementation based on operand types.
+   * Numeric tensors are compared elementwise by TensorOperators into a boolean tensor.
    *
    * @tparam Oper The comparison operator template class
    * @param v1 First operand
@@ -176,7 +235,9 @@ class CompareOperators {
    */
   template <template <typename T> class Oper>
   static OpReturnType operate(OpReturnType v1, OpReturnType v2) {
-    if (v1->is_numeric() && v2->is_numeric()) {
+    if (TensorOperators::is_numeric_tensor(v1) || TensorOperators::is_numeric_tensor(v2)) {
+      return TensorOperators::operate(v1, v2, Oper<int32_t>::elementwiseOp);
+    } else if (v1->is_numeric() && v2->is_numeric()) {
       auto returnType = get_max_dataType(v1->get_dataType_enum(), v2->get_dataType_enum());
 
       switch (returnType) {
@@ -204,6 +265,51 @@ class CompareOperators {
    */
   static CompareFuncPtr get_operator(const std::string& opType);
 
+  /**
+   * @brief Gets the resolved comparison for the specified operation type
+   *
+   * @param opType String identifier for the comparison operation
+   * @return Resolved comparison operation
+   */
+  static CompareOpType get_op_type(const std::string& opType);
+
+  /**
+   * @brief Compares two unboxed numeric scalars without allocating
+   *
+   * Type promotion is the same as in operate().
+   *
+   * @param v1 First operand
+   * @param v2 Second operand
+   * @param opType Resolved comparison operation
+   * @param result Set to the boolean result of the comparison
+   * @return false if the operands are not both numeric scalars or the operation is a membership
+   * test, the caller should then fall back to the comparison function on the boxed operands
+   */
+  static bool compare_scalar(const Value& v1, const Value& v2, CompareOpType opType,
+                             Value& result) {
+    if (!v1.is_numeric() || !v2.is_numeric() || opType == CompareOpType::IN ||
+        opType == CompareOpType::NOT_IN) {
+      return false;
+    }
+    bool ret;
+    switch (std::max(v1.tag(), v2.tag())) {
+      case Value::Tag::INT32:
+        ret = compare_single(v1.get<int32_t>(), v2.get<int32_t>(), opType);
+        break;
+      case Value::Tag::INT64:
+        ret = compare_single(v1.get<int64_t>(), v2.get<int64_t>(), opType);
+        break;
+      case Value::Tag::FLOAT:
+        ret = compare_single(v1.get<float>(), v2.get<float>(), opType);
+        break;
+      default:
+        ret = compare_single(v1.get<double>(), v2.get<double>(), opType);
+        break;
+    }
+    result = Value(ret);
+    return true;
+  }
+
   /**
    * @brief Tests if first value is contained in second value
    *
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 
 #include "custom_func_data_variable.hpp"
 #include "range_data_variable.hpp"
@@ -14,6 +15,55 @@
 #include "single_variable.hpp"
 #include "variable_scope.hpp"
 
+/**
+ * @brief Running state of the builtin reductions sum(), min(), max(), len(), any() and all()
+ *
+ * Used by the builtins to reduce an iterable, and by CallNode to reduce the elements of a
+ * comprehension argument as they are produced, without evaluating the comprehension into a list.
+ * Sums of int and float scalars are accumulated unboxed.
+ */
+class Reduction {
+ public:
+  enum class Type { SUM, MIN, MAX, LEN, ANY, ALL };
+
+ private:
+  Type _type;
+  int64_t _count = 0;            /**< Number of elements added */
+  int64_t _intSum = 0;           /**< Sum while all elements are integers */
+  double _doubleSum = 0;         /**< Sum once an element is a floating point number */
+  bool _isDouble = false;        /**< Whether the sum is accumulated in _doubleSum */
+  OpReturnType _value = nullptr; /**< Sum of non scalar elements, or the min/max element */
+  bool _decided = false;         /**< Result of any()/all() if the iteration was stopped early */
+
+  const char* name() const;
+
+ public:
+  explicit Reduction(Type type) : _type(type) {}
+
+  /**
+   * @brief Adds an element to the reduction.
+   *
+   * @return false if the result is known and the remaining elements can be skipped.
+   */
+  bool add(const OpReturnType& element);
+
+  /**
+   * @brief Returns the result for the elements added so far.
+   * @throws Exception for min() and max() of no elements.
+   */
+  OpReturnType result() const;
+
+  /**
+   * @brief Reduces all elements of an iterable, e.g. a list, tuple, range or tensor.
+   */
+  static OpReturnType reduce(Type type, const OpReturnType& iterable);
+
+  /**
+   * @brief Returns the reduction implemented by function, if it is one of the builtins.
+   */
+  static std::optional<Type> get_type(const OpReturnType& function);
+};
+
 /**
  * @brief Collection of built-in functions and operators
  *
@@ -196,6 +246,78 @@ DELITEPY_DOC_BLOCK_END
     return OpReturnType(new SingleVariable<int32_t>(args[0]->get_size()));
   }
 
+/*
+DELITEPY_DOC_BLOCK_BEGIN
+- `sum()` function
+DELITEPY_DOC_BLOCK_END
+*/
+  /**
+   * @brief Returns the sum of the elements of an iterable, 0 if it is empty
+   *
+   * @param args Vector containing the iterable
+   * @param stack Current call stack (unused)
+   * @return Sum of the elements
+   */
+  static OpReturnType sum(const std::vector<OpReturnType>& args, CallStack& stack);
+
+/*
+DELITEPY_DOC_BLOCK_BEGIN
+- `min()` function
+DELITEPY_DOC_BLOCK_END
+*/
+  /**
+   * @brief Returns the smallest element of an iterable, or the smallest of multiple arguments
+   *
+   * @param args Vector containing the iterable, or at least two values to compare
+   * @param stack Current call stack (unused)
+   * @return The first smallest element
+   * @throws Exception if the iterable is empty
+   */
+  static OpReturnType min(const std::vector<OpReturnType>& args, CallStack& stack);
+
+/*
+DELITEPY_DOC_BLOCK_BEGIN
+- `max()` function
+DELITEPY_DOC_BLOCK_END
+*/
+  /**
+   * @brief Returns the largest element of an iterable, or the largest of multiple arguments
+   *
+   * @param args Vector containing the iterable, or at least two values to compare
+   * @param stack Current call stack (unused)
+   * @return The first largest element
+   * @throws Exception if the iterable is empty
+   */
+  static OpReturnType max(const std::vector<OpReturnType>& args, CallStack& stack);
+
+/*
+DELITEPY_DOC_BLOCK_BEGIN
+- `any()` function
+DELITEPY_DOC_BLOCK_END
+*/
+  /**
+   * @brief Returns true if any element of an iterable is truthy
+   *
+   * @param args Vector containing the iterable
+   * @param stack Current call stack (unused)
+   * @return Boolean result
+   */
+  static OpReturnType any(const std::vector<OpReturnType>& args, CallStack& stack);
+
+/*
+DELITEPY_DOC_BLOCK_BEGIN
+- `all()` function
+DELITEPY_DOC_BLOCK_END
+*/
+  /**
+   * @brief Returns true if all elements of an iterable are truthy
+   *
+   * @param args Vector containing the iterable
+   * @param stack Current call stack (unused)
+   * @return Boolean result
+   */
+  static OpReturnType all(const std::vector<OpReturnType>& args, CallStack& stack);
+
 /*
 DELITEPY_DOC_BLOCK_BEGIN
 - `Exception` class
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Elementwise operation computed by ElementwiseKernels
+ */
+enum class ElementwiseOp {
+  ADD,
+  SUB,
+  MULT,
+  DIV,
+  POW,
+  MOD,
+  MIN,
+  MAX,
+  EQ, /**< Comparisons, from here on the output is boolean */
+  NOT_EQ,
+  GT,
+  GTE,
+  LT,
+  LTE,
+};
+
+/**
+ * @brief Instruction set used by the vectorized loops of ElementwiseKernels
+ */
+enum class SimdLevel {
+  SCALAR,    /**< Plain loops, used when the compiler has no vector extensions */
+  VECTOR128, /**< 128 bit vectors, SSE2 on x86 and NEON on ARM */
+  AVX2,      /**< 256 bit vectors, selected at runtime on x86 CPUs supporting AVX2 */
+};
+
+/**
+ * @brief Vectorized elementwise kernels on contiguous buffers with NumPy style broadcasting
+ *
+ * Shapes are aligned on their last dimension, and a dimension of size 1 is repeated to match the
+ * other operand. Before looping, dimensions of size 1 are dropped and adjacent dimensions laid out
+ * contiguously in both operands are merged, so that the innermost loop runs over as many elements
+ * as possible. The innermost loop has vectorized versions for two arrays, an array and a repeated
+ * scalar, and a scalar and an array. ADD, SUB, MULT, DIV, MIN, MAX and the comparisons are
+ * vectorized, POW and MOD run the scalar loop.
+ *
+ * The vector width is picked once per process from the features of the CPU, see get_simd_level().
+ */
+class ElementwiseKernels {
+ public:
+  /**
+   * @brief Whether the operation outputs booleans
+   */
+  static bool is_comparison(ElementwiseOp op) noexcept { return op >= ElementwiseOp::EQ; }
+
+  /**
+   * @brief Shape of the result of broadcasting two shapes
+   * @throws std::runtime_error if the shapes cannot be broadcast together
+   */
+  static std::vector<int64_t> broadcast_shapes(const std::vector<int64_t>& shape1,
+                                               const std::vector<int64_t>& shape2);
+
+  /**
+   * @brief Computes op elementwise on two broadcast operands
+   *
+   * @tparam T Type of the operands, one of int32_t, int64_t, float and double
+   * @tparam Out T for arithmetic operations and bool for comparisons
+   * @param a Contiguous elements of the first operand
+   * @param shapeA Shape of the first operand, empty for a scalar
+   * @param b Contiguous elements of the second operand
+   * @param shapeB Shape of the second operand, empty for a scalar
+   * @param out Contiguous elements of the result, of shape broadcast_shapes(shapeA, shapeB)
+   * @throws std::runtime_error on division or modulo by zero, or if the shapes cannot be broadcast
+   */
+  template <typename T, typename Out>
+  static void compute(ElementwiseOp op, const T* a, const std::vector<int64_t>& shapeA, const T* b,
+                      const std::vector<int64_t>& shapeB, Out* out);
+
+  /**
+   * @brief Instruction set used by compute()
+   */
+  static SimdLevel get_simd_level() noexcept;
+
+  /**
+   * @brief Limits the instruction set used by compute(), levels not supported by the CPU are
+   * ignored. Meant for tests and benchmarks comparing the vectorized and scalar loops.
+   */
+  static void set_max_simd_level(SimdLevel level) noexcept;
+};
@@ -22,11 +22,22 @@
  * @return The data type with higher precedence
  */
 inline int get_max_dataType(int dataType1, int dataType2) {
-  std::map<int, int> _typeScore = {
-      {DATATYPE::BOOLEAN, 0}, {DATATYPE::INT32, 3},  {DATATYPE::INT64, 4},
-      {DATATYPE::FLOAT, 5},   {DATATYPE::DOUBLE, 6},
+  // Called for every arithmetic and comparison, so the score is looked up without allocating
+  auto typeScore = [](int dataType) {
+    switch (dataType) {
+      case DATATYPE::INT32:
+        return 3;
+      case DATATYPE::INT64:
+        return 4;
+      case DATATYPE::FLOAT:
+        return 5;
+      case DATATYPE::DOUBLE:
+        return 6;
+      default:
+        return 0;
+    }
   };
-  if (_typeScore[dataType1] < _typeScore[dataType2]) {
+  if (typeScore(dataType1) < typeScore(dataType2)) {
     return dataType2;
   } else
     return dataType1;
@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <vector>
+
+#ifndef MINIMAL_BUILD
+#include "thread_pool.hpp"
+#else   // MINIMAL_BUILD
+class ThreadPool;
+#endif  // MINIMAL_BUILD
+
+/**
+ * @brief Runs runTask for every task in [0, numTasks) on the pool and the calling thread
+ *
+ * Tasks are claimed one at a time, so that uneven tasks are balanced across the threads. Kernels
+ * keep their results independent of the threads by giving every task a fixed part of the work.
+ *
+ * @param pool Thread pool to run the tasks on, nullptr to run them on the calling thread
+ */
+inline void parallel_for(ThreadPool* pool, int64_t numTasks,
+                         const std::function<void(int64_t)>& runTask) {
+#ifndef MINIMAL_BUILD
+  if (pool != nullptr && numTasks > 1 && pool->num_workers() > 0) {
+    std::atomic<int64_t> nextTask = 0;
+    auto claimTasks = [&]() {
+      int64_t task;
+      while ((task = nextTask.fetch_add(1)) < numTasks) {
+        runTask(task);
+      }
+    };
+    std::vector<std::future<void>> workers;
+    const int64_t numWorkers = std::min<int64_t>(pool->num_workers(), numTasks - 1);
+    for (int64_t i = 0; i < numWorkers; i++) {
+      workers.emplace_back(pool->enqueue(claimTasks));
+    }
+    claimTasks();
+    for (auto& worker : workers) {
+      pool->join(worker);
+      worker.get();
+    }
+    return;
+  }
+#endif  // MINIMAL_BUILD
+  for (int64_t task = 0; task < numTasks; task++) {
+    runTask(task);
+  }
+}
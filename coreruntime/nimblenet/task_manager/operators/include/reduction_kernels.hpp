@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Reduction computed by ReductionKernels
+ */
+enum class ReduceOp {
+  SUM,
+  MIN,
+  MAX,
+};
+
+/**
+ * @brief Vectorized reductions of contiguous tensors along any set of axes
+ *
+ * Dimensions of size 1 are dropped and adjacent dimensions which are all reduced or all kept are
+ * merged, the reduced dimensions are then removed one at a time starting from the innermost:
+ * - A reduced innermost dimension is reduced along each contiguous row. Sums of rows are
+ *   pairwise, so that their rounding error grows with the logarithm of the row length.
+ * - A reduced dimension followed by kept ones is reduced by accumulating its rows into the output
+ *   with vectors running along the kept elements. Floating point sums use Kahan compensation.
+ *
+ * Reductions of at least ParallelMinElements elements are split across the threads of the pool
+ * given, over independent rows or blocks of columns, and over fixed chunks when everything is
+ * reduced to a single element. The results do not depend on the threads used.
+ *
+ * The vector width follows ElementwiseKernels::get_simd_level().
+ */
+class ReductionKernels {
+ public:
+  /** @brief Minimum number of elements of a reduction to split it across threads */
+  static constexpr int64_t ParallelMinElements = 1 << 18;
+
+  /**
+   * @brief Reduces in along the axes set in reduceAxes
+   *
+   * @tparam T One of int32_t, int64_t, float and double
+   * @param in Contiguous elements of the tensor
+   * @param shape Shape of the tensor
+   * @param reduceAxes For every dimension of shape, whether it is reduced
+   * @param out Contiguous elements of the result, of shape without the reduced dimensions
+   * @param pool Thread pool to split large reductions across, nullptr to run on the calling thread
+   * @throws std::runtime_error if MIN or MAX reduce zero elements into a non empty result
+   */
+  template <typename T>
+  static void reduce(ReduceOp op, const T* in, const std::vector<int64_t>& shape,
+                     const std::vector<bool>& reduceAxes, T* out, ThreadPool* pool);
+};
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Top k selection and argsort along an axis of contiguous tensors
+ *
+ * Elements are ordered by value and equal values by their position along the axis, so that the
+ * results are those of a stable sort. NaNs come after every number in ascending order and before
+ * them in descending order.
+ *
+ * The top k of a row keeps the k best elements seen in a heap when k is small compared to the row,
+ * most elements then cost a single comparison with the worst of the heap. Larger k find the k-th
+ * element with introselect in linear time, and only sort the k elements selected. Values are
+ * selected without building indices for the whole row.
+ *
+ * Operations on at least ParallelMinElements elements are split across the threads of the pool
+ * given, over rows, or over fixed chunks of a single row whose candidates are merged afterwards.
+ * The results do not depend on the threads used.
+ */
+class SelectionKernels {
+ public:
+  /** @brief Minimum number of elements of an operation to split it across threads */
+  static constexpr int64_t ParallelMinElements = 1 << 18;
+
+  /**
+   * @brief Selects the k first elements along an axis in ascending or descending order
+   *
+   * @tparam T One of uint8_t for booleans, int32_t, int64_t, float and double
+   * @param in Contiguous elements of the tensor
+   * @param shape Shape of the tensor
+   * @param axis Axis to select along, in [0, shape.size())
+   * @param k Number of elements to select, at most shape[axis]
+   * @param indices Positions along the axis of the elements selected, of shape with shape[axis]
+   * replaced by k. nullptr to only compute the values
+   * @param values Elements selected, of the same shape as indices. nullptr to only compute indices
+   * @param pool Thread pool to split large selections across, nullptr to run on the calling thread
+   */
+  template <typename T>
+  static void topk(const T* in, const std::vector<int64_t>& shape, int axis, int64_t k,
+                   bool descending, int32_t* indices, T* values, ThreadPool* pool);
+
+  /**
+   * @brief Positions along an axis of the elements in ascending or descending order
+   *
+   * @param indices Contiguous result, of the same shape as the tensor
+   */
+  template <typename T>
+  static void argsort(const T* in, const std::vector<int64_t>& shape, int axis, bool descending,
+                      int32_t* indices, ThreadPool* pool);
+};
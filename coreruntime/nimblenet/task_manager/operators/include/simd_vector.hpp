@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Portable vectors for the kernels of the operators, only meant to be included by their source
+ * files.
+ *
+ * GCC and Clang vector extensions are lowered to SSE/AVX on x86 and NEON on ARM, and to scalar
+ * code on targets without vector registers. Kernels are compiled once with 16 byte vectors and,
+ * on x86, once more with 32 byte vectors in functions with the avx2 target attribute, the kernel
+ * to run is picked from ElementwiseKernels::get_simd_level(). Without vector extensions only the
+ * scalar loops of the kernels are compiled.
+ */
+
+#if defined(__GNUC__)
+#define NE_VECTOR_EXTENSIONS
+#if defined(__x86_64__) || defined(__i386__)
+#define NE_VECTOR_AVX2
+#endif
+#endif
+
+#ifdef NE_VECTOR_EXTENSIONS
+#define NE_ALWAYS_INLINE inline __attribute__((always_inline))
+// 256 bit vectors are only returned from functions inlined into the AVX2 kernels
+#pragma GCC diagnostic ignored "-Wpsabi"
+#else
+#define NE_ALWAYS_INLINE inline
+#endif
+
+#ifdef NE_VECTOR_EXTENSIONS
+namespace simd {
+
+/**
+ * @brief Vector of Bytes bytes holding elements of type T
+ */
+template <typename T, int Bytes>
+struct VecTraits {
+  static constexpr int Lanes = Bytes / sizeof(T);
+  typedef T Vec __attribute__((vector_size(Bytes)));
+  typedef int8_t Bools __attribute__((vector_size(Lanes)));
+};
+
+// Loads and stores go through memcpy as the buffers are only aligned to their element type
+template <typename V, typename T>
+NE_ALWAYS_INLINE V load(const T* ptr) {
+  V v;
+  std::memcpy(&v, ptr, sizeof(V));
+  return v;
+}
+
+template <typename V, typename T>
+NE_ALWAYS_INLINE void store(T* ptr, const V& v) {
+  std::memcpy(ptr, &v, sizeof(V));
+}
+
+/**
+ * @brief Picks lanes of a where mask is set and lanes of b elsewhere
+ */
+template <typename V, typename M>
+NE_ALWAYS_INLINE V select(const M& mask, const V& a, const V& b) {
+  return (V)(((M)a & mask) | ((M)b & ~mask));
+}
+
+/**
+ * @brief Whether any lane of a mask of 16 bytes is set
+ */
+template <typename M>
+NE_ALWAYS_INLINE bool any(const M& mask) {
+  static_assert(sizeof(M) == 16, "any() takes masks of 16 bytes");
+  typedef int64_t Halves __attribute__((vector_size(16)));
+  const Halves halves = (Halves)mask;
+  return (halves[0] | halves[1]) != 0;
+}
+
+}  // namespace simd
+#endif  // NE_VECTOR_EXTENSIONS
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "data_variable.hpp"
+#include "elementwise_kernels.hpp"
+#include "reduction_kernels.hpp"
+
+/**
+ * @brief Reductions of a tensor computed by TensorOperators::reduce()
+ */
+enum class TensorReduction {
+  SUM,
+  MEAN,
+  MIN,
+  MAX,
+};
+
+/**
+ * @brief Elementwise arithmetic and comparisons on numeric tensors with NumPy style broadcasting
+ *
+ * Operands are tensors of booleans or numbers, and numeric or boolean scalars. The type of the
+ * result follows the promotion of get_max_dataType() between two tensors. A scalar combined with
+ * a tensor keeps the type of the tensor unless the scalar is of a wider kind (boolean, integer,
+ * floating point), e.g. a float tensor multiplied by a double stays a float tensor while an int32
+ * tensor multiplied by a double becomes a double tensor. An integer scalar which does not fit in
+ * an int32 tensor makes the result int64. Arithmetic on booleans is done on int32.
+ * Comparisons return a boolean tensor.
+ *
+ * The elements are computed by ElementwiseKernels, operands of another type than the result are
+ * converted to it first.
+ */
+class TensorOperators {
+ public:
+  /**
+   * @brief Whether the variable is a tensor of booleans or numbers, including empty tensors
+   */
+  static bool is_numeric_tensor(const OpReturnType& v);
+
+  /**
+   * @brief Computes op elementwise on two operands, at least one of them being a tensor
+   *
+   * @return Tensor holding the result, nullptr if an operand is neither a numeric tensor nor a
+   * numeric or boolean scalar
+   * @throws std::runtime_error if the shapes cannot be broadcast together, or on division or
+   * modulo by zero
+   */
+  static OpReturnType operate(const OpReturnType& v1, const OpReturnType& v2, ElementwiseOp op);
+
+  /**
+   * @brief Reduces a numeric tensor along some of its axes, like the NumPy function of that name
+   *
+   * Booleans are reduced as int32, so their sum is an int32 while their minimum and maximum are
+   * booleans. The sum, minimum and maximum of other tensors keep the type of the tensor. The mean
+   * along axes of a float tensor is a float tensor, other means are doubles. Reducing every axis
+   * without keepDims returns a single variable instead of a tensor. The minimum and maximum of a
+   * string tensor are supported over all its elements only.
+   *
+   * @param axis None to reduce every axis, else an axis or a list or tuple of axes, negative axes
+   * counting from the end
+   * @param keepDims Whether the reduced axes are kept in the result with size 1
+   * @param pool Thread pool to split large reductions across, nullptr to run on the calling thread
+   * @throws std::runtime_error if tensor is not a numeric tensor, or a string tensor reduced by
+   * minimum or maximum without axis, if an axis is out of bounds or repeated, or for the minimum
+   * or maximum of zero elements
+   */
+  static OpReturnType reduce(TensorReduction reduction, const OpReturnType& tensor,
+                             const OpReturnType& axis, bool keepDims, ThreadPool* pool);
+};
@@ -7,6 +7,7 @@
 #pragma once
 #include "data_variable.hpp"
 #include "single_variable.hpp"
+#include "value.hpp"
 
 typedef OpReturnType (*UnaryOpFuncPtr)(OpReturnType);
 
@@ -51,4 +52,39 @@ class UnaryOperators {
    * @return Result of unary subtraction operation
    */
   static OpReturnType unary_sub(OpReturnType v) { return v->unary_sub(); }
+
+  /**
+   * @brief Performs a unary operation on an unboxed scalar without allocating
+   *
+   * @param v Operand
+   * @param func Unary operation, as returned by get_operator()
+   * @param result Set to the result of the operation
+   * @return false if the operation cannot be done on the unboxed operand, the caller should then
+   * fall back to func on the boxed operand
+   */
+  static bool operate_scalar(const Value& v, UnaryOpFuncPtr func, Value& result) {
+    if (func == inverse_bool && v.is_scalar()) {
+      result = Value(!v.get_bool());
+      return true;
+    }
+    if (func != unary_sub) {
+      return false;
+    }
+    switch (v.tag()) {
+      case Value::Tag::INT32:
+        result = Value(int32_t(-v.get<int32_t>()));
+        return true;
+      case Value::Tag::INT64:
+        result = Value(int64_t(-v.get<int64_t>()));
+        return true;
+      case Value::Tag::FLOAT:
+        result = Value(-v.get<float>());
+        return true;
+      case Value::Tag::DOUBLE:
+        result = Value(-v.get<double>());
+        return true;
+      default:
+        return false;
+    }
+  }
 };
@@ -17,9 +17,27 @@ std::map<std::string, CompareFuncPtr> CompareOperators::_compareOpMap = {
     {"NotIn", CompareOperators::notIn},
 };
 
+std::map<std::string, CompareOpType> CompareOperators::_compareOpTypeMap = {
+    {"Eq", CompareOpType::EQ},
+    {"Gt", CompareOpType::GT},
+    {"GtE", CompareOpType::GTE},
+    {"Lt", CompareOpType::LT},
+    {"LtE", CompareOpType::LTE},
+    {"In", CompareOpType::IN},
+    {"NotEq", CompareOpType::NOT_EQ},
+    {"NotIn", CompareOpType::NOT_IN},
+};
+
 CompareFuncPtr CompareOperators::get_operator(const std::string& opType) {
   if (_compareOpMap.find(opType) == _compareOpMap.end()) {
     THROW("compareOp=%s not found", opType.c_str());
   }
   return _compareOpMap[opType];
 }
+
+CompareOpType CompareOperators::get_op_type(const std::string& opType) {
+  if (_compareOpTypeMap.find(opType) == _compareOpTypeMap.end()) {
+    THROW("compareOp=%s not found", opType.c_str());
+  }
+  return _compareOpTypeMap[opType];
+}
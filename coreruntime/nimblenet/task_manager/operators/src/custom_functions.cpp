@@ -6,6 +6,8 @@
 
 #include "custom_functions.hpp"
 
+#include "binary_operators.hpp"
+#include "compare_operators.hpp"
 #include "exception_data_variable.hpp"
 #include "statements.hpp"
 
@@ -18,12 +20,233 @@ std::map<std::string, CustomFuncPtr> CustomFunctions::_customFuncMap = {
     {"bool", CustomFunctions::cast_bool},
     {"int", CustomFunctions::cast_int},
     {"len", CustomFunctions::len},
+    {"sum", CustomFunctions::sum},
+    {"min", CustomFunctions::min},
+    {"max", CustomFunctions::max},
+    {"any", CustomFunctions::any},
+    {"all", CustomFunctions::all},
     {"concurrent", CustomFunctions::concurrent},
     {"add_event", CustomFunctions::add_event},
     {"pre_add_event", CustomFunctions::pre_add_event_hook},
     {"Exception", CustomFunctions::create_exception},
 };
 
+const char* Reduction::name() const {
+  switch (_type) {
+    case Type::SUM:
+      return "sum";
+    case Type::MIN:
+      return "min";
+    case Type::MAX:
+      return "max";
+    case Type::LEN:
+      return "len";
+    case Type::ANY:
+      return "any";
+    case Type::ALL:
+      return "all";
+  }
+  return "";
+}
+
+static bool is_scalar(const OpReturnType& d) {
+  return d->get_containerType() == CONTAINERTYPE::SINGLE;
+}
+
+static bool is_integer_scalar(const OpReturnType& d) {
+  return is_scalar(d) && (d->get_dataType_enum() == DATATYPE::INT32 ||
+                          d->get_dataType_enum() == DATATYPE::INT64 ||
+                          d->get_dataType_enum() == DATATYPE::BOOLEAN);
+}
+
+static bool is_floating_scalar(const OpReturnType& d) {
+  return is_scalar(d) && (d->get_dataType_enum() == DATATYPE::FLOAT ||
+                          d->get_dataType_enum() == DATATYPE::DOUBLE);
+}
+
+// Returns true if v1 < v2, comparing numeric scalars without the generic operators
+static bool less_than(const OpReturnType& v1, const OpReturnType& v2) {
+  if (is_integer_scalar(v1) && is_integer_scalar(v2)) {
+    return v1->get_int64() < v2->get_int64();
+  }
+  if ((is_integer_scalar(v1) || is_floating_scalar(v1)) &&
+      (is_integer_scalar(v2) || is_floating_scalar(v2))) {
+    return v1->get_double() < v2->get_double();
+  }
+  auto ret = CompareOperators::operate<LessThanOp>(v1, v2);
+  if (ret == nullptr) {
+    THROW("'<' not supported between instances of %s(%s) and %s(%s)",
+          v1->get_containerType_string(), util::get_string_from_enum(v1->get_dataType_enum()),
+          v2->get_containerType_string(), util::get_string_from_enum(v2->get_dataType_enum()));
+  }
+  return ret->get_bool();
+}
+
+bool Reduction::add(const OpReturnType& element) {
+  _count++;
+  switch (_type) {
+    case Type::SUM: {
+      if (_value == nullptr && is_integer_scalar(element)) {
+        if (_isDouble) {
+          _doubleSum += element->get_int64();
+        } else {
+          _intSum += element->get_int64();
+        }
+        return true;
+      }
+      if (_value == nullptr && is_floating_scalar(element)) {
+        if (!_isDouble) {
+          _doubleSum = _intSum;
+          _isDouble = true;
+        }
+        _doubleSum += element->get_double();
+        return true;
+      }
+      if (element->is_string()) {
+        THROW("%s", "sum() can't sum strings, use str.join() instead");
+      }
+      // Tensors and other types are added with the generic operators, starting from the sum of
+      // the scalars before them
+      auto sum = BinaryOperators::operate(_value == nullptr ? result() : _value, element,
+                                          BinaryOpType::ADD);
+      if (sum == nullptr) {
+        THROW("sum() can't add %s(%s) to the sum of the previous elements",
+              element->get_containerType_string(),
+              util::get_string_from_enum(element->get_dataType_enum()));
+      }
+      _value = sum;
+      return true;
+    }
+    case Type::MIN:
+      if (_value == nullptr || less_than(element, _value)) {
+        _value = element;
+      }
+      return true;
+    case Type::MAX:
+      if (_value == nullptr || less_than(_value, element)) {
+        _value = element;
+      }
+      return true;
+    case Type::LEN:
+      return true;
+    case Type::ANY:
+      if (element->get_bool()) {
+        _decided = true;
+        return false;
+      }
+      return true;
+    case Type::ALL:
+      if (!element->get_bool()) {
+        _decided = true;
+        return false;
+      }
+      return true;
+  }
+  return true;
+}
+
+OpReturnType Reduction::result() const {
+  switch (_type) {
+    case Type::SUM:
+      if (_value != nullptr) {
+        return _value;
+      }
+      if (_isDouble) {
+        return OpReturnType(new SingleVariable<double>(_doubleSum));
+      }
+      return OpReturnType(new SingleVariable<int64_t>(_intSum));
+    case Type::MIN:
+    case Type::MAX:
+      if (_value == nullptr) {
+        THROW("%s() arg is an empty sequence", name());
+      }
+      return _value;
+    case Type::LEN:
+      // Same type as the len() of a list
+      return OpReturnType(new SingleVariable<int32_t>(_count));
+    case Type::ANY:
+      return OpReturnType(new SingleVariable<bool>(_decided));
+    case Type::ALL:
+      return OpReturnType(new SingleVariable<bool>(!_decided));
+  }
+  return OpReturnType(new NoneVariable());
+}
+
+OpReturnType Reduction::reduce(Type type, const OpReturnType& iterable) {
+  Reduction reduction(type);
+  int size = iterable->get_size();
+  for (int i = 0; i < size; i++) {
+    if (!reduction.add(iterable->get_int_subscript(i))) {
+      break;
+    }
+  }
+  return reduction.result();
+}
+
+std::optional<Reduction::Type> Reduction::get_type(const OpReturnType& function) {
+  auto customFunction = dynamic_cast<const CustomFuncDataVariable*>(function.get());
+  if (customFunction == nullptr) {
+    return std::nullopt;
+  }
+  auto ptr = customFunction->get_function_pointer();
+  if (ptr == CustomFunctions::sum) return Type::SUM;
+  if (ptr == CustomFunctions::min) return Type::MIN;
+  if (ptr == CustomFunctions::max) return Type::MAX;
+  if (ptr == CustomFunctions::len) return Type::LEN;
+  if (ptr == CustomFunctions::any) return Type::ANY;
+  if (ptr == CustomFunctions::all) return Type::ALL;
+  return std::nullopt;
+}
+
+OpReturnType CustomFunctions::sum(const std::vector<OpReturnType>& args, CallStack& stack) {
+  if (args.size() != 1) {
+    THROW("sum expects a single argument, provided %d.", args.size());
+  }
+  return Reduction::reduce(Reduction::Type::SUM, args[0]);
+}
+
+OpReturnType CustomFunctions::min(const std::vector<OpReturnType>& args, CallStack& stack) {
+  if (args.empty()) {
+    THROW("%s", "min expects at least one argument, provided 0.");
+  }
+  if (args.size() == 1) {
+    return Reduction::reduce(Reduction::Type::MIN, args[0]);
+  }
+  Reduction reduction(Reduction::Type::MIN);
+  for (const auto& arg : args) {
+    reduction.add(arg);
+  }
+  return reduction.result();
+}
+
+OpReturnType CustomFunctions::max(const std::vector<OpReturnType>& args, CallStack& stack) {
+  if (args.empty()) {
+    THROW("%s", "max expects at least one argument, provided 0.");
+  }
+  if (args.size() == 1) {
+    return Reduction::reduce(Reduction::Type::MAX, args[0]);
+  }
+  Reduction reduction(Reduction::Type::MAX);
+  for (const auto& arg : args) {
+    reduction.add(arg);
+  }
+  return reduction.result();
+}
+
+OpReturnType CustomFunctions::any(const std::vector<OpReturnType>& args, CallStack& stack) {
+  if (args.size() != 1) {
+    THROW("any expects a single argument, provided %d.", args.size());
+  }
+  return Reduction::reduce(Reduction::Type::ANY, args[0]);
+}
+
+OpReturnType CustomFunctions::all(const std::vector<OpReturnType>& args, CallStack& stack) {
+  if (args.size() != 1) {
+    THROW("all expects a single argument, provided %d.", args.size());
+  }
+  return Reduction::reduce(Reduction::Type::ALL, args[0]);
+}
+
 OpReturnType CustomFunctions::concurrent(const std::vector<OpReturnType>& arguments,
                                          CallStack& stack) {
   if (arguments.size() != 1)
@@ -65,6 +288,8 @@ OpReturnType CustomFunctions::pre_add_event_hook(const std::vector<OpReturnType>
     }
 
     auto commandCenter = stack.command_center();
+    // The hook runs on the threads calling add_event
+    arguments[0]->mark_shared();
     commandCenter->get_userEventsManager().add_pre_event_hook(arguments[0], std::move(types));
     return arguments[0];
   };
@@ -79,6 +304,8 @@ OpReturnType CustomFunctions::add_event(const std::vector<OpReturnType>& rawStor
     if (arguments.size() != 1)
       THROW("decorator function args should have size 1 given %d.", arguments.size());
     auto functionDataVariable = arguments[0];
+    // The hook runs on the threads calling add_event
+    functionDataVariable->mark_shared();
     for (auto& rawStoreDataVar : rawStoreDataVariables) {
       if (rawStoreDataVar->get_dataType_enum() != DATATYPE::RAW_EVENTS_STORE) {
         THROW("RawEventStore required for add_event decorator dataType=%s given",
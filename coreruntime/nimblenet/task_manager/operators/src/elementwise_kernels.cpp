@@ -0,0 +1,426 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "elementwise_kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include "binary_operators.hpp"
+#include "core_utils/fmt.hpp"
+#include "simd_vector.hpp"
+
+namespace {
+
+/*
+ * Operations of the kernels, scalar() computes one element and vec() a vector of elements.
+ * Comparisons return a mask from vec() with all the bits of a lane set where the comparison holds.
+ */
+
+template <typename T>
+struct AddOp {
+  static constexpr bool Vectorized = true;
+
+  template <typename V>
+  static NE_ALWAYS_INLINE V vec(const V& a, const V& b) {
+    return a + b;
+  }
+
+  static NE_ALWAYS_INLINE T scalar(T a, T b) { return a + b; }
+};
+
+template <typename T>
+struct SubOp {
+  static constexpr bool Vectorized = true;
+
+  template <typename V>
+  static NE_ALWAYS_INLINE V vec(const V& a, const V& b) {
+    return a - b;
+  }
+
+  static NE_ALWAYS_INLINE T scalar(T a, T b) { return a - b; }
+};
+
+template <typename T>
+struct MultOp {
+  static constexpr bool Vectorized = true;
+
+  template <typename V>
+  static NE_ALWAYS_INLINE V vec(const V& a, const V& b) {
+    return a * b;
+  }
+
+  static NE_ALWAYS_INLINE T scalar(T a, T b) { return a * b; }
+};
+
+template <typename T>
+struct DivOp {
+  // There is no vector integer division on either x86 or ARM
+  static constexpr bool Vectorized = std::is_floating_point_v<T>;
+
+  template <typename V>
+  static NE_ALWAYS_INLINE V vec(const V& a, const V& b) {
+    return a / b;
+  }
+
+  static NE_ALWAYS_INLINE T scalar(T a, T b) { return a / b; }
+};
+
+template <typename T>
+struct PowOp {
+  static constexpr bool Vectorized = false;
+
+  static NE_ALWAYS_INLINE T scalar(T a, T b) { return T(std::pow(a, b)); }
+};
+
+template <typename T>
+struct ModOp {
+  static constexpr bool Vectorized = false;
+
+  static NE_ALWAYS_INLINE T scalar(T a, T b) { return ModOperator<T>::compute(a, b); }
+};
+
+template <typename T>
+struct MinOp {
+  static constexpr bool Vectorized = true;
+
+  template <typename V>
+  static NE_ALWAYS_INLINE V vec(const V& a, const V& b) {
+    return simd::select(a < b, a, b);
+  }
+
+  static NE_ALWAYS_INLINE T scalar(T a, T b) { return a < b ? a : b; }
+};
+
+template <typename T>
+struct MaxOp {
+  static constexpr bool Vectorized = true;
+
+  template <typename V>
+  static NE_ALWAYS_INLINE V vec(const V& a, const V& b) {
+    return simd::select(a > b, a, b);
+  }
+
+  static NE_ALWAYS_INLINE T scalar(T a, T b) { return a > b ? a : b; }
+};
+
+#define NE_COMPARE_OP(name, oper)                                      \
+  template <typename T>                                                \
+  struct name {                                                        \
+    static constexpr bool Vectorized = true;                           \
+                                                                       \
+    template <typename V>                                              \
+    static NE_ALWAYS_INLINE auto vec(const V& a, const V& b) {         \
+      return a oper b;                                                 \
+    }                                                                  \
+                                                                       \
+    static NE_ALWAYS_INLINE bool scalar(T a, T b) { return a oper b; } \
+  };
+
+NE_COMPARE_OP(EqOp, ==)
+NE_COMPARE_OP(NotEqOp, !=)
+NE_COMPARE_OP(GtOp, >)
+NE_COMPARE_OP(GtEOp, >=)
+NE_COMPARE_OP(LtOp, <)
+NE_COMPARE_OP(LtEOp, <=)
+
+#undef NE_COMPARE_OP
+
+/**
+ * @brief Innermost loop over n elements of the output
+ *
+ * @tparam Bytes Width of the vectors, 0 for the scalar loop only
+ * @tparam ScalarA Whether a is a single element repeated over the loop, b likewise
+ */
+template <typename Op, typename T, typename Out, int Bytes, bool ScalarA, bool ScalarB>
+NE_ALWAYS_INLINE void inner_loop(const T* a, const T* b, Out* out, int64_t n) {
+  int64_t i = 0;
+#ifdef NE_VECTOR_EXTENSIONS
+  if constexpr (Bytes > 0 && Op::Vectorized) {
+    using Traits = simd::VecTraits<T, Bytes>;
+    using V = typename Traits::Vec;
+    constexpr int Lanes = Traits::Lanes;
+    V repeatedA{}, repeatedB{};
+    if constexpr (ScalarA) repeatedA = V{} + *a;
+    if constexpr (ScalarB) repeatedB = V{} + *b;
+    for (; i + Lanes <= n; i += Lanes) {
+      V x, y;
+      if constexpr (ScalarA) {
+        x = repeatedA;
+      } else {
+        x = simd::load<V>(a + i);
+      }
+      if constexpr (ScalarB) {
+        y = repeatedB;
+      } else {
+        y = simd::load<V>(b + i);
+      }
+      auto result = Op::vec(x, y);
+      if constexpr (std::is_same_v<Out, bool>) {
+        // Narrow the all ones lanes of the mask to bytes holding 0 or 1
+        typename Traits::Bools bools = __builtin_convertvector(result, typename Traits::Bools) & 1;
+        std::memcpy(out + i, &bools, Lanes);
+      } else {
+        simd::store(out + i, result);
+      }
+    }
+  }
+#endif  // NE_VECTOR_EXTENSIONS
+  for (; i < n; i++) {
+    out[i] = Op::scalar(ScalarA ? *a : a[i], ScalarB ? *b : b[i]);
+  }
+}
+
+template <typename T, typename Out>
+using KernelFn = void (*)(const T* a, const T* b, Out* out, int64_t n);
+
+template <typename Op, typename T, typename Out, bool ScalarA, bool ScalarB>
+void kernel_scalar(const T* a, const T* b, Out* out, int64_t n) {
+  inner_loop<Op, T, Out, 0, ScalarA, ScalarB>(a, b, out, n);
+}
+
+#ifdef NE_VECTOR_EXTENSIONS
+template <typename Op, typename T, typename Out, bool ScalarA, bool ScalarB>
+void kernel_vector128(const T* a, const T* b, Out* out, int64_t n) {
+  inner_loop<Op, T, Out, 16, ScalarA, ScalarB>(a, b, out, n);
+}
+#endif  // NE_VECTOR_EXTENSIONS
+
+#ifdef NE_VECTOR_AVX2
+template <typename Op, typename T, typename Out, bool ScalarA, bool ScalarB>
+__attribute__((target("avx2"))) void kernel_avx2(const T* a, const T* b, Out* out, int64_t n) {
+  inner_loop<Op, T, Out, 32, ScalarA, ScalarB>(a, b, out, n);
+}
+#endif  // NE_VECTOR_AVX2
+
+template <typename Op, typename T, typename Out, bool ScalarA, bool ScalarB>
+KernelFn<T, Out> get_kernel(SimdLevel level) {
+  switch (level) {
+#ifdef NE_VECTOR_AVX2
+    case SimdLevel::AVX2:
+      return kernel_avx2<Op, T, Out, ScalarA, ScalarB>;
+#endif
+#ifdef NE_VECTOR_EXTENSIONS
+    case SimdLevel::VECTOR128:
+      return kernel_vector128<Op, T, Out, ScalarA, ScalarB>;
+#endif
+    default:
+      return kernel_scalar<Op, T, Out, ScalarA, ScalarB>;
+  }
+}
+
+template <typename Op, typename T, typename Out>
+KernelFn<T, Out> get_kernel(SimdLevel level, bool scalarA, bool scalarB) {
+  if (scalarA) {
+    return scalarB ? get_kernel<Op, T, Out, true, true>(level)
+                   : get_kernel<Op, T, Out, true, false>(level);
+  }
+  return scalarB ? get_kernel<Op, T, Out, false, true>(level)
+                 : get_kernel<Op, T, Out, false, false>(level);
+}
+
+SimdLevel detect_simd_level() {
+#ifdef NE_VECTOR_AVX2
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+#endif
+#ifdef NE_VECTOR_EXTENSIONS
+  return SimdLevel::VECTOR128;
+#else
+  return SimdLevel::SCALAR;
+#endif
+}
+
+std::atomic<SimdLevel> maxSimdLevel{SimdLevel::AVX2};
+
+/**
+ * @brief Dimensions of a broadcast operation after merging, innermost first
+ */
+struct BroadcastLoops {
+  std::vector<int64_t> dims;
+  std::vector<int64_t> stridesA; /**< 0 where a is repeated */
+  std::vector<int64_t> stridesB;
+  int64_t numElements = 1;
+};
+
+BroadcastLoops get_broadcast_loops(const std::vector<int64_t>& outShape,
+                                   const std::vector<int64_t>& shapeA,
+                                   const std::vector<int64_t>& shapeB) {
+  BroadcastLoops loops;
+  int64_t strideA = 1, strideB = 1;
+  const int outDims = outShape.size();
+  for (int d = outDims - 1; d >= 0; d--) {
+    const int dA = d - (outDims - (int)shapeA.size());
+    const int dB = d - (outDims - (int)shapeB.size());
+    const int64_t dimA = dA >= 0 ? shapeA[dA] : 1;
+    const int64_t dimB = dB >= 0 ? shapeB[dB] : 1;
+    const int64_t dim = outShape[d];
+    loops.numElements *= dim;
+    if (dim == 1) {
+      continue;
+    }
+    const int64_t sA = dimA == 1 ? 0 : strideA;
+    const int64_t sB = dimB == 1 ? 0 : strideB;
+    // Merge with the inner dimension if both operands continue it without a jump
+    if (!loops.dims.empty() && sA == loops.stridesA.back() * loops.dims.back() &&
+        sB == loops.stridesB.back() * loops.dims.back()) {
+      loops.dims.back() *= dim;
+    } else {
+      loops.dims.push_back(dim);
+      loops.stridesA.push_back(sA);
+      loops.stridesB.push_back(sB);
+    }
+    strideA *= dimA;
+    strideB *= dimB;
+  }
+  if (loops.dims.empty()) {
+    // All the dimensions are 1, a single element
+    loops.dims.push_back(1);
+    loops.stridesA.push_back(0);
+    loops.stridesB.push_back(0);
+  }
+  return loops;
+}
+
+template <typename Op, typename T, typename Out>
+void run_loops(const BroadcastLoops& loops, const T* a, const T* b, Out* out) {
+  // The innermost stride is 1, or 0 for a repeated operand, as the operands are contiguous
+  const int64_t inner = loops.dims[0];
+  const auto kernel = get_kernel<Op, T, Out>(ElementwiseKernels::get_simd_level(),
+                                             loops.stridesA[0] == 0, loops.stridesB[0] == 0);
+  const int numOuterDims = loops.dims.size() - 1;
+  std::vector<int64_t> index(numOuterDims, 0);
+  int64_t offsetA = 0, offsetB = 0;
+  for (int64_t outOffset = 0; outOffset < loops.numElements; outOffset += inner) {
+    kernel(a + offsetA, b + offsetB, out + outOffset, inner);
+    for (int k = 0; k < numOuterDims; k++) {
+      offsetA += loops.stridesA[k + 1];
+      offsetB += loops.stridesB[k + 1];
+      if (++index[k] < loops.dims[k + 1]) {
+        break;
+      }
+      offsetA -= loops.stridesA[k + 1] * loops.dims[k + 1];
+      offsetB -= loops.stridesB[k + 1] * loops.dims[k + 1];
+      index[k] = 0;
+    }
+  }
+}
+
+}  // namespace
+
+std::vector<int64_t> ElementwiseKernels::broadcast_shapes(const std::vector<int64_t>& shape1,
+                                                          const std::vector<int64_t>& shape2) {
+  const auto& longer = shape1.size() >= shape2.size() ? shape1 : shape2;
+  const auto& shorter = shape1.size() >= shape2.size() ? shape2 : shape1;
+  std::vector<int64_t> shape = longer;
+  const int offset = longer.size() - shorter.size();
+  for (int i = 0; i < (int)shorter.size(); i++) {
+    const int64_t dim = shorter[i];
+    int64_t& outDim = shape[i + offset];
+    if (dim == outDim || dim == 1) {
+      continue;
+    }
+    if (outDim != 1) {
+      THROW("operands could not be broadcast together, dimension %d from the end has size %lld "
+            "and %lld",
+            (int)(shorter.size() - i), (long long)outDim, (long long)dim);
+    }
+    outDim = dim;
+  }
+  return shape;
+}
+
+template <typename T, typename Out>
+void ElementwiseKernels::compute(ElementwiseOp op, const T* a, const std::vector<int64_t>& shapeA,
+                                 const T* b, const std::vector<int64_t>& shapeB, Out* out) {
+  const auto loops = get_broadcast_loops(broadcast_shapes(shapeA, shapeB), shapeA, shapeB);
+  if (loops.numElements == 0) {
+    return;
+  }
+
+  if (op == ElementwiseOp::DIV || op == ElementwiseOp::MOD) {
+    int64_t numElementsB = 1;
+    for (auto dim : shapeB) {
+      numElementsB *= dim;
+    }
+    if (std::find(b, b + numElementsB, T(0)) != b + numElementsB) {
+      if (op == ElementwiseOp::DIV) {
+        THROW("%s", "Division by zero will result in undefined behaviour.");
+      }
+      THROW("%s", "Modulo by zero error.");
+    }
+  }
+
+  if constexpr (std::is_same_v<Out, bool>) {
+    switch (op) {
+      case ElementwiseOp::EQ:
+        return run_loops<EqOp<T>>(loops, a, b, out);
+      case ElementwiseOp::NOT_EQ:
+        return run_loops<NotEqOp<T>>(loops, a, b, out);
+      case ElementwiseOp::GT:
+        return run_loops<GtOp<T>>(loops, a, b, out);
+      case ElementwiseOp::GTE:
+        return run_loops<GtEOp<T>>(loops, a, b, out);
+      case ElementwiseOp::LT:
+        return run_loops<LtOp<T>>(loops, a, b, out);
+      case ElementwiseOp::LTE:
+        return run_loops<LtEOp<T>>(loops, a, b, out);
+      default:
+        break;
+    }
+  } else {
+    switch (op) {
+      case ElementwiseOp::ADD:
+        return run_loops<AddOp<T>>(loops, a, b, out);
+      case ElementwiseOp::SUB:
+        return run_loops<SubOp<T>>(loops, a, b, out);
+      case ElementwiseOp::MULT:
+        return run_loops<MultOp<T>>(loops, a, b, out);
+      case ElementwiseOp::DIV:
+        return run_loops<DivOp<T>>(loops, a, b, out);
+      case ElementwiseOp::POW:
+        return run_loops<PowOp<T>>(loops, a, b, out);
+      case ElementwiseOp::MOD:
+        return run_loops<ModOp<T>>(loops, a, b, out);
+      case ElementwiseOp::MIN:
+        return run_loops<MinOp<T>>(loops, a, b, out);
+      case ElementwiseOp::MAX:
+        return run_loops<MaxOp<T>>(loops, a, b, out);
+      default:
+        break;
+    }
+  }
+  THROW("elementwise operation %d does not output %s", (int)op,
+        std::is_same_v<Out, bool> ? "booleans" : "numbers");
+}
+
+SimdLevel ElementwiseKernels::get_simd_level() noexcept {
+  static const SimdLevel supportedLevel = detect_simd_level();
+  return std::min(supportedLevel, maxSimdLevel.load(std::memory_order_relaxed));
+}
+
+void ElementwiseKernels::set_max_simd_level(SimdLevel level) noexcept {
+  maxSimdLevel.store(level, std::memory_order_relaxed);
+}
+
+#define INSTANTIATE_ELEMENTWISE_KERNELS(T)                                                     \
+  template void ElementwiseKernels::compute<T, T>(ElementwiseOp, const T*,                     \
+                                                  const std::vector<int64_t>&, const T*,       \
+                                                  const std::vector<int64_t>&, T*);            \
+  template void ElementwiseKernels::compute<T, bool>(ElementwiseOp, const T*,                  \
+                                                     const std::vector<int64_t>&, const T*,    \
+                                                     const std::vector<int64_t>&, bool*);
+
+INSTANTIATE_ELEMENTWISE_KERNELS(int32_t)
+INSTANTIATE_ELEMENTWISE_KERNELS(int64_t)
+INSTANTIATE_ELEMENTWISE_KERNELS(float)
+INSTANTIATE_ELEMENTWISE_KERNELS(double)
+
+#undef INSTANTIATE_ELEMENTWISE_KERNELS
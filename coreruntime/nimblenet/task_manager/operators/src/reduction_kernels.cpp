@@ -0,0 +1,354 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "reduction_kernels.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "core_utils/fmt.hpp"
+#include "elementwise_kernels.hpp"
+#include "parallel_for.hpp"
+#include "simd_vector.hpp"
+
+namespace {
+
+constexpr int64_t PairwiseBlock = 256;      /**< Elements summed by a single pass of accumulators */
+constexpr int64_t ChunkElements = 1 << 16;  /**< Elements of a task reducing contiguous rows */
+constexpr int64_t ColumnBlock = 1024;       /**< Kept elements of a task accumulating rows */
+
+template <ReduceOp Op, typename T>
+NE_ALWAYS_INLINE T combine(T a, T b) {
+  if constexpr (Op == ReduceOp::SUM) {
+    return a + b;
+  } else if constexpr (Op == ReduceOp::MIN) {
+    return a < b ? a : b;
+  } else {
+    return a > b ? a : b;
+  }
+}
+
+/**
+ * @brief Adds x to sum, carrying the low order bits lost by the addition in compensation
+ */
+template <typename V>
+NE_ALWAYS_INLINE void kahan_add(V& sum, V& compensation, const V& x) {
+  V y = x - compensation;
+  V t = sum + y;
+  compensation = (t - sum) - y;
+  sum = t;
+}
+
+#ifdef NE_VECTOR_EXTENSIONS
+template <ReduceOp Op, typename V>
+NE_ALWAYS_INLINE V combine_vec(const V& a, const V& b) {
+  if constexpr (Op == ReduceOp::SUM) {
+    return a + b;
+  } else if constexpr (Op == ReduceOp::MIN) {
+    return simd::select(a < b, a, b);
+  } else {
+    return simd::select(a > b, a, b);
+  }
+}
+#endif  // NE_VECTOR_EXTENSIONS
+
+/**
+ * @brief Reduces n > 0 contiguous elements from left to right, in as many lanes as possible
+ */
+template <ReduceOp Op, typename T, int Bytes>
+NE_ALWAYS_INLINE T reduce_block(const T* in, int64_t n) {
+#ifdef NE_VECTOR_EXTENSIONS
+  if constexpr (Bytes > 0) {
+    using V = typename simd::VecTraits<T, Bytes>::Vec;
+    constexpr int Lanes = simd::VecTraits<T, Bytes>::Lanes;
+    if (n >= 4 * Lanes) {
+      // Independent accumulators, so that a vector does not wait for the previous one
+      V acc0 = simd::load<V>(in);
+      V acc1 = simd::load<V>(in + Lanes);
+      V acc2 = simd::load<V>(in + 2 * Lanes);
+      V acc3 = simd::load<V>(in + 3 * Lanes);
+      int64_t i = 4 * Lanes;
+      for (; i + 4 * Lanes <= n; i += 4 * Lanes) {
+        acc0 = combine_vec<Op>(acc0, simd::load<V>(in + i));
+        acc1 = combine_vec<Op>(acc1, simd::load<V>(in + i + Lanes));
+        acc2 = combine_vec<Op>(acc2, simd::load<V>(in + i + 2 * Lanes));
+        acc3 = combine_vec<Op>(acc3, simd::load<V>(in + i + 3 * Lanes));
+      }
+      V acc = combine_vec<Op>(combine_vec<Op>(acc0, acc1), combine_vec<Op>(acc2, acc3));
+      T result = acc[0];
+      for (int lane = 1; lane < Lanes; lane++) {
+        result = combine<Op>(result, acc[lane]);
+      }
+      for (; i < n; i++) {
+        result = combine<Op>(result, in[i]);
+      }
+      return result;
+    }
+  }
+#endif  // NE_VECTOR_EXTENSIONS
+  T result = in[0];
+  for (int64_t i = 1; i < n; i++) {
+    result = combine<Op>(result, in[i]);
+  }
+  return result;
+}
+
+/**
+ * @brief Reduces n > 0 contiguous elements by halves down to blocks of PairwiseBlock elements
+ */
+template <ReduceOp Op, typename T, int Bytes>
+T reduce_contiguous(const T* in, int64_t n) {
+  if (n <= PairwiseBlock) {
+    return reduce_block<Op, T, Bytes>(in, n);
+  }
+  const int64_t half = std::max(PairwiseBlock, n / 2 / PairwiseBlock * PairwiseBlock);
+  return combine<Op>(reduce_contiguous<Op, T, Bytes>(in, half),
+                     reduce_contiguous<Op, T, Bytes>(in + half, n - half));
+}
+
+/**
+ * @brief Reduces numRows > 0 rows of rowSize elements into out, for the elements [begin, end)
+ */
+template <ReduceOp Op, typename T, int Bytes>
+NE_ALWAYS_INLINE void accumulate_rows(const T* in, int64_t numRows, int64_t rowSize,
+                                      int64_t begin, int64_t end, T* out) {
+  constexpr bool Compensated = Op == ReduceOp::SUM && std::is_floating_point_v<T>;
+  int64_t j = begin;
+#ifdef NE_VECTOR_EXTENSIONS
+  if constexpr (Bytes > 0) {
+    using V = typename simd::VecTraits<T, Bytes>::Vec;
+    constexpr int Lanes = simd::VecTraits<T, Bytes>::Lanes;
+    // A few vectors per pass over the rows, so that every row is read a cache line at a time
+    constexpr int Unroll = 4;
+    for (; j + Unroll * Lanes <= end; j += Unroll * Lanes) {
+      V acc[Unroll], compensation[Unroll];
+      for (int u = 0; u < Unroll; u++) {
+        acc[u] = simd::load<V>(in + j + u * Lanes);
+        compensation[u] = V{};
+      }
+      for (int64_t r = 1; r < numRows; r++) {
+        const T* row = in + r * rowSize + j;
+        for (int u = 0; u < Unroll; u++) {
+          if constexpr (Compensated) {
+            kahan_add(acc[u], compensation[u], simd::load<V>(row + u * Lanes));
+          } else {
+            acc[u] = combine_vec<Op>(acc[u], simd::load<V>(row + u * Lanes));
+          }
+        }
+      }
+      for (int u = 0; u < Unroll; u++) {
+        simd::store(out + j + u * Lanes, acc[u]);
+      }
+    }
+    for (; j + Lanes <= end; j += Lanes) {
+      V acc = simd::load<V>(in + j), compensation{};
+      for (int64_t r = 1; r < numRows; r++) {
+        if constexpr (Compensated) {
+          kahan_add(acc, compensation, simd::load<V>(in + r * rowSize + j));
+        } else {
+          acc = combine_vec<Op>(acc, simd::load<V>(in + r * rowSize + j));
+        }
+      }
+      simd::store(out + j, acc);
+    }
+  }
+#endif  // NE_VECTOR_EXTENSIONS
+  for (; j < end; j++) {
+    T acc = in[j], compensation{};
+    for (int64_t r = 1; r < numRows; r++) {
+      if constexpr (Compensated) {
+        kahan_add(acc, compensation, in[r * rowSize + j]);
+      } else {
+        acc = combine<Op>(acc, in[r * rowSize + j]);
+      }
+    }
+    out[j] = acc;
+  }
+}
+
+template <ReduceOp Op, typename T, int Bytes>
+void accumulate_rows_generic(const T* in, int64_t numRows, int64_t rowSize, int64_t begin,
+                             int64_t end, T* out) {
+  accumulate_rows<Op, T, Bytes>(in, numRows, rowSize, begin, end, out);
+}
+
+#ifdef NE_VECTOR_AVX2
+template <ReduceOp Op, typename T>
+__attribute__((target("avx2"))) T reduce_contiguous_avx2(const T* in, int64_t n) {
+  if (n <= PairwiseBlock) {
+    return reduce_block<Op, T, 32>(in, n);
+  }
+  const int64_t half = std::max(PairwiseBlock, n / 2 / PairwiseBlock * PairwiseBlock);
+  return combine<Op>(reduce_contiguous_avx2<Op, T>(in, half),
+                     reduce_contiguous_avx2<Op, T>(in + half, n - half));
+}
+
+template <ReduceOp Op, typename T>
+__attribute__((target("avx2"))) void accumulate_rows_avx2(const T* in, int64_t numRows,
+                                                          int64_t rowSize, int64_t begin,
+                                                          int64_t end, T* out) {
+  accumulate_rows<Op, T, 32>(in, numRows, rowSize, begin, end, out);
+}
+#endif  // NE_VECTOR_AVX2
+
+template <typename T>
+struct RowKernels {
+  T (*reduceContiguous)(const T* in, int64_t n);
+  void (*accumulateRows)(const T* in, int64_t numRows, int64_t rowSize, int64_t begin,
+                         int64_t end, T* out);
+};
+
+template <ReduceOp Op, typename T>
+RowKernels<T> get_kernels(SimdLevel level) {
+  switch (level) {
+#ifdef NE_VECTOR_AVX2
+    case SimdLevel::AVX2:
+      return {reduce_contiguous_avx2<Op, T>, accumulate_rows_avx2<Op, T>};
+#endif
+#ifdef NE_VECTOR_EXTENSIONS
+    case SimdLevel::VECTOR128:
+      return {reduce_contiguous<Op, T, 16>, accumulate_rows_generic<Op, T, 16>};
+#endif
+    default:
+      return {reduce_contiguous<Op, T, 0>, accumulate_rows_generic<Op, T, 0>};
+  }
+}
+
+/**
+ * @brief Removes the reduced groups of dimensions one at a time, innermost first
+ *
+ * @param sizes Sizes of the merged dimensions, all larger than 1
+ * @param reduced Whether each merged dimension is reduced, consecutive ones differ
+ */
+template <ReduceOp Op, typename T>
+void reduce_groups(const T* in, std::vector<int64_t> sizes, std::vector<bool> reduced, T* out,
+                   ThreadPool* pool) {
+  const auto kernels = get_kernels<Op, T>(ElementwiseKernels::get_simd_level());
+  int numReduced = std::count(reduced.begin(), reduced.end(), true);
+  int64_t numElements = 1;
+  for (auto size : sizes) {
+    numElements *= size;
+  }
+
+  std::vector<T> buffers[2];
+  const T* src = in;
+  for (int step = 0; numReduced > 0; step++) {
+    ThreadPool* stepPool = numElements >= ReductionKernels::ParallelMinElements ? pool : nullptr;
+    const int last = sizes.size() - 1;
+    const int64_t rowSize = sizes[last];
+    const int64_t dstElements =
+        reduced[last] ? numElements / rowSize : numElements / sizes[last - 1];
+    T* dst = out;
+    if (numReduced > 1) {
+      buffers[step % 2].resize(dstElements);
+      dst = buffers[step % 2].data();
+    }
+
+    if (reduced[last]) {
+      const int64_t numRows = dstElements;
+      if (numRows == 1 && rowSize > ChunkElements) {
+        // Fixed chunks, so that the result does not depend on the number of threads
+        const int64_t numChunks = (rowSize + ChunkElements - 1) / ChunkElements;
+        std::vector<T> partials(numChunks);
+        parallel_for(stepPool, numChunks, [&](int64_t chunk) {
+          const int64_t begin = chunk * ChunkElements;
+          partials[chunk] =
+              kernels.reduceContiguous(src + begin, std::min(ChunkElements, rowSize - begin));
+        });
+        *dst = kernels.reduceContiguous(partials.data(), numChunks);
+      } else {
+        const int64_t rowsPerTask = std::max<int64_t>(1, ChunkElements / rowSize);
+        parallel_for(stepPool, (numRows + rowsPerTask - 1) / rowsPerTask, [&](int64_t task) {
+          const int64_t end = std::min(numRows, (task + 1) * rowsPerTask);
+          for (int64_t row = task * rowsPerTask; row < end; row++) {
+            dst[row] = kernels.reduceContiguous(src + row * rowSize, rowSize);
+          }
+        });
+      }
+      sizes.pop_back();
+      reduced.pop_back();
+    } else {
+      const int64_t numRows = sizes[last - 1];
+      const int64_t numOuter = dstElements / rowSize;
+      const int64_t numColumnBlocks = (rowSize + ColumnBlock - 1) / ColumnBlock;
+      parallel_for(stepPool, numOuter * numColumnBlocks, [&](int64_t task) {
+        const int64_t outer = task / numColumnBlocks;
+        const int64_t begin = task % numColumnBlocks * ColumnBlock;
+        kernels.accumulateRows(src + outer * numRows * rowSize, numRows, rowSize, begin,
+                               std::min(begin + ColumnBlock, rowSize), dst + outer * rowSize);
+      });
+      sizes.erase(sizes.begin() + last - 1);
+      reduced.erase(reduced.begin() + last - 1);
+      // The kept dimensions around the removed one are now adjacent
+      if (sizes.size() > 1) {
+        sizes[sizes.size() - 2] *= sizes.back();
+        sizes.pop_back();
+        reduced.pop_back();
+      }
+    }
+    src = dst;
+    numElements = dstElements;
+    numReduced--;
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void ReductionKernels::reduce(ReduceOp op, const T* in, const std::vector<int64_t>& shape,
+                              const std::vector<bool>& reduceAxes, T* out, ThreadPool* pool) {
+  std::vector<int64_t> sizes;
+  std::vector<bool> reduced;
+  int64_t numOut = 1, numReducedElements = 1;
+  for (int d = 0; d < (int)shape.size(); d++) {
+    (reduceAxes[d] ? numReducedElements : numOut) *= shape[d];
+    if (shape[d] == 1) {
+      continue;
+    }
+    if (!sizes.empty() && reduced.back() == reduceAxes[d]) {
+      sizes.back() *= shape[d];
+    } else {
+      sizes.push_back(shape[d]);
+      reduced.push_back(reduceAxes[d]);
+    }
+  }
+
+  if (numOut == 0) {
+    return;
+  }
+  if (numReducedElements == 0) {
+    if (op != ReduceOp::SUM) {
+      THROW("%s", "Expected a non-empty tensor");
+    }
+    std::fill(out, out + numOut, T(0));
+    return;
+  }
+  if (std::find(reduced.begin(), reduced.end(), true) == reduced.end()) {
+    // Only dimensions of size 1 are reduced
+    std::copy(in, in + numOut, out);
+    return;
+  }
+
+  switch (op) {
+    case ReduceOp::SUM:
+      return reduce_groups<ReduceOp::SUM>(in, std::move(sizes), std::move(reduced), out, pool);
+    case ReduceOp::MIN:
+      return reduce_groups<ReduceOp::MIN>(in, std::move(sizes), std::move(reduced), out, pool);
+    case ReduceOp::MAX:
+      return reduce_groups<ReduceOp::MAX>(in, std::move(sizes), std::move(reduced), out, pool);
+  }
+}
+
+#define INSTANTIATE_REDUCTION_KERNELS(T)                                                         \
+  template void ReductionKernels::reduce<T>(ReduceOp, const T*, const std::vector<int64_t>&,     \
+                                            const std::vector<bool>&, T*, ThreadPool*);
+
+INSTANTIATE_REDUCTION_KERNELS(int32_t)
+INSTANTIATE_REDUCTION_KERNELS(int64_t)
+INSTANTIATE_REDUCTION_KERNELS(float)
+INSTANTIATE_REDUCTION_KERNELS(double)
+
+#undef INSTANTIATE_REDUCTION_KERNELS
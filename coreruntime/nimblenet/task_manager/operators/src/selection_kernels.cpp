@@ -0,0 +1,342 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "selection_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "parallel_for.hpp"
+#include "simd_vector.hpp"
+
+namespace {
+
+constexpr int64_t ChunkElements = 1 << 14; /**< Elements of a task, or of a chunk of one row */
+constexpr int64_t HeapRatio = 64;          /**< Minimum ratio of the row length to k for a heap */
+constexpr int64_t HeapBlock = 64;          /**< Elements compared to the heap after a skip */
+
+template <typename T>
+struct Entry {
+  T value;
+  int32_t index;
+};
+
+template <typename T>
+bool key_less(T a, T b) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return a < b || (std::isnan(b) && !std::isnan(a));
+  } else {
+    return a < b;
+  }
+}
+
+/**
+ * @brief Whether an element comes before another one, entries of equal values by their index
+ */
+template <typename T, bool Descending>
+struct Before {
+  bool operator()(T a, T b) const { return Descending ? key_less(b, a) : key_less(a, b); }
+
+  bool operator()(const Entry<T>& a, const Entry<T>& b) const {
+    if ((*this)(a.value, b.value)) return true;
+    if ((*this)(b.value, a.value)) return false;
+    return a.index < b.index;
+  }
+};
+
+/**
+ * @brief Rows along an axis, of size elements inner elements apart
+ */
+struct Rows {
+  int64_t numRows = 1;
+  int64_t size;
+  int64_t inner = 1;
+
+  Rows(const std::vector<int64_t>& shape, int axis) : size(shape[axis]) {
+    for (int d = 0; d < (int)shape.size(); d++) {
+      if (d != axis) numRows *= shape[d];
+      if (d > axis) inner *= shape[d];
+    }
+  }
+
+  /**
+   * @brief Offset of the first element of a row in a tensor of length elements along the axis
+   */
+  int64_t offset(int64_t row, int64_t length) const {
+    return row / inner * length * inner + row % inner;
+  }
+};
+
+template <typename T>
+const T* get_row(const T* in, const Rows& rows, int64_t row, std::vector<T>& buffer) {
+  const T* start = in + rows.offset(row, rows.size);
+  if (rows.inner == 1) {
+    return start;
+  }
+  buffer.resize(rows.size);
+  for (int64_t j = 0; j < rows.size; j++) {
+    buffer[j] = start[j * rows.inner];
+  }
+  return buffer.data();
+}
+
+/**
+ * @brief Replaces the top of a heap with entry, which comes before it, and restores the heap
+ */
+template <typename T, bool Descending>
+void replace_top(Entry<T>* heap, int64_t size, const Entry<T>& entry) {
+  const Before<T, Descending> before;
+  int64_t hole = 0;
+  while (true) {
+    int64_t child = 2 * hole + 1;
+    if (child >= size) break;
+    if (child + 1 < size && before(heap[child], heap[child + 1])) child++;
+    if (!before(entry, heap[child])) break;
+    heap[hole] = heap[child];
+    hole = child;
+  }
+  heap[hole] = entry;
+}
+
+/**
+ * @brief Skips the blocks of elements from i which all come after threshold
+ *
+ * @return Start of the first block which may hold an element coming before threshold, or of the
+ * last elements left which are fewer than a block
+ */
+template <typename T, bool Descending>
+int64_t skip_blocks(const T* row, int64_t i, int64_t n, T threshold) {
+#ifdef NE_VECTOR_EXTENSIONS
+  using V = typename simd::VecTraits<T, 16>::Vec;
+  constexpr int Lanes = simd::VecTraits<T, 16>::Lanes;
+  const V thresholds = V{} + threshold;
+  // Negated comparisons keep NaNs, which are compared exactly by the caller
+  auto mayComeBefore = [&](const T* ptr) {
+    const V v = simd::load<V>(ptr);
+    if constexpr (Descending) {
+      return ~(v <= thresholds);
+    } else {
+      return ~(v >= thresholds);
+    }
+  };
+  for (; i + 4 * Lanes <= n; i += 4 * Lanes) {
+    if (simd::any(mayComeBefore(row + i) | mayComeBefore(row + i + Lanes) |
+                  mayComeBefore(row + i + 2 * Lanes) | mayComeBefore(row + i + 3 * Lanes))) {
+      break;
+    }
+  }
+#endif  // NE_VECTOR_EXTENSIONS
+  return i;
+}
+
+/**
+ * @brief Writes the 0 < k <= n entries of a contiguous row coming first to out, in order
+ *
+ * @param firstIndex Index of the first element of the row, added to the indices of the entries
+ */
+template <typename T, bool Descending>
+void select_entries(const T* row, int64_t n, int64_t k, int64_t firstIndex, Entry<T>* out,
+                    std::vector<T>& scratch) {
+  const Before<T, Descending> before;
+  if (k * HeapRatio <= n) {
+    // out is a heap of the k entries coming first so far, with the last of them on top
+    for (int64_t i = 0; i < k; i++) {
+      out[i] = {row[i], int32_t(firstIndex + i)};
+    }
+    std::make_heap(out, out + k, before);
+    for (int64_t i = k; i < n;) {
+      i = skip_blocks<T, Descending>(row, i, n, out[0].value);
+      for (const int64_t end = std::min(n, i + HeapBlock); i < end; i++) {
+        // Ties come after the entry on top, which has a lower index
+        if (before(row[i], out[0].value)) {
+          replace_top<T, Descending>(out, k, {row[i], int32_t(firstIndex + i)});
+        }
+      }
+    }
+    std::sort_heap(out, out + k, before);
+    return;
+  }
+
+  // The k-th value, then the values coming before it and its first ties in the order of the row
+  scratch.assign(row, row + n);
+  std::nth_element(scratch.begin(), scratch.begin() + k - 1, scratch.end(), before);
+  const T pivot = scratch[k - 1];
+  int64_t numTies = k - std::count_if(scratch.begin(), scratch.begin() + k - 1,
+                                      [&](T value) { return before(value, pivot); });
+  int64_t numSelected = 0;
+  for (int64_t i = 0; numSelected < k; i++) {
+    bool selected = before(row[i], pivot);
+    if (!selected && numTies > 0 && !before(pivot, row[i])) {
+      selected = true;
+      numTies--;
+    }
+    if (selected) {
+      out[numSelected++] = {row[i], int32_t(firstIndex + i)};
+    }
+  }
+  std::sort(out, out + k, before);
+}
+
+/**
+ * @brief Writes the 0 < k <= n values of a contiguous row coming first to the front of scratch
+ */
+template <typename T, bool Descending>
+void select_values(const T* row, int64_t n, int64_t k, std::vector<T>& scratch) {
+  const Before<T, Descending> before;
+  scratch.assign(row, row + n);
+  std::nth_element(scratch.begin(), scratch.begin() + k - 1, scratch.end(), before);
+  std::sort(scratch.begin(), scratch.begin() + k, before);
+}
+
+template <typename T>
+void write_entries(const Entry<T>* entries, int64_t k, int64_t offset, int64_t stride,
+                   int32_t* indices, T* values) {
+  for (int64_t t = 0; t < k; t++) {
+    if (indices != nullptr) indices[offset + t * stride] = entries[t].index;
+    if (values != nullptr) values[offset + t * stride] = entries[t].value;
+  }
+}
+
+template <typename T, bool Descending>
+void topk_rows(const T* in, const Rows& rows, int64_t k, int32_t* indices, T* values,
+               ThreadPool* pool) {
+  const Before<T, Descending> before;
+  const int64_t n = rows.size;
+  if (pool != nullptr && rows.numRows == 1 && n >= SelectionKernels::ParallelMinElements &&
+      k * 8 <= ChunkElements) {
+    // Top k of fixed chunks, so that the candidates do not depend on the number of threads
+    const int64_t numChunks = (n + ChunkElements - 1) / ChunkElements;
+    std::vector<Entry<T>> candidates(numChunks * k);
+    parallel_for(pool, numChunks, [&](int64_t chunk) {
+      const int64_t begin = chunk * ChunkElements;
+      const int64_t length = std::min(ChunkElements, n - begin);
+      std::vector<T> scratch;
+      select_entries<T, Descending>(in + begin, length, std::min(k, length), begin,
+                                    candidates.data() + chunk * k, scratch);
+    });
+    // Only the last chunk can be shorter than k
+    const int64_t lastLength = n - (numChunks - 1) * ChunkElements;
+    candidates.resize((numChunks - 1) * k + std::min(k, lastLength));
+    std::nth_element(candidates.begin(), candidates.begin() + k - 1, candidates.end(), before);
+    std::sort(candidates.begin(), candidates.begin() + k, before);
+    write_entries(candidates.data(), k, 0, 1, indices, values);
+    return;
+  }
+
+  const int64_t rowsPerTask = std::max<int64_t>(1, ChunkElements / n);
+  ThreadPool* taskPool =
+      rows.numRows * n >= SelectionKernels::ParallelMinElements ? pool : nullptr;
+  parallel_for(taskPool, (rows.numRows + rowsPerTask - 1) / rowsPerTask, [&](int64_t task) {
+    std::vector<T> rowBuffer, scratch;
+    std::vector<Entry<T>> selected(k);
+    const int64_t end = std::min(rows.numRows, (task + 1) * rowsPerTask);
+    for (int64_t r = task * rowsPerTask; r < end; r++) {
+      const T* row = get_row(in, rows, r, rowBuffer);
+      const int64_t outOffset = rows.offset(r, k);
+      if (indices == nullptr && k * HeapRatio > n) {
+        select_values<T, Descending>(row, n, k, scratch);
+        for (int64_t t = 0; t < k; t++) {
+          values[outOffset + t * rows.inner] = scratch[t];
+        }
+        continue;
+      }
+      select_entries<T, Descending>(row, n, k, 0, selected.data(), scratch);
+      write_entries(selected.data(), k, outOffset, rows.inner, indices, values);
+    }
+  });
+}
+
+template <typename T, bool Descending>
+void argsort_rows(const T* in, const Rows& rows, int32_t* indices, ThreadPool* pool) {
+  const Before<T, Descending> before;
+  const int64_t n = rows.size;
+  if (pool != nullptr && rows.numRows == 1 && n >= SelectionKernels::ParallelMinElements) {
+    // Sorts fixed chunks, then merges runs of doubling length
+    std::vector<Entry<T>> entries(n), merged(n);
+    for (int64_t j = 0; j < n; j++) {
+      entries[j] = {in[j], int32_t(j)};
+    }
+    parallel_for(pool, (n + ChunkElements - 1) / ChunkElements, [&](int64_t chunk) {
+      const int64_t begin = chunk * ChunkElements;
+      std::sort(entries.begin() + begin, entries.begin() + std::min(n, begin + ChunkElements),
+                before);
+    });
+    for (int64_t width = ChunkElements; width < n; width *= 2) {
+      parallel_for(pool, (n + 2 * width - 1) / (2 * width), [&](int64_t merge) {
+        const int64_t begin = merge * 2 * width;
+        const int64_t middle = std::min(n, begin + width);
+        const int64_t end = std::min(n, begin + 2 * width);
+        std::merge(entries.begin() + begin, entries.begin() + middle, entries.begin() + middle,
+                   entries.begin() + end, merged.begin() + begin, before);
+      });
+      entries.swap(merged);
+    }
+    write_entries<T>(entries.data(), n, 0, 1, indices, nullptr);
+    return;
+  }
+
+  const int64_t rowsPerTask = std::max<int64_t>(1, ChunkElements / n);
+  ThreadPool* taskPool =
+      rows.numRows * n >= SelectionKernels::ParallelMinElements ? pool : nullptr;
+  parallel_for(taskPool, (rows.numRows + rowsPerTask - 1) / rowsPerTask, [&](int64_t task) {
+    std::vector<T> rowBuffer;
+    std::vector<Entry<T>> entries(n);
+    const int64_t end = std::min(rows.numRows, (task + 1) * rowsPerTask);
+    for (int64_t r = task * rowsPerTask; r < end; r++) {
+      const T* row = get_row(in, rows, r, rowBuffer);
+      for (int64_t j = 0; j < n; j++) {
+        entries[j] = {row[j], int32_t(j)};
+      }
+      std::sort(entries.begin(), entries.end(), before);
+      write_entries<T>(entries.data(), n, rows.offset(r, n), rows.inner, indices, nullptr);
+    }
+  });
+}
+
+}  // namespace
+
+template <typename T>
+void SelectionKernels::topk(const T* in, const std::vector<int64_t>& shape, int axis, int64_t k,
+                            bool descending, int32_t* indices, T* values, ThreadPool* pool) {
+  const Rows rows(shape, axis);
+  if (k == 0 || rows.numRows == 0) {
+    return;
+  }
+  if (descending) {
+    topk_rows<T, true>(in, rows, k, indices, values, pool);
+  } else {
+    topk_rows<T, false>(in, rows, k, indices, values, pool);
+  }
+}
+
+template <typename T>
+void SelectionKernels::argsort(const T* in, const std::vector<int64_t>& shape, int axis,
+                               bool descending, int32_t* indices, ThreadPool* pool) {
+  const Rows rows(shape, axis);
+  if (rows.size == 0 || rows.numRows == 0) {
+    return;
+  }
+  if (descending) {
+    argsort_rows<T, true>(in, rows, indices, pool);
+  } else {
+    argsort_rows<T, false>(in, rows, indices, pool);
+  }
+}
+
+#define INSTANTIATE_SELECTION_KERNELS(T)                                                      \
+  template void SelectionKernels::topk<T>(const T*, const std::vector<int64_t>&, int, int64_t, \
+                                          bool, int32_t*, T*, ThreadPool*);                   \
+  template void SelectionKernels::argsort<T>(const T*, const std::vector<int64_t>&, int, bool, \
+                                             int32_t*, ThreadPool*);
+
+INSTANTIATE_SELECTION_KERNELS(uint8_t)
+INSTANTIATE_SELECTION_KERNELS(int32_t)
+INSTANTIATE_SELECTION_KERNELS(int64_t)
+INSTANTIATE_SELECTION_KERNELS(float)
+INSTANTIATE_SELECTION_KERNELS(double)
+
+#undef INSTANTIATE_SELECTION_KERNELS
@@ -0,0 +1,354 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensor_operators.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "operator_types.hpp"
+#include "single_variable.hpp"
+
+namespace {
+
+bool is_elementwise_dataType(int dataType) {
+  switch (dataType) {
+    case DATATYPE::BOOLEAN:
+    case DATATYPE::INT32:
+    case DATATYPE::INT64:
+    case DATATYPE::FLOAT:
+    case DATATYPE::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Boolean, integer and floating point kinds, scalars of a kind not wider than the one of a
+ * tensor do not change its type
+ */
+int get_kind(int dataType) {
+  switch (dataType) {
+    case DATATYPE::BOOLEAN:
+      return 0;
+    case DATATYPE::INT32:
+    case DATATYPE::INT64:
+      return 1;
+    default:
+      return 2;
+  }
+}
+
+/**
+ * @brief Type of an elementwise operation of a tensor and a scalar. The tensor keeps its type unless
+ * the scalar is of a wider kind, or is an integer which does not fit in an int32 tensor, in which
+ * case the result is promoted to int64 instead of wrapping around.
+ */
+int get_tensor_scalar_dataType(int tensorDataType, const OpReturnType& scalar) {
+  const int scalarDataType = scalar->get_dataType_enum();
+  if (get_kind(scalarDataType) > get_kind(tensorDataType)) {
+    return get_max_dataType(tensorDataType, scalarDataType);
+  }
+  if (tensorDataType == DATATYPE::INT32 && scalarDataType == DATATYPE::INT64) {
+    const auto value = scalar->get_int64();
+    if (value < std::numeric_limits<int32_t>::min() ||
+        value > std::numeric_limits<int32_t>::max()) {
+      return DATATYPE::INT64;
+    }
+  }
+  return tensorDataType;
+}
+
+template <typename T, typename Src>
+void convert_elements(const OpReturnType& v, std::vector<T>& buffer) {
+  const Src* src = static_cast<const Src*>(v->get_raw_ptr());
+  std::transform(src, src + buffer.size(), buffer.begin(), [](Src s) { return static_cast<T>(s); });
+}
+
+/**
+ * @brief Contiguous elements of an operand as T, converted into buffer if needed
+ */
+template <typename T>
+const T* get_elements(const OpReturnType& v, bool isTensor, std::vector<T>& buffer) {
+  if (!isTensor) {
+    buffer.assign(1, v->get<T>());
+    return buffer.data();
+  }
+  if (v->get_dataType_enum() == get_dataType_enum<T>()) {
+    return static_cast<const T*>(v->get_raw_ptr());
+  }
+  buffer.resize(v->get_numElements());
+  if (buffer.empty()) {
+    return buffer.data();
+  }
+  switch (v->get_dataType_enum()) {
+    case DATATYPE::BOOLEAN:
+      convert_elements<T, bool>(v, buffer);
+      break;
+    case DATATYPE::INT32:
+      convert_elements<T, int32_t>(v, buffer);
+      break;
+    case DATATYPE::INT64:
+      convert_elements<T, int64_t>(v, buffer);
+      break;
+    case DATATYPE::FLOAT:
+      convert_elements<T, float>(v, buffer);
+      break;
+    case DATATYPE::DOUBLE:
+      convert_elements<T, double>(v, buffer);
+      break;
+  }
+  return buffer.data();
+}
+
+template <typename T>
+OpReturnType compute(const OpReturnType& v1, bool isTensor1, const OpReturnType& v2,
+                     bool isTensor2, ElementwiseOp op) {
+  static const std::vector<int64_t> scalarShape;
+  const auto& shape1 = isTensor1 ? v1->get_shape() : scalarShape;
+  const auto& shape2 = isTensor2 ? v2->get_shape() : scalarShape;
+  const bool comparison = ElementwiseKernels::is_comparison(op);
+  auto result = DataVariable::create_tensor(
+      comparison ? DATATYPE::BOOLEAN : get_dataType_enum<T>(),
+      ElementwiseKernels::broadcast_shapes(shape1, shape2));
+  if (result->get_numElements() == 0) {
+    return result;
+  }
+
+  std::vector<T> buffer1, buffer2;
+  const T* elements1 = get_elements<T>(v1, isTensor1, buffer1);
+  const T* elements2 = get_elements<T>(v2, isTensor2, buffer2);
+  if (comparison) {
+    ElementwiseKernels::compute<T, bool>(op, elements1, shape1, elements2, shape2,
+                                         static_cast<bool*>(result->get_raw_ptr()));
+  } else {
+    ElementwiseKernels::compute<T, T>(op, elements1, shape1, elements2, shape2,
+                                      static_cast<T*>(result->get_raw_ptr()));
+  }
+  return result;
+}
+
+const char* get_reduction_name(TensorReduction reduction) {
+  switch (reduction) {
+    case TensorReduction::SUM:
+      return "sum";
+    case TensorReduction::MEAN:
+      return "mean";
+    case TensorReduction::MIN:
+      return "min";
+    case TensorReduction::MAX:
+      return "max";
+  }
+  return "reduction";
+}
+
+/**
+ * @brief For every dimension of a tensor, whether the axis argument of a reduction selects it
+ */
+std::vector<bool> get_reduce_axes(const char* name, const OpReturnType& axis, int numDims) {
+  const bool allAxes = axis == nullptr || axis->is_none();
+  std::vector<bool> reduceAxes(numDims, allAxes);
+  if (allAxes) {
+    return reduceAxes;
+  }
+
+  auto addAxis = [&](const OpReturnType& axisVariable) {
+    if (!axisVariable->is_single() || !axisVariable->is_integer()) {
+      THROW("%s expects integer axes, got %s[%s]", name,
+            util::get_string_from_enum(axisVariable->get_dataType_enum()),
+            axisVariable->get_containerType_string());
+    }
+    const int64_t index = axisVariable->get_int64();
+    if (index < -numDims || index >= numDims) {
+      THROW("%s got axis %lld, out of bounds for a tensor of %d dimensions", name,
+            (long long)index, numDims);
+    }
+    const int dim = index < 0 ? index + numDims : index;
+    if (reduceAxes[dim]) {
+      THROW("%s got axis %d more than once", name, dim);
+    }
+    reduceAxes[dim] = true;
+  };
+
+  const int containerType = axis->get_containerType();
+  if (containerType == CONTAINERTYPE::LIST || containerType == CONTAINERTYPE::TUPLE) {
+    for (int i = 0; i < axis->get_size(); i++) {
+      addAxis(axis->get_int_subscript(i));
+    }
+  } else {
+    addAxis(axis);
+  }
+  return reduceAxes;
+}
+
+/**
+ * @brief Reduces a numeric tensor with its elements converted to T
+ */
+template <typename T>
+OpReturnType reduce_as(TensorReduction reduction, const OpReturnType& tensor,
+                       const std::vector<bool>& reduceAxes, bool keepDims, ThreadPool* pool) {
+  const auto& shape = tensor->get_shape();
+  std::vector<int64_t> outShape;
+  int64_t numReduced = 1;
+  for (int d = 0; d < (int)shape.size(); d++) {
+    if (!reduceAxes[d]) {
+      outShape.push_back(shape[d]);
+      continue;
+    }
+    numReduced *= shape[d];
+    if (keepDims) {
+      outShape.push_back(1);
+    }
+  }
+  const bool isScalar = outShape.empty();
+
+  auto result = DataVariable::create_tensor(get_dataType_enum<T>(),
+                                            isScalar ? std::vector<int64_t>{1} : outShape);
+  const int64_t numOut = result->get_numElements();
+  if (numOut == 0) {
+    return result;
+  }
+  T* out = static_cast<T*>(result->get_raw_ptr());
+  std::vector<T> buffer;
+  const T* elements = get_elements<T>(tensor, true, buffer);
+  switch (reduction) {
+    case TensorReduction::SUM:
+    case TensorReduction::MEAN:
+      ReductionKernels::reduce<T>(ReduceOp::SUM, elements, shape, reduceAxes, out, pool);
+      break;
+    case TensorReduction::MIN:
+      ReductionKernels::reduce<T>(ReduceOp::MIN, elements, shape, reduceAxes, out, pool);
+      break;
+    case TensorReduction::MAX:
+      ReductionKernels::reduce<T>(ReduceOp::MAX, elements, shape, reduceAxes, out, pool);
+      break;
+  }
+  if (reduction == TensorReduction::MEAN) {
+    for (int64_t i = 0; i < numOut; i++) {
+      out[i] /= numReduced;
+    }
+  }
+
+  if (!isScalar) {
+    return result;
+  }
+  if (reduction == TensorReduction::MEAN) {
+    return std::make_shared<SingleVariable<double>>(out[0]);
+  }
+  return std::make_shared<SingleVariable<T>>(out[0]);
+}
+
+/**
+ * @brief Minimum or maximum of all the elements of a string tensor, compared lexicographically
+ */
+OpReturnType reduce_strings(TensorReduction reduction, const OpReturnType& tensor) {
+  const int numElements = tensor->get_numElements();
+  if (numElements == 0) {
+    THROW("%s", "Expected a non-empty tensor");
+  }
+  const auto strings = static_cast<const std::string*>(tensor->get_raw_ptr());
+  const auto resultIt = reduction == TensorReduction::MIN
+                            ? std::min_element(strings, strings + numElements)
+                            : std::max_element(strings, strings + numElements);
+  return std::make_shared<SingleVariable<std::string>>(*resultIt);
+}
+
+/**
+ * @brief Converts the minimum or maximum of a boolean tensor, reduced as int32, back to booleans
+ */
+OpReturnType to_boolean(const OpReturnType& reduced) {
+  if (reduced->is_single()) {
+    return std::make_shared<SingleVariable<bool>>(reduced->get_int32() != 0);
+  }
+  auto result = DataVariable::create_tensor(DATATYPE::BOOLEAN, reduced->get_shape());
+  const int32_t* values = static_cast<const int32_t*>(reduced->get_raw_ptr());
+  std::copy(values, values + reduced->get_numElements(), static_cast<bool*>(result->get_raw_ptr()));
+  return result;
+}
+
+}  // namespace
+
+bool TensorOperators::is_numeric_tensor(const OpReturnType& v) {
+  return v->get_containerType() == CONTAINERTYPE::VECTOR &&
+         is_elementwise_dataType(v->get_dataType_enum());
+}
+
+OpReturnType TensorOperators::operate(const OpReturnType& v1, const OpReturnType& v2,
+                                      ElementwiseOp op) {
+  const bool isTensor1 = is_numeric_tensor(v1);
+  const bool isTensor2 = is_numeric_tensor(v2);
+  const auto isScalar = [](const OpReturnType& v) {
+    return v->is_single() && is_elementwise_dataType(v->get_dataType_enum());
+  };
+  if (!(isTensor1 || isTensor2) || !(isTensor1 || isScalar(v1)) || !(isTensor2 || isScalar(v2))) {
+    return nullptr;
+  }
+
+  const int dataType1 = v1->get_dataType_enum();
+  const int dataType2 = v2->get_dataType_enum();
+  int dataType;
+  if (isTensor1 && isTensor2) {
+    dataType = get_max_dataType(dataType1, dataType2);
+  } else if (isTensor1) {
+    dataType = get_tensor_scalar_dataType(dataType1, v2);
+  } else {
+    dataType = get_tensor_scalar_dataType(dataType2, v1);
+  }
+
+  switch (dataType) {
+    case DATATYPE::INT64:
+      return compute<int64_t>(v1, isTensor1, v2, isTensor2, op);
+    case DATATYPE::FLOAT:
+      return compute<float>(v1, isTensor1, v2, isTensor2, op);
+    case DATATYPE::DOUBLE:
+      return compute<double>(v1, isTensor1, v2, isTensor2, op);
+    default:
+      // Booleans are computed as int32
+      return compute<int32_t>(v1, isTensor1, v2, isTensor2, op);
+  }
+}
+
+OpReturnType TensorOperators::reduce(TensorReduction reduction, const OpReturnType& tensor,
+                                     const OpReturnType& axis, bool keepDims, ThreadPool* pool) {
+  const char* name = get_reduction_name(reduction);
+  if (tensor->get_containerType() != CONTAINERTYPE::VECTOR) {
+    THROW("%s expected a tensor, got %s", name, tensor->get_containerType_string());
+  }
+  const int dataType = tensor->get_dataType_enum();
+  const bool isMinOrMax = reduction == TensorReduction::MIN || reduction == TensorReduction::MAX;
+  if (dataType == DATATYPE::STRING && isMinOrMax && (axis == nullptr || axis->is_none())) {
+    return reduce_strings(reduction, tensor);
+  }
+  if (!is_elementwise_dataType(dataType)) {
+    THROW("%s only supports integral and floating point tensors", name);
+  }
+  const auto reduceAxes = get_reduce_axes(name, axis, tensor->get_shape().size());
+
+  if (reduction == TensorReduction::MEAN) {
+    if (dataType == DATATYPE::FLOAT) {
+      return reduce_as<float>(reduction, tensor, reduceAxes, keepDims, pool);
+    }
+    return reduce_as<double>(reduction, tensor, reduceAxes, keepDims, pool);
+  }
+  switch (dataType) {
+    case DATATYPE::INT64:
+      return reduce_as<int64_t>(reduction, tensor, reduceAxes, keepDims, pool);
+    case DATATYPE::FLOAT:
+      return reduce_as<float>(reduction, tensor, reduceAxes, keepDims, pool);
+    case DATATYPE::DOUBLE:
+      return reduce_as<double>(reduction, tensor, reduceAxes, keepDims, pool);
+    case DATATYPE::BOOLEAN: {
+      // Booleans are reduced as int32, their minimum and maximum are booleans again
+      auto reduced = reduce_as<int32_t>(reduction, tensor, reduceAxes, keepDims, pool);
+      return isMinOrMax ? to_boolean(reduced) : reduced;
+    }
+    default:
+      return reduce_as<int32_t>(reduction, tensor, reduceAxes, keepDims, pool);
+  }
+}
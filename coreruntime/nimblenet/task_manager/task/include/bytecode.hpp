@@ -0,0 +1,234 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "binary_operators.hpp"
+#include "bool_operators.hpp"
+#include "compare_operators.hpp"
+#include "ne_fwd.hpp"
+#include "unary_operators.hpp"
+#include "value.hpp"
+#include "variable_scope.hpp"
+
+class ASTNode;
+class Statement;
+class Body;
+class MemberInlineCache;
+
+/**
+ * @brief Opcodes of the register based bytecode.
+ *
+ * R[x] denotes register x of the executing function. Operands which are not registers index into
+ * the side tables of BytecodeFunction. Registers hold a Value, so bool and numeric results are not
+ * boxed until they escape the function.
+ */
+enum class OpCode : uint8_t {
+  LOAD_CONST,      /**< R[a] = constants[b] */
+  LOAD_NONE,       /**< R[a] = None */
+  LOAD_VAR,        /**< R[a] = stack[variables[b]] */
+  STORE_VAR,       /**< stack[variables[b]] = R[a] */
+  MOVE,            /**< R[a] = R[b] */
+  BINARY,          /**< R[a] = R[b] binaryOps[d] R[c] */
+  COMPARE,         /**< R[a] = compareOps[d](R[b], R[c]) */
+  BOOL_OP,         /**< R[a] = boolOps[d](R[b], R[c]) */
+  UNARY,           /**< R[a] = unaryOps[c](R[b]) */
+  JUMP,            /**< pc = a */
+  JUMP_IF_FALSE,   /**< if (!R[a]) pc = b */
+  JUMP_IF_TRUE,    /**< if (R[a]) pc = b */
+  FOR_PREP,        /**< counters[a] = 0 */
+  FOR_ITER,        /**< if (counters[d] < len(R[a])) R[b] = R[a][counters[d]++] else pc = c */
+  CALL_VAR,        /**< R[a] = stack[variables[d]](R[b], ..., R[b + c - 1]) */
+  CALL_CONST,      /**< R[a] = constants[d](R[b], ..., R[b + c - 1]) */
+  CALL_MEMBER,     /**< R[a] = R[b].memberCalls[d](R[b + 1], ..., R[b + c]) */
+  GET_MEMBER,      /**< R[a] = R[b].member[c] */
+  SET_MEMBER,      /**< R[b].member[c] = R[a] */
+  GET_SUBSCRIPT,   /**< R[a] = R[b][R[c]] */
+  SET_SUBSCRIPT,   /**< R[b][R[c]] = R[a] */
+  BUILD_LIST,      /**< R[a] = [R[b], ..., R[b + c - 1]] */
+  BUILD_TUPLE,     /**< R[a] = (R[b], ..., R[b + c - 1]) */
+  BUILD_DICT,      /**< R[a] = {R[b]: R[b + c], ..., R[b + c - 1]: R[b + 2c - 1]} */
+  EVAL_NODE,       /**< R[a] = nodes[b]->get(), tree walker fallback for expressions */
+  STORE_NODE,      /**< nodes[b]->set(R[a]), tree walker fallback for assignment targets */
+  EXEC_STATEMENT,  /**< statements[a]->execute(), break jumps to b and continue jumps to c */
+  RETURN,          /**< return R[a] */
+  RETURN_NONE,     /**< return None */
+};
+
+/**
+ * @brief Single bytecode instruction with up to four operands.
+ */
+struct Instruction {
+  OpCode op;
+  int32_t a = 0;
+  int32_t b = 0;
+  int32_t c = 0;
+  int32_t d = 0;
+  int32_t lines = 0; /**< Index of the source line chain used to annotate errors */
+};
+
+/**
+ * @brief Compiled form of the body of a FunctionDef.
+ *
+ * The function is immutable once compiled, all per call state (registers and loop counters) lives
+ * on the native stack of run() so that the same function can be executed concurrently.
+ */
+class BytecodeFunction {
+  struct Variable {
+    StackLocation location; /**< Location of the variable in the call stack */
+    std::string name;       /**< Name of the variable, used for error messages */
+  };
+
+  struct BinaryOp {
+    BinaryOpType type; /**< Resolved operation, used on unboxed operands */
+    std::string name;  /**< Name of the operation */
+  };
+
+  struct CompareOp {
+    CompareFuncPtr func; /**< Comparison function */
+    CompareOpType type;  /**< Resolved comparison, used on unboxed operands */
+    std::string name;    /**< Name of the comparison, used for error messages */
+  };
+
+  struct BoolOp {
+    BoolFuncPtr func; /**< Boolean operation function */
+    bool isAnd;       /**< Whether the operation is an and, used on unboxed operands */
+    std::string name; /**< Name of the boolean operation, used for error messages */
+  };
+
+  struct UnaryOp {
+    UnaryOpFuncPtr func; /**< Unary operation function */
+    std::string name;    /**< Name of the unary operation, used for error messages */
+  };
+
+  struct MemberCall {
+    int memberIndex;          /**< Index of the member function */
+    MemberInlineCache* cache; /**< Inline cache of the call site, owned by its AttributeNode */
+  };
+
+  std::vector<Instruction> _code;         /**< Instructions of the function */
+  std::vector<Value> _constants;          /**< Constants referenced by LOAD_CONST */
+  std::vector<Variable> _variables;       /**< Stack variables referenced by the function */
+  std::vector<BinaryOp> _binaryOps;       /**< Binary operators referenced by BINARY */
+  std::vector<CompareOp> _compareOps;     /**< Comparison operators referenced by COMPARE */
+  std::vector<BoolOp> _boolOps;           /**< Boolean operators referenced by BOOL_OP */
+  std::vector<UnaryOp> _unaryOps;         /**< Unary operators referenced by UNARY */
+  std::vector<MemberCall> _memberCalls;   /**< Member function calls referenced by CALL_MEMBER */
+  std::vector<ASTNode*> _nodes;           /**< Non owning pointers to nodes evaluated by the tree walker */
+  std::vector<Statement*> _statements;    /**< Non owning pointers to statements executed by the tree walker */
+  std::vector<std::string> _linePrefixes; /**< Error prefix ("lineNo=x, lineNo=y, ") per line chain */
+  int _numRegisters = 0;                  /**< Number of registers needed by the function */
+  int _numCounters = 0;                   /**< Number of for loop counters needed by the function */
+
+  friend class BytecodeCompiler;
+
+ public:
+  /**
+   * @brief Executes the function in the current frame of the stack.
+   *
+   * The caller is responsible for entering the function frame and setting the arguments.
+   *
+   * @param stack Call stack whose top frame belongs to this function.
+   * @return Value returned by the function, NoneVariable if it does not return anything.
+   */
+  OpReturnType run(CallStack& stack) const;
+
+  /**
+   * @brief Returns a human readable listing of the instructions, used for debugging.
+   */
+  std::string disassemble() const;
+};
+
+/**
+ * @brief Compiles the statement tree of a function into a BytecodeFunction.
+ *
+ * Statements and nodes lower themselves through their compile() hooks. Anything without a
+ * dedicated lowering is emitted as a call back into the tree walker (EVAL_NODE, STORE_NODE and
+ * EXEC_STATEMENT), so every function can be compiled.
+ */
+class BytecodeCompiler {
+  struct Loop {
+    int continueTarget = -1;     /**< Instruction to jump to on continue */
+    std::vector<int> breakJumps; /**< Jumps to patch with the loop exit on break */
+  };
+
+  std::unique_ptr<BytecodeFunction> _function = std::make_unique<BytecodeFunction>();
+  std::vector<Loop> _loops;                 /**< Loops enclosing the statement being compiled */
+  std::vector<int> _lineChain;              /**< Lines of the statements enclosing the code emitted */
+  std::map<std::vector<int>, int> _lineChainIndexMap; /**< Line chain to index of its error prefix */
+  int _currentLines = -1;                   /**< Index of the current line chain, -1 if not computed */
+  int _nextRegister = 0;                    /**< First free register */
+
+ public:
+  /**
+   * @brief Compiles the body of a function.
+   *
+   * @param body Body of the function, has to outlive the compiled function.
+   * @return Compiled function.
+   */
+  static std::unique_ptr<BytecodeFunction> compile(const Body& body);
+
+  int emit(OpCode op, int a = 0, int b = 0, int c = 0, int d = 0);
+
+  int next_instruction() const { return _function->_code.size(); }
+
+  Instruction& instruction(int index) { return _function->_code[index]; }
+
+  /**
+   * @brief Allocates a temporary register, registers are freed with release_registers().
+   */
+  int allocate_register();
+
+  /**
+   * @brief Allocates count consecutive registers and returns the first one.
+   */
+  int allocate_registers(int count);
+
+  int register_mark() const { return _nextRegister; }
+
+  void release_registers(int mark) { _nextRegister = mark; }
+
+  int allocate_counter() { return _function->_numCounters++; }
+
+  int add_constant(OpReturnType constant);
+  int add_variable(const StackLocation& location, const std::string& name);
+  int add_binary_op(const std::string& opType);
+  int add_compare_op(CompareFuncPtr func, const std::string& opType);
+  int add_bool_op(BoolFuncPtr func, const std::string& opType);
+  int add_unary_op(UnaryOpFuncPtr func, const std::string& opType);
+  int add_member_call(int memberIndex, MemberInlineCache* cache);
+  int add_node(ASTNode* node);
+  int add_statement(Statement* statement);
+
+  void push_line(int lineNo);
+  void pop_line();
+
+  void begin_loop(int continueTarget);
+
+  /**
+   * @brief Patches the break jumps of the innermost loop to jump to exitTarget.
+   */
+  void end_loop(int exitTarget);
+
+  bool in_loop() const { return !_loops.empty(); }
+
+  int continue_target() const { return _loops.back().continueTarget; }
+
+  /**
+   * @brief Registers an instruction of the innermost loop which has to jump to the loop exit.
+   */
+  void add_break_jump(int index);
+
+  /**
+   * @brief Emits a jump to the exit of the innermost loop.
+   */
+  void emit_break();
+};
@@ -28,13 +28,26 @@ class DpModule {
   std::map<std::string, StackLocation> _variableNamesLocationMap;  /**< Maps variable names to their stack locations */
   std::string _name;  /**< Name of the module */
   int _index;         /**< Unique index of this module within the task */
+  CallStack _stack;   /**< Stack the module was executed on, which holds its global frame */
 
  public:
   DpModule(CommandCenter* commandCenter, const std::string& name, int index, const json& astJson,
-           CallStack& stack);
+           CallStack& stack, bool compileBytecode = false, bool optimize = false);
   ~DpModule();
   void operate(const std::string& functionName, const MapVariablePtr inputs, MapVariablePtr outputs,
                CallStack& stack);
   bool has_variable(const std::string& name) const;
-  StackLocation get_variable_location(const std::string& name) const;
+
+  /**
+   * @brief Returns the value of a global variable of the module, which has to exist.
+   *
+   * Read from the stack the module was executed on, so that a module imported for the first time
+   * inside a function can be imported again from other calls, whose stacks do not hold its frame.
+   */
+  OpReturnType get_variable(const std::string& name) const;
+
+  /**
+   * @brief Shares the frames of the module with other threads, see CallStack::share_frames().
+   */
+  void share_frames() { _stack.share_frames(); }
 };
@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ne_fwd.hpp"
+
+class CallStack;
+class DataVariable;
+
+/**
+ * @brief Polymorphic inline cache for calls to members of script classes, e.g. obj.method(x).
+ *
+ * Calling a method of an object of a script class looks the member up in the map of the object,
+ * then in the map of its class, and then copies the arguments to prepend self. Every call site
+ * keeps a cache from the layout of the receiver's class to the function it resolved to, so that
+ * repeated calls from the same site go straight to the function. Receivers which are not objects
+ * or classes defined in the script are dispatched with DataVariable::call_function() as before.
+ *
+ * The cache holds up to MAX_ENTRIES classes. It is shared by every thread executing the call site,
+ * so lookups read an immutable snapshot of the entries and misses publish a new snapshot. After
+ * MAX_UPDATES snapshots the site is considered megamorphic and is no longer updated.
+ */
+class MemberInlineCache {
+ public:
+  struct Stats {
+    int64_t hits = 0;   /**< Calls which found the receiver's class in the cache */
+    int64_t misses = 0; /**< Calls which had to look the member up in the receiver's class */
+  };
+
+ private:
+  static constexpr int MAX_ENTRIES = 4;
+  static constexpr int MAX_UPDATES = 8;
+
+  struct Entry {
+    uint64_t layoutId = 0; /**< ClassDataVariable::layout_id() of the receiver's class */
+    /**
+     * @brief Member the call resolved to, owned by the class, which may replace it at any time
+     */
+    std::weak_ptr<DataVariable> member;
+  };
+
+  struct Snapshot {
+    int size = 0;
+    Entry entries[MAX_ENTRIES];
+  };
+
+  std::atomic<const Snapshot*> _snapshot{nullptr}; /**< Entries used by lookups */
+  std::vector<std::unique_ptr<Snapshot>> _snapshots; /**< All published snapshots, guarded by _mutex */
+  std::mutex _mutex;
+
+  static std::atomic<int64_t> _hits;
+  static std::atomic<int64_t> _misses;
+
+  /**
+   * @brief Returns the member cached for a layout, nullptr if it is missing or was destroyed.
+   */
+  OpReturnType lookup(uint64_t layoutId) const;
+  void insert(uint64_t layoutId, const OpReturnType& member);
+
+ public:
+  /**
+   * @brief Calls receiver.member[memberIndex](arguments), same as receiver->call_function().
+   */
+  OpReturnType call(const OpReturnType& receiver, int memberIndex,
+                    const std::vector<OpReturnType>& arguments, CallStack& stack);
+
+  /**
+   * @brief Hits and misses of all the caches since the process started.
+   */
+  static Stats get_stats();
+};
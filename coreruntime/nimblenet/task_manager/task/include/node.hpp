@@ -14,10 +14,17 @@
 #include "iterable_data_variable.hpp"
 #include "list_data_variable.hpp"
 #include "map_data_variable.hpp"
+#include "member_cache.hpp"
+#include "quickening.hpp"
 #include "tuple_data_variable.hpp"
 #include "unary_operators.hpp"
 #include "variable_scope.hpp"
 
+class BytecodeCompiler;
+class ScriptOptimizer;
+class ComprehensionNode;
+class Reduction;
+
 /**
  * @brief Base class for all Abstract Syntax Tree nodes
  *
@@ -41,10 +48,52 @@ class ASTNode {
     throw create_exception("%s", "cannot assign");
   }
 
+  /**
+   * @brief Same as set_variable(), nodes which can store unboxed values keep them unboxed.
+   */
+  virtual void set_value(Value value, CallStack& stack) { set_variable(value.take_box(), stack); }
+
   virtual OpReturnType call(const std::vector<OpReturnType>& args, CallStack& stack) {
     THROW("%s", "Cannot call variable");
   }
 
+  /**
+   * @brief Emits bytecode which leaves the value of this node in register reg.
+   *
+   * Nodes without a dedicated lowering are evaluated by the VM through get().
+   */
+  virtual void compile(BytecodeCompiler& compiler, int reg);
+
+  /**
+   * @brief Emits bytecode which assigns the value held in register reg to this node.
+   *
+   * Nodes without a dedicated lowering are assigned by the VM through set().
+   */
+  virtual void compile_store(BytecodeCompiler& compiler, int reg);
+
+  /**
+   * @brief Emits bytecode which calls this node with the given arguments into register reg.
+   *
+   * @return false if calling this node has no dedicated lowering.
+   */
+  virtual bool compile_call(BytecodeCompiler& compiler, int reg,
+                            const std::vector<ASTNode*>& arguments) {
+    return false;
+  }
+
+  /**
+   * @brief Optimizes the children of this node and returns the node to use in its place, which
+   * can be a newly created node. The caller deletes this node if it gets replaced.
+   */
+  virtual ASTNode* optimize(ScriptOptimizer& optimizer) { return this; }
+
+  /**
+   * @brief Returns the node as Python like source, used to debug the optimized tree.
+   */
+  virtual std::string dump() const { return "<expr>"; }
+
+  int get_line() const { return _lineNo; }
+
   OpReturnType get(CallStack& stack) {
     try {
       auto ret = get_value(stack);
@@ -83,6 +132,10 @@ class NullNode : public ASTNode {
   NullNode() {}
 
   OpReturnType get_value(CallStack&) override { return OpReturnType(new NoneVariable()); }
+
+  void compile(BytecodeCompiler& compiler, int reg) override;
+
+  std::string dump() const override { return "None"; }
 };
 
 class ConstantNode : public ASTNode {
@@ -91,7 +144,27 @@ class ConstantNode : public ASTNode {
  public:
   ConstantNode(VariableScope* scope, const json& constJson);
 
+  /**
+   * @brief Creates a node for a value computed by the ScriptOptimizer.
+   */
+  ConstantNode(VariableScope* scope, int lineNo, OpReturnType value) : _d(std::move(value)) {
+    _scope = scope;
+    _lineNo = lineNo;
+  }
+
   OpReturnType get_value(CallStack&) override { return _d; }
+
+  const OpReturnType& value() const { return _d; }
+
+  // Builtin functions resolved by the ScriptOptimizer are constants which can be called
+  OpReturnType call(const std::vector<OpReturnType>& args, CallStack& stack) override {
+    return _d->execute_function(args, stack);
+  }
+
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  bool compile_call(BytecodeCompiler& compiler, int reg,
+                    const std::vector<ASTNode*>& arguments) override;
+  std::string dump() const override;
 };
 
 class BinNode : public ASTNode {
@@ -99,10 +172,21 @@ class BinNode : public ASTNode {
   ASTNode* _left = nullptr;   /**< Left operand of the binary operation */
   ASTNode* _right = nullptr;  /**< Right operand of the binary operation */
   std::string _opType;        /**< Type of binary operation (e.g., "+", "-", "*") */
+  BinaryOpType _op;           /**< Operation resolved from _opType */
+  Quickening _quickening;     /**< Operand types the node specialized itself for */
+
+  /**
+   * @brief Fast path for the specialized operand types, nullptr if the operands fail the guard
+   */
+  OpReturnType operate_quickened(QuickenedOperands operands, const OpReturnType& d1,
+                                 const OpReturnType& d2) const;
 
  public:
   BinNode(VariableScope* scope, const json& binOpJson);
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
 
   virtual ~BinNode() {
     delete _left;
@@ -119,6 +203,9 @@ class UnaryNode : public ASTNode {
  public:
   UnaryNode(VariableScope* scope, const json& unaryOpJson);
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
 
   virtual ~UnaryNode() { delete _operand; }
 };
@@ -129,10 +216,22 @@ class CompareNode : public ASTNode {
   std::vector<CompareFuncPtr> _compareFuncs;  /**< Functions for each comparison operation */
   ASTNode* _left = nullptr;                /**< Left-hand side operand for comparison */
   std::vector<std::string> _opTypes;       /**< Types of comparison operations */
+  std::vector<CompareOpType> _ops;         /**< Comparisons resolved from _opTypes */
+  Quickening _quickening;                  /**< Operand types the node specialized itself for */
+
+  /**
+   * @brief Fast path of comparison i for the specialized operand types, nullptr if the operands
+   * fail the guard
+   */
+  OpReturnType compare_quickened(QuickenedOperands operands, int i, const OpReturnType& d1,
+                                 const OpReturnType& d2) const;
 
  public:
   CompareNode(VariableScope* scope, const json& compareOpJson);
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
 
   virtual ~CompareNode() {
     delete _left;
@@ -150,6 +249,9 @@ class BoolNode : public ASTNode {
  public:
   BoolNode(VariableScope* scope, const json& boolOpJson);
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
 
   virtual ~BoolNode() {
     for (auto comp : _comparators) {
@@ -161,10 +263,21 @@ class BoolNode : public ASTNode {
 class CallNode : public ASTNode {
   std::vector<ASTNode*> _arguments;  /**< Arguments to the function call */
   ASTNode* _functionNode = nullptr;  /**< The function being called */
+  /**
+   * The only argument if it is a comprehension and the function a variable or constant. If the
+   * function turns out to be a builtin reduction like sum(), the comprehension is consumed element
+   * by element instead of being evaluated into a list.
+   */
+  ComprehensionNode* _comprehensionArgument = nullptr;
+
+  void find_comprehension_argument();
 
  public:
   CallNode(VariableScope* scope, const json& callFuncJson);
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
 
   virtual ~CallNode() {
     for (auto arg : _arguments) {
@@ -193,6 +306,10 @@ class ListNode : public ASTNode {
     return OpReturnType(new ListDataVariable(std::move(membersOfList)));
   }
 
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
+
   virtual ~ListNode() {
     for (auto mem : _membersInList) {
       delete mem;
@@ -244,6 +361,10 @@ class TupleNode : public ASTNode {
     return ret;
   }
 
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
+
   virtual ~TupleNode() {
     for (auto mem : _membersInTuple) {
       delete mem;
@@ -273,8 +394,24 @@ class NameNode : public ASTNode {
     stack.set_variable(_stackLocation, d);
   }
 
+  void set_value(Value value, CallStack& stack) override {
+    if (_type != Type::STORE)
+      throw create_exception("%s", "can only call set for store name variable");
+    stack.set_value(_stackLocation, std::move(value));
+  }
+
   OpReturnType get_value(CallStack& stack) override;
   OpReturnType call(const std::vector<OpReturnType>& args, CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  void compile_store(BytecodeCompiler& compiler, int reg) override;
+  bool compile_call(BytecodeCompiler& compiler, int reg,
+                    const std::vector<ASTNode*>& arguments) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override { return _variableName; }
+
+  bool is_store() const { return _type == Type::STORE; }
+
+  const StackLocation& get_location() const { return _stackLocation; }
 };
 
 /**
@@ -288,6 +425,7 @@ class AttributeNode : public ASTNode {
   int _memberIndex = -1;  /**< Index of the member/attribute in the object */
   // this mainNode is the variable whose attribute is called or accessed.
   ASTNode* _mainNode = nullptr;  /**< The object whose attribute is being accessed */
+  MemberInlineCache _callCache;  /**< Functions resolved by calls of the attribute */
 
  public:
   AttributeNode(VariableScope* scope, const json& nameOpJson);
@@ -305,6 +443,12 @@ class AttributeNode : public ASTNode {
   }
 
   OpReturnType call(const std::vector<OpReturnType>& args, CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  void compile_store(BytecodeCompiler& compiler, int reg) override;
+  bool compile_call(BytecodeCompiler& compiler, int reg,
+                    const std::vector<ASTNode*>& arguments) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
 
   ~AttributeNode() { delete _mainNode; }
 };
@@ -342,6 +486,9 @@ class SliceNode : public ASTNode {
     return OpReturnType(new ListSliceVariable(lowerVal, upperVal, stepVal));
   }
 
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
+
   virtual ~SliceNode() {
     delete _lower;
     delete _upper;
@@ -349,11 +496,23 @@ class SliceNode : public ASTNode {
   }
 };
 
+/**
+ * @brief Returns the interned key if the JSON of a node is a constant string, nullptr otherwise.
+ */
+inline const InternedKey* get_constant_key(const json& nodeJson) {
+  if (nodeJson.is_object() && nodeJson.value("_type", "") == "Constant" &&
+      nodeJson.at("value").is_string()) {
+    return InternedKey::intern(nodeJson.at("value").get<std::string>());
+  }
+  return nullptr;
+}
+
 class SubscriptNode : public ASTNode {
   bool _store = false;
   // assuming slice is a constant
   ASTNode* _sliceNode = nullptr;
   ASTNode* _mainNode = nullptr;
+  const InternedKey* _key = nullptr; /**< Slice if it is a constant string, e.g. d["key"] */
 
  public:
   SubscriptNode(VariableScope* scope, const json& subOpJson) : ASTNode(scope, subOpJson) {
@@ -368,6 +527,7 @@ class SubscriptNode : public ASTNode {
       _sliceNode = new SliceNode(scope, sliceJson);
     } else {
       _sliceNode = create_node(scope, sliceJson);
+      _key = get_constant_key(sliceJson);
     }
     _mainNode = create_node(scope, valueJson);
   }
@@ -376,13 +536,31 @@ class SubscriptNode : public ASTNode {
     if (!_store) throw create_exception("%s", "cannot set rvalue variable");
     auto subscript = _sliceNode->get(stack);
     auto mainData = _mainNode->get(stack);
+    if (_key && mainData->get_containerType() == CONTAINERTYPE::MAP) {
+      return mainData->set_interned_subscript(*_key, d);
+    }
     mainData->set_subscript(subscript, d);
   }
 
   OpReturnType get_value(CallStack& stack) override {
     auto subscript = _sliceNode->get(stack);
     auto mainData = _mainNode->get(stack);
+    if (_key && mainData->get_containerType() == CONTAINERTYPE::MAP) {
+      return mainData->get_interned_subscript(*_key);
+    }
+    return get_subscript_value(mainData, subscript);
+  }
 
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  void compile_store(BytecodeCompiler& compiler, int reg) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
+
+  /**
+   * @brief Evaluates mainData[subscript], where subscript is either a slice, a key or an index.
+   */
+  static OpReturnType get_subscript_value(const OpReturnType& mainData,
+                                          const OpReturnType& subscript) {
     if (subscript->get_containerType() == CONTAINERTYPE::SLICE) {
       if (mainData->get_containerType() == CONTAINERTYPE::LIST) {
         return mainData->get_subscript(subscript);
@@ -390,7 +568,7 @@ class SubscriptNode : public ASTNode {
                  mainData->get_dataType_enum() == DATATYPE::STRING) {
         return mainData->get_subscript(subscript);
       } else {
-        throw create_exception("%s", "cannot subscript non-list or non-string variable");
+        THROW("%s", "cannot subscript non-list or non-string variable");
       }
     }
 
@@ -410,6 +588,7 @@ class SubscriptNode : public ASTNode {
 class DictNode : public ASTNode {
   std::vector<ASTNode*> _keyNodes;
   std::vector<ASTNode*> _valueNodes;
+  std::vector<const InternedKey*> _internedKeys; /**< Keys which are constant strings, or nullptr */
 
  public:
   DictNode(VariableScope* scope, const json& dictNodeJson) : ASTNode(scope, dictNodeJson) {
@@ -417,6 +596,7 @@ class DictNode : public ASTNode {
     auto valuesJsonArray = dictNodeJson.at("values");
     for (auto keyJson : keysJsonArray) {
       _keyNodes.push_back(create_node(scope, keyJson));
+      _internedKeys.push_back(get_constant_key(keyJson));
     }
     for (auto valueJson : valuesJsonArray) {
       _valueNodes.push_back(create_node(scope, valueJson));
@@ -429,26 +609,37 @@ class DictNode : public ASTNode {
   ~DictNode() override;
 
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int reg) override;
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+  std::string dump() const override;
 };
 
 /**
  * @brief AST node for a single generator in a comprehension expression
  *
  * SingleGeneratorNode handles one level of iteration in a comprehension
- * (e.g., "for x in range(5)" in [x for x in range(5)]). It manages the
- * iteration state, target variable assignment, and optional conditions.
- * Multiple generators can be chained together for nested comprehensions.
+ * (e.g., "for x in range(5)" in [x for x in range(5)]). It assigns the target
+ * variable(s) and checks the optional conditions. Multiple generators are
+ * chained together for nested comprehensions and run as nested loops by
+ * for_each(), which keeps no iteration state in the node so that the same
+ * comprehension can be evaluated recursively and by several threads at once.
  */
 class SingleGeneratorNode : public ASTNode {
  private:
   VariableScope* _generatorScope = nullptr;  /**< Scope for generator variables */
   ASTNode* _iterableNode = nullptr;          /**< The iterable being looped over */
   ASTNode* _targetNode = nullptr;            /**< Target variable(s) for assignment */
-  std::vector<ASTNode*> _elementNodes;       /**< Element expressions to evaluate */
   std::vector<ASTNode*> _conditionNodes;     /**< Optional conditions (if clauses) */
   SingleGeneratorNode* _nextGenerator = nullptr;  /**< Next generator in the chain */
-  IterableOverScriptable* _iterable = nullptr;    /**< Iterator for the iterable */
-  OpReturnType _cachedItem = nullptr;             /**< Currently cached item from iteration */
+
+  bool conditions_pass(CallStack& stack) {
+    for (auto& condNode : _conditionNodes) {
+      if (!condNode->get(stack)->get_bool()) {
+        return false;
+      }
+    }
+    return true;
+  }
 
  public:
   SingleGeneratorNode(VariableScope* generatorScope, const json& genJson)
@@ -476,91 +667,57 @@ class SingleGeneratorNode : public ASTNode {
         _conditionNodes.push_back(create_node(generatorScope, ifJson));
       }
     }
-    _iterable = new IterableOverScriptable();
   }
 
   VariableScope* get_scope() const { return _generatorScope; }
 
-  void add_element_node(ASTNode* elementNode) { _elementNodes.push_back(elementNode); }
-
   void set_next_generator(SingleGeneratorNode* nextGenerator) { _nextGenerator = nextGenerator; }
 
-  void reset_iterator() {
-    _iterable->reset_iterator();
-    _cachedItem = nullptr;
-    if (_nextGenerator != nullptr) {
-      _nextGenerator->reset_iterator();
-    }
-  }
-
-  OpReturnType get_next_and_reset_next_generator(CallStack& stack) {
-    try {
-      OpReturnType item = _iterable->next(stack);
-      if (_nextGenerator != nullptr) {
-        _nextGenerator->reset_iterator();
+  /**
+   * @brief Runs this generator and the ones chained after it as nested loops, calling consume()
+   * once the targets of all of them are assigned and their conditions pass.
+   *
+   * @param consume Evaluates the element expression(s), returns false to stop the iteration.
+   * @param sizeHint If not null, set to the size of the iterable before the first element is
+   * consumed, an upper bound of the number of elements if no generator is chained after this one.
+   * @return false if consume() stopped the iteration.
+   */
+  template <class Consumer>
+  bool for_each(CallStack& stack, Consumer& consume, int* sizeHint = nullptr) {
+    auto iterable = _iterableNode->get(stack);
+    if (iterable->get_containerType() != CONTAINERTYPE::LIST &&
+        iterable->get_containerType() != CONTAINERTYPE::TUPLE &&
+        iterable->get_containerType() != CONTAINERTYPE::RANGE &&
+        !(iterable->get_containerType() == CONTAINERTYPE::SINGLE &&
+          iterable->get_dataType_enum() == DATATYPE::STRING)) {
+      THROW("IterableOverScriptable requires a list or tuple or range got %s",
+            iterable->get_containerType_string());
+    }
+    if (sizeHint != nullptr) {
+      *sizeHint = iterable->get_size();
+    }
+    // The size is read on every iteration, the body can modify the iterable
+    for (int i = 0; i < iterable->get_size(); i++) {
+      _targetNode->set_variable(iterable->get_int_subscript(i), stack);
+      if (!conditions_pass(stack)) {
+        continue;
       }
-      return item;
-    } catch (const std::runtime_error& e) {
-      if (std::string(e.what()) == "StopIteration") {
-        if (_nextGenerator != nullptr) {
-          _nextGenerator->reset_iterator();
-        }
-        return nullptr;
+      bool proceed = (_nextGenerator != nullptr) ? _nextGenerator->for_each(stack, consume)
+                                                 : consume();
+      if (!proceed) {
+        return false;
       }
-      throw;
     }
+    return true;
   }
 
+  // Generators are only run through for_each() of their comprehension
   OpReturnType get_value(CallStack& stack) override {
-    // Get the iterable for this generator
-    _iterable->set_data(_iterableNode->get(stack));
-    // Prepare result
-    std::vector<OpReturnType> resultItems;
-    // Get current item
-    if (_cachedItem == nullptr) {
-      _cachedItem = get_next_and_reset_next_generator(stack);
-    }
-    while (_cachedItem != nullptr) {
-      // Assign to target variable
-      _targetNode->set_variable(_cachedItem, stack);
-      // Check conditions
-      bool conditionsPassed = true;
-      for (auto& condNode : _conditionNodes) {
-        auto result = condNode->get(stack);
-        if (!result->get_bool()) {
-          conditionsPassed = false;
-          break;
-        }
-      }
-
-      // Skip if conditions aren't met
-      if (!conditionsPassed) {
-        _cachedItem = get_next_and_reset_next_generator(stack);
-        continue;
-      }
-
-      // Process this item
-      if (_nextGenerator != nullptr) {
-        auto res = _nextGenerator->get(stack);
-        if (res == nullptr) {
-          // _nextGenerator is exhausted, so we need to get the next item from the current generator
-          _cachedItem = get_next_and_reset_next_generator(stack);
-          continue;
-        }
-        return res;
-      } else if (!_elementNodes.empty()) {
-        for (auto& elem : _elementNodes) {
-          resultItems.push_back(elem->get(stack));
-        }
-        _cachedItem = get_next_and_reset_next_generator(stack);
-        return OpReturnType(new TupleDataVariable(std::move(resultItems)));
-      }
-      THROW("No next generator or element nodes found");
-    }
-    // If we get here, we've exhausted the generator
-    return nullptr;
+    THROW("%s", "generator can only be evaluated by its comprehension");
   }
 
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+
   ~SingleGeneratorNode() {
     delete _iterableNode;
     delete _targetNode;
@@ -568,10 +725,6 @@ class SingleGeneratorNode : public ASTNode {
     for (auto& cond : _conditionNodes) {
       delete cond;
     }
-    delete _iterable;
-    for (auto& elem : _elementNodes) {
-      delete elem;
-    }
   }
 };
 
@@ -581,10 +734,15 @@ class SingleGeneratorNode : public ASTNode {
  * ComprehensionNode manages a chain of generators for nested comprehensions.
  * It handles the creation and linking of multiple SingleGeneratorNode instances
  * to support complex expressions like [x*y for x in range(3) for y in range(3)].
+ *
+ * The iteration, the conditions and the consumer of the elements run fused in a
+ * single loop, see for_each(). Reductions like sum() consume the elements of a
+ * comprehension argument directly, see CallNode.
  */
 class ComprehensionNode : public ASTNode {
  protected:
   std::vector<SingleGeneratorNode*> _chainGenerators;  /**< Chain of generator nodes for nested comprehensions */
+  ASTNode* _elementNode = nullptr; /**< Element expression of list and generator comprehensions */
 
  public:
   // Constructor that handles all generators in the chain
@@ -616,29 +774,76 @@ class ComprehensionNode : public ASTNode {
     }
   }
 
+  /**
+   * @brief Creates a node evaluated in the scope of the innermost generator, owned by the caller.
+   */
   ASTNode* create_element_node(const json& eltJson) {
     if (!_chainGenerators.empty()) {
-      auto scope = _chainGenerators.back()->get_scope();
-      auto elementNode = create_node(scope, eltJson);
-      _chainGenerators.back()->add_element_node(elementNode);
-      return elementNode;
+      return create_node(_chainGenerators.back()->get_scope(), eltJson);
     }
     return nullptr;
   }
 
-  OpReturnType get_value(CallStack& stack) override { return _chainGenerators[0]->get(stack); }
+  /**
+   * @brief Calls consume() for every element of the comprehension, see
+   * SingleGeneratorNode::for_each().
+   *
+   * @param sizeHint If not null, set to the maximum number of elements if it is known before the
+   * first element is consumed, left unchanged otherwise.
+   */
+  template <class Consumer>
+  void for_each(CallStack& stack, Consumer&& consume, int* sizeHint = nullptr) {
+    if (_chainGenerators.empty()) {
+      return;
+    }
+    // With nested generators the size of the outermost iterable says nothing about the output
+    _chainGenerators[0]->for_each(stack, consume,
+                                  _chainGenerators.size() == 1 ? sizeHint : nullptr);
+  }
+
+  /**
+   * @brief Whether reduce() can be used, i.e. this is a list comprehension or a generator
+   * expression. Dict comprehensions have no element expression.
+   */
+  bool has_element() const { return _elementNode != nullptr; }
+
+  /**
+   * @brief Feeds the value of the element expression for every element to reduction, see
+   * has_element().
+   */
+  void reduce(Reduction& reduction, CallStack& stack);
+
+  /**
+   * @brief Evaluates the element expression for every element into a list.
+   */
+  OpReturnType get_list(CallStack& stack) {
+    std::vector<OpReturnType> resultItems;
+    int sizeHint = 0;
+    for_each(
+        stack,
+        [&]() {
+          if (resultItems.empty()) {
+            resultItems.reserve(sizeHint);
+          }
+          resultItems.push_back(_elementNode->get(stack));
+          return true;
+        },
+        &sizeHint);
+    return OpReturnType(new ListDataVariable(std::move(resultItems)));
+  }
+
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
 
   ~ComprehensionNode() {
     for (auto& generator : _chainGenerators) {
       delete generator;
     }
+    delete _elementNode;
   }
 };
 
 // List comprehension: [expr for var in iterable]
 class ListComprehensionNode : public ComprehensionNode {
-  ASTNode* _elementNode = nullptr;
-
  public:
   ListComprehensionNode(VariableScope* scope, const json& comprehensionJson)
       : ComprehensionNode(scope, comprehensionJson) {
@@ -648,23 +853,7 @@ class ListComprehensionNode : public ComprehensionNode {
   }
 
   // Run the full comprehension loop and return a complete list
-  OpReturnType get_value(CallStack& stack) override {
-    if (_chainGenerators.empty()) {
-      return OpReturnType(new ListDataVariable());
-    }
-    std::vector<OpReturnType> resultItems;
-    _chainGenerators[0]->reset_iterator();
-    // Iterate through all the generator's values and add them to our result list
-    while (true) {
-      auto response = _chainGenerators[0]->get(stack);
-      if (response == nullptr) {
-        break;
-      }
-      resultItems.push_back(response->get_int_subscript(0));
-    }
-    _chainGenerators[0]->reset_iterator();
-    return OpReturnType(new ListDataVariable(std::move(resultItems)));
-  }
+  OpReturnType get_value(CallStack& stack) override { return get_list(stack); }
 };
 
 // Dictionary comprehension: {key_expr: value_expr for var in iterable}
@@ -686,6 +875,8 @@ class DictComprehensionNode : public ComprehensionNode {
   // Run the full comprehension loop and return a dictionary
   OpReturnType get_value(CallStack& stack) override;
 
+  ASTNode* optimize(ScriptOptimizer& optimizer) override;
+
   ~DictComprehensionNode() {
     delete _keyNode;
     delete _valueNode;
@@ -694,8 +885,14 @@ class DictComprehensionNode : public ComprehensionNode {
 };
 
 // Generator expression: (expr for var in iterable)
+// Consumed element by element when passed to a reduction like sum(), evaluated into a list
+// otherwise
 class GeneratorExpNode : public ComprehensionNode {
  public:
   GeneratorExpNode(VariableScope* scope, const json& comprehensionJson)
-      : ComprehensionNode(scope, comprehensionJson) {}
+      : ComprehensionNode(scope, comprehensionJson) {
+    _elementNode = create_element_node(comprehensionJson.at("elt"));
+  }
+
+  OpReturnType get_value(CallStack& stack) override { return get_list(stack); }
 };
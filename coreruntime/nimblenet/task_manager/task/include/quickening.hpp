@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "data_variable.hpp"
+
+/**
+ * @brief Operand types an operator node has specialized itself for.
+ */
+enum class QuickenedOperands : uint8_t {
+  NONE,    /**< Still observing the operands */
+  INT64,   /**< Both operands are int64 scalars */
+  DOUBLE,  /**< Both operands are double scalars */
+  STRING,  /**< Both operands are strings */
+  GENERIC, /**< Operand types vary or are not specialized, always use the generic operators */
+};
+
+/**
+ * @brief Runtime quickening of BinNode and CompareNode.
+ *
+ * The generic operators check the container and data types of both operands and promote them on
+ * every evaluation. A node records the operand types of its first QUICKEN_AFTER executions; if they
+ * were always the same specialized pair, the node switches to a fast path for that pair. The fast
+ * path guards on the operand types, and the first operands failing the guard switch the node to the
+ * generic operators for good.
+ *
+ * Nodes can be evaluated by several threads at once, so the state is atomic. Races only affect how
+ * soon a node specializes, every path computes the same result.
+ */
+class Quickening {
+  std::atomic<QuickenedOperands> _operands = QuickenedOperands::NONE;
+  std::atomic<QuickenedOperands> _observed = QuickenedOperands::NONE;
+  std::atomic<int> _executions = 0;
+
+ public:
+  static constexpr int QUICKEN_AFTER = 8;
+
+  QuickenedOperands get() const { return _operands.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Records the operands of an execution in the NONE state.
+   */
+  void observe(QuickenedOperands operands) {
+    auto expected = QuickenedOperands::NONE;
+    if (!_observed.compare_exchange_strong(expected, operands, std::memory_order_relaxed) &&
+        expected != operands) {
+      deoptimize();
+      return;
+    }
+    if (operands == QuickenedOperands::GENERIC) {
+      deoptimize();
+      return;
+    }
+    if (_executions.fetch_add(1, std::memory_order_relaxed) + 1 == QUICKEN_AFTER) {
+      auto none = QuickenedOperands::NONE;
+      _operands.compare_exchange_strong(none, operands, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Gives up on specializing, called when the operands fail the guard of the fast path.
+   */
+  void deoptimize() { _operands.store(QuickenedOperands::GENERIC, std::memory_order_relaxed); }
+
+  /**
+   * @brief Returns true if data is a scalar of the given data type.
+   */
+  static bool is_scalar_of(const OpReturnType& data, int dataType) {
+    return data->get_containerType() == CONTAINERTYPE::SINGLE &&
+           data->get_dataType_enum() == dataType;
+  }
+
+  /**
+   * @brief Returns the specialization matching both operands, GENERIC if there is none.
+   */
+  static QuickenedOperands classify(const OpReturnType& v1, const OpReturnType& v2) {
+    if (v1->get_containerType() != CONTAINERTYPE::SINGLE ||
+        v2->get_containerType() != CONTAINERTYPE::SINGLE) {
+      return QuickenedOperands::GENERIC;
+    }
+    int dataType = v1->get_dataType_enum();
+    if (dataType != v2->get_dataType_enum()) {
+      return QuickenedOperands::GENERIC;
+    }
+    switch (dataType) {
+      case DATATYPE::INT64:
+        return QuickenedOperands::INT64;
+      case DATATYPE::DOUBLE:
+        return QuickenedOperands::DOUBLE;
+      case DATATYPE::STRING:
+        return QuickenedOperands::STRING;
+      default:
+        return QuickenedOperands::GENERIC;
+    }
+  }
+};
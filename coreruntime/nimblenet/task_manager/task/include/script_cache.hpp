@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "json.hpp"
+
+/**
+ * @brief Binary cache of the AST of a script, stored next to the script asset.
+ *
+ * Parsing the JSON AST of a large script is the most expensive part of loading it. The cache
+ * stores the AST of every module of the script encoded as CBOR, which is parsed several times
+ * faster than JSON text. The file is memory mapped and a module is decoded only when it is
+ * requested, so modules which are never imported are never decoded.
+ *
+ * File layout, integers are in the byte order of the device:
+ * @code
+ * uint32 magic, uint32 format version
+ * uint32 length, script name
+ * uint32 length, script version
+ * uint32 number of modules
+ * number of modules x (uint32 length, module name, uint64 offset, uint64 size)
+ * CBOR encoded module ASTs, offsets are from the start of the file
+ * @endcode
+ */
+class ScriptCache {
+  struct Entry {
+    uint64_t offset; /**< Offset of the encoded module from the start of the file */
+    uint64_t size;   /**< Size of the encoded module */
+  };
+
+  std::string _path;                     /**< Path of the file, removed if a module is corrupted */
+  const uint8_t* _data = nullptr;       /**< Memory mapped file */
+  size_t _size = 0;                     /**< Size of the file */
+  std::map<std::string, Entry> _modules; /**< Module name to location of its encoded AST */
+
+  ScriptCache(const std::string& path, const uint8_t* data, size_t size)
+      : _path(path), _data(data), _size(size) {}
+
+  bool parse_header(const std::string& scriptName, const std::string& version);
+
+ public:
+  static constexpr uint32_t MAGIC = 0x5453414E;   /**< "NAST" */
+  static constexpr uint32_t FORMAT_VERSION = 2;  /**< Bumped on any change of the file layout */
+
+  ScriptCache(const ScriptCache&) = delete;
+  ScriptCache& operator=(const ScriptCache&) = delete;
+
+  /**
+   * @brief Returns the path of the cache of version of the script named scriptName stored at
+   * scriptPath.
+   *
+   * The path contains the version, like the script asset itself, so two versions of a script do
+   * not overwrite each other's cache. As names and versions can contain dots, two scripts can
+   * still share a path, e.g. foo version 2.1.0 and foo.2 version 1.0, so the name and the version
+   * are checked against the header on load.
+   */
+  static std::string get_cache_path(const std::string& scriptPath, const std::string& scriptName,
+                                    const std::string& version);
+
+  /**
+   * @brief Memory maps the cache at path.
+   *
+   * @return nullptr if the file does not exist, is corrupted or was written for another script,
+   * script version or format version.
+   */
+  static std::shared_ptr<ScriptCache> load(const std::string& path, const std::string& scriptName,
+                                           const std::string& version);
+
+  /**
+   * @brief Writes the cache for a script.
+   *
+   * @param modules JSON object from module name to the AST of the module.
+   * @return true if the cache was written.
+   */
+  static bool save(const std::string& path, const std::string& scriptName,
+                   const std::string& version, const nlohmann::json& modules);
+
+  /**
+   * @brief Removes the caches of the script named scriptName, stored next to path, other than the
+   * one at path.
+   *
+   * Called once the cache of a new version is written, so that the caches of earlier versions do
+   * not pile up next to the assets. A cache is removed if the script name in its header is
+   * scriptName, rather than the name in its file name, so that caches of scripts named
+   * <scriptName>.<suffix> are kept. Caches of earlier format versions are removed as well, as they
+   * can no longer be loaded.
+   */
+  static void remove_other_versions(const std::string& path, const std::string& scriptName);
+
+  bool has_module(const std::string& name) const { return _modules.count(name); }
+
+  /**
+   * @brief Decodes the AST of a module, the module must exist.
+   *
+   * @return null if the encoded module is corrupted, in which case the cache file is removed so
+   * that it is written again by the next load of the script.
+   */
+  nlohmann::json get_module(const std::string& name) const;
+
+  ~ScriptCache();
+};
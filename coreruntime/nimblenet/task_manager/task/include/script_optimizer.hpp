@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ne_fwd.hpp"
+#include "variable_scope.hpp"
+
+class ASTNode;
+class Statement;
+class Body;
+class FunctionDef;
+
+/**
+ * @brief Load time optimization pass over the statement tree of a module.
+ *
+ * The pass runs once after a module is parsed and before its body is executed. Statements and
+ * nodes rewrite themselves through their optimize() hooks:
+ * - Operators whose operands are all constants are folded into a ConstantNode.
+ * - If statements over a constant test keep only the branch taken, while loops over a constant
+ *   false test, asserts over a constant true test and statements after a return, break, continue
+ *   or raise are removed.
+ * - Builtin functions and module level variables which are assigned a constant exactly once in
+ *   the module are resolved to a ConstantNode, so that loading them does not touch the call stack.
+ *
+ * Module level statements are optimized first, in order. Function bodies are optimized afterwards
+ * so that they see every module level constant, and are then compiled to bytecode if enabled.
+ */
+class ScriptOptimizer {
+  enum class Phase { MODULE, FUNCTIONS };
+
+  bool _optimize = false;         /**< Whether statements and nodes are rewritten */
+  bool _compileBytecode = false;  /**< Whether function bodies are compiled to bytecode */
+  Phase _phase = Phase::MODULE;   /**< Phase of the pass */
+  int _bodyDepth = 0;             /**< Number of bodies enclosing the statement being optimized */
+
+  std::vector<std::pair<StackLocation, OpReturnType>> _constants; /**< Variables bound to a constant */
+  std::vector<FunctionDef*> _deferredFunctions; /**< Functions to process after the module body */
+
+  int _numFolded = 0;           /**< Number of expressions folded into constants */
+  int _numStatementsRemoved = 0; /**< Number of dead statements and branches removed */
+  int _numNamesResolved = 0;    /**< Number of variable loads resolved to constants */
+
+  void process_function(FunctionDef* function);
+
+ public:
+  ScriptOptimizer(bool optimize, bool compileBytecode)
+      : _optimize(optimize), _compileBytecode(compileBytecode) {}
+
+  /**
+   * @brief Optimizes the body of a module and compiles its functions.
+   */
+  void optimize_module(Body& body);
+
+  bool enabled() const { return _optimize; }
+
+  /**
+   * @brief Optimizes a node, deleting it if it gets replaced.
+   *
+   * @return Node to use in place of node.
+   */
+  ASTNode* optimize(ASTNode* node);
+
+  /**
+   * @brief Optimizes a statement, deleting it if it gets replaced or removed.
+   *
+   * @return Statement to use in place of statement, nullptr if the statement has to be removed.
+   */
+  Statement* optimize(Statement* statement);
+
+  /**
+   * @brief Optimizes the statements of a body in place.
+   */
+  void optimize(std::vector<Statement*>& codeLines);
+
+  /**
+   * @brief Evaluates a node whose operands are constants.
+   *
+   * @return ConstantNode holding the result, or node itself if it cannot be evaluated at load time
+   * e.g. because it raises an error, which is then raised when the script runs.
+   */
+  ASTNode* fold(ASTNode* node, VariableScope* scope, int lineNo);
+
+  /**
+   * @brief Called for a function definition, the body is processed once the module level
+   * statements are done.
+   */
+  void add_function(FunctionDef* function);
+
+  /**
+   * @brief Records that the variable at loc is assigned the constant value.
+   */
+  void add_constant(const StackLocation& loc, OpReturnType value);
+
+  /**
+   * @brief Records that the variable at loc is assigned value, which is a constant if the
+   * assignment is at the top level of the module.
+   */
+  void add_assignment(const StackLocation& loc, OpReturnType value);
+
+  /**
+   * @brief Returns the constant bound to the variable at loc, nullptr if there is none.
+   */
+  OpReturnType get_constant(const StackLocation& loc, const VariableScope* scope);
+
+  void statement_removed() { _numStatementsRemoved++; }
+};
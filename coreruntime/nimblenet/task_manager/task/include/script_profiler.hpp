@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Profiler of script execution, records the time spent per function and per line.
+ *
+ * The profiler is off by default and is enabled by the profileScript flag of the config when the
+ * script is loaded. Once enabled, every call of a script function, every executed line of the
+ * interpreter and the load of every module enter a frame of the profiler. Frames are kept in a
+ * tree of call paths, each node counting the calls of its path and the time spent in it, which
+ * gives the inclusive time of the node and, subtracting the time of its children, its exclusive
+ * time. When disabled, entering a frame costs a single relaxed atomic load.
+ *
+ * Every thread records into a tree of its own, so that threads running the script concurrently do
+ * not contend with each other. The trees are merged when the profile is read. Functions run by the
+ * ConcurrentExecutor are roots of the tree of the worker thread.
+ *
+ * Lines are profiled by the AST interpreter only, functions compiled to bytecode are profiled as a
+ * whole.
+ */
+class ScriptProfiler {
+ public:
+  /**
+   * @brief Output formats of the profile.
+   */
+  enum class Format {
+    COLLAPSED, /**< One "frame;frame;frame microseconds" line per call path, for flame graphs */
+    JSON,      /**< Calls, inclusive and exclusive microseconds per function and per line */
+  };
+
+ private:
+  struct Node {
+    std::string name;      /**< Name of the function or module, empty for lines */
+    int line = -1;         /**< Line number of line frames, -1 for functions and modules */
+    Node* parent = nullptr;
+    int64_t calls = 0;
+    int64_t totalNs = 0;   /**< Time spent in the node, including its children */
+    std::unordered_map<const void*, std::unique_ptr<Node>> children;
+  };
+
+  struct ThreadProfile {
+    std::mutex mutex; /**< Taken by the owning thread for every update and by readers of the tree */
+    Node root;
+    Node* current = &root;
+    int depth = 0;
+    uint64_t generation = 0;
+  };
+
+  static std::atomic<bool> _enabled;
+  static std::atomic<uint64_t> _generation; /**< Incremented by reset() */
+  static std::mutex _mutex;                 /**< Guards _threads */
+  static std::vector<std::shared_ptr<ThreadProfile>> _threads;
+
+  /**
+   * @brief Profile of the calling thread, replaced by a fresh one after reset() once the thread
+   * has left all its frames.
+   */
+  static ThreadProfile& thread_profile();
+
+  friend class ProfilerScope;
+
+ public:
+  static bool enabled() noexcept { return _enabled.load(std::memory_order_relaxed); }
+
+  static void set_enabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+  /**
+   * @brief Drops the recorded profile, frames open on other threads are recorded to the old one.
+   */
+  static void reset();
+
+  /**
+   * @brief Returns the profile recorded since the last reset() in the given format.
+   */
+  static std::string get_profile(Format format);
+
+  /**
+   * @brief Writes get_profile(format) to filePath.
+   */
+  static void write_profile(Format format, const std::string& filePath);
+
+  /**
+   * @brief Parses the name of a format, "collapsed" or "json".
+   */
+  static Format parse_format(const std::string& format);
+};
+
+/**
+ * @brief Frame of the profiler, entered for the lifetime of the object if profiling is enabled.
+ */
+class ProfilerScope {
+  ScriptProfiler::ThreadProfile* _profile = nullptr; /**< nullptr if profiling was disabled */
+  ScriptProfiler::Node* _node = nullptr;
+  std::chrono::steady_clock::time_point _start;
+
+  void enter(const void* key, const std::string& name, int line);
+  void exit();
+
+ public:
+  /**
+   * @brief Enters the frame of a function or module, identified by key.
+   */
+  ProfilerScope(const void* key, const std::string& name) {
+    if (ScriptProfiler::enabled()) {
+      enter(key, name, -1);
+    }
+  }
+
+  /**
+   * @brief Enters the frame of a line of the enclosing function, identified by key.
+   */
+  ProfilerScope(const void* key, int line) {
+    if (ScriptProfiler::enabled()) {
+      static const std::string noName;
+      enter(key, noName, line);
+    }
+  }
+
+  ~ProfilerScope() {
+    if (_profile) {
+      exit();
+    }
+  }
+
+  ProfilerScope(const ProfilerScope&) = delete;
+  ProfilerScope& operator=(const ProfilerScope&) = delete;
+};
@@ -6,16 +6,19 @@
 
 #pragma once
 
+#include "bytecode.hpp"
 #include "data_variable.hpp"
 #include "json.hpp"
 #include "nimble_net_data_variable.hpp"
 #include "nimble_net_internal_data_variable.hpp"
 #include "node.hpp"
 #include "regex_data_variable.hpp"
+#include "script_optimizer.hpp"
 
 class VariableScope;
 
 enum RETURNTYPE {
+  NORMAL = 0,
   BREAK = 1,
   CONTINUE = 2,
   RETURN = 3,
@@ -28,23 +31,34 @@ static std::unordered_map<std::string, DECORATOR_TYPE> _decoratorNameMap = {
     {"concurrent", DECORATOR_TYPE::CONCURRENT_METHOD},
     {"pre_add_event", DECORATOR_TYPE::PRE_ADD_EVENT_HOOK}};
 
+/**
+ * @brief Control flow signalled by an executed statement.
+ *
+ * Returned by value from Statement::execute(), so executing a statement does not allocate. The type
+ * is RETURNTYPE::NORMAL when execution continues with the next statement.
+ */
 class StatRetType {
-  StatRetType(int t, OpReturnType d) {
-    type = t;
-    returnVal = d;
-  }
+  StatRetType(int t, OpReturnType&& d) : returnVal(std::move(d)), type(t) {}
 
  public:
   OpReturnType returnVal = nullptr;
-  int type = -1;
+  int type = RETURNTYPE::NORMAL;
+
+  StatRetType() = default;
 
-  static StatRetType* create_return(OpReturnType d) {
-    return new StatRetType(RETURNTYPE::RETURN, d);
+  /**
+   * @brief Whether the statement ends the enclosing loop or function, i.e. break, continue or
+   * return.
+   */
+  bool is_control_flow() const { return type != RETURNTYPE::NORMAL; }
+
+  static StatRetType create_return(OpReturnType d) {
+    return StatRetType(RETURNTYPE::RETURN, std::move(d));
   }
 
-  static StatRetType* create_break() { return new StatRetType(RETURNTYPE::BREAK, nullptr); }
+  static StatRetType create_break() { return StatRetType(RETURNTYPE::BREAK, nullptr); }
 
-  static StatRetType* create_continue() { return new StatRetType(RETURNTYPE::CONTINUE, nullptr); }
+  static StatRetType create_continue() { return StatRetType(RETURNTYPE::CONTINUE, nullptr); }
 };
 
 class Statement {
@@ -54,6 +68,8 @@ class Statement {
  protected:
   int _lineNo = -1;
 
+  Statement(int lineNo) { _lineNo = lineNo; }
+
  public:
   virtual ~Statement() = default;
 
@@ -61,7 +77,28 @@ class Statement {
 
   int get_line() { return _lineNo; }
 
-  virtual StatRetType* execute(CallStack& stack) = 0;
+  virtual StatRetType execute(CallStack& stack) = 0;
+
+  /**
+   * @brief Emits bytecode for this statement.
+   *
+   * Statements without a dedicated lowering are executed by the VM through execute().
+   */
+  virtual void compile(BytecodeCompiler& compiler);
+
+  /**
+   * @brief Optimizes the nodes and bodies of this statement.
+   *
+   * @return Statement to use in place of this one, which can be a newly created statement, or
+   * nullptr if the statement does nothing and can be removed. The caller deletes this statement if
+   * it is not returned.
+   */
+  virtual Statement* optimize(ScriptOptimizer& optimizer) { return this; }
+
+  /**
+   * @brief Appends the statement as Python like source to out, used to debug the optimized tree.
+   */
+  virtual void dump(std::string& out, int indent) const;
 };
 
 /*
@@ -78,7 +115,13 @@ class AssignStatement : public Statement {
  public:
   AssignStatement(VariableScope* scope, const json& line);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  void compile(BytecodeCompiler& compiler) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
 
   virtual ~AssignStatement();
 };
@@ -96,7 +139,13 @@ class ExprStatement : public Statement {
  public:
   ExprStatement(VariableScope* scope, const json& line);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  void compile(BytecodeCompiler& compiler) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
 
   virtual ~ExprStatement();
 };
@@ -114,7 +163,13 @@ class ReturnStatement : public Statement {
  public:
   ReturnStatement(VariableScope* scope, const json& line);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  void compile(BytecodeCompiler& compiler) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
 
   virtual ~ReturnStatement();
 };
@@ -123,14 +178,22 @@ class BreakStatement : public Statement {
  public:
   BreakStatement(VariableScope* scope, const json& line) : Statement(line) {}
 
-  StatRetType* execute(CallStack& stack) override { return StatRetType::create_break(); };
+  StatRetType execute(CallStack& stack) override { return StatRetType::create_break(); };
+
+  void compile(BytecodeCompiler& compiler) override;
+
+  void dump(std::string& out, int indent) const override;
 };
 
 class ContinueStatement : public Statement {
  public:
   ContinueStatement(VariableScope* scope, const json& line) : Statement(line) {}
 
-  StatRetType* execute(CallStack& stack) override { return StatRetType::create_continue(); };
+  StatRetType execute(CallStack& stack) override { return StatRetType::create_continue(); };
+
+  void compile(BytecodeCompiler& compiler) override;
+
+  void dump(std::string& out, int indent) const override;
 };
 
 class Body {
@@ -139,7 +202,15 @@ class Body {
  public:
   Body(VariableScope* scope, const json& body, Statement* initialStatement = nullptr);
 
-  StatRetType* execute(CallStack& stack);
+  StatRetType execute(CallStack& stack);
+
+  void compile(BytecodeCompiler& compiler) const;
+
+  void optimize(ScriptOptimizer& optimizer) { optimizer.optimize(_codeLines); }
+
+  bool empty() const { return _codeLines.empty(); }
+
+  void dump(std::string& out, int indent) const;
 
   ~Body() {
     for (auto line : _codeLines) {
@@ -167,6 +238,7 @@ class FunctionDef : public Statement, public std::enable_shared_from_this<Functi
   StackLocation _functionLocation = StackLocation::null;  /**< Location of the function in the stack */
   // ^This is  maintained by VariableScope, we just use it here on execution
   StackLocation _stackLocation{StackLocation::null};  /**< Stack location for the function itself */
+  std::unique_ptr<BytecodeFunction> _bytecode;  /**< Compiled body, nullptr when the body is interpreted */
 
   void set_static() { _static = true; }
 
@@ -176,7 +248,20 @@ class FunctionDef : public Statement, public std::enable_shared_from_this<Functi
   FunctionDef(VariableScope* scope, const json& line, StackLocation&& functionLocation);
   OpReturnType call_function(const std::vector<OpReturnType>& arguments, CallStack& stack);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  /**
+   * @brief Optimizes the decorators, the body is handed over to the optimizer which processes it
+   * with process_body() once the enclosing module body is done.
+   */
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  /**
+   * @brief Optimizes the body and compiles it to bytecode if compileBytecode is set.
+   */
+  void process_body(ScriptOptimizer& optimizer, bool compileBytecode);
+
+  void dump(std::string& out, int indent) const override;
 
   std::string get_function_name() const { return _functionName; }
 
@@ -230,7 +315,15 @@ class FunctionDataVariable final : public DataVariable {
 
   nlohmann::json to_json() const override { return "[Function]"; }
 
-  void set_static() { _def->set_static(); }
+  void set_static() {
+    _def->set_static();
+    // Static functions run without the script lock, possibly on several threads at once
+    _stack.share_frames();
+  }
+
+  // The function can be called from other threads, which access the frames it captured
+  void mark_shared() final { _stack.share_frames(); }
+
   friend class CustomFunctions;
 
  public:
@@ -279,12 +372,15 @@ class ImportStatement : public Statement {
       if (aliasName.type() != json::value_t::null) {
         varName = aliasName;
       }
-      const auto stackLocation = scope->add_variable(varName);
+      // Imports can shadow builtins like min()
+      const auto stackLocation = scope->add_or_shadow_builtin(varName);
       _imports.push_back({module, importName, stackLocation});
     }
   }
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  void dump(std::string& out, int indent) const override;
 };
 
 class ForStatement : public Statement {
@@ -295,7 +391,13 @@ class ForStatement : public Statement {
  public:
   ForStatement(VariableScope* scope, const json& line);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  void compile(BytecodeCompiler& compiler) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
 
   virtual ~ForStatement();
 };
@@ -307,7 +409,13 @@ class WhileStatement : public Statement {
  public:
   WhileStatement(VariableScope* scope, const json& line);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  void compile(BytecodeCompiler& compiler) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
 
   virtual ~WhileStatement();
 };
@@ -320,7 +428,13 @@ class IfStatement : public Statement {
  public:
   IfStatement(VariableScope* scope, const json& line);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  void compile(BytecodeCompiler& compiler) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
 
   virtual ~IfStatement();
 };
@@ -332,7 +446,11 @@ class AssertStatement : public Statement {
  public:
   AssertStatement(VariableScope* scope, const json& line);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
 
   virtual ~AssertStatement();
 };
@@ -343,7 +461,11 @@ class RaiseStatement : public Statement {
  public:
   RaiseStatement(VariableScope* scope, const json& line);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
 
   virtual ~RaiseStatement();
 };
@@ -356,15 +478,19 @@ class Handler : public Statement {
  public:
   Handler(VariableScope* scope, const json& line);
 
-  StatRetType* catch_exception(CallStack& stack, OpReturnType exception);
+  StatRetType catch_exception(CallStack& stack, OpReturnType exception);
 
-  StatRetType* execute(CallStack& stack) override {
+  StatRetType execute(CallStack& stack) override {
     THROW("%s", "Should not be called");
-    return nullptr;
+    return StatRetType();
   }
 
   bool match_expectation_type(const std::string& type) const;
 
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
+
   virtual ~Handler() { delete _body; }
 };
 
@@ -375,7 +501,11 @@ class TryStatement : public Statement {
  public:
   TryStatement(VariableScope* scope, const json& line);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
 
   virtual ~TryStatement() { delete _tryBody; }
 };
@@ -386,7 +516,33 @@ class InbuiltFunctionsStatement : public Statement {
  public:
   InbuiltFunctionsStatement(VariableScope* scope);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
+};
+
+/**
+ * @brief Executes a body in place of a statement which always executes it, e.g. an if statement
+ * over a constant test. Created by the ScriptOptimizer, keeps the line of the replaced statement
+ * so that errors are reported in the same way.
+ */
+class BlockStatement : public Statement {
+  Body* _body = nullptr;
+
+ public:
+  BlockStatement(int lineNo, Body* body) : Statement(lineNo), _body(body) {}
+
+  StatRetType execute(CallStack& stack) override { return _body->execute(stack); }
+
+  void compile(BytecodeCompiler& compiler) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
+
+  virtual ~BlockStatement() { delete _body; }
 };
 
 /**
@@ -404,7 +560,11 @@ class ClassDef : public Statement, public std::enable_shared_from_this<ClassDef>
  public:
   ClassDef(VariableScope* scope, const json& line);
 
-  StatRetType* execute(CallStack& stack) override;
+  StatRetType execute(CallStack& stack) override;
+
+  Statement* optimize(ScriptOptimizer& optimizer) override;
+
+  void dump(std::string& out, int indent) const override;
 
   virtual ~ClassDef() {}
 };
@@ -419,6 +579,9 @@ class ClassDef : public Statement, public std::enable_shared_from_this<ClassDef>
 class ClassDataVariable final : public DataVariable {
   // map from member index to datavariable
   std::map<int, OpReturnType> _membersMap;  /**< Map of member indices to their values */
+  uint64_t _layoutId;  /**< Identifies the current set of members, used by MemberInlineCache */
+
+  static uint64_t next_layout_id();
 
   int get_dataType_enum() const final { return DATATYPE::NONE; }
 
@@ -442,6 +605,18 @@ class ClassDataVariable final : public DataVariable {
   OpReturnType get_member(int memberIndex) override;
 
   void set_member(int memberIndex, OpReturnType d) override;
+
+  /**
+   * @brief Returns the member at memberIndex, nullptr if the class does not have it.
+   */
+  OpReturnType find_member(int memberIndex) const;
+
+  /**
+   * @brief Id which changes whenever a member is set and is never shared by two classes.
+   *
+   * Members resolved for a layout id stay valid as long as the class has the same layout id.
+   */
+  uint64_t layout_id() const { return _layoutId; }
 };
 
 /**
@@ -455,6 +630,7 @@ class ObjectDataVariable final : public DataVariable {
   OpReturnType _classDataVariable;  /**< Reference to the class definition */
   // map from member index to datavariable
   std::map<int, OpReturnType> _membersMap;  /**< Map of member indices to their values */
+  bool _shared = false;                     /**< Whether mark_shared() was called */
 
   int get_dataType_enum() const final { return DATATYPE::NONE; }
 
@@ -475,6 +651,17 @@ class ObjectDataVariable final : public DataVariable {
   OpReturnType get_member(int memberIndex) override;
 
   void set_member(int memberIndex, OpReturnType d) override;
+
+  void mark_shared() override;
+
+  /**
+   * @brief Whether the member was set on the object itself instead of its class.
+   */
+  bool has_own_member(int memberIndex) const { return _membersMap.count(memberIndex); }
+
+  ClassDataVariable* get_class() const {
+    return static_cast<ClassDataVariable*>(_classDataVariable.get());
+  }
 };
 
 /*
@@ -489,7 +676,14 @@ class RuntimeClassDef : public Statement {
     _classDef = std::make_shared<ClassDef>(scope, line);
   }
 
-  StatRetType* execute(CallStack& stack) override { return _classDef->execute(stack); }
+  StatRetType execute(CallStack& stack) override { return _classDef->execute(stack); }
+
+  Statement* optimize(ScriptOptimizer& optimizer) override {
+    _classDef->optimize(optimizer);
+    return this;
+  }
+
+  void dump(std::string& out, int indent) const override { _classDef->dump(out, indent); }
 };
 
 /**
@@ -518,9 +712,17 @@ class RuntimeFunctionDef : public Statement {
 
   static RuntimeFunctionDef* create_normal_function_def(VariableScope* scope, const json& line) {
     auto funcName = line.at("name");
-    auto location = scope->add_variable(funcName);
+    // A module can redefine a function or a builtin like min()
+    auto location = scope->add_or_shadow_builtin(funcName);
     return new RuntimeFunctionDef(scope, line, std::move(location));
   }
 
-  StatRetType* execute(CallStack& stack) override { return _functionDef->execute(stack); }
+  StatRetType execute(CallStack& stack) override { return _functionDef->execute(stack); }
+
+  Statement* optimize(ScriptOptimizer& optimizer) override {
+    _functionDef->optimize(optimizer);
+    return this;
+  }
+
+  void dump(std::string& out, int indent) const override { _functionDef->dump(out, indent); }
 };
@@ -21,6 +21,7 @@
 #include "job.hpp"
 #include "json.hpp"
 #include "rigtorp/SPSCQueue.h"
+#include "script_cache.hpp"
 #include "variable_scope.hpp"
 
 class CharStream;
@@ -77,8 +78,12 @@ class Task {
   std::vector<std::weak_ptr<FutureDataVariable>> _pendingFutures;  /**< Pending future variables awaiting completion */
 
   json _astJson;  /**< Abstract Syntax Tree representation of the task */
+  std::shared_ptr<ScriptCache> _scriptCache;  /**< Cached AST, used instead of _astJson when set */
+  std::string _scriptPath;  /**< Script asset, parsed again if _scriptCache is corrupted */
   std::unique_ptr<DpModule> _mainModule;  /**< The main module containing the entry point */
   std::unordered_map<std::string, std::shared_ptr<DpModule>> _modules;  /**< All modules in this task */
+  bool _compileBytecode = false;  /**< Whether module functions are compiled to bytecode on parse */
+  bool _optimizeScript = false;   /**< Whether modules are optimized on parse */
 
   std::shared_mutex _taskMutex;  /**< Mutex for thread-safe task operations */
 #ifdef GENAI
@@ -95,6 +100,8 @@ class Task {
   void run_background_jobs_on_new_thread();
 #endif
 
+  json get_module_ast(const std::string& name);
+
  public:
   Task(const std::string& version, const std::string& ast, CommandCenter* commandCenter);
   Task(const std::string& version, json&& astJson, CommandCenter* commandCenter);
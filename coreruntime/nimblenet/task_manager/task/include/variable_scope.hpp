@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <set>
 #include <shared_mutex>
 
 #include "data_variable.hpp"
 #include "ne_fwd.hpp"
+#include "value.hpp"
 
 #ifdef GENAI
 #include "llm_data_variable.hpp"
@@ -60,16 +63,30 @@ class CallStack;
  *
  * Each stack frame contains the local variables for a function call,
  * along with metadata about the module and function being executed.
- * Thread-safe access to variable values is provided through mutex protection.
+ * Bool and numeric variables are kept unboxed, they are boxed lazily when read as a DataVariable.
+ *
+ * A frame is private to the thread which created it and is accessed without locking. Before the
+ * frame becomes reachable from a thread which does not hold the script lock, i.e. when its stack is
+ * captured by run_parallel or by a concurrent function, share() switches it to locking the mutex on
+ * every access. A frame never goes back to private.
  */
 class StackFrame {
   using StackFramePtr = std::shared_ptr<StackFrame>;
 
-  std::vector<OpReturnType> _varValues;  /**< Storage for variable values in this frame */
+  std::vector<Value> _varValues;  /**< Storage for variable values in this frame */
   // StackFramePtr _parentFrame;
   int _moduleIndex;    /**< Index of the module this frame belongs to */
   int _functionIndex;  /**< Index of the function this frame represents */
-  std::mutex mutex;    /**< Mutex for thread-safe access to variable values */
+  std::mutex mutex;    /**< Mutex for thread-safe access to variable values, once shared */
+  std::atomic<bool> _shared{false}; /**< Whether the frame can be accessed by multiple threads */
+
+  std::unique_lock<std::mutex> lock_if_shared() {
+    std::unique_lock<std::mutex> locker(mutex, std::defer_lock);
+    if (_shared.load(std::memory_order_acquire)) {
+      locker.lock();
+    }
+    return locker;
+  }
 
  public:
   int get_module_index() const { return _moduleIndex; }
@@ -79,16 +96,53 @@ class StackFrame {
   StackFrame(int moduleIndex, int functionIndex, int numVariables)
       : _moduleIndex(moduleIndex), _functionIndex(functionIndex), _varValues(numVariables) {}
 
-  OpReturnType get(int varIndex) {
+  /**
+   * @brief Makes further accesses of the frame thread safe.
+   *
+   * Has to be called by a thread which can access the frame, before handing the frame to another
+   * thread. Variables of the frame, and the ones stored in it later, are marked shared as well.
+   */
+  void share() {
+    if (_shared.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
     std::lock_guard<std::mutex> locker(mutex);
+    for (const auto& value : _varValues) {
+      if (value.tag() == Value::Tag::BOXED) {
+        value.box()->mark_shared();
+      }
+    }
+  }
+
+  OpReturnType get(int varIndex) {
+    auto locker = lock_if_shared();
     assert(_varValues.size() > varIndex);
-    return _varValues[varIndex];
+    // The box is cached in the slot, so repeated reads of a scalar allocate only once
+    return _varValues[varIndex].box();
   }
 
   void set(int varIndex, OpReturnType val) {
-    std::lock_guard<std::mutex> locker(mutex);
+    if (val && _shared.load(std::memory_order_acquire)) {
+      val->mark_shared();
+    }
+    auto locker = lock_if_shared();
+    assert(_varValues.size() > varIndex);
+    _varValues[varIndex] = Value::unbox(val);
+  }
+
+  Value get_value(int varIndex) {
+    auto locker = lock_if_shared();
+    assert(_varValues.size() > varIndex);
+    return _varValues[varIndex];
+  }
+
+  void set_value(int varIndex, Value val) {
+    if (val.tag() == Value::Tag::BOXED && _shared.load(std::memory_order_acquire)) {
+      val.box()->mark_shared();
+    }
+    auto locker = lock_if_shared();
     assert(_varValues.size() > varIndex);
-    _varValues[varIndex] = val;
+    _varValues[varIndex] = std::move(val);
   }
 };
 
@@ -159,6 +213,13 @@ class ScopedUnlock {
  * all active function calls and their local variables. It provides
  * thread-safe access to variables through stack locations and manages
  * the lifecycle of stack frames.
+ *
+ * Copies of a stack share its frames, they are made for every call of a function (which runs on
+ * the stack captured at its definition) and for every item of run_parallel. To make a copy O(1),
+ * the index of frames is shared copy-on-write between copies. Frames entered on a stack whose index
+ * is shared are kept in a short list of pushed frames, searched before the index, and are moved into
+ * a private copy of the index only if the list grows beyond MAX_PUSHED_FRAMES or a frame of the
+ * index is exited.
  */
 class CallStack {
   // copy and copy assignment is overriden for this class, if any other change made to
@@ -166,8 +227,33 @@ class CallStack {
 
   using StackFramePtr = std::shared_ptr<StackFrame>;
 
-  std::vector<StackFramePtr> _functionsStack;  /**< Current call stack of active functions */
-  std::vector<std::vector<std::vector<StackFramePtr>>> _moduleToStackFrameMap;  /**< 3D map: module -> function -> stack frames */
+  struct FrameIndex {
+    std::vector<StackFramePtr> functionsStack;  /**< Current call stack of active functions */
+    std::vector<std::vector<std::vector<StackFramePtr>>> moduleToStackFrameMap;  /**< 3D map: module -> function -> stack frames */
+
+    void push(StackFramePtr frame);
+    void pop();
+  };
+
+  static constexpr int MAX_PUSHED_FRAMES = 8;
+
+  std::shared_ptr<FrameIndex> _index = std::make_shared<FrameIndex>(); /**< Frames, shared with copies of the stack */
+  std::vector<StackFramePtr> _pushedFrames; /**< Frames entered while _index was shared, innermost last */
+  /**
+   * Whether _index was created by this stack and never handed to a copy, so it can be mutated in
+   * place. Ownership is tracked explicitly instead of checking _index.use_count(), which is a relaxed
+   * load and does not order the mutation after the reads of a copy on another thread. Copying a
+   * stack clears it on both stacks, so each of them copies the index before mutating it. Atomic
+   * since stacks of concurrent calls are copied from the same stack.
+   */
+  mutable std::atomic<bool> _ownsIndex = true;
+
+  StackFrame& top_frame(const StackLocation& loc) const;
+
+  /**
+   * @brief Makes _index private to this stack and moves the pushed frames into it.
+   */
+  void materialize_index();
 
   CommandCenter* _commandCenter = nullptr;  /**< Reference to the command center for task access */
 
@@ -188,6 +274,16 @@ class CallStack {
   OpReturnType get_variable(StackLocation loc) const;
   void set_variable(StackLocation loc, OpReturnType val);
 
+  /**
+   * @brief Same as get_variable() but does not box bool and numeric variables.
+   */
+  Value get_value(StackLocation loc) const;
+
+  /**
+   * @brief Same as set_variable() but keeps bool and numeric values unboxed.
+   */
+  void set_value(StackLocation loc, Value val);
+
   CallStack& operator=(const CallStack& other);
 
   CallStack create_copy_with_deferred_lock();
@@ -202,6 +298,13 @@ class CallStack {
 
   bool is_script_lock_created() const { return lock.mutex(); }
 
+  /**
+   * @brief Shares all frames of the stack with other threads, see StackFrame::share().
+   *
+   * Frames entered afterwards on a copy of the stack stay private to the thread using the copy.
+   */
+  void share_frames();
+
   void enter_function_frame(int moduleIndex, int functionIndex, int numVariablesInFrame);
   void exit_function_frame();
 
@@ -234,6 +337,16 @@ class VariableScope {
   // of the number of variables a stack frame has and assign indices appropriately
   std::shared_ptr<int> _numVariablesStack;  /**< Shared counter for variables in the stack frame */
 
+  // Number of places in the script which assign each variable, shared across all the scopes of a
+  // module. Keyed by the function index and variable index of the variable's location.
+  std::shared_ptr<std::map<std::pair<int, int>, int>> _numBindings;  /**< Binding sites per variable */
+
+  // Locations of the builtin functions, shared across all the scopes of a module
+  std::shared_ptr<std::set<std::pair<int, int>>> _builtins;  /**< Builtin function locations */
+
+  // Builtin names assigned in blocks of this function scope, see add_or_shadow_builtin()
+  std::set<std::string> _builtinsShadowedInBlocks;
+
   VariableScope(VariableScope* p, bool isNewFunction);
 
   int get_variable_index_in_scope(const std::string& variableName);
@@ -258,6 +371,32 @@ class VariableScope {
 
   StackLocation add_variable(const std::string& variableName);
 
+  /**
+   * @brief Same as add_variable(), but a builtin with the same name in this scope is rebound instead
+   * of failing, e.g. for a module level function shadowing a builtin. The rebound variable is no
+   * longer a builtin, so defining it a second time fails. A builtin name added in a block, e.g. the
+   * body of an if or a for, is only visible in that block, later loads of the name in the enclosing
+   * function fail like loads of an undefined variable.
+   */
+  StackLocation add_or_shadow_builtin(const std::string& variableName);
+
+  /**
+   * @brief Adds the variable holding a builtin function, see is_builtin().
+   */
+  StackLocation add_builtin(const std::string& variableName);
+
+  /**
+   * @brief Whether loc holds a builtin function which the module has not rebound. Assigning a
+   * builtin name inside a function creates a local variable instead of rebinding the builtin for the
+   * whole module.
+   */
+  bool is_builtin(const StackLocation& loc) const;
+
+  /**
+   * @brief Whether this is the top scope of a function or of the module, rather than a block.
+   */
+  bool is_function_scope() const;
+
   VariableScope* add_scope();
   // Returns new scope and a shared pointer to number of variables in function's stack frame
   VariableScope* add_function_scope();
@@ -271,6 +410,17 @@ class VariableScope {
   // Returns a shared pointer so that this particular information can be stored by the function
   auto num_variables_stack() const noexcept { return _numVariablesStack; }
 
+  /**
+   * @brief Records a place in the script which assigns the variable at loc, e.g. an assignment
+   * target, a function argument or an import. Every variable added to a scope has one binding.
+   */
+  void add_binding(const StackLocation& loc);
+
+  /**
+   * @brief Number of places in the module which assign the variable at loc.
+   */
+  int num_bindings(const StackLocation& loc) const;
+
   // OpReturnType get_variable(int index) { return _variableValues[index]; }
   // void set_variable(int index, OpReturnType d) { _variableValues[index] = d; }
   /// number of variables stored in this scope
@@ -0,0 +1,783 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "bytecode.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "node.hpp"
+#include "run_arena.hpp"
+#include "statements.hpp"
+
+static const char* get_opcode_name(OpCode op) {
+  switch (op) {
+    case OpCode::LOAD_CONST:
+      return "LOAD_CONST";
+    case OpCode::LOAD_NONE:
+      return "LOAD_NONE";
+    case OpCode::LOAD_VAR:
+      return "LOAD_VAR";
+    case OpCode::STORE_VAR:
+      return "STORE_VAR";
+    case OpCode::MOVE:
+      return "MOVE";
+    case OpCode::BINARY:
+      return "BINARY";
+    case OpCode::COMPARE:
+      return "COMPARE";
+    case OpCode::BOOL_OP:
+      return "BOOL_OP";
+    case OpCode::UNARY:
+      return "UNARY";
+    case OpCode::JUMP:
+      return "JUMP";
+    case OpCode::JUMP_IF_FALSE:
+      return "JUMP_IF_FALSE";
+    case OpCode::JUMP_IF_TRUE:
+      return "JUMP_IF_TRUE";
+    case OpCode::FOR_PREP:
+      return "FOR_PREP";
+    case OpCode::FOR_ITER:
+      return "FOR_ITER";
+    case OpCode::CALL_VAR:
+      return "CALL_VAR";
+    case OpCode::CALL_CONST:
+      return "CALL_CONST";
+    case OpCode::CALL_MEMBER:
+      return "CALL_MEMBER";
+    case OpCode::GET_MEMBER:
+      return "GET_MEMBER";
+    case OpCode::SET_MEMBER:
+      return "SET_MEMBER";
+    case OpCode::GET_SUBSCRIPT:
+      return "GET_SUBSCRIPT";
+    case OpCode::SET_SUBSCRIPT:
+      return "SET_SUBSCRIPT";
+    case OpCode::BUILD_LIST:
+      return "BUILD_LIST";
+    case OpCode::BUILD_TUPLE:
+      return "BUILD_TUPLE";
+    case OpCode::BUILD_DICT:
+      return "BUILD_DICT";
+    case OpCode::EVAL_NODE:
+      return "EVAL_NODE";
+    case OpCode::STORE_NODE:
+      return "STORE_NODE";
+    case OpCode::EXEC_STATEMENT:
+      return "EXEC_STATEMENT";
+    case OpCode::RETURN:
+      return "RETURN";
+    case OpCode::RETURN_NONE:
+      return "RETURN_NONE";
+  }
+  return "UNKNOWN";
+}
+
+// Moves count registers starting at first into a vector of arguments, boxing unboxed scalars.
+// Registers only hold temporaries, so they can be left empty.
+static inline std::vector<OpReturnType> move_registers(ArenaArray<Value>& registers, int first,
+                                                       int count) {
+  std::vector<OpReturnType> ret;
+  ret.reserve(count);
+  for (int i = first; i < first + count; i++) {
+    ret.push_back(registers[i].take_box());
+  }
+  return ret;
+}
+
+OpReturnType BytecodeFunction::run(CallStack& stack) const {
+  // Registers and counters never outlive the call, so they come from the arena of the run_task
+  ArenaArray<Value> registers(_numRegisters);
+  ArenaArray<int> counters(_numCounters);
+  const Instruction* instr = nullptr;
+  int pc = 0;
+
+  try {
+    while (true) {
+      instr = &_code[pc++];
+      switch (instr->op) {
+        case OpCode::LOAD_CONST:
+          registers[instr->a] = _constants[instr->b];
+          break;
+        case OpCode::LOAD_NONE:
+          registers[instr->a] = OpReturnType(new NoneVariable());
+          break;
+        case OpCode::LOAD_VAR: {
+          const auto& variable = _variables[instr->b];
+          auto ret = stack.get_value(variable.location);
+          if (ret.empty()) {
+            THROW("Local variable %s accessed before assignment", variable.name.c_str());
+          }
+          registers[instr->a] = std::move(ret);
+          break;
+        }
+        case OpCode::STORE_VAR:
+          stack.set_value(_variables[instr->b].location, registers[instr->a]);
+          break;
+        case OpCode::MOVE:
+          registers[instr->a] = registers[instr->b];
+          break;
+        case OpCode::BINARY: {
+          const auto& op = _binaryOps[instr->d];
+          Value result;
+          if (!BinaryOperators::operate_scalar(registers[instr->b], registers[instr->c], op.type,
+                                               result)) {
+            const auto& d1 = registers[instr->b].box();
+            const auto& d2 = registers[instr->c].box();
+            auto ret = BinaryOperators::operate(d1, d2, op.type);
+            if (ret == nullptr) {
+              auto enum1 = util::get_string_from_enum(d1->get_dataType_enum());
+              auto enum2 = util::get_string_from_enum(d2->get_dataType_enum());
+              THROW("Could not %s, check types left=%s(%s), right=%s(%s)", op.name.c_str(),
+                    d1->get_containerType_string(), enum1, d2->get_containerType_string(), enum2);
+            }
+            result = std::move(ret);
+          }
+          registers[instr->a] = std::move(result);
+          break;
+        }
+        case OpCode::COMPARE: {
+          const auto& op = _compareOps[instr->d];
+          Value result;
+          if (!CompareOperators::compare_scalar(registers[instr->b], registers[instr->c], op.type,
+                                                result)) {
+            const auto& d1 = registers[instr->b].box();
+            const auto& d2 = registers[instr->c].box();
+            auto ret = op.func(d1, d2);
+            if (ret == nullptr) {
+              auto enumString1 = util::get_string_from_enum(d1->get_dataType_enum());
+              auto enumString2 = util::get_string_from_enum(d2->get_dataType_enum());
+              THROW("Could not %s, check types left=%s[%s], right=%s[%s]", op.name.c_str(),
+                    enumString1, d1->get_containerType_string(), enumString2,
+                    d2->get_containerType_string());
+            }
+            result = Value::unbox(ret);
+          }
+          registers[instr->a] = std::move(result);
+          break;
+        }
+        case OpCode::BOOL_OP: {
+          const auto& v1 = registers[instr->b];
+          const auto& v2 = registers[instr->c];
+          const auto& op = _boolOps[instr->d];
+          if (v1.is_scalar() && v2.is_scalar()) {
+            registers[instr->a] =
+                Value(op.isAnd ? v1.get_bool() && v2.get_bool() : v1.get_bool() || v2.get_bool());
+            break;
+          }
+          const auto& d1 = v1.box();
+          const auto& d2 = v2.box();
+          auto ret = op.func(d1, d2);
+          if (ret == nullptr) {
+            auto enumString1 = util::get_string_from_enum(d1->get_dataType_enum());
+            auto enumString2 = util::get_string_from_enum(d2->get_dataType_enum());
+            THROW("Could not %s, check types left=%s[%s], right=%s[%s]", op.name.c_str(),
+                  enumString1, d1->get_containerType_string(), enumString2,
+                  d2->get_containerType_string());
+          }
+          registers[instr->a] = Value::unbox(ret);
+          break;
+        }
+        case OpCode::UNARY: {
+          const auto& op = _unaryOps[instr->c];
+          Value result;
+          if (!UnaryOperators::operate_scalar(registers[instr->b], op.func, result)) {
+            const auto& d = registers[instr->b].box();
+            auto ret = op.func(d);
+            if (ret == nullptr) {
+              auto enumString = util::get_string_from_enum(d->get_dataType_enum());
+              THROW("Could not %s, check types operand=%s[%s]", op.name.c_str(), enumString,
+                    d->get_containerType_string());
+            }
+            result = Value::unbox(ret);
+          }
+          registers[instr->a] = std::move(result);
+          break;
+        }
+        case OpCode::JUMP:
+          pc = instr->a;
+          break;
+        case OpCode::JUMP_IF_FALSE:
+          if (!registers[instr->a].get_bool()) {
+            pc = instr->b;
+          }
+          break;
+        case OpCode::JUMP_IF_TRUE:
+          if (registers[instr->a].get_bool()) {
+            pc = instr->b;
+          }
+          break;
+        case OpCode::FOR_PREP:
+          counters[instr->a] = 0;
+          break;
+        case OpCode::FOR_ITER: {
+          // Size is read on every iteration since the body might add or remove elements
+          const auto& iterable = registers[instr->a].box();
+          int& counter = counters[instr->d];
+          if (counter >= iterable->get_size()) {
+            pc = instr->c;
+          } else if (iterable->get_containerType() == CONTAINERTYPE::RANGE) {
+            registers[instr->b] = Value(int64_t(counter++));
+          } else if (iterable->get_containerType() == CONTAINERTYPE::LIST) {
+            // Elements of unboxed lists are read without boxing them
+            registers[instr->b] =
+                static_cast<ListDataVariable*>(iterable.get())->get_int_subscript_value(counter++);
+          } else {
+            registers[instr->b] = Value::unbox(iterable->get_int_subscript(counter++));
+          }
+          break;
+        }
+        case OpCode::CALL_VAR: {
+          auto args = move_registers(registers, instr->b, instr->c);
+          const auto& variable = _variables[instr->d];
+          auto function = stack.get_variable(variable.location);
+          if (function == nullptr) {
+            THROW("Local variable %s accessed before assignment", variable.name.c_str());
+          }
+          registers[instr->a] = Value::unbox(function->execute_function(args, stack));
+          break;
+        }
+        case OpCode::CALL_CONST: {
+          auto args = move_registers(registers, instr->b, instr->c);
+          registers[instr->a] =
+              Value::unbox(_constants[instr->d].box()->execute_function(args, stack));
+          break;
+        }
+        case OpCode::CALL_MEMBER: {
+          auto object = registers[instr->b].take_box();
+          auto args = move_registers(registers, instr->b + 1, instr->c);
+          const auto& call = _memberCalls[instr->d];
+          registers[instr->a] =
+              Value::unbox(call.cache->call(object, call.memberIndex, args, stack));
+          break;
+        }
+        case OpCode::GET_MEMBER:
+          registers[instr->a] = Value::unbox(registers[instr->b].box()->get_member(instr->c));
+          break;
+        case OpCode::SET_MEMBER:
+          registers[instr->b].box()->set_member(instr->c, registers[instr->a].box());
+          break;
+        case OpCode::GET_SUBSCRIPT: {
+          const auto& mainData = registers[instr->b].box();
+          const auto& subscript = registers[instr->c];
+          if (mainData->get_containerType() == CONTAINERTYPE::LIST &&
+              (subscript.tag() == Value::Tag::INT32 || subscript.tag() == Value::Tag::INT64)) {
+            auto index = subscript.get<int64_t>();
+            if (index < std::numeric_limits<int32_t>::min() ||
+                index > std::numeric_limits<int32_t>::max()) {
+              THROW("trying to access %lld index for list of size=%d",
+                    static_cast<long long>(index), mainData->get_size());
+            }
+            registers[instr->a] = static_cast<ListDataVariable*>(mainData.get())
+                                      ->get_int_subscript_value(static_cast<int32_t>(index));
+            break;
+          }
+          registers[instr->a] =
+              Value::unbox(SubscriptNode::get_subscript_value(mainData, subscript.box()));
+          break;
+        }
+        case OpCode::SET_SUBSCRIPT:
+          registers[instr->b].box()->set_subscript(registers[instr->c].box(),
+                                                   registers[instr->a].box());
+          break;
+        case OpCode::BUILD_LIST:
+          registers[instr->a] =
+              OpReturnType(new ListDataVariable(move_registers(registers, instr->b, instr->c)));
+          break;
+        case OpCode::BUILD_TUPLE:
+          registers[instr->a] =
+              OpReturnType(new TupleDataVariable(move_registers(registers, instr->b, instr->c)));
+          break;
+        case OpCode::BUILD_DICT: {
+          auto keys = move_registers(registers, instr->b, instr->c);
+          auto values = move_registers(registers, instr->b + instr->c, instr->c);
+          auto map = std::make_shared<MapDataVariable>(keys, values);
+          map->set_thread_local();
+          registers[instr->a] = OpReturnType(std::move(map));
+          break;
+        }
+        case OpCode::EVAL_NODE:
+          registers[instr->a] = Value::unbox(_nodes[instr->b]->get(stack));
+          break;
+        case OpCode::STORE_NODE:
+          _nodes[instr->b]->set(registers[instr->a].box(), stack);
+          break;
+        case OpCode::EXEC_STATEMENT: {
+          auto ret = _statements[instr->a]->execute(stack);
+          if (!ret.is_control_flow()) {
+            break;
+          }
+          if (ret.type == RETURNTYPE::RETURN) {
+            return std::move(ret.returnVal);
+          }
+          int target = ret.type == RETURNTYPE::BREAK ? instr->b : instr->c;
+          if (target < 0) {
+            // break/continue outside of a loop ends the function, same as in the tree walker
+            return OpReturnType(new NoneVariable());
+          }
+          pc = target;
+          break;
+        }
+        case OpCode::RETURN:
+          return registers[instr->a].take_box();
+        case OpCode::RETURN_NONE:
+          return OpReturnType(new NoneVariable());
+      }
+    }
+  } catch (std::exception& e) {
+    THROW("%s%s", _linePrefixes[instr->lines].c_str(), e.what());
+  }
+}
+
+std::string BytecodeFunction::disassemble() const {
+  std::string ret;
+  for (int i = 0; i < _code.size(); i++) {
+    const auto& instr = _code[i];
+    ret += ne::fmt("%4d %-15s %d %d %d %d ; %s\n", i, get_opcode_name(instr.op), instr.a, instr.b,
+                   instr.c, instr.d, _linePrefixes[instr.lines].c_str())
+               .str;
+  }
+  return ret;
+}
+
+std::unique_ptr<BytecodeFunction> BytecodeCompiler::compile(const Body& body) {
+  BytecodeCompiler compiler;
+  body.compile(compiler);
+  compiler.emit(OpCode::RETURN_NONE);
+  return std::move(compiler._function);
+}
+
+int BytecodeCompiler::emit(OpCode op, int a, int b, int c, int d) {
+  if (_currentLines == -1) {
+    auto it = _lineChainIndexMap.find(_lineChain);
+    if (it == _lineChainIndexMap.end()) {
+      std::string prefix;
+      for (auto lineNo : _lineChain) {
+        prefix += ne::fmt("lineNo=%d, ", lineNo).str;
+      }
+      it = _lineChainIndexMap.insert({_lineChain, _function->_linePrefixes.size()}).first;
+      _function->_linePrefixes.push_back(std::move(prefix));
+    }
+    _currentLines = it->second;
+  }
+  _function->_code.push_back(Instruction{op, a, b, c, d, _currentLines});
+  return _function->_code.size() - 1;
+}
+
+int BytecodeCompiler::allocate_register() { return allocate_registers(1); }
+
+int BytecodeCompiler::allocate_registers(int count) {
+  int first = _nextRegister;
+  _nextRegister += count;
+  _function->_numRegisters = std::max(_function->_numRegisters, _nextRegister);
+  return first;
+}
+
+int BytecodeCompiler::add_constant(OpReturnType constant) {
+  _function->_constants.push_back(Value::unbox(constant).without_box());
+  return _function->_constants.size() - 1;
+}
+
+int BytecodeCompiler::add_variable(const StackLocation& location, const std::string& name) {
+  auto& variables = _function->_variables;
+  for (int i = 0; i < variables.size(); i++) {
+    if (variables[i].location == location) return i;
+  }
+  variables.push_back({location, name});
+  return variables.size() - 1;
+}
+
+int BytecodeCompiler::add_binary_op(const std::string& opType) {
+  auto& binaryOps = _function->_binaryOps;
+  auto it = std::find_if(binaryOps.begin(), binaryOps.end(),
+                         [&](const auto& op) { return op.name == opType; });
+  if (it != binaryOps.end()) return it - binaryOps.begin();
+  binaryOps.push_back({BinaryOperators::get_op_type(opType), opType});
+  return binaryOps.size() - 1;
+}
+
+int BytecodeCompiler::add_compare_op(CompareFuncPtr func, const std::string& opType) {
+  _function->_compareOps.push_back({func, CompareOperators::get_op_type(opType), opType});
+  return _function->_compareOps.size() - 1;
+}
+
+int BytecodeCompiler::add_bool_op(BoolFuncPtr func, const std::string& opType) {
+  _function->_boolOps.push_back({func, opType == "And", opType});
+  return _function->_boolOps.size() - 1;
+}
+
+int BytecodeCompiler::add_unary_op(UnaryOpFuncPtr func, const std::string& opType) {
+  _function->_unaryOps.push_back({func, opType});
+  return _function->_unaryOps.size() - 1;
+}
+
+int BytecodeCompiler::add_member_call(int memberIndex, MemberInlineCache* cache) {
+  _function->_memberCalls.push_back({memberIndex, cache});
+  return _function->_memberCalls.size() - 1;
+}
+
+int BytecodeCompiler::add_node(ASTNode* node) {
+  _function->_nodes.push_back(node);
+  return _function->_nodes.size() - 1;
+}
+
+int BytecodeCompiler::add_statement(Statement* statement) {
+  _function->_statements.push_back(statement);
+  return _function->_statements.size() - 1;
+}
+
+void BytecodeCompiler::push_line(int lineNo) {
+  _lineChain.push_back(lineNo);
+  _currentLines = -1;
+}
+
+void BytecodeCompiler::pop_line() {
+  _lineChain.pop_back();
+  _currentLines = -1;
+}
+
+void BytecodeCompiler::begin_loop(int continueTarget) { _loops.push_back({continueTarget, {}}); }
+
+void BytecodeCompiler::end_loop(int exitTarget) {
+  for (auto index : _loops.back().breakJumps) {
+    auto& instr = instruction(index);
+    if (instr.op == OpCode::JUMP) {
+      instr.a = exitTarget;
+    } else {
+      instr.b = exitTarget;
+    }
+  }
+  _loops.pop_back();
+}
+
+void BytecodeCompiler::add_break_jump(int index) { _loops.back().breakJumps.push_back(index); }
+
+void BytecodeCompiler::emit_break() {
+  if (!in_loop()) {
+    emit(OpCode::RETURN_NONE);
+    return;
+  }
+  add_break_jump(emit(OpCode::JUMP, -1));
+}
+
+// Lowering of nodes
+
+void ASTNode::compile(BytecodeCompiler& compiler, int reg) {
+  compiler.emit(OpCode::EVAL_NODE, reg, compiler.add_node(this));
+}
+
+void ASTNode::compile_store(BytecodeCompiler& compiler, int reg) {
+  compiler.emit(OpCode::STORE_NODE, reg, compiler.add_node(this));
+}
+
+void NullNode::compile(BytecodeCompiler& compiler, int reg) {
+  compiler.emit(OpCode::LOAD_NONE, reg);
+}
+
+void ConstantNode::compile(BytecodeCompiler& compiler, int reg) {
+  compiler.emit(OpCode::LOAD_CONST, reg, compiler.add_constant(_d));
+}
+
+bool ConstantNode::compile_call(BytecodeCompiler& compiler, int reg,
+                                const std::vector<ASTNode*>& arguments) {
+  int mark = compiler.register_mark();
+  int first = compiler.allocate_registers(arguments.size());
+  for (int i = 0; i < arguments.size(); i++) {
+    arguments[i]->compile(compiler, first + i);
+  }
+  compiler.emit(OpCode::CALL_CONST, reg, first, arguments.size(), compiler.add_constant(_d));
+  compiler.release_registers(mark);
+  return true;
+}
+
+void BinNode::compile(BytecodeCompiler& compiler, int reg) {
+  int mark = compiler.register_mark();
+  _left->compile(compiler, reg);
+  int right = compiler.allocate_register();
+  _right->compile(compiler, right);
+  compiler.emit(OpCode::BINARY, reg, reg, right, compiler.add_binary_op(_opType));
+  compiler.release_registers(mark);
+}
+
+void UnaryNode::compile(BytecodeCompiler& compiler, int reg) {
+  _operand->compile(compiler, reg);
+  compiler.emit(OpCode::UNARY, reg, reg, compiler.add_unary_op(_func, _opType));
+}
+
+void CompareNode::compile(BytecodeCompiler& compiler, int reg) {
+  int mark = compiler.register_mark();
+  int left = compiler.allocate_register();
+  int right = compiler.allocate_register();
+  _left->compile(compiler, left);
+  std::vector<int> shortCircuitJumps;
+  for (int i = 0; i < _comparators.size(); i++) {
+    _comparators[i]->compile(compiler, right);
+    compiler.emit(OpCode::COMPARE, reg, left, right,
+                  compiler.add_compare_op(_compareFuncs[i], _opTypes[i]));
+    if (i + 1 < _comparators.size()) {
+      shortCircuitJumps.push_back(compiler.emit(OpCode::JUMP_IF_FALSE, reg, -1));
+      compiler.emit(OpCode::MOVE, left, right);
+    }
+  }
+  for (auto jump : shortCircuitJumps) {
+    compiler.instruction(jump).b = compiler.next_instruction();
+  }
+  compiler.release_registers(mark);
+}
+
+void BoolNode::compile(BytecodeCompiler& compiler, int reg) {
+  if (_comparators.size() < 2) {
+    return ASTNode::compile(compiler, reg);
+  }
+  bool isAnd = _opType == "And";
+  int mark = compiler.register_mark();
+  int left = compiler.allocate_register();
+  int right = compiler.allocate_register();
+  int opIndex = compiler.add_bool_op(_func, _opType);
+  _comparators[0]->compile(compiler, left);
+  std::vector<int> shortCircuitJumps;
+  for (int i = 1; i < _comparators.size(); i++) {
+    shortCircuitJumps.push_back(
+        compiler.emit(isAnd ? OpCode::JUMP_IF_FALSE : OpCode::JUMP_IF_TRUE, left, -1));
+    _comparators[i]->compile(compiler, right);
+    compiler.emit(OpCode::BOOL_OP, reg, left, right, opIndex);
+    compiler.emit(OpCode::MOVE, left, right);
+  }
+  int endJump = compiler.emit(OpCode::JUMP, -1);
+  for (auto jump : shortCircuitJumps) {
+    compiler.instruction(jump).b = compiler.next_instruction();
+  }
+  compiler.emit(OpCode::LOAD_CONST, reg,
+                compiler.add_constant(OpReturnType(new SingleVariable<bool>(!isAnd))));
+  compiler.instruction(endJump).a = compiler.next_instruction();
+  compiler.release_registers(mark);
+}
+
+void CallNode::compile(BytecodeCompiler& compiler, int reg) {
+  // Evaluated through get(), which streams a comprehension argument into a builtin reduction
+  if (_comprehensionArgument != nullptr) {
+    return ASTNode::compile(compiler, reg);
+  }
+  if (!_functionNode->compile_call(compiler, reg, _arguments)) {
+    ASTNode::compile(compiler, reg);
+  }
+}
+
+void ListNode::compile(BytecodeCompiler& compiler, int reg) {
+  int mark = compiler.register_mark();
+  int first = compiler.allocate_registers(_membersInList.size());
+  for (int i = 0; i < _membersInList.size(); i++) {
+    _membersInList[i]->compile(compiler, first + i);
+  }
+  compiler.emit(OpCode::BUILD_LIST, reg, first, _membersInList.size());
+  compiler.release_registers(mark);
+}
+
+void TupleNode::compile(BytecodeCompiler& compiler, int reg) {
+  if (_store) {
+    return ASTNode::compile(compiler, reg);
+  }
+  int mark = compiler.register_mark();
+  int first = compiler.allocate_registers(_membersInTuple.size());
+  for (int i = 0; i < _membersInTuple.size(); i++) {
+    _membersInTuple[i]->compile(compiler, first + i);
+  }
+  compiler.emit(OpCode::BUILD_TUPLE, reg, first, _membersInTuple.size());
+  compiler.release_registers(mark);
+}
+
+void NameNode::compile(BytecodeCompiler& compiler, int reg) {
+  if (_type != Type::LOAD) {
+    return ASTNode::compile(compiler, reg);
+  }
+  compiler.emit(OpCode::LOAD_VAR, reg, compiler.add_variable(_stackLocation, _variableName));
+}
+
+void NameNode::compile_store(BytecodeCompiler& compiler, int reg) {
+  if (_type != Type::STORE) {
+    return ASTNode::compile_store(compiler, reg);
+  }
+  compiler.emit(OpCode::STORE_VAR, reg, compiler.add_variable(_stackLocation, _variableName));
+}
+
+bool NameNode::compile_call(BytecodeCompiler& compiler, int reg,
+                            const std::vector<ASTNode*>& arguments) {
+  if (_type != Type::LOAD) {
+    return false;
+  }
+  int mark = compiler.register_mark();
+  int first = compiler.allocate_registers(arguments.size());
+  for (int i = 0; i < arguments.size(); i++) {
+    arguments[i]->compile(compiler, first + i);
+  }
+  compiler.emit(OpCode::CALL_VAR, reg, first, arguments.size(),
+                compiler.add_variable(_stackLocation, _variableName));
+  compiler.release_registers(mark);
+  return true;
+}
+
+void AttributeNode::compile(BytecodeCompiler& compiler, int reg) {
+  _mainNode->compile(compiler, reg);
+  compiler.emit(OpCode::GET_MEMBER, reg, reg, _memberIndex);
+}
+
+void AttributeNode::compile_store(BytecodeCompiler& compiler, int reg) {
+  int mark = compiler.register_mark();
+  int object = compiler.allocate_register();
+  _mainNode->compile(compiler, object);
+  compiler.emit(OpCode::SET_MEMBER, reg, object, _memberIndex);
+  compiler.release_registers(mark);
+}
+
+bool AttributeNode::compile_call(BytecodeCompiler& compiler, int reg,
+                                 const std::vector<ASTNode*>& arguments) {
+  // Arguments are evaluated before the object, same as in AttributeNode::call
+  int mark = compiler.register_mark();
+  int object = compiler.allocate_registers(arguments.size() + 1);
+  for (int i = 0; i < arguments.size(); i++) {
+    arguments[i]->compile(compiler, object + 1 + i);
+  }
+  _mainNode->compile(compiler, object);
+  compiler.emit(OpCode::CALL_MEMBER, reg, object, arguments.size(),
+                compiler.add_member_call(_memberIndex, &_callCache));
+  compiler.release_registers(mark);
+  return true;
+}
+
+void SubscriptNode::compile(BytecodeCompiler& compiler, int reg) {
+  int mark = compiler.register_mark();
+  int subscript = compiler.allocate_register();
+  _sliceNode->compile(compiler, subscript);
+  _mainNode->compile(compiler, reg);
+  compiler.emit(OpCode::GET_SUBSCRIPT, reg, reg, subscript);
+  compiler.release_registers(mark);
+}
+
+void SubscriptNode::compile_store(BytecodeCompiler& compiler, int reg) {
+  if (!_store) {
+    return ASTNode::compile_store(compiler, reg);
+  }
+  int mark = compiler.register_mark();
+  int subscript = compiler.allocate_register();
+  int mainData = compiler.allocate_register();
+  _sliceNode->compile(compiler, subscript);
+  _mainNode->compile(compiler, mainData);
+  compiler.emit(OpCode::SET_SUBSCRIPT, reg, mainData, subscript);
+  compiler.release_registers(mark);
+}
+
+void DictNode::compile(BytecodeCompiler& compiler, int reg) {
+  int mark = compiler.register_mark();
+  int numItems = _keyNodes.size();
+  int first = compiler.allocate_registers(2 * numItems);
+  for (int i = 0; i < numItems; i++) {
+    _keyNodes[i]->compile(compiler, first + i);
+  }
+  for (int i = 0; i < numItems; i++) {
+    _valueNodes[i]->compile(compiler, first + numItems + i);
+  }
+  compiler.emit(OpCode::BUILD_DICT, reg, first, numItems);
+  compiler.release_registers(mark);
+}
+
+// Lowering of statements
+
+void Statement::compile(BytecodeCompiler& compiler) {
+  int index = compiler.add_statement(this);
+  if (!compiler.in_loop()) {
+    compiler.emit(OpCode::EXEC_STATEMENT, index, -1, -1);
+    return;
+  }
+  compiler.add_break_jump(
+      compiler.emit(OpCode::EXEC_STATEMENT, index, -1, compiler.continue_target()));
+}
+
+void Body::compile(BytecodeCompiler& compiler) const {
+  for (auto s : _codeLines) {
+    compiler.push_line(s->get_line());
+    s->compile(compiler);
+    compiler.pop_line();
+  }
+}
+
+void AssignStatement::compile(BytecodeCompiler& compiler) {
+  int mark = compiler.register_mark();
+  int value = compiler.allocate_register();
+  _node->compile(compiler, value);
+  _targetOp->compile_store(compiler, value);
+  compiler.release_registers(mark);
+}
+
+void ExprStatement::compile(BytecodeCompiler& compiler) {
+  int mark = compiler.register_mark();
+  _node->compile(compiler, compiler.allocate_register());
+  compiler.release_registers(mark);
+}
+
+void ReturnStatement::compile(BytecodeCompiler& compiler) {
+  int mark = compiler.register_mark();
+  int value = compiler.allocate_register();
+  _node->compile(compiler, value);
+  compiler.emit(OpCode::RETURN, value);
+  compiler.release_registers(mark);
+}
+
+void BreakStatement::compile(BytecodeCompiler& compiler) { compiler.emit_break(); }
+
+void BlockStatement::compile(BytecodeCompiler& compiler) { _body->compile(compiler); }
+
+void ContinueStatement::compile(BytecodeCompiler& compiler) {
+  if (!compiler.in_loop()) {
+    compiler.emit(OpCode::RETURN_NONE);
+    return;
+  }
+  compiler.emit(OpCode::JUMP, compiler.continue_target());
+}
+
+void IfStatement::compile(BytecodeCompiler& compiler) {
+  int mark = compiler.register_mark();
+  int test = compiler.allocate_register();
+  _testNode->compile(compiler, test);
+  int elseJump = compiler.emit(OpCode::JUMP_IF_FALSE, test, -1);
+  compiler.release_registers(mark);
+  _trueBody->compile(compiler);
+  int endJump = compiler.emit(OpCode::JUMP, -1);
+  compiler.instruction(elseJump).b = compiler.next_instruction();
+  _elseBody->compile(compiler);
+  compiler.instruction(endJump).a = compiler.next_instruction();
+}
+
+void WhileStatement::compile(BytecodeCompiler& compiler) {
+  int loopStart = compiler.next_instruction();
+  int mark = compiler.register_mark();
+  int test = compiler.allocate_register();
+  _testNode->compile(compiler, test);
+  int exitJump = compiler.emit(OpCode::JUMP_IF_FALSE, test, -1);
+  compiler.release_registers(mark);
+  compiler.begin_loop(loopStart);
+  _body->compile(compiler);
+  compiler.emit(OpCode::JUMP, loopStart);
+  compiler.instruction(exitJump).b = compiler.next_instruction();
+  compiler.end_loop(compiler.next_instruction());
+}
+
+void ForStatement::compile(BytecodeCompiler& compiler) {
+  int mark = compiler.register_mark();
+  int iterable = compiler.allocate_register();
+  int item = compiler.allocate_register();
+  int counter = compiler.allocate_counter();
+  _iterator->compile(compiler, iterable);
+  compiler.emit(OpCode::FOR_PREP, counter);
+  int loopStart = compiler.emit(OpCode::FOR_ITER, iterable, item, -1, counter);
+  _newVar->compile_store(compiler, item);
+  compiler.begin_loop(loopStart);
+  _body->compile(compiler);
+  compiler.emit(OpCode::JUMP, loopStart);
+  compiler.instruction(loopStart).c = compiler.next_instruction();
+  compiler.end_loop(compiler.next_instruction());
+  compiler.release_registers(mark);
+}
@@ -6,19 +6,31 @@
 
 #include "dp_module.hpp"
 
+#include "script_profiler.hpp"
+
 DpModule::DpModule(CommandCenter* commandCenter, const std::string& name, int index,
-                   const json& astJson, CallStack& stack)
-    : _name(name), _index(index) {
+                   const json& astJson, CallStack& stack, bool compileBytecode, bool optimize)
+    : _name(name), _index(index), _stack(commandCenter) {
   const json& bodyJson = astJson.at("body");
   auto globalScope = new VariableScope(commandCenter, index);
   _body = std::make_unique<Body>(globalScope, bodyJson, new InbuiltFunctionsStatement(globalScope));
+  ScriptOptimizer(optimize, compileBytecode).optimize_module(*_body);
+  if (optimize) {
+    std::string dump;
+    _body->dump(dump, 0);
+    LOG_VERBOSE("Optimized module=%s\n%s", _name.c_str(), dump.c_str());
+  }
 
   stack.enter_function_frame(index, globalScope->current_function_index(),
                              *globalScope->num_variables_stack());
 
   CallStack copyStack = stack.create_copy_with_deferred_lock();
-  _body->execute(copyStack);
+  {
+    ProfilerScope profilerScope(this, _name);
+    _body->execute(copyStack);
+  }
   _variableNamesLocationMap = globalScope->get_all_locations_in_scope();
+  _stack = copyStack;
   delete globalScope;
 }
 
@@ -48,6 +60,6 @@ bool DpModule::has_variable(const std::string& name) const {
 }
 
 // caller has to ensure that variable exists
-StackLocation DpModule::get_variable_location(const std::string& name) const {
-  return _variableNamesLocationMap.at(name);
+OpReturnType DpModule::get_variable(const std::string& name) const {
+  return _stack.get_variable(_variableNamesLocationMap.at(name));
 }
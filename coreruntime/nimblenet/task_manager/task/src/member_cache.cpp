@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "member_cache.hpp"
+
+#include "data_variable.hpp"
+#include "statements.hpp"
+
+std::atomic<int64_t> MemberInlineCache::_hits{0};
+std::atomic<int64_t> MemberInlineCache::_misses{0};
+
+OpReturnType MemberInlineCache::lookup(uint64_t layoutId) const {
+  const Snapshot* snapshot = _snapshot.load(std::memory_order_acquire);
+  if (!snapshot) return nullptr;
+  for (int i = 0; i < snapshot->size; i++) {
+    // The class may have replaced the member since, the reference keeps it alive for the call
+    if (snapshot->entries[i].layoutId == layoutId) return snapshot->entries[i].member.lock();
+  }
+  return nullptr;
+}
+
+void MemberInlineCache::insert(uint64_t layoutId, const OpReturnType& member) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_snapshots.size() >= MAX_UPDATES) return;
+  auto snapshot = std::make_unique<Snapshot>();
+  if (!_snapshots.empty()) {
+    *snapshot = *_snapshots.back();
+  }
+  for (int i = 0; i < snapshot->size; i++) {
+    // Another thread already added the class
+    if (snapshot->entries[i].layoutId == layoutId) return;
+  }
+  if (snapshot->size == MAX_ENTRIES) {
+    // Evict the oldest class
+    std::move(snapshot->entries + 1, snapshot->entries + MAX_ENTRIES, snapshot->entries);
+    snapshot->size--;
+  }
+  snapshot->entries[snapshot->size++] = {layoutId, member};
+  // Snapshots are kept alive till the cache is destroyed, since other threads might be reading them
+  _snapshot.store(snapshot.get(), std::memory_order_release);
+  _snapshots.push_back(std::move(snapshot));
+}
+
+OpReturnType MemberInlineCache::call(const OpReturnType& receiver, int memberIndex,
+                                     const std::vector<OpReturnType>& arguments,
+                                     CallStack& stack) {
+  if (receiver->get_containerType() != CONTAINERTYPE::CLASS) {
+    return receiver->call_function(memberIndex, arguments, stack);
+  }
+
+  ClassDataVariable* classVariable = nullptr;
+  auto object = dynamic_cast<ObjectDataVariable*>(receiver.get());
+  if (object) {
+    // Functions assigned to the object itself shadow the members of the class
+    if (object->has_own_member(memberIndex)) {
+      return receiver->call_function(memberIndex, arguments, stack);
+    }
+    classVariable = object->get_class();
+  } else {
+    classVariable = dynamic_cast<ClassDataVariable*>(receiver.get());
+  }
+  if (!classVariable) {
+    return receiver->call_function(memberIndex, arguments, stack);
+  }
+
+  uint64_t layoutId = classVariable->layout_id();
+  // Hold a reference for the whole call, the function could replace itself in the class while
+  // it is executing
+  OpReturnType function = lookup(layoutId);
+  if (function) {
+    _hits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    function = classVariable->find_member(memberIndex);
+    if (!function) {
+      // Let the receiver raise the same error as without the cache
+      return receiver->call_function(memberIndex, arguments, stack);
+    }
+    insert(layoutId, function);
+  }
+
+  if (!object) {
+    return function->execute_function(arguments, stack);
+  }
+  std::vector<OpReturnType> newArgs;
+  newArgs.reserve(arguments.size() + 1);
+  newArgs.push_back(receiver);
+  newArgs.insert(newArgs.end(), arguments.begin(), arguments.end());
+  return function->execute_function(newArgs, stack);
+}
+
+MemberInlineCache::Stats MemberInlineCache::get_stats() {
+  Stats stats;
+  stats.hits = _hits.load(std::memory_order_relaxed);
+  stats.misses = _misses.load(std::memory_order_relaxed);
+  return stats;
+}
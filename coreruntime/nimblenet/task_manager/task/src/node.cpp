@@ -22,12 +22,64 @@ BinNode::BinNode(VariableScope* scope, const json& binOpJson) : ASTNode(scope, b
   auto rightBlock = binOpJson.at("right");
   _right = ASTNode::create_node(scope, rightBlock);
   _opType = binOpJson.at("op").at("_type");
+  _op = BinaryOperators::get_op_type(_opType);
+}
+
+template <typename T>
+static OpReturnType operate_numeric(const OpReturnType& d1, const OpReturnType& d2,
+                                    BinaryOpType op) {
+  Value result;
+  ScalarBinOp<T>::compute(Value(d1->get<T>()), Value(d2->get<T>()), op, result);
+  return OpReturnType(new SingleVariable<T>(result.get<T>()));
+}
+
+OpReturnType BinNode::operate_quickened(QuickenedOperands operands, const OpReturnType& d1,
+                                        const OpReturnType& d2) const {
+  switch (operands) {
+    case QuickenedOperands::INT64:
+      if (Quickening::is_scalar_of(d1, DATATYPE::INT64) &&
+          Quickening::is_scalar_of(d2, DATATYPE::INT64)) {
+        return operate_numeric<int64_t>(d1, d2, _op);
+      }
+      break;
+    case QuickenedOperands::DOUBLE:
+      if (Quickening::is_scalar_of(d1, DATATYPE::DOUBLE) &&
+          Quickening::is_scalar_of(d2, DATATYPE::DOUBLE)) {
+        return operate_numeric<double>(d1, d2, _op);
+      }
+      break;
+    case QuickenedOperands::STRING:
+      if (Quickening::is_scalar_of(d1, DATATYPE::STRING) &&
+          Quickening::is_scalar_of(d2, DATATYPE::STRING)) {
+        return OpReturnType(new SingleVariable<std::string>(d1->get_string() + d2->get_string()));
+      }
+      break;
+    default:
+      break;
+  }
+  return nullptr;
 }
 
 OpReturnType BinNode::get_value(CallStack& stack) {
   auto d1 = _left->get(stack);
   auto d2 = _right->get(stack);
-  auto ret = BinaryOperators::operate(d1, d2, _opType);
+  auto operands = _quickening.get();
+  if (operands == QuickenedOperands::NONE) {
+    auto observed = Quickening::classify(d1, d2);
+    // Only numeric operations are specialized, and concatenation for strings
+    if (_op == BinaryOpType::UNKNOWN ||
+        (observed == QuickenedOperands::STRING && _op != BinaryOpType::ADD)) {
+      observed = QuickenedOperands::GENERIC;
+    }
+    _quickening.observe(observed);
+  } else if (operands != QuickenedOperands::GENERIC) {
+    if (auto ret = operate_quickened(operands, d1, d2)) {
+      return ret;
+    }
+    _quickening.deoptimize();
+  }
+
+  auto ret = BinaryOperators::operate(d1, d2, _op);
   if (ret == nullptr) {
     auto enum1 = util::get_string_from_enum(d1->get_dataType_enum());
     auto enum2 = util::get_string_from_enum(d2->get_dataType_enum());
@@ -67,6 +119,7 @@ CompareNode::CompareNode(VariableScope* scope, const json& j) {
   for (auto singleFunc : compareFuncJsons) {
     std::string type = singleFunc.at("_type");
     _opTypes.push_back(type);
+    _ops.push_back(CompareOperators::get_op_type(type));
     _compareFuncs.push_back(CompareOperators::get_operator(type));
   }
   if (_comparators.size() != _compareFuncs.size()) {
@@ -75,12 +128,60 @@ CompareNode::CompareNode(VariableScope* scope, const json& j) {
   }
 }
 
+OpReturnType CompareNode::compare_quickened(QuickenedOperands operands, int i,
+                                            const OpReturnType& d1, const OpReturnType& d2) const {
+  bool ret;
+  switch (operands) {
+    case QuickenedOperands::INT64:
+      if (!Quickening::is_scalar_of(d1, DATATYPE::INT64) ||
+          !Quickening::is_scalar_of(d2, DATATYPE::INT64)) {
+        return nullptr;
+      }
+      ret = CompareOperators::compare_single(d1->get_int64(), d2->get_int64(), _ops[i]);
+      break;
+    case QuickenedOperands::DOUBLE:
+      if (!Quickening::is_scalar_of(d1, DATATYPE::DOUBLE) ||
+          !Quickening::is_scalar_of(d2, DATATYPE::DOUBLE)) {
+        return nullptr;
+      }
+      ret = CompareOperators::compare_single(d1->get_double(), d2->get_double(), _ops[i]);
+      break;
+    case QuickenedOperands::STRING:
+      if (!Quickening::is_scalar_of(d1, DATATYPE::STRING) ||
+          !Quickening::is_scalar_of(d2, DATATYPE::STRING)) {
+        return nullptr;
+      }
+      ret = CompareOperators::compare_single(d1->get_string(), d2->get_string(), _ops[i]);
+      break;
+    default:
+      return nullptr;
+  }
+  return OpReturnType(new SingleVariable<bool>(ret));
+}
+
 OpReturnType CompareNode::get_value(CallStack& stack) {
   auto d = _left->get(stack);
   OpReturnType ret = nullptr;
   for (int i = 0; i < _comparators.size(); i++) {
     auto d2 = _comparators[i]->get(stack);
-    ret = _compareFuncs[i](d, d2);
+    ret = nullptr;
+    auto operands = _quickening.get();
+    if (operands == QuickenedOperands::NONE) {
+      auto observed = Quickening::classify(d, d2);
+      // Membership tests are not specialized
+      if (_ops[i] == CompareOpType::IN || _ops[i] == CompareOpType::NOT_IN) {
+        observed = QuickenedOperands::GENERIC;
+      }
+      _quickening.observe(observed);
+    } else if (operands != QuickenedOperands::GENERIC) {
+      ret = compare_quickened(operands, i, d, d2);
+      if (ret == nullptr) {
+        _quickening.deoptimize();
+      }
+    }
+    if (ret == nullptr) {
+      ret = _compareFuncs[i](d, d2);
+    }
     if (ret == nullptr) {
       auto enumString1 = util::get_string_from_enum(d->get_dataType_enum());
       auto enumString2 = util::get_string_from_enum(d2->get_dataType_enum());
@@ -137,9 +238,37 @@ CallNode::CallNode(VariableScope* scope, const json& callFuncJson) : ASTNode(sco
   for (auto arg : args) {
     _arguments.push_back(ASTNode::create_node(scope, arg));
   }
+  find_comprehension_argument();
+}
+
+void CallNode::find_comprehension_argument() {
+  _comprehensionArgument = nullptr;
+  if (_arguments.size() != 1) {
+    return;
+  }
+  // For other functions, e.g. attributes, call() does not only evaluate the function and execute it
+  if (!dynamic_cast<NameNode*>(_functionNode) && !dynamic_cast<ConstantNode*>(_functionNode)) {
+    return;
+  }
+  auto comprehension = dynamic_cast<ComprehensionNode*>(_arguments[0]);
+  // Dict comprehensions are built by get() like any other argument
+  if (comprehension != nullptr && comprehension->has_element()) {
+    _comprehensionArgument = comprehension;
+  }
 }
 
 OpReturnType CallNode::get_value(CallStack& stack) {
+  if (_comprehensionArgument != nullptr) {
+    auto function = _functionNode->get(stack);
+    auto reductionType = Reduction::get_type(function);
+    if (reductionType) {
+      Reduction reduction(*reductionType);
+      _comprehensionArgument->reduce(reduction, stack);
+      return reduction.result();
+    }
+    return function->execute_function({_comprehensionArgument->get(stack)}, stack);
+  }
+
   std::vector<OpReturnType> argsOfFunctionToCall(_arguments.size());
   for (int i = 0; i < _arguments.size(); i++) {
     argsOfFunctionToCall[i] = _arguments[i]->get(stack);
@@ -157,8 +286,10 @@ NameNode::NameNode(VariableScope* scope, const json& nameOpJson) : ASTNode(scope
     // Ideally we would only check in this scope and create the variable here if it doesn't exist,
     // instead we want to modify outer scope's variable in this case.
     auto stack_location = _scope->get_variable_location_on_stack(varName);
-    if (stack_location == StackLocation::null) {
-      stack_location = _scope->add_variable(varName);
+    if (stack_location == StackLocation::null || _scope->is_builtin(stack_location)) {
+      stack_location = _scope->add_or_shadow_builtin(varName);
+    } else {
+      _scope->add_binding(stack_location);
     }
     _stackLocation = std::move(stack_location);
   } else {
@@ -207,7 +338,7 @@ AttributeNode::AttributeNode(VariableScope* scope, const json& attributeNodeJson
 OpReturnType AttributeNode::call(const std::vector<OpReturnType>& args, CallStack& stack) {
   auto classVariable = _mainNode->get(stack);
   // this calls member function
-  return classVariable->call_function(_memberIndex, args, stack);
+  return _callCache.call(classVariable, _memberIndex, args, stack);
 }
 
 // STATIC FUNCTIONS BELOW
@@ -266,7 +397,17 @@ OpReturnType DictNode::get_value(CallStack& stack) {
   for (int i = 0; i < _valueNodes.size(); i++) {
     values[i] = _valueNodes[i]->get(stack);
   }
-  return OpReturnType(new MapDataVariable(keys, values));
+  auto map = std::make_shared<MapDataVariable>();
+  map->set_thread_local();
+  OpReturnType ret = map;
+  for (int i = 0; i < keys.size(); i++) {
+    if (_internedKeys[i]) {
+      ret->set_interned_subscript(*_internedKeys[i], values[i]);
+    } else {
+      ret->set_subscript(keys[i], values[i]);
+    }
+  }
+  return ret;
 }
 
 DictNode::~DictNode() {
@@ -278,24 +419,33 @@ DictNode::~DictNode() {
   }
 }
 
+void ComprehensionNode::reduce(Reduction& reduction, CallStack& stack) {
+  for_each(stack, [&]() { return reduction.add(_elementNode->get(stack)); });
+}
+
 OpReturnType DictComprehensionNode::get_value(CallStack& stack) {
   if (_chainGenerators.empty()) {
-    return OpReturnType(new MapDataVariable());
+    auto map = std::make_shared<MapDataVariable>();
+    map->set_thread_local();
+    return map;
   }
 
   std::vector<OpReturnType> keys;
   std::vector<OpReturnType> values;
-  _chainGenerators[0]->reset_iterator();
-
-  // Iterate through all the generator's values and add them to our result list
-  while (true) {
-    auto kvTuple = _chainGenerators[0]->get(stack);
-    if (kvTuple == nullptr) {
-      break;
-    }
-    keys.push_back(kvTuple->get_int_subscript(0));
-    values.push_back(kvTuple->get_int_subscript(1));
-  }
-  _chainGenerators[0]->reset_iterator();
-  return OpReturnType(new MapDataVariable(keys, values));
+  int sizeHint = 0;
+  for_each(
+      stack,
+      [&]() {
+        if (keys.empty()) {
+          keys.reserve(sizeHint);
+          values.reserve(sizeHint);
+        }
+        keys.push_back(_keyNode->get(stack));
+        values.push_back(_valueNode->get(stack));
+        return true;
+      },
+      &sizeHint);
+  auto map = std::make_shared<MapDataVariable>(keys, values);
+  map->set_thread_local();
+  return map;
 }
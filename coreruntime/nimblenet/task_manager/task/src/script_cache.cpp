@@ -0,0 +1,235 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "script_cache.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "logger.hpp"
+#include "native_interface.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+
+template <typename T>
+void append(std::string& out, T val) {
+  out.append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+void append_string(std::string& out, const std::string& val) {
+  append<uint32_t>(out, val.size());
+  out += val;
+}
+
+/**
+ * @brief Bounds checked reader over the memory mapped file.
+ */
+class Reader {
+  const uint8_t* _data;
+  size_t _size;
+  size_t _pos = 0;
+
+ public:
+  Reader(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+  template <typename T>
+  bool read(T& val) {
+    if (_size - _pos < sizeof(T)) return false;
+    std::memcpy(&val, _data + _pos, sizeof(T));
+    _pos += sizeof(T);
+    return true;
+  }
+
+  bool read_string(std::string& val) {
+    uint32_t length;
+    if (!read(length) || _size - _pos < length) return false;
+    val.assign(reinterpret_cast<const char*>(_data + _pos), length);
+    _pos += length;
+    return true;
+  }
+};
+
+const std::string CACHE_SUFFIX = ".astc";
+
+/**
+ * @brief Whether the file at path is a cache of the script named scriptName, or a cache of an
+ * earlier format version, which can no longer be loaded.
+ *
+ * The name is read from the header, as both script names and versions can contain dots, so that
+ * <name>.<version>.astc file names cannot be split back into the two.
+ */
+bool is_removable_cache(const std::string& path, const std::string& scriptName) {
+  std::ifstream in(path, std::ios::binary);
+  uint32_t magic, formatVersion, nameLength;
+  if (!in.read(reinterpret_cast<char*>(&magic), sizeof(magic)) || magic != ScriptCache::MAGIC ||
+      !in.read(reinterpret_cast<char*>(&formatVersion), sizeof(formatVersion))) {
+    return false;
+  }
+  if (formatVersion != ScriptCache::FORMAT_VERSION) {
+    return true;
+  }
+  if (!in.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength)) ||
+      nameLength != scriptName.size()) {
+    return false;
+  }
+  std::string name(nameLength, '\0');
+  return in.read(name.data(), nameLength) && name == scriptName;
+}
+
+}  // namespace
+
+std::string ScriptCache::get_cache_path(const std::string& scriptPath, const std::string& scriptName,
+                                        const std::string& version) {
+  // Script assets are stored as <name><version><suffix>, the cache next to them as
+  // <name>.<version>.astc, so that the caches of two versions of a script do not replace each other
+  auto separator = scriptPath.find_last_of('/');
+  std::string directory = separator == std::string::npos ? "" : scriptPath.substr(0, separator + 1);
+  return directory + scriptName + "." + version + CACHE_SUFFIX;
+}
+
+std::shared_ptr<ScriptCache> ScriptCache::load(const std::string& path,
+                                               const std::string& scriptName,
+                                               const std::string& version) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return nullptr;
+  }
+  void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the file descriptor is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG_TO_ERROR("Could not map script cache %s, error: %s", path.c_str(), strerror(errno));
+    return nullptr;
+  }
+  std::shared_ptr<ScriptCache> cache(
+      new ScriptCache(path, static_cast<const uint8_t*>(data), st.st_size));
+  if (!cache->parse_header(scriptName, version)) {
+    LOG_TO_INFO("Ignoring stale script cache %s", path.c_str());
+    return nullptr;
+  }
+  return cache;
+}
+
+bool ScriptCache::parse_header(const std::string& scriptName, const std::string& version) {
+  Reader reader(_data, _size);
+  uint32_t magic, formatVersion, numModules;
+  std::string cacheScriptName, cacheVersion;
+  if (!reader.read(magic) || magic != MAGIC || !reader.read(formatVersion) ||
+      formatVersion != FORMAT_VERSION || !reader.read_string(cacheScriptName) ||
+      cacheScriptName != scriptName || !reader.read_string(cacheVersion) ||
+      cacheVersion != version || !reader.read(numModules)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < numModules; i++) {
+    std::string name;
+    Entry entry;
+    if (!reader.read_string(name) || !reader.read(entry.offset) || !reader.read(entry.size) ||
+        entry.offset > _size || entry.size > _size - entry.offset) {
+      return false;
+    }
+    _modules[name] = entry;
+  }
+  return true;
+}
+
+bool ScriptCache::save(const std::string& path, const std::string& scriptName,
+                       const std::string& version, const json& modules) {
+  std::vector<std::pair<std::string, std::vector<uint8_t>>> encodedModules;
+  for (auto& [name, ast] : modules.items()) {
+    encodedModules.push_back({name, json::to_cbor(ast)});
+  }
+
+  std::string header;
+  append(header, MAGIC);
+  append(header, FORMAT_VERSION);
+  append_string(header, scriptName);
+  append_string(header, version);
+  append<uint32_t>(header, encodedModules.size());
+  size_t headerSize = header.size();
+  for (auto& [name, encoded] : encodedModules) {
+    headerSize += sizeof(uint32_t) + name.size() + 2 * sizeof(uint64_t);
+  }
+
+  std::string content = std::move(header);
+  uint64_t offset = headerSize;
+  for (auto& [name, encoded] : encodedModules) {
+    append_string(content, name);
+    append<uint64_t>(content, offset);
+    append<uint64_t>(content, encoded.size());
+    offset += encoded.size();
+  }
+  for (auto& [name, encoded] : encodedModules) {
+    content.append(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+  }
+
+  // Write to a temporary file and rename it, so that a partially written cache is never loaded
+  std::string tempPath = path + ".tmp";
+  nativeinterface::write_data_to_file(std::move(content), tempPath);
+  if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+    LOG_TO_ERROR("Could not save script cache %s, error: %s", path.c_str(), strerror(errno));
+    std::remove(tempPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+void ScriptCache::remove_other_versions(const std::string& path, const std::string& scriptName) {
+  auto separator = path.find_last_of('/');
+  std::string directory = separator == std::string::npos ? "" : path.substr(0, separator + 1);
+  std::string fileName = separator == std::string::npos ? path : path.substr(separator + 1);
+
+  DIR* dir = opendir(directory.empty() ? "." : directory.c_str());
+  if (dir == nullptr) {
+    return;
+  }
+  struct dirent* entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string name = entry->d_name;
+    std::string stalePath = directory + name;
+    if (name == fileName || name.size() <= CACHE_SUFFIX.size() ||
+        name.compare(name.size() - CACHE_SUFFIX.size(), CACHE_SUFFIX.size(), CACHE_SUFFIX) != 0 ||
+        !is_removable_cache(stalePath, scriptName)) {
+      continue;
+    }
+    if (std::remove(stalePath.c_str()) != 0) {
+      LOG_TO_ERROR("Could not remove stale script cache %s, error: %s", stalePath.c_str(),
+                   strerror(errno));
+    }
+  }
+  closedir(dir);
+}
+
+json ScriptCache::get_module(const std::string& name) const {
+  const auto& entry = _modules.at(name);
+  const uint8_t* begin = _data + entry.offset;
+  try {
+    return json::from_cbor(begin, begin + entry.size);
+  } catch (json::exception& e) {
+    LOG_TO_ERROR("Could not decode module %s of script cache %s, error: %s", name.c_str(),
+                 _path.c_str(), e.what());
+    // The mapping stays valid after the file is removed
+    std::remove(_path.c_str());
+    return nullptr;
+  }
+}
+
+ScriptCache::~ScriptCache() { munmap(const_cast<uint8_t*>(_data), _size); }
@@ -0,0 +1,590 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "script_optimizer.hpp"
+
+#include "node.hpp"
+#include "statements.hpp"
+
+static const char* get_operator_symbol(const std::string& opType) {
+  static const std::map<std::string, const char*> symbols = {
+      {"Add", "+"},  {"Sub", "-"},     {"Mult", "*"},   {"Div", "/"},       {"FloorDiv", "//"},
+      {"Mod", "%"},  {"Pow", "**"},    {"Eq", "=="},    {"NotEq", "!="},    {"Lt", "<"},
+      {"LtE", "<="}, {"Gt", ">"},      {"GtE", ">="},   {"In", "in"},       {"NotIn", "not in"},
+      {"Is", "is"},  {"IsNot", "is not"}, {"And", "and"}, {"Or", "or"},     {"Not", "not "},
+      {"USub", "-"}, {"UAdd", "+"},
+  };
+  auto it = symbols.find(opType);
+  if (it == symbols.end()) {
+    return opType.c_str();
+  }
+  return it->second;
+}
+
+static ConstantNode* as_constant(ASTNode* node) { return dynamic_cast<ConstantNode*>(node); }
+
+// Returns the node as a constant if statements can be rewritten based on its value
+static ConstantNode* as_constant(const ScriptOptimizer& optimizer, ASTNode* node) {
+  if (!optimizer.enabled()) {
+    return nullptr;
+  }
+  return as_constant(node);
+}
+
+static std::string dump_nodes(const std::vector<ASTNode*>& nodes) {
+  std::string ret;
+  for (int i = 0; i < nodes.size(); i++) {
+    if (i > 0) ret += ", ";
+    ret += nodes[i]->dump();
+  }
+  return ret;
+}
+
+static void dump_line(std::string& out, int indent, const std::string& line) {
+  out.append(2 * indent, ' ');
+  out += line;
+  out += "\n";
+}
+
+static void optimize_nodes(ScriptOptimizer& optimizer, std::vector<ASTNode*>& nodes) {
+  for (auto& node : nodes) {
+    node = optimizer.optimize(node);
+  }
+}
+
+static bool all_constants(const std::vector<ASTNode*>& nodes) {
+  for (auto node : nodes) {
+    if (as_constant(node) == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ScriptOptimizer
+
+void ScriptOptimizer::optimize_module(Body& body) {
+  // Statements are visited even if optimization is disabled, to collect the functions to compile
+  _phase = Phase::MODULE;
+  body.optimize(*this);
+  _phase = Phase::FUNCTIONS;
+  for (auto function : _deferredFunctions) {
+    process_function(function);
+  }
+  _deferredFunctions.clear();
+  if (_optimize) {
+    LOG_VERBOSE("Optimized script: folded=%d, removed=%d, resolved=%d", _numFolded,
+                _numStatementsRemoved, _numNamesResolved);
+  }
+}
+
+void ScriptOptimizer::process_function(FunctionDef* function) {
+  function->process_body(*this, _compileBytecode);
+}
+
+ASTNode* ScriptOptimizer::optimize(ASTNode* node) {
+  if (!_optimize || node == nullptr) {
+    return node;
+  }
+  auto ret = node->optimize(*this);
+  if (ret != node) {
+    delete node;
+  }
+  return ret;
+}
+
+Statement* ScriptOptimizer::optimize(Statement* statement) {
+  auto ret = statement->optimize(*this);
+  if (ret != statement) {
+    delete statement;
+  }
+  return ret;
+}
+
+void ScriptOptimizer::optimize(std::vector<Statement*>& codeLines) {
+  _bodyDepth++;
+  std::vector<Statement*> optimizedLines;
+  optimizedLines.reserve(codeLines.size());
+  bool reachable = true;
+  for (auto statement : codeLines) {
+    if (!reachable) {
+      // Statements after a return, break, continue or raise can never run
+      delete statement;
+      _numStatementsRemoved++;
+      continue;
+    }
+    auto optimized = optimize(statement);
+    if (optimized == nullptr) {
+      _numStatementsRemoved++;
+      continue;
+    }
+    optimizedLines.push_back(optimized);
+    if (_optimize &&
+        (dynamic_cast<ReturnStatement*>(optimized) || dynamic_cast<BreakStatement*>(optimized) ||
+         dynamic_cast<ContinueStatement*>(optimized) || dynamic_cast<RaiseStatement*>(optimized))) {
+      reachable = false;
+    }
+  }
+  codeLines = std::move(optimizedLines);
+  _bodyDepth--;
+}
+
+ASTNode* ScriptOptimizer::fold(ASTNode* node, VariableScope* scope, int lineNo) {
+  // Operands are constants, so evaluation does not touch the stack
+  CallStack stack(nullptr);
+  OpReturnType value;
+  try {
+    value = node->get_value(stack);
+  } catch (...) {
+    return node;
+  }
+  // Containers are mutable, so each evaluation has to create a new one
+  if (value == nullptr || !value->is_single()) {
+    return node;
+  }
+  _numFolded++;
+  return new ConstantNode(scope, lineNo, value);
+}
+
+void ScriptOptimizer::add_function(FunctionDef* function) {
+  if (_phase == Phase::MODULE) {
+    _deferredFunctions.push_back(function);
+  } else {
+    process_function(function);
+  }
+}
+
+void ScriptOptimizer::add_constant(const StackLocation& loc, OpReturnType value) {
+  _constants.push_back({loc, std::move(value)});
+}
+
+void ScriptOptimizer::add_assignment(const StackLocation& loc, OpReturnType value) {
+  // Only top level module statements are guaranteed to run, and to run before any function body
+  if (_phase == Phase::MODULE && _bodyDepth == 1) {
+    add_constant(loc, std::move(value));
+  }
+}
+
+OpReturnType ScriptOptimizer::get_constant(const StackLocation& loc, const VariableScope* scope) {
+  if (scope->num_bindings(loc) != 1) {
+    return nullptr;
+  }
+  for (auto& [constantLoc, value] : _constants) {
+    if (constantLoc == loc) {
+      _numNamesResolved++;
+      return value;
+    }
+  }
+  return nullptr;
+}
+
+// NODES
+
+std::string ConstantNode::dump() const { return _d->to_json().dump(); }
+
+ASTNode* BinNode::optimize(ScriptOptimizer& optimizer) {
+  _left = optimizer.optimize(_left);
+  _right = optimizer.optimize(_right);
+  if (as_constant(_left) && as_constant(_right)) {
+    return optimizer.fold(this, _scope, _lineNo);
+  }
+  return this;
+}
+
+std::string BinNode::dump() const {
+  return "(" + _left->dump() + " " + get_operator_symbol(_opType) + " " + _right->dump() + ")";
+}
+
+ASTNode* UnaryNode::optimize(ScriptOptimizer& optimizer) {
+  _operand = optimizer.optimize(_operand);
+  if (as_constant(_operand)) {
+    return optimizer.fold(this, _scope, _lineNo);
+  }
+  return this;
+}
+
+std::string UnaryNode::dump() const {
+  return std::string("(") + get_operator_symbol(_opType) + _operand->dump() + ")";
+}
+
+ASTNode* CompareNode::optimize(ScriptOptimizer& optimizer) {
+  _left = optimizer.optimize(_left);
+  optimize_nodes(optimizer, _comparators);
+  if (as_constant(_left) && all_constants(_comparators)) {
+    return optimizer.fold(this, _scope, _lineNo);
+  }
+  return this;
+}
+
+std::string CompareNode::dump() const {
+  std::string ret = "(" + _left->dump();
+  for (int i = 0; i < _comparators.size(); i++) {
+    ret += std::string(" ") + get_operator_symbol(_opTypes[i]) + " " + _comparators[i]->dump();
+  }
+  return ret + ")";
+}
+
+ASTNode* BoolNode::optimize(ScriptOptimizer& optimizer) {
+  optimize_nodes(optimizer, _comparators);
+  if (all_constants(_comparators)) {
+    return optimizer.fold(this, _scope, _lineNo);
+  }
+  return this;
+}
+
+std::string BoolNode::dump() const {
+  std::string ret = "(" + _comparators[0]->dump();
+  for (int i = 1; i < _comparators.size(); i++) {
+    ret += std::string(" ") + get_operator_symbol(_opType) + " " + _comparators[i]->dump();
+  }
+  return ret + ")";
+}
+
+ASTNode* CallNode::optimize(ScriptOptimizer& optimizer) {
+  _functionNode = optimizer.optimize(_functionNode);
+  optimize_nodes(optimizer, _arguments);
+  // The function can now be a constant
+  find_comprehension_argument();
+  return this;
+}
+
+std::string CallNode::dump() const {
+  return _functionNode->dump() + "(" + dump_nodes(_arguments) + ")";
+}
+
+ASTNode* ListNode::optimize(ScriptOptimizer& optimizer) {
+  optimize_nodes(optimizer, _membersInList);
+  return this;
+}
+
+std::string ListNode::dump() const { return "[" + dump_nodes(_membersInList) + "]"; }
+
+ASTNode* TupleNode::optimize(ScriptOptimizer& optimizer) {
+  if (!_store) {
+    optimize_nodes(optimizer, _membersInTuple);
+  }
+  return this;
+}
+
+std::string TupleNode::dump() const { return "(" + dump_nodes(_membersInTuple) + ")"; }
+
+ASTNode* NameNode::optimize(ScriptOptimizer& optimizer) {
+  if (_type != Type::LOAD) {
+    return this;
+  }
+  auto value = optimizer.get_constant(_stackLocation, _scope);
+  if (value == nullptr) {
+    return this;
+  }
+  return new ConstantNode(_scope, _lineNo, value);
+}
+
+ASTNode* AttributeNode::optimize(ScriptOptimizer& optimizer) {
+  _mainNode = optimizer.optimize(_mainNode);
+  return this;
+}
+
+std::string AttributeNode::dump() const {
+  return _mainNode->dump() + "." + DataVariable::get_member_func_string(_memberIndex);
+}
+
+ASTNode* SliceNode::optimize(ScriptOptimizer& optimizer) {
+  _lower = optimizer.optimize(_lower);
+  _upper = optimizer.optimize(_upper);
+  _step = optimizer.optimize(_step);
+  return this;
+}
+
+std::string SliceNode::dump() const {
+  std::string ret = (_lower ? _lower->dump() : "") + ":" + (_upper ? _upper->dump() : "");
+  if (_step) {
+    ret += ":" + _step->dump();
+  }
+  return ret;
+}
+
+ASTNode* SubscriptNode::optimize(ScriptOptimizer& optimizer) {
+  _sliceNode = optimizer.optimize(_sliceNode);
+  _mainNode = optimizer.optimize(_mainNode);
+  return this;
+}
+
+std::string SubscriptNode::dump() const {
+  return _mainNode->dump() + "[" + _sliceNode->dump() + "]";
+}
+
+ASTNode* DictNode::optimize(ScriptOptimizer& optimizer) {
+  optimize_nodes(optimizer, _keyNodes);
+  optimize_nodes(optimizer, _valueNodes);
+  return this;
+}
+
+std::string DictNode::dump() const {
+  std::string ret = "{";
+  for (int i = 0; i < _keyNodes.size(); i++) {
+    if (i > 0) ret += ", ";
+    ret += _keyNodes[i]->dump() + ": " + _valueNodes[i]->dump();
+  }
+  return ret + "}";
+}
+
+ASTNode* SingleGeneratorNode::optimize(ScriptOptimizer& optimizer) {
+  _iterableNode = optimizer.optimize(_iterableNode);
+  optimize_nodes(optimizer, _conditionNodes);
+  if (_nextGenerator != nullptr) {
+    _nextGenerator->optimize(optimizer);
+  }
+  return this;
+}
+
+ASTNode* ComprehensionNode::optimize(ScriptOptimizer& optimizer) {
+  // Optimizing the first generator optimizes the ones chained after it
+  if (!_chainGenerators.empty()) {
+    _chainGenerators[0]->optimize(optimizer);
+  }
+  _elementNode = optimizer.optimize(_elementNode);
+  return this;
+}
+
+ASTNode* DictComprehensionNode::optimize(ScriptOptimizer& optimizer) {
+  ComprehensionNode::optimize(optimizer);
+  _keyNode = optimizer.optimize(_keyNode);
+  _valueNode = optimizer.optimize(_valueNode);
+  return this;
+}
+
+// STATEMENTS
+
+void Statement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "<statement>");
+}
+
+void Body::dump(std::string& out, int indent) const {
+  if (_codeLines.empty()) {
+    dump_line(out, indent, "pass");
+  }
+  for (auto s : _codeLines) {
+    s->dump(out, indent);
+  }
+}
+
+Statement* AssignStatement::optimize(ScriptOptimizer& optimizer) {
+  _node = optimizer.optimize(_node);
+  _targetOp = optimizer.optimize(_targetOp);
+  auto target = dynamic_cast<NameNode*>(_targetOp);
+  auto constant = as_constant(_node);
+  if (target != nullptr && target->is_store() && constant != nullptr) {
+    optimizer.add_assignment(target->get_location(), constant->value());
+  }
+  return this;
+}
+
+void AssignStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, _targetOp->dump() + " = " + _node->dump());
+}
+
+Statement* ExprStatement::optimize(ScriptOptimizer& optimizer) {
+  _node = optimizer.optimize(_node);
+  if (as_constant(optimizer, _node)) {
+    // Expression without side effects, e.g. a docstring
+    return nullptr;
+  }
+  return this;
+}
+
+void ExprStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, _node->dump());
+}
+
+Statement* ReturnStatement::optimize(ScriptOptimizer& optimizer) {
+  _node = optimizer.optimize(_node);
+  return this;
+}
+
+void ReturnStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "return " + _node->dump());
+}
+
+void BreakStatement::dump(std::string& out, int indent) const { dump_line(out, indent, "break"); }
+
+void ContinueStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "continue");
+}
+
+Statement* FunctionDef::optimize(ScriptOptimizer& optimizer) {
+  for (auto& decorator : _decorators) {
+    decorator = optimizer.optimize(decorator);
+  }
+  optimizer.add_function(this);
+  return this;
+}
+
+void FunctionDef::process_body(ScriptOptimizer& optimizer, bool compileBytecode) {
+  _body->optimize(optimizer);
+  if (compileBytecode) {
+    _bytecode = BytecodeCompiler::compile(*_body);
+    LOG_VERBOSE("Compiled function=%s\n%s", _functionName.c_str(),
+                _bytecode->disassemble().c_str());
+  }
+}
+
+void FunctionDef::dump(std::string& out, int indent) const {
+  for (auto decorator : _decorators) {
+    dump_line(out, indent, "@" + decorator->dump());
+  }
+  dump_line(out, indent, "def " + _functionName + "(...):");
+  _body->dump(out, indent + 1);
+}
+
+void ImportStatement::dump(std::string& out, int indent) const {
+  for (auto& import : _imports) {
+    dump_line(out, indent, "from " + import.module + " import " + import.name);
+  }
+}
+
+Statement* ForStatement::optimize(ScriptOptimizer& optimizer) {
+  _iterator = optimizer.optimize(_iterator);
+  _newVar = optimizer.optimize(_newVar);
+  _body->optimize(optimizer);
+  return this;
+}
+
+void ForStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "for " + _newVar->dump() + " in " + _iterator->dump() + ":");
+  _body->dump(out, indent + 1);
+}
+
+Statement* WhileStatement::optimize(ScriptOptimizer& optimizer) {
+  _testNode = optimizer.optimize(_testNode);
+  auto test = as_constant(optimizer, _testNode);
+  if (test != nullptr && !test->value()->get_bool()) {
+    return nullptr;
+  }
+  _body->optimize(optimizer);
+  return this;
+}
+
+void WhileStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "while " + _testNode->dump() + ":");
+  _body->dump(out, indent + 1);
+}
+
+Statement* IfStatement::optimize(ScriptOptimizer& optimizer) {
+  _testNode = optimizer.optimize(_testNode);
+  auto test = as_constant(optimizer, _testNode);
+  if (test == nullptr) {
+    _trueBody->optimize(optimizer);
+    _elseBody->optimize(optimizer);
+    return this;
+  }
+  optimizer.statement_removed();
+  Body* body = nullptr;
+  if (test->value()->get_bool()) {
+    std::swap(body, _trueBody);
+  } else {
+    std::swap(body, _elseBody);
+  }
+  if (body->empty()) {
+    delete body;
+    return nullptr;
+  }
+  return optimizer.optimize(new BlockStatement(_lineNo, body));
+}
+
+void IfStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "if " + _testNode->dump() + ":");
+  _trueBody->dump(out, indent + 1);
+  if (!_elseBody->empty()) {
+    dump_line(out, indent, "else:");
+    _elseBody->dump(out, indent + 1);
+  }
+}
+
+Statement* BlockStatement::optimize(ScriptOptimizer& optimizer) {
+  _body->optimize(optimizer);
+  if (_body->empty()) {
+    return nullptr;
+  }
+  return this;
+}
+
+void BlockStatement::dump(std::string& out, int indent) const { _body->dump(out, indent); }
+
+Statement* AssertStatement::optimize(ScriptOptimizer& optimizer) {
+  _testNode = optimizer.optimize(_testNode);
+  _msgNode = optimizer.optimize(_msgNode);
+  auto test = as_constant(optimizer, _testNode);
+  if (test != nullptr && test->value()->get_bool()) {
+    return nullptr;
+  }
+  return this;
+}
+
+void AssertStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent,
+            "assert " + _testNode->dump() + (_msgNode ? ", " + _msgNode->dump() : ""));
+}
+
+Statement* RaiseStatement::optimize(ScriptOptimizer& optimizer) {
+  _throwNode = optimizer.optimize(_throwNode);
+  return this;
+}
+
+void RaiseStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "raise " + _throwNode->dump());
+}
+
+Statement* Handler::optimize(ScriptOptimizer& optimizer) {
+  _body->optimize(optimizer);
+  return this;
+}
+
+void Handler::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "except " + _exceptionType.value_or("") + ":");
+  _body->dump(out, indent + 1);
+}
+
+Statement* TryStatement::optimize(ScriptOptimizer& optimizer) {
+  _tryBody->optimize(optimizer);
+  for (auto& handler : _handlers) {
+    handler->optimize(optimizer);
+  }
+  return this;
+}
+
+void TryStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "try:");
+  _tryBody->dump(out, indent + 1);
+  for (auto& handler : _handlers) {
+    handler->dump(out, indent);
+  }
+}
+
+Statement* InbuiltFunctionsStatement::optimize(ScriptOptimizer& optimizer) {
+  // Same values as the ones set by execute(), builtins are stateless so they can be shared
+  int i = 0;
+  for (auto it = CustomFunctions::_customFuncMap.begin();
+       it != CustomFunctions::_customFuncMap.end(); ++it) {
+    optimizer.add_constant(_locations[i++], OpReturnType(new CustomFuncDataVariable(it->second)));
+  }
+  return this;
+}
+
+void InbuiltFunctionsStatement::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "<builtins>");
+}
+
+Statement* ClassDef::optimize(ScriptOptimizer& optimizer) {
+  optimizer.optimize(_codeLines);
+  return this;
+}
+
+void ClassDef::dump(std::string& out, int indent) const {
+  dump_line(out, indent, "class:");
+  for (auto s : _codeLines) {
+    s->dump(out, indent + 1);
+  }
+}
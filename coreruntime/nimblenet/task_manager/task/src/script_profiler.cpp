@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "script_profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <map>
+
+#include "core_utils/fmt.hpp"
+#include "nlohmann/json.hpp"
+
+std::atomic<bool> ScriptProfiler::_enabled{false};
+std::atomic<uint64_t> ScriptProfiler::_generation{0};
+std::mutex ScriptProfiler::_mutex;
+std::vector<std::shared_ptr<ScriptProfiler::ThreadProfile>> ScriptProfiler::_threads;
+
+namespace {
+
+/**
+ * @brief Node of the trees of all threads merged, children are keyed by their label.
+ */
+struct MergedNode {
+  bool isLine = false;
+  int64_t calls = 0;
+  int64_t totalNs = 0;
+  std::map<std::string, MergedNode> children;
+
+  int64_t self_ns() const {
+    int64_t childrenNs = 0;
+    for (const auto& [label, child] : children) {
+      childrenNs += child.totalNs;
+    }
+    return std::max<int64_t>(totalNs - childrenNs, 0);
+  }
+};
+
+struct Totals {
+  int64_t calls = 0;
+  int64_t inclusiveNs = 0;
+  int64_t exclusiveNs = 0;
+};
+
+void write_collapsed(const MergedNode& node, const std::string& path, std::string& out) {
+  for (const auto& [label, child] : node.children) {
+    std::string childPath = path.empty() ? label : path + ";" + label;
+    int64_t selfUs = child.self_ns() / 1000;
+    if (selfUs > 0) {
+      out += childPath + " " + std::to_string(selfUs) + "\n";
+    }
+    write_collapsed(child, childPath, out);
+  }
+}
+
+// Time of recursive calls is added to the inclusive time of the outermost call only
+void add_totals(const MergedNode& node, std::map<std::string, int>& active,
+                std::map<std::string, Totals>& functions, std::map<std::string, Totals>& lines) {
+  for (const auto& [label, child] : node.children) {
+    auto& totals = child.isLine ? lines[label] : functions[label];
+    totals.calls += child.calls;
+    totals.exclusiveNs += child.self_ns();
+    if (active[label]++ == 0) {
+      totals.inclusiveNs += child.totalNs;
+    }
+    add_totals(child, active, functions, lines);
+    active[label]--;
+  }
+}
+
+nlohmann::json totals_to_json(const std::map<std::string, Totals>& totals) {
+  auto json = nlohmann::json::object();
+  for (const auto& [label, t] : totals) {
+    json[label] = {{"calls", t.calls},
+                   {"inclusiveUs", t.inclusiveNs / 1000.0},
+                   {"exclusiveUs", t.exclusiveNs / 1000.0}};
+  }
+  return json;
+}
+
+}  // namespace
+
+ScriptProfiler::ThreadProfile& ScriptProfiler::thread_profile() {
+  static thread_local std::shared_ptr<ThreadProfile> profile;
+  if (profile && profile->depth > 0) {
+    // Frames of the profile are open, keep using it even if it was reset
+    return *profile;
+  }
+  if (!profile || profile->generation != _generation.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> locker(_mutex);
+    profile = std::make_shared<ThreadProfile>();
+    profile->generation = _generation.load(std::memory_order_acquire);
+    _threads.push_back(profile);
+  }
+  return *profile;
+}
+
+void ScriptProfiler::reset() {
+  std::lock_guard<std::mutex> locker(_mutex);
+  _threads.clear();
+  _generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::string ScriptProfiler::get_profile(Format format) {
+  MergedNode merged;
+  {
+    std::function<void(const Node&, const std::string&, MergedNode&)> mergeNode;
+    mergeNode = [&mergeNode](const Node& node, const std::string& function, MergedNode& into) {
+      for (const auto& [key, child] : node.children) {
+        bool isLine = child->line >= 0;
+        // Lines are labelled with the function they belong to, the closest function above them
+        std::string label = isLine ? function + ":" + std::to_string(child->line) : child->name;
+        auto& mergedChild = into.children[label];
+        mergedChild.isLine = isLine;
+        mergedChild.calls += child->calls;
+        mergedChild.totalNs += child->totalNs;
+        mergeNode(*child, isLine ? function : child->name, mergedChild);
+      }
+    };
+    std::lock_guard<std::mutex> locker(_mutex);
+    for (const auto& thread : _threads) {
+      std::lock_guard<std::mutex> threadLocker(thread->mutex);
+      mergeNode(thread->root, "", merged);
+    }
+  }
+
+  if (format == Format::COLLAPSED) {
+    std::string out;
+    write_collapsed(merged, "", out);
+    return out;
+  }
+  std::map<std::string, int> active;
+  std::map<std::string, Totals> functions;
+  std::map<std::string, Totals> lines;
+  add_totals(merged, active, functions, lines);
+  nlohmann::json json = {{"functions", totals_to_json(functions)},
+                         {"lines", totals_to_json(lines)}};
+  return json.dump();
+}
+
+void ScriptProfiler::write_profile(Format format, const std::string& filePath) {
+  auto profile = get_profile(format);
+  std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+  if (!file) {
+    THROW("Could not open %s to write the script profile", filePath.c_str());
+  }
+  file << profile;
+  if (!file) {
+    THROW("Could not write the script profile to %s", filePath.c_str());
+  }
+}
+
+ScriptProfiler::Format ScriptProfiler::parse_format(const std::string& format) {
+  if (format == "collapsed") {
+    return Format::COLLAPSED;
+  }
+  if (format == "json") {
+    return Format::JSON;
+  }
+  THROW("Unknown script profile format %s, expected collapsed or json", format.c_str());
+}
+
+void ProfilerScope::enter(const void* key, const std::string& name, int line) {
+  auto& profile = ScriptProfiler::thread_profile();
+  {
+    std::lock_guard<std::mutex> locker(profile.mutex);
+    auto& child = profile.current->children[key];
+    if (!child) {
+      child = std::make_unique<ScriptProfiler::Node>();
+      child->name = name;
+      child->line = line;
+      child->parent = profile.current;
+    }
+    profile.current = child.get();
+    profile.depth++;
+    _node = child.get();
+  }
+  _profile = &profile;
+  _start = std::chrono::steady_clock::now();
+}
+
+void ProfilerScope::exit() {
+  auto elapsed = std::chrono::steady_clock::now() - _start;
+  std::lock_guard<std::mutex> locker(_profile->mutex);
+  _node->calls++;
+  _node->totalNs += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  _profile->current = _node->parent;
+  _profile->depth--;
+}
@@ -6,7 +6,10 @@
 
 #include "statements.hpp"
 
+#include <atomic>
+
 #include "exception_data_variable.hpp"
+#include "script_profiler.hpp"
 
 AssignStatement::AssignStatement(VariableScope* scope, const json& line) : Statement(line) {
   auto valueBlock = line.at("value");
@@ -15,10 +18,10 @@ AssignStatement::AssignStatement(VariableScope* scope, const json& line) : State
   _targetOp = ASTNode::create_node(scope, targetBlock);
 }
 
-StatRetType* AssignStatement::execute(CallStack& stack) {
+StatRetType AssignStatement::execute(CallStack& stack) {
   auto ret = _node->get(stack);
   _targetOp->set(ret, stack);
-  return nullptr;
+  return StatRetType();
 }
 
 AssignStatement::~AssignStatement() {
@@ -31,9 +34,9 @@ ExprStatement::ExprStatement(VariableScope* scope, const json& line) : Statement
   _node = ASTNode::create_node(scope, valueBlock);
 }
 
-StatRetType* ExprStatement::execute(CallStack& stack) {
+StatRetType ExprStatement::execute(CallStack& stack) {
   _node->get(stack);
-  return nullptr;
+  return StatRetType();
 }
 
 ExprStatement::~ExprStatement() { delete _node; }
@@ -44,28 +47,29 @@ ReturnStatement::ReturnStatement(VariableScope* scope, const json& line) : State
   _node = ASTNode::create_node(scope, valueBlock);
 }
 
-StatRetType* ReturnStatement::execute(CallStack& stack) {
+StatRetType ReturnStatement::execute(CallStack& stack) {
   auto d = _node->get(stack);
   return StatRetType::create_return(d);
 }
 
 ReturnStatement::~ReturnStatement() { delete _node; }
 
-StatRetType* execute_codelines(CallStack& stack, const std::vector<Statement*> codeLines) {
+StatRetType execute_codelines(CallStack& stack, const std::vector<Statement*>& codeLines) {
   for (auto s : codeLines) {
     try {
+      ProfilerScope profilerScope(s, s->get_line());
       auto ret = s->execute(stack);
-      if (ret != nullptr) {
+      if (ret.is_control_flow()) {
         return ret;
       }
     } catch (std::exception& e) {
       THROW("lineNo=%d, %s", s->get_line(), e.what());
     }
   }
-  return nullptr;
+  return StatRetType();
 }
 
-StatRetType* Body::execute(CallStack& stack) { return execute_codelines(stack, _codeLines); }
+StatRetType Body::execute(CallStack& stack) { return execute_codelines(stack, _codeLines); }
 
 FunctionDef::FunctionDef(VariableScope* scope, const json& line, StackLocation&& functionLocation)
     : Statement(line) {
@@ -92,7 +96,7 @@ FunctionDef::FunctionDef(VariableScope* scope, const json& line, StackLocation&&
   }
 }
 
-StatRetType* FunctionDef::execute(CallStack& stack) {
+StatRetType FunctionDef::execute(CallStack& stack) {
   auto functionDataVariable = OpReturnType(new FunctionDataVariable(stack, shared_from_this()));
   for (auto& decorator : _decorators) {
     auto val = decorator->get(stack);
@@ -100,7 +104,7 @@ StatRetType* FunctionDef::execute(CallStack& stack) {
     functionDataVariable = val->execute_function(args, stack);
   }
   stack.set_variable(_functionLocation, functionDataVariable);
-  return nullptr;
+  return StatRetType();
 }
 
 OpReturnType FunctionDef::call_function(const std::vector<OpReturnType>& arguments,
@@ -115,6 +119,7 @@ OpReturnType FunctionDef::call_function(const std::vector<OpReturnType>& argumen
     // lock needs to be held since function is not static
     scopedLock = stack.scoped_lock_unique_ptr();
   }
+  ProfilerScope profilerScope(this, _functionName);
   if (arguments.size() != _argumentLocations.size()) {
     THROW("function arguments number not matching %d given %d expected", arguments.size(),
           _argumentLocations.size());
@@ -123,14 +128,17 @@ OpReturnType FunctionDef::call_function(const std::vector<OpReturnType>& argumen
   for (int i = 0; i < _argumentLocations.size(); i++) {
     stack.set_variable(_argumentLocations[i], arguments[i]);
   }
+  if (_bytecode) {
+    auto retVal = _bytecode->run(stack);
+    stack.exit_function_frame();
+    return retVal;
+  }
   auto ret = _body->execute(stack);
   stack.exit_function_frame();
-  if (ret == nullptr || ret->type != RETURNTYPE::RETURN) {
+  if (ret.type != RETURNTYPE::RETURN) {
     return OpReturnType(new NoneVariable());
   }
-  auto retVal = ret->returnVal;
-  delete ret;
-  return retVal;
+  return std::move(ret.returnVal);
 }
 
 #define STAT_REGISTER(statementType, StatementClass) \
@@ -201,7 +209,7 @@ ClassDef::ClassDef(VariableScope* scope, const json& line) : Statement(line) {
   }
 }
 
-StatRetType* ClassDef::execute(CallStack& stack) {
+StatRetType ClassDef::execute(CallStack& stack) {
   auto classDataVariable = OpReturnType(new ClassDataVariable());
   stack.set_variable(_classLocation, classDataVariable);
   execute_codelines(stack, _codeLines);
@@ -209,10 +217,15 @@ StatRetType* ClassDef::execute(CallStack& stack) {
     auto value = stack.get_variable(location);
     classDataVariable->set_member(memberIndex, value);
   }
-  return nullptr;
+  return StatRetType();
+}
+
+uint64_t ClassDataVariable::next_layout_id() {
+  static std::atomic<uint64_t> nextLayoutId{1};
+  return nextLayoutId.fetch_add(1, std::memory_order_relaxed);
 }
 
-ClassDataVariable::ClassDataVariable() {}
+ClassDataVariable::ClassDataVariable() : _layoutId(next_layout_id()) {}
 
 OpReturnType ClassDataVariable::execute_function(const std::vector<OpReturnType>& arguments,
                                                  CallStack& stack) {
@@ -243,6 +256,13 @@ OpReturnType ClassDataVariable::get_member(int memberIndex) {
 
 void ClassDataVariable::set_member(int memberIndex, OpReturnType d) {
   _membersMap[memberIndex] = d;
+  // Invalidates the members cached for the previous layout
+  _layoutId = next_layout_id();
+}
+
+OpReturnType ClassDataVariable::find_member(int memberIndex) const {
+  auto it = _membersMap.find(memberIndex);
+  return it == _membersMap.end() ? nullptr : it->second;
 }
 
 ObjectDataVariable::ObjectDataVariable(OpReturnType classDataVariable) {
@@ -275,9 +295,18 @@ OpReturnType ObjectDataVariable::get_member(int memberIndex) {
 }
 
 void ObjectDataVariable::set_member(int memberIndex, OpReturnType d) {
+  if (_shared) d->mark_shared();
   _membersMap[memberIndex] = d;
 }
 
+void ObjectDataVariable::mark_shared() {
+  if (_shared) return;
+  _shared = true;
+  for (const auto& [memberIndex, member] : _membersMap) {
+    member->mark_shared();
+  }
+}
+
 AssertStatement::AssertStatement(VariableScope* scope, const json& line) : Statement(line) {
   auto testJson = line.at("test");
   _testNode = ASTNode::create_node(scope, testJson);
@@ -287,10 +316,10 @@ AssertStatement::AssertStatement(VariableScope* scope, const json& line) : State
   }
 }
 
-StatRetType* AssertStatement::execute(CallStack& stack) {
+StatRetType AssertStatement::execute(CallStack& stack) {
   auto testVal = _testNode->get(stack);
   if (testVal->get_bool()) {
-    return nullptr;
+    return StatRetType();
   } else {
     // Throw Assertion Error
     if (_msgNode == nullptr) {
@@ -313,7 +342,7 @@ RaiseStatement::RaiseStatement(VariableScope* scope, const json& line) : Stateme
   _throwNode = ASTNode::create_node(scope, throwJson);
 }
 
-StatRetType* RaiseStatement::execute(CallStack& stack) {
+StatRetType RaiseStatement::execute(CallStack& stack) {
   auto throwValue = _throwNode->get(stack);
 
   if (throwValue->get_dataType_enum() != DATATYPE::EXCEPTION) {
@@ -352,7 +381,7 @@ bool Handler::match_expectation_type(const std::string& type) const {
   return true;
 }
 
-StatRetType* Handler::catch_exception(CallStack& stack, OpReturnType exception) {
+StatRetType Handler::catch_exception(CallStack& stack, OpReturnType exception) {
   if (_exceptionVariableLocation != StackLocation::null) {
     stack.set_variable(_exceptionVariableLocation, exception);
   }
@@ -369,7 +398,7 @@ TryStatement::TryStatement(VariableScope* scope, const json& line) : Statement(l
   }
 }
 
-StatRetType* TryStatement::execute(CallStack& stack) {
+StatRetType TryStatement::execute(CallStack& stack) {
   try {
     return _tryBody->execute(stack);
   } catch (std::exception& e) {
@@ -386,7 +415,7 @@ StatRetType* TryStatement::execute(CallStack& stack) {
   }
 }
 
-StatRetType* ImportStatement::execute(CallStack& stack) {
+StatRetType ImportStatement::execute(CallStack& stack) {
   auto task = stack.task();
   for (const auto& [moduleName, importName, stackLocation] : _imports) {
     // TODO (puneet): remove "nimbleedge" top-level package name after all deployments are updated
@@ -417,52 +446,52 @@ StatRetType* ImportStatement::execute(CallStack& stack) {
         THROW("Cannot import=%s from module=%s at lineno=%d: import not found in module",
               importName.c_str(), moduleName.c_str(), get_line());
       }
-      auto loc = module->get_variable_location(importName);
-      stack.set_variable(stackLocation, stack.get_variable(loc));
+      stack.set_variable(stackLocation, module->get_variable(importName));
     }
   }
-  return nullptr;
+  return StatRetType();
 }
 
 InbuiltFunctionsStatement::InbuiltFunctionsStatement(VariableScope* scope) {
   for (auto it = CustomFunctions::_customFuncMap.begin();
        it != CustomFunctions::_customFuncMap.end(); ++it) {
-    _locations.push_back(scope->add_variable(it->first));
+    _locations.push_back(scope->add_builtin(it->first));
   }
 }
 
-StatRetType* InbuiltFunctionsStatement::execute(CallStack& stack) {
+StatRetType InbuiltFunctionsStatement::execute(CallStack& stack) {
   int i = 0;
   for (auto it = CustomFunctions::_customFuncMap.begin();
        it != CustomFunctions::_customFuncMap.end(); ++it) {
     stack.set_variable(_locations[i++], OpReturnType(new CustomFuncDataVariable(it->second)));
   }
-  return nullptr;
+  return StatRetType();
 }
 
-StatRetType* ForStatement::execute(CallStack& stack) {
+StatRetType ForStatement::execute(CallStack& stack) {
   auto iteratorVal = _iterator->get(stack);
   int size = iteratorVal->get_size();
+  // Elements of unboxed lists are read without boxing them
+  auto list = iteratorVal->get_containerType() == CONTAINERTYPE::LIST
+                  ? static_cast<ListDataVariable*>(iteratorVal.get())
+                  : nullptr;
   for (int i = 0; i < size; i++) {
-    auto d = iteratorVal->get_int_subscript(i);
-    _newVar->set_variable(d, stack);
+    if (list) {
+      _newVar->set_value(list->get_int_subscript_value(i), stack);
+    } else {
+      _newVar->set_variable(iteratorVal->get_int_subscript(i), stack);
+    }
     auto ret = _body->execute(stack);
     // there might be elements getting added or deleted inside body->execute, so changing the
     // iteration size
     size = iteratorVal->get_size();
-    if (ret != nullptr) {
-      if (ret->type == RETURNTYPE::BREAK) {
-        delete ret;
-        break;
-      } else if (ret->type == RETURNTYPE::CONTINUE) {
-        delete ret;
-        continue;
-      } else if (ret->type == RETURNTYPE::RETURN) {
-        return ret;
-      }
+    if (ret.type == RETURNTYPE::BREAK) {
+      break;
+    } else if (ret.type == RETURNTYPE::RETURN) {
+      return ret;
     }
   }
-  return nullptr;
+  return StatRetType();
 }
 
 ForStatement::ForStatement(VariableScope* scope, const json& line) : Statement(line) {
@@ -489,23 +518,17 @@ WhileStatement::WhileStatement(VariableScope* scope, const json& line) : Stateme
   _body = new Body(whileLoopScope, bodyJson);
 }
 
-StatRetType* WhileStatement::execute(CallStack& stack) {
+StatRetType WhileStatement::execute(CallStack& stack) {
   while (_testNode->get(stack)->get_bool()) {
     auto ret = _body->execute(stack);
-    if (ret != nullptr) {
-      if (ret->type == RETURNTYPE::BREAK) {
-        delete ret;
-        break;
-      } else if (ret->type == RETURNTYPE::CONTINUE) {
-        delete ret;
-        continue;
-      } else if (ret->type == RETURNTYPE::RETURN) {
-        return ret;
-      }
+    if (ret.type == RETURNTYPE::BREAK) {
+      break;
+    } else if (ret.type == RETURNTYPE::RETURN) {
+      return ret;
     }
   }
 
-  return nullptr;
+  return StatRetType();
 }
 
 WhileStatement::~WhileStatement() {
@@ -524,7 +547,7 @@ IfStatement::IfStatement(VariableScope* scope, const json& line) : Statement(lin
   _elseBody = new Body(elseScope, elseBodyJson);
 }
 
-StatRetType* IfStatement::execute(CallStack& stack) {
+StatRetType IfStatement::execute(CallStack& stack) {
   auto testVal = _testNode->get(stack);
   if (testVal->get_bool()) {
     return _trueBody->execute(stack);
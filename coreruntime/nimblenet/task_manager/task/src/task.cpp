@@ -10,6 +10,7 @@
 
 #include "data_variable.hpp"
 #include "future_data_variable.hpp"
+#include "script_profiler.hpp"
 #include "statements.hpp"
 #include "variable_scope.hpp"
 
@@ -65,16 +66,41 @@ static inline void log_script_acu_metric(std::shared_ptr<Asset> scriptAsset,
 
 Task::Task(CommandCenter* commandCenter, std::shared_ptr<Asset> taskAsset)
     : _callStack(commandCenter) {
-  auto [readSuccess, task] =
-      nativeinterface::read_potentially_compressed_file(taskAsset->locationOnDisk.path);
-  if (!readSuccess) {
-    LOG_TO_CLIENT_ERROR("%s", "Script could not be read from file.");
-    return;
+  const auto& scriptPath = taskAsset->locationOnDisk.path;
+  const auto cachePath = ScriptCache::get_cache_path(scriptPath, taskAsset->name, taskAsset->version);
+  const bool useCache = commandCenter->get_config()->cacheScriptAst;
+  _scriptPath = scriptPath;
+  if (useCache) {
+    _scriptCache = ScriptCache::load(cachePath, taskAsset->name, taskAsset->version);
+  }
+
+  if (_scriptCache == nullptr) {
+    auto [readSuccess, task] = nativeinterface::read_potentially_compressed_file(scriptPath);
+    if (!readSuccess) {
+      LOG_TO_CLIENT_ERROR("%s", "Script could not be read from file.");
+      return;
+    }
+    _astJson = nlohmann::json::parse(task);
+    if (useCache) {
+      bool saved;
+      if (_astJson.contains(MAIN_MODULE)) {
+        saved = ScriptCache::save(cachePath, taskAsset->name, taskAsset->version, _astJson);
+      } else {
+        // A script without imports is the AST of the main module, which is moved into the object
+        // of modules for saving and back, so that the AST is not copied
+        json modules = json::object();
+        modules[MAIN_MODULE] = std::move(_astJson);
+        saved = ScriptCache::save(cachePath, taskAsset->name, taskAsset->version, modules);
+        _astJson = std::move(modules[MAIN_MODULE]);
+      }
+      if (saved) {
+        ScriptCache::remove_other_versions(cachePath, taskAsset->name);
+      }
+    }
   }
 
   _version = taskAsset->version;
   _commandCenter = commandCenter;
-  _astJson = nlohmann::json::parse(task);
 
 #ifdef GENAI
   _streamPushThread = std::thread(&Task::run_background_jobs_on_new_thread, this);
@@ -91,26 +117,62 @@ void Task::operate(const std::string& functionName, const MapVariablePtr inputs,
 
 void Task::parse_main_module() {
   if (_mainModule) return;
-  json mainAst = _astJson;
-  if (_astJson.contains(MAIN_MODULE)) {
-    mainAst = _astJson.at(MAIN_MODULE);
-  }
-  _mainModule = std::make_unique<DpModule>(_commandCenter, MAIN_MODULE, 0, mainAst, _callStack);
+  json mainAst = get_module_ast(MAIN_MODULE);
+  _compileBytecode = _commandCenter->get_config()->compileScript;
+  _optimizeScript = _commandCenter->get_config()->optimizeScript;
+  // The profile covers the script loaded last, starting with the execution of its modules
+  ScriptProfiler::reset();
+  ScriptProfiler::set_enabled(_commandCenter->get_config()->profileScript);
+  _mainModule = std::make_unique<DpModule>(_commandCenter, MAIN_MODULE, 0, mainAst, _callStack,
+                                           _compileBytecode, _optimizeScript);
+  // The module is loaded on the ScriptLoadJob thread while run_task runs on client threads, and
+  // functions are looked up without the script lock and run concurrently. Sharing the frames makes
+  // accesses of module variables lock the frame holding them and the dicts they hold
+  _callStack.share_frames();
   LOG_TO_CLIENT_INFO("Script Loaded with version=%s", _version.c_str());
 }
 
 bool Task::has_module(const std::string& module) const {
+  if (_scriptCache) {
+    return _modules.find(module) != _modules.end() || _scriptCache->has_module(module);
+  }
   return _modules.find(module) != _modules.end() ||
          (_astJson.is_object() && _astJson.contains(module));
 }
 
+json Task::get_module_ast(const std::string& name) {
+  if (_scriptCache) {
+    auto ast = _scriptCache->get_module(name);
+    if (!ast.is_null()) {
+      return ast;
+    }
+    // Cache is corrupted, parse the script again and use it for this and all later modules
+    _scriptCache = nullptr;
+    auto [readSuccess, script] = nativeinterface::read_potentially_compressed_file(_scriptPath);
+    if (!readSuccess) {
+      THROW("Script %s could not be read from file", _scriptPath.c_str());
+    }
+    _astJson = nlohmann::json::parse(script);
+  }
+  // A script without imports is stored as the AST of its main module
+  if (name == MAIN_MODULE && !_astJson.contains(MAIN_MODULE)) {
+    return _astJson;
+  }
+  return _astJson.at(name);
+}
+
 std::shared_ptr<DpModule> Task::get_module(const std::string& name, CallStack& stack) {
   if (_modules.find(name) != _modules.end()) {
     return _modules.at(name);
   }
   auto module = std::make_shared<DpModule>(_commandCenter, name, _modules.size() + 1,
-                                           _astJson.at(name), stack);
+                                           get_module_ast(name), stack, _compileBytecode,
+                                           _optimizeScript);
   _modules[name] = module;
+  // The frame of an imported module is not on _callStack, which parse_main_module() shares. Other
+  // threads reach its variables through the functions of the module, and through later imports
+  // when it is imported for the first time inside a function
+  module->share_frames();
   return module;
 }
 
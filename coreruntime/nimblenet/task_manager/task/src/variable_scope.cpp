@@ -16,27 +16,72 @@ StackLocation StackLocation::local(int moduleIndex, int functionIndex, int varIn
   return StackLocation(moduleIndex, functionIndex, varIndex);
 }
 
+void CallStack::FrameIndex::push(StackFramePtr frame) {
+  int moduleIndex = frame->get_module_index();
+  int functionIndex = frame->get_function_index();
+  if (moduleIndex >= moduleToStackFrameMap.size()) {
+    moduleToStackFrameMap.resize(moduleIndex + 1);
+  }
+  if (functionIndex >= moduleToStackFrameMap[moduleIndex].size()) {
+    moduleToStackFrameMap[moduleIndex].resize(functionIndex + 1);
+  }
+  moduleToStackFrameMap[moduleIndex][functionIndex].push_back(frame);
+  functionsStack.push_back(std::move(frame));
+}
+
+void CallStack::FrameIndex::pop() {
+  if (functionsStack.size() == 0) {
+    THROW("%s", "Attempting to exit function frame when there is currently no function running");
+  }
+  const auto currentStackFramePtr = functionsStack.back();
+  functionsStack.pop_back();
+  auto& currentFunctionExecs = moduleToStackFrameMap[currentStackFramePtr->get_module_index()]
+                                                    [currentStackFramePtr->get_function_index()];
+  if (currentFunctionExecs.size() == 0) {
+    THROW("%s", "Function existed in functions stack, but can't find its frame pointer");
+  }
+  currentFunctionExecs.pop_back();
+}
+
 // Responsibility of caller to ensure that the location is correct
+StackFrame& CallStack::top_frame(const StackLocation& loc) const {
+  // Frames entered on this copy of the stack shadow the ones in the shared index
+  for (auto it = _pushedFrames.rbegin(); it != _pushedFrames.rend(); ++it) {
+    if ((*it)->get_function_index() == loc._functionIndex &&
+        (*it)->get_module_index() == loc._moduleIndex) {
+      return **it;
+    }
+  }
+  const auto& moduleToStackFrameMap = _index->moduleToStackFrameMap;
+  assert(loc._moduleIndex < moduleToStackFrameMap.size() &&
+         loc._functionIndex < moduleToStackFrameMap[loc._moduleIndex].size());
+  return *moduleToStackFrameMap[loc._moduleIndex][loc._functionIndex].back();
+}
+
 OpReturnType CallStack::get_variable(StackLocation loc) const {
-  assert(loc._moduleIndex < _moduleToStackFrameMap.size() &&
-         loc._functionIndex < _moduleToStackFrameMap[loc._moduleIndex].size());
-  const auto stackFramePtr = _moduleToStackFrameMap[loc._moduleIndex][loc._functionIndex].back();
-  return stackFramePtr->get(loc._varIndex);
+  return top_frame(loc).get(loc._varIndex);
 }
 
 // Caller will ensure the StackLocation is correct
 void CallStack::set_variable(StackLocation loc, OpReturnType val) {
-  assert(loc._moduleIndex < _moduleToStackFrameMap.size() &&
-         loc._functionIndex < _moduleToStackFrameMap[loc._moduleIndex].size());
-
   if (auto futureVal = std::dynamic_pointer_cast<FutureDataVariable>(val); futureVal) {
     // Internally, the function will call _task->save_future() only once. Hence futures can be
     // passed around after getting created in the global stack frame
     futureVal->save_to_task(*task());
   }
 
-  auto stackFramePtr = _moduleToStackFrameMap[loc._moduleIndex][loc._functionIndex].back();
-  stackFramePtr->set(loc._varIndex, val);
+  top_frame(loc).set(loc._varIndex, val);
+}
+
+Value CallStack::get_value(StackLocation loc) const {
+  return top_frame(loc).get_value(loc._varIndex);
+}
+
+void CallStack::set_value(StackLocation loc, Value val) {
+  if (!val.is_scalar()) {
+    return set_variable(loc, val.take_box());
+  }
+  top_frame(loc).set_value(loc._varIndex, std::move(val));
 }
 
 CallStack::CallStack(const CallStack& other) { *this = other; }
@@ -45,8 +90,11 @@ CallStack& CallStack::operator=(const CallStack& other) {
   if (this == &other) {
     return *this;  // Handle self-assignment
   }
-  _functionsStack = other._functionsStack;
-  _moduleToStackFrameMap = other._moduleToStackFrameMap;
+  // The index is shared and copied only when one of the stacks exits a frame of the index
+  _index = other._index;
+  _ownsIndex.store(false, std::memory_order_relaxed);
+  other._ownsIndex.store(false, std::memory_order_relaxed);
+  _pushedFrames = other._pushedFrames;
   _commandCenter = other._commandCenter;
   return *this;
 }
@@ -58,34 +106,54 @@ CallStack CallStack::create_copy_with_deferred_lock() {
   return newStack;
 }
 
-std::shared_ptr<Task> CallStack::task() noexcept { return _commandCenter->get_task(); }
+void CallStack::share_frames() {
+  for (auto& functionFrames : _index->moduleToStackFrameMap) {
+    for (auto& frames : functionFrames) {
+      for (auto& frame : frames) {
+        frame->share();
+      }
+    }
+  }
+  for (auto& frame : _pushedFrames) {
+    frame->share();
+  }
+}
 
-void CallStack::enter_function_frame(int moduleIndex, int functionIndex, int numVariablesInFrame) {
-  if (moduleIndex >= _moduleToStackFrameMap.size()) {
-    _moduleToStackFrameMap.resize(moduleIndex + 1);
+void CallStack::materialize_index() {
+  if (!_ownsIndex.load(std::memory_order_relaxed)) {
+    _index = std::make_shared<FrameIndex>(*_index);
+    _ownsIndex.store(true, std::memory_order_relaxed);
   }
-  if (functionIndex >= _moduleToStackFrameMap[moduleIndex].size()) {
-    _moduleToStackFrameMap[moduleIndex].resize(functionIndex + 1);
+  for (auto& frame : _pushedFrames) {
+    _index->push(std::move(frame));
   }
+  _pushedFrames.clear();
+}
+
+std::shared_ptr<Task> CallStack::task() noexcept { return _commandCenter->get_task(); }
+
+void CallStack::enter_function_frame(int moduleIndex, int functionIndex, int numVariablesInFrame) {
   // Not calling make_shared since StackFrame's constructor is private
   std::shared_ptr<StackFrame> stackFramePtr{
       new StackFrame{moduleIndex, functionIndex, numVariablesInFrame}};
-  _moduleToStackFrameMap[moduleIndex][functionIndex].push_back(stackFramePtr);
-  _functionsStack.push_back(stackFramePtr);
+  if (_pushedFrames.empty() && _ownsIndex.load(std::memory_order_relaxed)) {
+    _index->push(std::move(stackFramePtr));
+    return;
+  }
+  _pushedFrames.push_back(std::move(stackFramePtr));
+  if (_pushedFrames.size() > MAX_PUSHED_FRAMES) {
+    // Keep lookups of variables from scanning a long list of frames, e.g. on deep recursion
+    materialize_index();
+  }
 }
 
 void CallStack::exit_function_frame() {
-  if (_functionsStack.size() == 0) {
-    THROW("%s", "Attempting to exit function frame when there is currently no function running");
-  }
-  const auto currentStackFramePtr = _functionsStack.back();
-  _functionsStack.pop_back();
-  auto& currentFunctionExecs = _moduleToStackFrameMap[currentStackFramePtr->get_module_index()]
-                                                     [currentStackFramePtr->get_function_index()];
-  if (currentFunctionExecs.size() == 0) {
-    THROW("%s", "Function existed in functions stack, but can't find its frame pointer");
+  if (!_pushedFrames.empty()) {
+    _pushedFrames.pop_back();
+    return;
   }
-  currentFunctionExecs.pop_back();
+  materialize_index();
+  _index->pop();
 }
 
 VariableScope::VariableScope(VariableScope* p, bool isNewFunction) {
@@ -93,6 +161,8 @@ VariableScope::VariableScope(VariableScope* p, bool isNewFunction) {
   _commandCenter = p->get_commandCenter();
   _moduleIndex = p->_moduleIndex;
   _nextFunctionIndex = p->_nextFunctionIndex;
+  _numBindings = p->_numBindings;
+  _builtins = p->_builtins;
   if (isNewFunction) {
     _currentFunctionIndex = *_nextFunctionIndex;
     *_nextFunctionIndex += 1;
@@ -106,6 +176,8 @@ VariableScope::VariableScope(VariableScope* p, bool isNewFunction) {
 VariableScope::VariableScope(CommandCenter* commandCenter, int moduleIndex) {
   _commandCenter = commandCenter;
   _moduleIndex = moduleIndex;
+  _numBindings = std::make_shared<std::map<std::pair<int, int>, int>>();
+  _builtins = std::make_shared<std::set<std::pair<int, int>>>();
   _parentScope = nullptr;
   // Index 0 is used for global scope
   _currentFunctionIndex = 0;
@@ -118,7 +190,57 @@ StackLocation VariableScope::add_variable(const std::string& variableName) {
     THROW("Trying to add same variable in scope=%s", variableName.c_str());
   int index = create_new_variable();
   _variableNamesIdxMap[variableName] = index;
-  return StackLocation::local(_moduleIndex, current_function_index(), index);
+  auto location = StackLocation::local(_moduleIndex, current_function_index(), index);
+  add_binding(location);
+  return location;
+}
+
+StackLocation VariableScope::add_or_shadow_builtin(const std::string& variableName) {
+  auto it = _variableNamesIdxMap.find(variableName);
+  if (it != _variableNamesIdxMap.end()) {
+    auto location = StackLocation::local(_moduleIndex, current_function_index(), it->second);
+    if (is_builtin(location)) {
+      // From now on the variable is a regular one, defining it again fails like for any function
+      _builtins->erase({location._functionIndex, location._varIndex});
+      add_binding(location);
+      return location;
+    }
+  } else if (!is_function_scope() && is_builtin(get_variable_location_on_stack(variableName))) {
+    // The variable is only visible in this block, later loads outside of it must not silently
+    // fall back to the builtin
+    auto functionScope = this;
+    while (!functionScope->is_function_scope()) {
+      functionScope = functionScope->get_parent();
+    }
+    functionScope->_builtinsShadowedInBlocks.insert(variableName);
+  }
+  return add_variable(variableName);
+}
+
+StackLocation VariableScope::add_builtin(const std::string& variableName) {
+  auto location = add_variable(variableName);
+  _builtins->insert({location._functionIndex, location._varIndex});
+  return location;
+}
+
+bool VariableScope::is_builtin(const StackLocation& loc) const {
+  return _builtins->count({loc._functionIndex, loc._varIndex}) > 0;
+}
+
+void VariableScope::add_binding(const StackLocation& loc) {
+  (*_numBindings)[{loc._functionIndex, loc._varIndex}]++;
+}
+
+int VariableScope::num_bindings(const StackLocation& loc) const {
+  auto it = _numBindings->find({loc._functionIndex, loc._varIndex});
+  if (it == _numBindings->end()) {
+    return 0;
+  }
+  return it->second;
+}
+
+bool VariableScope::is_function_scope() const {
+  return _parentScope == nullptr || _parentScope->_currentFunctionIndex != _currentFunctionIndex;
 }
 
 VariableScope* VariableScope::add_scope() {
@@ -142,11 +264,17 @@ int VariableScope::get_variable_index_in_scope(const std::string& variableName)
 
 StackLocation VariableScope::get_variable_location_on_stack(const std::string& variableName) {
   auto scope = this;
+  bool shadowedInBlock = false;
   while (scope) {
+    shadowedInBlock |= scope->_builtinsShadowedInBlocks.count(variableName) > 0;
     int index = scope->get_variable_index_in_scope(variableName);
     if (index != -1) {
-      return StackLocation::local(scope->current_module_index(), scope->current_function_index(),
-                                  index);
+      auto location = StackLocation::local(scope->current_module_index(),
+                                           scope->current_function_index(), index);
+      if (shadowedInBlock && is_builtin(location)) {
+        return StackLocation::null;
+      }
+      return location;
     }
     scope = scope->get_parent();
   }
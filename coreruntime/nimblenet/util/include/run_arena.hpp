@@ -0,0 +1,161 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Bump allocator for memory which lives only while a single run_task call is executing.
+ *
+ * Every thread calling CommandCenter::run_task gets its own arena, installed by RunArenaScope for
+ * the duration of the call and reset when the call returns. Allocations are released in the reverse
+ * order they were made through mark() and release(), so that nested script function calls reuse
+ * the same memory. Blocks are kept across calls, so a steady state run_task does not touch the
+ * heap for memory served by the arena.
+ *
+ * Only memory whose lifetime is bound to a C++ scope may come from the arena. Its only user are the
+ * registers and loop counters allocated by BytecodeFunction::run, so unless the script is compiled
+ * to bytecode (compileScript in the config) the scope installed by run_task allocates nothing and
+ * the arena is never used. Argument vectors of calls are not served from it, as
+ * DataVariable::execute_function takes them as std::vector. DataVariables are reference counted and
+ * can be stored anywhere by the script, so they are never allocated here.
+ */
+class RunArena {
+ public:
+  struct Stats {
+    int64_t allocations = 0; /**< Allocations served by the arena */
+    int64_t bytes = 0;       /**< Bytes allocated, including alignment padding */
+    int64_t peakBytes = 0;   /**< Maximum number of bytes in use at the same time */
+    int64_t heapBlocks = 0;  /**< Blocks which had to be allocated from the heap */
+  };
+
+  /**
+   * @brief Position of the arena, allocations made after it are freed by release().
+   */
+  struct Mark {
+    size_t block = 0;
+    size_t offset = 0;
+    size_t inUse = 0;
+  };
+
+  static constexpr size_t BLOCK_SIZE = 16 * 1024;
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  std::vector<Block> _blocks;
+  size_t _block = 0;  /**< Index of the block allocations are made from */
+  size_t _offset = 0; /**< Offset of the first free byte in the current block */
+  size_t _inUse = 0;  /**< Bytes allocated and not released */
+  Stats _stats;
+
+  static thread_local RunArena* _current;
+
+  friend class RunArenaScope;
+
+ public:
+  RunArena() = default;
+  RunArena(const RunArena&) = delete;
+  RunArena& operator=(const RunArena&) = delete;
+
+  /**
+   * @brief Allocates size bytes aligned to alignment, which has to be a power of two.
+   */
+  void* allocate(size_t size, size_t alignment);
+
+  Mark mark() const { return {_block, _offset, _inUse}; }
+
+  /**
+   * @brief Frees every allocation made after mark was taken.
+   */
+  void release(const Mark& mark);
+
+  /**
+   * @brief Frees all allocations and clears the statistics, keeps the first block for reuse.
+   */
+  void reset();
+
+  const Stats& stats() const { return _stats; }
+
+  /**
+   * @brief Arena of the run_task executing on this thread, nullptr if there is none.
+   */
+  static RunArena* current() { return _current; }
+};
+
+/**
+ * @brief Installs the arena of this thread for the duration of a run_task call.
+ *
+ * Nested scopes on the same thread share the arena of the outermost scope, which resets it when it
+ * ends.
+ */
+class RunArenaScope {
+  RunArena* _arena = nullptr; /**< Arena installed by this scope, nullptr for nested scopes */
+
+ public:
+  RunArenaScope();
+  ~RunArenaScope();
+
+  RunArenaScope(const RunArenaScope&) = delete;
+  RunArenaScope& operator=(const RunArenaScope&) = delete;
+
+  /**
+   * @brief Statistics of the current call, empty for nested scopes.
+   */
+  RunArena::Stats stats() const { return _arena ? _arena->stats() : RunArena::Stats(); }
+};
+
+/**
+ * @brief Fixed size array of value initialized elements, allocated from the arena of the current
+ * run_task, or from the heap if there is none.
+ *
+ * Has to be destroyed in the reverse order of construction with respect to other ArenaArrays of the
+ * same thread, which holds for local variables.
+ */
+template <typename T>
+class ArenaArray {
+  RunArena* _arena = RunArena::current();
+  RunArena::Mark _mark;
+  T* _data = nullptr;
+  size_t _size = 0;
+
+ public:
+  explicit ArenaArray(size_t size) : _size(size) {
+    if (_arena) {
+      _mark = _arena->mark();
+      _data = static_cast<T*>(_arena->allocate(size * sizeof(T), alignof(T)));
+    } else {
+      _data = static_cast<T*>(::operator new(size * sizeof(T)));
+    }
+    std::uninitialized_value_construct_n(_data, size);
+  }
+
+  ~ArenaArray() {
+    std::destroy_n(_data, _size);
+    if (_arena) {
+      _arena->release(_mark);
+    } else {
+      ::operator delete(_data);
+    }
+  }
+
+  ArenaArray(const ArenaArray&) = delete;
+  ArenaArray& operator=(const ArenaArray&) = delete;
+
+  T& operator[](size_t index) { return _data[index]; }
+
+  const T& operator[](size_t index) const { return _data[index]; }
+
+  size_t size() const { return _size; }
+};
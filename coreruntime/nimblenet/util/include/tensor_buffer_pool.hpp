@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Thread safe pool of 64 byte aligned buffers for the data of tensors.
+ *
+ * Sizes are rounded up to size classes, four per power of two, so that at most a fifth of a buffer
+ * is unused. Released buffers are kept in a free list per class and handed out again to the next
+ * allocation of the same class, so that running the same script or model repeatedly with tensors
+ * of the same shapes stops going through the system allocator. Each buffer is preceded by a header
+ * of ALIGNMENT bytes recording its class, hence release() does not need the size.
+ *
+ * Buffers larger than MAX_POOLED_SIZE are not pooled, and released buffers are freed instead of
+ * pooled once the pool holds maxPooledBytes. trim() frees pooled buffers on memory pressure.
+ */
+class TensorBufferPool {
+ public:
+  struct Stats {
+    int64_t liveBytes = 0;   /**< Bytes of buffers allocated and not released */
+    int64_t pooledBytes = 0; /**< Bytes of released buffers kept for reuse */
+    int64_t hits = 0;        /**< Allocations served with a pooled buffer */
+    int64_t misses = 0;      /**< Allocations which went to the system allocator */
+
+    /**
+     * @brief Fraction of allocations served with a pooled buffer, 0 before any allocation.
+     */
+    double hit_rate() const { return hits + misses ? double(hits) / (hits + misses) : 0; }
+  };
+
+  static constexpr size_t ALIGNMENT = 64;
+  static constexpr size_t MIN_SIZE = 64;
+  static constexpr size_t MAX_POOLED_SIZE = size_t(64) << 20;
+  static constexpr size_t DEFAULT_MAX_POOLED_BYTES = size_t(64) << 20;
+  static constexpr int NUM_CLASSES = 81; /**< Classes from MIN_SIZE to MAX_POOLED_SIZE */
+
+ private:
+  struct SizeClass {
+    std::mutex mutex;
+    std::vector<void*> buffers; /**< Released buffers of this class */
+  };
+
+  SizeClass _classes[NUM_CLASSES];
+  std::atomic<int64_t> _liveBytes = 0;
+  std::atomic<int64_t> _pooledBytes = 0;
+  std::atomic<int64_t> _hits = 0;
+  std::atomic<int64_t> _misses = 0;
+  std::atomic<int64_t> _maxPooledBytes = DEFAULT_MAX_POOLED_BYTES;
+
+ public:
+  TensorBufferPool() = default;
+  TensorBufferPool(const TensorBufferPool&) = delete;
+  TensorBufferPool& operator=(const TensorBufferPool&) = delete;
+  ~TensorBufferPool();
+
+  /**
+   * @brief Returns an uninitialized buffer of at least size bytes aligned to ALIGNMENT.
+   *
+   * @throws std::bad_alloc if the system allocator fails
+   */
+  void* allocate(size_t size);
+
+  /**
+   * @brief Returns a buffer from allocate() to the pool, nullptr is ignored.
+   */
+  void release(void* buffer);
+
+  /**
+   * @brief Number of usable bytes of a buffer from allocate(), at least the size requested.
+   */
+  static size_t capacity(const void* buffer);
+
+  /**
+   * @brief Frees pooled buffers, largest first, until at most maxPooledBytes remain pooled.
+   */
+  void trim(size_t maxPooledBytes = 0);
+
+  /**
+   * @brief Sets the number of bytes above which released buffers are freed instead of pooled.
+   */
+  void set_max_pooled_bytes(size_t maxPooledBytes);
+
+  Stats stats() const;
+
+  /**
+   * @brief Pool used for the data of TensorVariables, and for the outputs of ONNX models with the
+   * pooledModelAllocator flag of the config.
+   */
+  static TensorBufferPool& instance();
+
+  /**
+   * @brief Size class of size bytes, NUM_CLASSES if it is larger than MAX_POOLED_SIZE.
+   */
+  static int get_size_class(size_t size);
+
+  /**
+   * @brief Capacity of the buffers of a size class below NUM_CLASSES.
+   */
+  static constexpr size_t get_class_size(int sizeClass) {
+    return sizeClass == 0 ? MIN_SIZE : size_t(5 + (sizeClass - 1) % 4) << (4 + (sizeClass - 1) / 4);
+  }
+};
@@ -7,11 +7,13 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -22,19 +24,27 @@
 static int DEFAULT_THREAD_SPIN_TIME_IN_MS = 50;
 
 /**
- * @brief A thread pool for managing and executing tasks concurrently using multiple worker threads.
+ * @brief A work stealing thread pool for managing and executing tasks concurrently using multiple
+ * worker threads.
  *
- * The ThreadPool class allows enqueuing tasks to be executed asynchronously by a pool of worker threads.
- * Tasks are processed in FIFO order.
+ * Every worker owns a deque of tasks. Tasks enqueued by a worker, e.g. by a nested run_parallel,
+ * are pushed to its own deque and taken back in LIFO order, while idle workers steal the oldest
+ * tasks from the other deques. Tasks enqueued from threads outside the pool go to a shared queue
+ * and are processed in FIFO order.
+ *
+ * Threads waiting for a task with join() execute pending tasks in the meantime and sleep once
+ * there are none left, instead of spinning on the future.
  */
 class ThreadPool {
  public:
   /**
    * @brief Constructs a ThreadPool with a specified number of worker threads.
-   * 
+   *
    * @param numThreads Number of worker threads to create.
+   * @param cpuAffinity CPUs to pin the workers to, worker i runs on cpuAffinity[i % size]. Empty to
+   * let the OS schedule the workers. Only supported on Linux and Android.
    */
-  explicit ThreadPool(size_t numThreads);
+  explicit ThreadPool(size_t numThreads, const std::vector<int>& cpuAffinity = {});
 
   /**
    * @brief Destructor. Stops all threads and joins them.
@@ -67,49 +77,118 @@ class ThreadPool {
         std::bind(std::forward<F>(f), std::forward<Args>(args)...));
 
     std::future<return_type> res = task->get_future();
-    {
-      std::unique_lock<std::mutex> lock(queueMutex);
-      if (stop) throw std::runtime_error("ThreadPool is stopped");
-
-      tasks.emplace([task]() { (*task)(); });
-    }
-    condition.notify_one();
+    push_task([task]() { (*task)(); });
     return res;
   }
 
   /**
-   * @brief Runs a single task from the thread pool queue in the current thread, if available.
+   * @brief Waits for the task of future to finish, executing pending tasks of the pool meanwhile.
+   *
+   * @details Safe to call from inside a task, the worker keeps executing the child tasks of its own
+   * deque and steals from the others. Does not call get() on the future.
+   */
+  template <class T>
+  void join(const std::future<T>& future) {
+    wait_until([&future]() {
+      return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+  }
+
+  /**
+   * @brief Runs a single task from the thread pool queues in the current thread, if available.
+   *
+   * @return true if a task was executed.
+   */
+  bool run_threadpool_task();
+
+  /**
+   * @brief Number of worker threads.
    */
-  void run_threadpool_task();
+  size_t num_workers() const { return workers.size(); }
 
  private:
+  using Task = std::function<void()>;
+
+  /**
+   * @brief Deque of tasks, the owner pushes and pops at the back and thieves take from the front.
+   */
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
   /**
-   * @brief Worker threads that execute tasks from the queue.
+   * @brief Worker threads that execute tasks from the queues.
    */
   std::vector<std::thread> workers;
 
   /**
-   * @brief Queue of tasks to be executed by the worker threads.
+   * @brief Deque of every worker, indexed by the worker index.
    */
-  std::queue<std::function<void()>> tasks;
+  std::vector<std::unique_ptr<WorkerQueue>> workerQueues;
 
   /**
-   * @brief Mutex for synchronizing access to the task queue.
+   * @brief Queue of tasks enqueued from threads outside the pool.
    */
-  std::mutex queueMutex;
+  WorkerQueue sharedQueue;
+
+  /**
+   * @brief Number of tasks in all the queues.
+   */
+  std::atomic<int64_t> queuedTasks = 0;
 
   /**
-   * @brief Condition variable for notifying worker threads of new tasks or shutdown.
+   * @brief Number of tasks executed, lets join() detect that a task finished while it was waiting.
    */
+  std::atomic<uint64_t> completedTasks = 0;
+
+  /**
+   * @brief Mutex and condition variable for notifying sleeping worker threads of new tasks or
+   * shutdown.
+   */
+  std::mutex queueMutex;
   std::condition_variable condition;
+  std::atomic<int> sleepingWorkers = 0;
+
+  /**
+   * @brief Mutex and condition variable for notifying threads sleeping in join() of new or finished
+   * tasks.
+   */
+  std::mutex joinMutex;
+  std::condition_variable joinCondition;
+  std::atomic<int> sleepingJoiners = 0;
 
   /**
    * @brief Flag indicating whether the thread pool is stopping.
    */
   std::atomic<bool> stop;
 
+  /**
+   * @brief Pool and index of the worker running on this thread, nullptr and -1 outside the pool.
+   */
+  static thread_local ThreadPool* currentPool;
+  static thread_local int currentWorker;
+
+  void push_task(Task&& task);
+
+  /**
+   * @brief Takes a task from the deque of the worker, the shared queue or another worker's deque.
+   *
+   * @param workerIndex Index of the calling worker, -1 for threads outside the pool.
+   */
+  bool pop_task(int workerIndex, Task& task);
+
+  void run_task(Task& task);
+
+  void wait_until(const std::function<bool()>& isDone);
+
+  /**
+   * @brief Wakes threads sleeping in join() if there are any.
+   */
+  void notify_joiners();
+
   /**
    * @brief Function executed by each worker thread to process tasks.
    */
-  void workerThread();
+  void workerThread(int workerIndex, int cpu);
 };
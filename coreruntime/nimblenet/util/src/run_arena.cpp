@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "run_arena.hpp"
+
+#include <algorithm>
+
+thread_local RunArena* RunArena::_current = nullptr;
+
+void* RunArena::allocate(size_t size, size_t alignment) {
+  while (true) {
+    if (_block < _blocks.size()) {
+      auto& block = _blocks[_block];
+      size_t start = (_offset + alignment - 1) & ~(alignment - 1);
+      if (start + size <= block.size) {
+        size_t used = start + size - _offset;
+        _offset = start + size;
+        _inUse += used;
+        _stats.allocations++;
+        _stats.bytes += used;
+        _stats.peakBytes = std::max<int64_t>(_stats.peakBytes, _inUse);
+        return block.data.get() + start;
+      }
+      // Move to the next block, the rest of this one stays unused till the next release
+      if (_block + 1 < _blocks.size() && _blocks[_block + 1].size >= size + alignment) {
+        _block++;
+        _offset = 0;
+        continue;
+      }
+    }
+    // Blocks after the current one are too small, replace them with a block large enough
+    size_t blockSize = std::max(BLOCK_SIZE, size + alignment);
+    if (!_blocks.empty()) {
+      _blocks.resize(_block + 1);
+      _block++;
+    }
+    _blocks.push_back({std::make_unique<char[]>(blockSize), blockSize});
+    _offset = 0;
+    _stats.heapBlocks++;
+  }
+}
+
+void RunArena::release(const Mark& mark) {
+  _block = mark.block;
+  _offset = mark.offset;
+  _inUse = mark.inUse;
+}
+
+void RunArena::reset() {
+  if (_blocks.size() > 1) {
+    // Keep the largest block, so that the next call is served by a single block
+    auto largest = std::max_element(_blocks.begin(), _blocks.end(),
+                                    [](const auto& a, const auto& b) { return a.size < b.size; });
+    Block block = std::move(*largest);
+    _blocks.clear();
+    _blocks.push_back(std::move(block));
+  }
+  _block = 0;
+  _offset = 0;
+  _inUse = 0;
+  _stats = Stats();
+}
+
+RunArenaScope::RunArenaScope() {
+  if (RunArena::_current) {
+    return;
+  }
+  static thread_local RunArena arena;
+  _arena = &arena;
+  RunArena::_current = _arena;
+}
+
+RunArenaScope::~RunArenaScope() {
+  if (!_arena) {
+    return;
+  }
+  _arena->reset();
+  RunArena::_current = nullptr;
+}
@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensor_buffer_pool.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+struct Header {
+  size_t capacity;
+  int sizeClass;
+};
+
+static_assert(sizeof(Header) <= TensorBufferPool::ALIGNMENT, "Header must fit before the data");
+static_assert(TensorBufferPool::MAX_POOLED_SIZE ==
+                  TensorBufferPool::get_class_size(TensorBufferPool::NUM_CLASSES - 1),
+              "Last size class must be MAX_POOLED_SIZE");
+
+Header* get_header(const void* buffer) {
+  return (Header*)((char*)buffer - TensorBufferPool::ALIGNMENT);
+}
+
+int floor_log2(size_t x) { return 63 - __builtin_clzll(x); }
+
+}  // namespace
+
+// Class 0 holds MIN_SIZE bytes, then each power of two 2^(shift + 2) up to 2^(shift + 3) is split
+// into four classes of m * 2^shift bytes for m from 5 to 8
+int TensorBufferPool::get_size_class(size_t size) {
+  if (size <= MIN_SIZE) {
+    return 0;
+  }
+  if (size > MAX_POOLED_SIZE) {
+    return NUM_CLASSES;
+  }
+  int shift = floor_log2(size - 1) - 2;
+  size_t m = (size - 1) >> shift;
+  return 4 * (shift - 4) + m - 3;
+}
+
+TensorBufferPool::~TensorBufferPool() { trim(0); }
+
+void* TensorBufferPool::allocate(size_t size) {
+  int sizeClass = get_size_class(size);
+  size_t capacity;
+  if (sizeClass < NUM_CLASSES) {
+    capacity = get_class_size(sizeClass);
+    auto& pooled = _classes[sizeClass];
+    std::unique_lock<std::mutex> lock(pooled.mutex);
+    if (!pooled.buffers.empty()) {
+      void* buffer = pooled.buffers.back();
+      pooled.buffers.pop_back();
+      lock.unlock();
+      _pooledBytes -= capacity;
+      _liveBytes += capacity;
+      _hits++;
+      return buffer;
+    }
+  } else {
+    capacity = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+
+  void* base = nullptr;
+  if (posix_memalign(&base, ALIGNMENT, ALIGNMENT + capacity) != 0) {
+    throw std::bad_alloc();
+  }
+  void* buffer = (char*)base + ALIGNMENT;
+  *get_header(buffer) = {capacity, sizeClass};
+  _liveBytes += capacity;
+  _misses++;
+  return buffer;
+}
+
+void TensorBufferPool::release(void* buffer) {
+  if (!buffer) {
+    return;
+  }
+  const Header& header = *get_header(buffer);
+  _liveBytes -= header.capacity;
+  if (header.sizeClass < NUM_CLASSES) {
+    int64_t capacity = header.capacity;
+    if (_pooledBytes.fetch_add(capacity) + capacity <= _maxPooledBytes.load()) {
+      auto& pooled = _classes[header.sizeClass];
+      std::lock_guard<std::mutex> lock(pooled.mutex);
+      pooled.buffers.push_back(buffer);
+      return;
+    }
+    _pooledBytes -= capacity;
+  }
+  free(get_header(buffer));
+}
+
+size_t TensorBufferPool::capacity(const void* buffer) { return get_header(buffer)->capacity; }
+
+void TensorBufferPool::trim(size_t maxPooledBytes) {
+  std::vector<void*> freed;
+  for (int sizeClass = NUM_CLASSES - 1; sizeClass >= 0; sizeClass--) {
+    if (_pooledBytes.load() <= (int64_t)maxPooledBytes) {
+      break;
+    }
+    auto& pooled = _classes[sizeClass];
+    const int64_t capacity = get_class_size(sizeClass);
+    {
+      std::lock_guard<std::mutex> lock(pooled.mutex);
+      while (!pooled.buffers.empty() && _pooledBytes.load() > (int64_t)maxPooledBytes) {
+        freed.push_back(pooled.buffers.back());
+        pooled.buffers.pop_back();
+        _pooledBytes -= capacity;
+      }
+    }
+    // Free outside of the lock, so that allocations of this class are not blocked
+    for (void* buffer : freed) {
+      free(get_header(buffer));
+    }
+    freed.clear();
+  }
+}
+
+void TensorBufferPool::set_max_pooled_bytes(size_t maxPooledBytes) {
+  _maxPooledBytes = maxPooledBytes;
+  trim(maxPooledBytes);
+}
+
+TensorBufferPool::Stats TensorBufferPool::stats() const {
+  Stats stats;
+  stats.liveBytes = _liveBytes.load();
+  stats.pooledBytes = _pooledBytes.load();
+  stats.hits = _hits.load();
+  stats.misses = _misses.load();
+  return stats;
+}
+
+TensorBufferPool& TensorBufferPool::instance() {
+  // Never destroyed, as tensors held by static objects may be released during exit
+  static TensorBufferPool* pool = new TensorBufferPool();
+  return *pool;
+}
@@ -6,55 +6,188 @@
 
 #include "thread_pool.hpp"
 
+#ifdef __linux__
+#include <sched.h>
+#endif  // __linux__
+
+#include <cerrno>
+#include <cstring>
+
 #include "client.h"
 #include "logger.hpp"
 
 std::atomic<int> ThreadPool::spinTimeInMs = DEFAULT_THREAD_SPIN_TIME_IN_MS;
+thread_local ThreadPool* ThreadPool::currentPool = nullptr;
+thread_local int ThreadPool::currentWorker = -1;
+
+static void set_thread_affinity(int cpu) {
+#ifdef __linux__
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(cpu, &cpuSet);
+  if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+    LOG_TO_ERROR("Could not pin thread pool worker to cpu %d, error: %s", cpu, strerror(errno));
+  }
+#else   // __linux__
+  LOG_TO_ERROR("Thread pool cpu affinity is not supported on this platform, ignoring cpu %d", cpu);
+#endif  // __linux__
+}
 
 // Constructor: Create worker threads
-ThreadPool::ThreadPool(size_t numThreads) : stop(false) {
+ThreadPool::ThreadPool(size_t numThreads, const std::vector<int>& cpuAffinity) : stop(false) {
+  // Create all the deques first, workers steal from each other as soon as they start
+  for (size_t i = 0; i < numThreads; ++i) {
+    workerQueues.emplace_back(std::make_unique<WorkerQueue>());
+  }
   for (size_t i = 0; i < numThreads; ++i) {
-    workers.emplace_back(&ThreadPool::workerThread, this);
+    int cpu = cpuAffinity.empty() ? -1 : cpuAffinity[i % cpuAffinity.size()];
+    workers.emplace_back(&ThreadPool::workerThread, this, i, cpu);
   }
 }
 
 // Destructor: Join all threads
 ThreadPool::~ThreadPool() {
   stop.store(true);
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+  }
   condition.notify_all();  // Wake up all threads to finish execution
+  notify_joiners();
   for (std::thread& worker : workers) {
     if (worker.joinable()) worker.join();
   }
 }
 
+void ThreadPool::push_task(Task&& task) {
+  if (stop) throw std::runtime_error("ThreadPool is stopped");
+
+  // Tasks enqueued by a worker are its children, keep them on its own deque
+  auto& queue = (currentPool == this) ? *workerQueues[currentWorker] : sharedQueue;
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.emplace_back(std::move(task));
+  }
+  queuedTasks.fetch_add(1);
+
+  if (sleepingWorkers.load() > 0) {
+    // Lock so that the notification cannot be lost between the check and the wait of a worker
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+    }
+    condition.notify_one();
+  }
+  notify_joiners();
+}
+
+bool ThreadPool::pop_task(int workerIndex, Task& task) {
+  if (queuedTasks.load() == 0) return false;
+
+  if (workerIndex >= 0) {
+    auto& own = *workerQueues[workerIndex];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      queuedTasks.fetch_sub(1);
+      return true;
+    }
+  }
+
+  auto takeFront = [&](WorkerQueue& queue) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    queuedTasks.fetch_sub(1);
+    return true;
+  };
+
+  if (takeFront(sharedQueue)) return true;
+  // Start stealing after the own deque, so that thieves spread over the victims
+  int numQueues = workerQueues.size();
+  for (int i = 1; i <= numQueues; i++) {
+    int victim = (workerIndex + i + numQueues) % numQueues;
+    if (victim == workerIndex) continue;
+    if (takeFront(*workerQueues[victim])) return true;
+  }
+  return false;
+}
+
+void ThreadPool::run_task(Task& task) {
+  task();  // Execute task outside lock
+  completedTasks.fetch_add(1);
+  notify_joiners();
+}
+
+void ThreadPool::notify_joiners() {
+  if (sleepingJoiners.load() == 0) return;
+  {
+    std::lock_guard<std::mutex> lock(joinMutex);
+  }
+  joinCondition.notify_all();
+}
+
+void ThreadPool::wait_until(const std::function<bool()>& isDone) {
+  int workerIndex = (currentPool == this) ? currentWorker : -1;
+  while (true) {
+    // Read before checking isDone, a task finishing after the check changes the count
+    uint64_t completed = completedTasks.load();
+    if (isDone()) return;
+
+    Task task;
+    if (pop_task(workerIndex, task)) {
+      run_task(task);
+      continue;
+    }
+
+    // Nothing to help with, sleep till a task finishes or a new one is enqueued
+    std::unique_lock<std::mutex> lock(joinMutex);
+    sleepingJoiners.fetch_add(1);
+    joinCondition.wait(lock, [&]() {
+      return stop || completedTasks.load() != completed || queuedTasks.load() > 0;
+    });
+    sleepingJoiners.fetch_sub(1);
+    if (stop) return;
+  }
+}
+
 // Worker function that processes tasks
-void ThreadPool::workerThread() {
+void ThreadPool::workerThread(int workerIndex, int cpu) {
+  currentPool = this;
+  currentWorker = workerIndex;
+  if (cpu >= 0) {
+    set_thread_affinity(cpu);
+  }
+
   bool attached = false;
   auto spinEndTime = Time::get_high_resolution_clock_time();
   while (true) {
-    std::function<void()> task;
-    {
-      std::unique_lock<std::mutex> lock(queueMutex);
+    if (stop) return;  // Exit thread if stopping
 
-      if (tasks.empty() && (Time::get_high_resolution_clock_time() > spinEndTime)) {
+    Task task;
+    if (!pop_task(workerIndex, task)) {
+      if (Time::get_high_resolution_clock_time() <= spinEndTime) {
+        std::this_thread::yield();
+        continue;
+      }
 #ifdef ANDROID_ABI
-        // detach before sleeping
-        if (attached) {
-          globalJvm->DetachCurrentThread();
-          attached = false;
-        }
+      // detach before sleeping
+      if (attached) {
+        globalJvm->DetachCurrentThread();
+        attached = false;
+      }
 #endif
 
-        // sleep
-        condition.wait(lock, [this] { return stop || !tasks.empty(); });
-        spinEndTime = Time::get_high_resolution_clock_time() +
-                      std::chrono::milliseconds(ThreadPool::spinTimeInMs);
+      // sleep
+      {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        sleepingWorkers.fetch_add(1);
+        condition.wait(lock, [this] { return stop || queuedTasks.load() > 0; });
+        sleepingWorkers.fetch_sub(1);
       }
-
-      if (stop) return;  // Exit thread if stopping and no tasks left
-      if (tasks.empty()) continue;
-      task = std::move(tasks.front());
-      tasks.pop();
+      spinEndTime = Time::get_high_resolution_clock_time() +
+                    std::chrono::milliseconds(ThreadPool::spinTimeInMs);
+      continue;
     }
 #ifdef ANDROID_ABI
     // attach before doing tasks
@@ -63,20 +196,16 @@ void ThreadPool::workerThread() {
       attached = true;
     }
 #endif
-    task();  // Execute task outside lock
+    run_task(task);
     spinEndTime = Time::get_high_resolution_clock_time() +
                   std::chrono::milliseconds(ThreadPool::spinTimeInMs);
   }
 }
 
-void ThreadPool::run_threadpool_task() {
-  std::function<void()> task;
-  {
-    std::unique_lock<std::mutex> lock(queueMutex);
-    if (stop) return;  // Exit thread if stopping and no tasks left
-    if (tasks.empty()) return;
-    task = std::move(tasks.front());
-    tasks.pop();
-  }
-  task();  // Execute task outside lock
+bool ThreadPool::run_threadpool_task() {
+  if (stop) return false;
+  Task task;
+  if (!pop_task((currentPool == this) ? currentWorker : -1, task)) return false;
+  run_task(task);
+  return true;
 }
@@ -73,6 +73,10 @@ const char* get_string_from_enum(int dataType) {
       return "FrontendObj";
     case DATATYPE::EXCEPTION:
       return "Exception";
+    case DATATYPE::NIMBLENET_CACHE:
+      return "Cache";
+    case DATATYPE::BACKGROUND_JOB:
+      return "BackgroundJob";
     default:
       return "UNKNOWN";
   }
@@ -0,0 +1,9 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+def run_model(inputs):
+    return {"output": inputs["model"].run(inputs["x"])}
+
+def count_runs(inputs):
+    return {"count": 1}
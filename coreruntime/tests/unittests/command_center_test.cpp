@@ -9,9 +9,11 @@
 #include <memory>
 
 #include "core_sdk.hpp"
+#include "map_data_variable.hpp"
 #include "native_interface.hpp"
 #include "nimbletest.hpp"
 #include "server_api.hpp"
+#include "tensor_data_variable.hpp"
 #include "util.hpp"
 
 class CommandCenterTest : public ::testing::Test {
@@ -38,3 +40,48 @@ TEST(CommandCenterTest, MultipleInitTest) {
 
   ASSERT_EQ(coreSDK->get_config()->get_modelIds()[0], initConfig->get_modelIds()[0]);
 }
+
+TEST(CommandCenterTest, BorrowedTensorDetachesFromCallerData) {
+  float data[6] = {1, 2, 3, 4, 5, 6};
+  int64_t shape[2] = {2, 3};
+  char name[] = "features";
+  CTensor tensor = {name, data, DATATYPE::FLOAT, shape, 2};
+  MapDataVariable inputs(CTensors{&tensor, 1, 0}, CreateTensorType::BORROW);
+  auto borrowed = std::dynamic_pointer_cast<TensorVariable>(inputs.get_map().at("features"));
+  ASSERT_TRUE(borrowed->is_borrowed());
+  ASSERT_EQ(borrowed->get_raw_ptr(), data);
+
+  borrowed->detach();
+  ASSERT_FALSE(borrowed->is_borrowed());
+  ASSERT_NE(borrowed->get_raw_ptr(), data);
+  data[0] = 100;
+  ASSERT_EQ(((float*)borrowed->get_raw_ptr())[0], 1);
+  ASSERT_EQ(((float*)borrowed->get_raw_ptr())[5], 6);
+
+  // Borrowed tensors escaping to other threads are detached when they are marked shared, also
+  // when the map holding them escapes
+  auto global = std::make_shared<MapDataVariable>();
+  auto threadLocalInputs =
+      std::make_shared<MapDataVariable>(CTensors{&tensor, 1, 0}, CreateTensorType::BORROW);
+  threadLocalInputs->set_thread_local();
+  auto escaping =
+      std::dynamic_pointer_cast<TensorVariable>(threadLocalInputs->get_map().at("features"));
+  ASSERT_TRUE(escaping->is_borrowed());
+  global->set_value_in_map("inputs", threadLocalInputs);
+  ASSERT_FALSE(escaping->is_borrowed());
+  ASSERT_EQ(((float*)escaping->get_raw_ptr())[0], 100);
+
+  MapDataVariable copied(CTensors{&tensor, 1, 0});
+  ASSERT_FALSE(
+      std::dynamic_pointer_cast<TensorVariable>(copied.get_map().at("features"))->is_borrowed());
+
+  // A slice escaping on its own detaches the tensor it reads from
+  MapDataVariable slicedInputs(CTensors{&tensor, 1, 0}, CreateTensorType::BORROW);
+  OpReturnType slicedTensor = slicedInputs.get_map().at("features");
+  auto sliced = std::dynamic_pointer_cast<TensorVariable>(slicedTensor);
+  auto row = slicedTensor->get_int_subscript(1);
+  global->set_value_in_map("row", row);
+  ASSERT_FALSE(sliced->is_borrowed());
+  data[3] = 400;
+  ASSERT_EQ(((float*)row->get_raw_ptr())[0], 4);
+}
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <thread>
+
+#include "map_data_variable.hpp"
+#include "member_func_table.hpp"
+#include "single_variable.hpp"
+#include "tensor_data_variable.hpp"
+#include "value.hpp"
+#include "variable_scope.hpp"
+
+TEST(DataVariableTest, MapIndexFindsEntriesAfterErase) {
+  std::map<std::string, OpReturnType> map;
+  MapIndex index;
+  for (int i = 0; i < 1000; i++) {
+    auto key = std::to_string(i);
+    auto it = map.emplace(key, nullptr).first;
+    index.insert(InternedKey::hash_of(key), &*it);
+  }
+  // Erasing shifts back entries of the same probe sequence, which have to stay reachable
+  for (int i = 0; i < 1000; i += 3) {
+    auto key = std::to_string(i);
+    auto hash = InternedKey::hash_of(key);
+    index.erase(hash, index.find(hash, key));
+    map.erase(key);
+  }
+  for (int i = 0; i < 1000; i++) {
+    auto key = std::to_string(i);
+    auto entry = index.find(InternedKey::hash_of(key), key);
+    if (i % 3 == 0) {
+      ASSERT_EQ(entry, nullptr);
+    } else {
+      ASSERT_NE(entry, nullptr);
+      ASSERT_EQ(entry->first, key);
+    }
+  }
+
+  // Interned keys are unique and match entries inserted with the same key
+  auto interned = InternedKey::intern("1");
+  ASSERT_EQ(interned, InternedKey::intern("1"));
+  ASSERT_EQ(index.find(interned->hash, interned->str, interned)->first, "1");
+}
+
+TEST(DataVariableTest, ThreadLocalMapIsSharedWhenAnotherThreadReachesIt) {
+  auto map = std::make_shared<MapDataVariable>();
+  map->set_thread_local();
+  auto value = std::make_shared<MapDataVariable>();
+  value->set_thread_local();
+  map->set_value_in_map("key", value);
+  auto key = OpReturnType(new SingleVariable<std::string>("key"));
+  // Another thread reaching the map without it being shared falls back to locking, and shares the
+  // values of the map as well
+  bool found = false;
+  std::thread([&] { found = map->in(key); }).join();
+  ASSERT_TRUE(found);
+  std::thread([&] { found = value->in(key); }).join();
+  ASSERT_FALSE(found);
+  // Once shared, the map is accessed under the lock by every thread, including the owner
+  map->set_value_in_map("other", OpReturnType(new NoneVariable()));
+  std::thread([&] { found = map->in(OpReturnType(new SingleVariable<std::string>("other"))); })
+      .join();
+  ASSERT_TRUE(found);
+  map->mark_shared();
+  ASSERT_TRUE(map->in(key));
+}
+
+TEST(DataVariableTest, MemberFuncTableResolvesAllMemberFunctions) {
+  // Every registered member function resolves to its MemberFuncType and back to the same name
+  std::set<int> indices;
+  for (const auto& entry : MemberFuncNames) {
+    std::string name(entry.name);
+    ASSERT_EQ(DataVariable::get_member_func_index(name), entry.index) << name;
+    ASSERT_EQ(DataVariable::add_and_get_member_func_index(name), entry.index) << name;
+    ASSERT_STREQ(DataVariable::get_member_func_string(entry.index), name.c_str());
+    ASSERT_TRUE(indices.insert(entry.index).second) << name;
+  }
+  ASSERT_EQ(indices.size(), MemberFuncType::LASTTYPE);
+  ASSERT_EQ(DataVariable::get_member_func_index("run"), MemberFuncType::RUNMODEL);
+  ASSERT_EQ(DataVariable::get_member_func_index("JsonDocument"), MemberFuncType::JSON_DOCUMENT);
+  ASSERT_EQ(DataVariable::get_member_func_index("parallel_reduce"),
+            MemberFuncType::PARALLEL_REDUCE);
+
+  // Members defined by the script are indexed after the member functions
+  int scriptIndex = DataVariable::add_and_get_member_func_index("member_of_script_class");
+  ASSERT_GE(scriptIndex, MemberFuncType::LASTTYPE);
+  ASSERT_EQ(DataVariable::add_and_get_member_func_index("member_of_script_class"), scriptIndex);
+  ASSERT_EQ(DataVariable::get_member_func_index("member_of_script_class"), scriptIndex);
+  ASSERT_STREQ(DataVariable::get_member_func_string(scriptIndex), "member_of_script_class");
+  ASSERT_EQ(DataVariable::get_member_func_index("not_a_member"), -1);
+  ASSERT_STREQ(DataVariable::get_member_func_string(-1), "");
+}
+
+TEST(DataVariableTest, EmptyValueHasNoTruthiness) {
+  ASSERT_THROW(Value().get_bool(), std::exception);
+  ASSERT_THROW(Value(OpReturnType()).get_bool(), std::exception);
+  ASSERT_FALSE(Value(int32_t(0)).get_bool());
+  ASSERT_TRUE(Value::unbox(OpReturnType(new SingleVariable<double>(0.5))).get_bool());
+}
+
+TEST(DataVariableTest, StringTensorSelectsAlongItsOnlyAxis) {
+  auto tensor = DataVariable::create_tensor(DATATYPE::STRING, {4});
+  auto strings = static_cast<std::string*>(tensor->get_raw_ptr());
+  strings[0] = "b";
+  strings[1] = "a";
+  strings[2] = "c";
+  strings[3] = "a";
+  auto str = [](const std::string& s) { return OpReturnType(new SingleVariable<std::string>(s)); };
+  auto num = [](int32_t i) { return OpReturnType(new SingleVariable<int32_t>(i)); };
+  CallStack stack(nullptr);
+
+  auto values = tensor->call_function(MemberFuncType::TOPK_VALUES, {num(3), str("asc")}, stack);
+  ASSERT_EQ(values->get_dataType_enum(), DATATYPE::STRING);
+  ASSERT_EQ(values->get_shape(), std::vector<int64_t>{3});
+  auto selected = static_cast<std::string*>(values->get_raw_ptr());
+  ASSERT_EQ(selected[0], "a");
+  ASSERT_EQ(selected[1], "a");
+  ASSERT_EQ(selected[2], "b");
+
+  // Equal elements keep their order
+  auto indices = tensor->call_function(MemberFuncType::TOPK, {num(2), str("asc"), num(-1)}, stack);
+  ASSERT_EQ(static_cast<int32_t*>(indices->get_raw_ptr())[0], 1);
+  ASSERT_EQ(static_cast<int32_t*>(indices->get_raw_ptr())[1], 3);
+
+  auto sorted = tensor->call_function(MemberFuncType::ARGSORT, {str("desc"), num(0)}, stack);
+  ASSERT_EQ(static_cast<int32_t*>(sorted->get_raw_ptr())[0], 2);
+  EXPECT_THROW(tensor->call_function(MemberFuncType::ARGSORT, {str("asc"), num(1)}, stack),
+               std::runtime_error);
+  EXPECT_THROW(tensor->call_function(MemberFuncType::TOPK_VALUES, {num(1), str("asc"), num(-2)},
+                                     stack),
+               std::runtime_error);
+}
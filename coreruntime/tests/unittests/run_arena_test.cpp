@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "run_arena.hpp"
+
+TEST(RunArenaTest, ReleasesInReverseOrder) {
+  ASSERT_EQ(RunArena::current(), nullptr);
+  {
+    RunArenaScope scope;
+    auto arena = RunArena::current();
+    ASSERT_NE(arena, nullptr);
+    {
+      ArenaArray<int64_t> outer(4);
+      ASSERT_EQ(outer[3], 0);
+      ASSERT_EQ(reinterpret_cast<uintptr_t>(&outer[0]) % alignof(int64_t), 0);
+      auto mark = arena->mark();
+      {
+        ArenaArray<char> inner(3);
+        // Larger than a block, served by a new block
+        ArenaArray<int> large(RunArena::BLOCK_SIZE);
+        large[RunArena::BLOCK_SIZE - 1] = 1;
+      }
+      // Memory released by the inner arrays is reused
+      ArenaArray<char> reused(3);
+      ASSERT_EQ(arena->mark().offset, mark.offset + 3);
+      {
+        // Nested scopes share the arena of the outermost one
+        RunArenaScope nested;
+        ASSERT_EQ(RunArena::current(), arena);
+      }
+      ASSERT_EQ(RunArena::current(), arena);
+    }
+    auto stats = scope.stats();
+    ASSERT_EQ(stats.allocations, 4);
+    ASSERT_EQ(stats.heapBlocks, 2);
+    ASSERT_GE(stats.peakBytes, 4 * sizeof(int64_t) + RunArena::BLOCK_SIZE * sizeof(int));
+  }
+  ASSERT_EQ(RunArena::current(), nullptr);
+
+  // Without a run_task on the thread arrays are allocated from the heap
+  ArenaArray<int> heapArray(2);
+  ASSERT_EQ(heapArray[1], 0);
+}
@@ -6,12 +6,20 @@
 
 #include <gtest/gtest.h>
 
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
 #ifdef SCRIPTING
 #include "command_center.hpp"
 #include "input_structs.hpp"
+#include "map_data_variable.hpp"
+#include "model_nimble_net_variable.hpp"
 #include "native_interface.hpp"
 #include "nimblejson.hpp"
 #include "nimbletest.hpp"
+#include "script_cache.hpp"
 #include "server_api.hpp"
 #include "task_input_structs.hpp"
 #include "tests_util.hpp"
@@ -347,4 +355,224 @@ TEST_F(ScriptingTest, InvalidModuleImportTest) {
   ASSERT_FALSE(commandCenter->is_ready());
   ASSERT_TRUE(commandCenter->is_task_initializing());
 }
+
+// A module imported for the first time inside a function is loaded on the thread running the
+// function. Its dicts have to be usable from the threads of later runs.
+TEST_F(ScriptingTest, LazilyImportedModuleTest) {
+  std::string taskAST;
+  ASSERT_TRUE(
+      ServerHelpers::get_file_from_assets("basic_script_test/lazy_module_import.ast", taskAST));
+  ASSERT_TRUE(commandCenter->load_task(GLOBALTASKNAME, "1.0.0", std::move(taskAST)));
+
+  const auto run = [&]() {
+    CTensors output;
+    auto status = commandCenter->run_task(GLOBALTASKNAME, "run", CTensors{nullptr, 0, 0}, &output);
+    EXPECT_EQ(status, nullptr);
+    if (status != nullptr) {
+      deallocate_nimblenet_status(status);
+      return int64_t(-1);
+    }
+    EXPECT_EQ(output.numTensors, 1);
+    int64_t count = *static_cast<int32_t*>(output.tensors[0].data);
+    commandCenter->deallocate_output_memory(&output);
+    return count;
+  };
+
+  int64_t firstCount = 0, secondCount = 0;
+  std::thread([&] { firstCount = run(); }).join();
+  std::thread([&] { secondCount = run(); }).join();
+  ASSERT_EQ(firstCount, 1);
+  ASSERT_EQ(secondCount, 2);
+}
+
+// Model which stays inside the inference until another run of the script has finished, or until
+// the timeout expires
+class BlockingModel : public TaskBaseModel {
+  int create_input_tensor_and_set_data_ptr(const int index, void* dataPtr) override {
+    return SUCCESS;
+  }
+
+  int create_input_tensor_and_set_data_ptr(const OpReturnType req, int modelInputIndex,
+                                           Ort::Value&& returnedInputTensor) override {
+    return SUCCESS;
+  }
+
+  int invoke_inference(OpReturnType& ret, const std::vector<Ort::Value>& inputTensors) override {
+    return SUCCESS;
+  }
+
+  int create_output_tensor_and_set_data_ptr(const int index, void* dataPtr) override {
+    return SUCCESS;
+  }
+
+  void load_model_from_buffer() override {}
+
+  int invoke_inference(InferenceReturn* ret) override { return SUCCESS; }
+
+  void run_dummy_inference() override {}
+
+ public:
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool started = false;
+  bool otherRunDone = false;
+  bool overlapped = false;
+  std::chrono::milliseconds timeout;
+
+  BlockingModel(const std::string& modelFile, CommandCenter* commandCenter,
+                std::chrono::milliseconds timeout_)
+      : TaskBaseModel(modelFile, "1.0.0", "blockingModel", nlohmann::json::object(), 1,
+                      commandCenter, false),
+        timeout(timeout_) {}
+
+  int get_inference(const std::string& inferId, const std::vector<OpReturnType>& req,
+                    OpReturnType& ret) override {
+    std::unique_lock<std::mutex> locker(mutex);
+    started = true;
+    cv.notify_all();
+    overlapped = cv.wait_for(locker, timeout, [&] { return otherRunDone; });
+    ret = req[0];
+    return SUCCESS;
+  }
+
+  std::vector<const char*> get_input_names() override { return {"x"}; }
+
+  std::vector<const char*> get_output_names() override { return {"y"}; }
+};
+
+// With concurrentModelRun other functions of the script run while a model runs, without it they
+// wait for the script lock held by the function running the model
+TEST_F(ScriptingTest, ConcurrentModelRunTest) {
+  std::string taskAST;
+  ASSERT_TRUE(
+      ServerHelpers::get_file_from_assets("basic_script_test/concurrent_model_run.ast", taskAST));
+  ASSERT_TRUE(commandCenter->load_task(GLOBALTASKNAME, "1.0.0", std::move(taskAST)));
+  std::ofstream(nativeinterface::HOMEDIR + "blocking_model") << "model";
+
+  const auto operate = [&](const std::string& functionName, const OpReturnType& model) {
+    auto inputs = std::make_shared<MapDataVariable>();
+    inputs->set_value_in_map("model", model);
+    inputs->set_value_in_map("x", OpReturnType(new SingleVariable<int32_t>(7)));
+    auto outputs = std::make_shared<MapDataVariable>();
+    commandCenter->get_task()->operate(functionName, inputs, outputs);
+    return outputs;
+  };
+
+  // Runs count_runs once run_model is inside the model, returns whether it finished before the
+  // model returned
+  const auto overlaps = [&](std::chrono::milliseconds timeout) {
+    auto model = std::make_shared<BlockingModel>("blocking_model", commandCenter, timeout);
+    OpReturnType modelVariable(new ModelNimbleNetVariable(commandCenter, "blockingModel", model));
+    std::shared_ptr<MapDataVariable> modelOutputs;
+    std::thread modelRun([&] { modelOutputs = operate("run_model", modelVariable); });
+    {
+      std::unique_lock<std::mutex> locker(model->mutex);
+      model->cv.wait(locker, [&] { return model->started; });
+    }
+    EXPECT_EQ(operate("count_runs", modelVariable)->get_map().at("count")->get_int32(), 1);
+    {
+      std::lock_guard<std::mutex> locker(model->mutex);
+      model->otherRunDone = true;
+    }
+    model->cv.notify_all();
+    modelRun.join();
+    EXPECT_EQ(modelOutputs->get_map().at("output")->get_int32(), 7);
+    return model->overlapped;
+  };
+
+  commandCenter->get_config()->concurrentModelRun = true;
+  ASSERT_TRUE(overlaps(std::chrono::seconds(30)));
+  commandCenter->get_config()->concurrentModelRun = false;
+  ASSERT_FALSE(overlaps(std::chrono::milliseconds(200)));
+}
+
+TEST_F(ScriptingTest, ScriptAstCacheTest) {
+  auto modules = nlohmann::json::parse(
+      R"({"main": {"body": [{"lineno": 1}, "a", 2.5]}, "helper": {"body": []}})");
+  std::string path =
+      ScriptCache::get_cache_path(nativeinterface::HOMEDIR + "script1.0.0.ast", "script", "1.0.0");
+  ASSERT_EQ(path, nativeinterface::HOMEDIR + "script.1.0.0.astc");
+  // Caches of other versions of the script are kept apart
+  ASSERT_NE(ScriptCache::get_cache_path(nativeinterface::HOMEDIR + "script2.0.0.ast", "script",
+                                        "2.0.0"),
+            path);
+  ASSERT_TRUE(ScriptCache::save(path, "script", "1.0.0", modules));
+
+  auto cache = ScriptCache::load(path, "script", "1.0.0");
+  ASSERT_NE(cache, nullptr);
+  ASSERT_TRUE(cache->has_module("main"));
+  ASSERT_TRUE(cache->has_module("helper"));
+  ASSERT_FALSE(cache->has_module("other"));
+  ASSERT_EQ(cache->get_module("main"), modules.at("main"));
+  ASSERT_EQ(cache->get_module("helper"), modules.at("helper"));
+
+  // Cache written for another version of the script should not be used
+  ASSERT_EQ(ScriptCache::load(path, "script", "2.0.0"), nullptr);
+  // Nor one written for another script sharing the path, script.1 version 0.0 here
+  ASSERT_EQ(ScriptCache::load(path, "script.1", "0.0"), nullptr);
+  ASSERT_EQ(ScriptCache::load(path + ".missing", "script", "1.0.0"), nullptr);
+}
+
+TEST_F(ScriptingTest, StaleScriptAstCacheRemovedTest) {
+  auto modules = nlohmann::json::parse(R"({"main": {"body": []}})");
+  std::string oldPath =
+      ScriptCache::get_cache_path(nativeinterface::HOMEDIR + "script1.0.0.ast", "script", "1.0.0");
+  std::string newPath =
+      ScriptCache::get_cache_path(nativeinterface::HOMEDIR + "script2.0.0.ast", "script", "2.0.0");
+  std::string otherScriptPath =
+      ScriptCache::get_cache_path(nativeinterface::HOMEDIR + "other1.0.0.ast", "other", "1.0.0");
+  std::string dottedScriptPath = ScriptCache::get_cache_path(
+      nativeinterface::HOMEDIR + "script.bar1.0.0.ast", "script.bar", "1.0.0");
+  ASSERT_TRUE(ScriptCache::save(oldPath, "script", "1.0.0", modules));
+  ASSERT_TRUE(ScriptCache::save(otherScriptPath, "other", "1.0.0", modules));
+  ASSERT_TRUE(ScriptCache::save(dottedScriptPath, "script.bar", "1.0.0", modules));
+  // The name of script.2 followed by its version looks like script followed by a version
+  std::string versionedNamePath = ScriptCache::get_cache_path(
+      nativeinterface::HOMEDIR + "script.21.0.ast", "script.2", "1.0");
+  ASSERT_EQ(versionedNamePath, nativeinterface::HOMEDIR + "script.2.1.0.astc");
+  ASSERT_TRUE(ScriptCache::save(versionedNamePath, "script.2", "1.0", modules));
+  ASSERT_TRUE(ScriptCache::save(newPath, "script", "2.0.0", modules));
+
+  ScriptCache::remove_other_versions(newPath, "script");
+  ASSERT_FALSE(std::ifstream(oldPath).good());
+  ASSERT_NE(ScriptCache::load(newPath, "script", "2.0.0"), nullptr);
+  // Caches of other scripts are kept, including ones whose name starts with the script name
+  ASSERT_NE(ScriptCache::load(otherScriptPath, "other", "1.0.0"), nullptr);
+  ASSERT_NE(ScriptCache::load(dottedScriptPath, "script.bar", "1.0.0"), nullptr);
+  ASSERT_NE(ScriptCache::load(versionedNamePath, "script.2", "1.0"), nullptr);
+
+  // Removing the versions of the dotted script keeps the cache of script
+  std::string newDottedScriptPath = ScriptCache::get_cache_path(
+      nativeinterface::HOMEDIR + "script.bar2.0.0.ast", "script.bar", "2.0.0");
+  ASSERT_TRUE(ScriptCache::save(newDottedScriptPath, "script.bar", "2.0.0", modules));
+  ScriptCache::remove_other_versions(newDottedScriptPath, "script.bar");
+  ASSERT_FALSE(std::ifstream(dottedScriptPath).good());
+  ASSERT_NE(ScriptCache::load(newPath, "script", "2.0.0"), nullptr);
+}
+
+TEST_F(ScriptingTest, CorruptedScriptAstCacheTest) {
+  auto modules = nlohmann::json::parse(R"({"main": {"body": []}, "helper": {"body": []}})");
+  std::string path =
+      ScriptCache::get_cache_path(nativeinterface::HOMEDIR + "script.ast", "script", "1.0.0");
+  ASSERT_TRUE(ScriptCache::save(path, "script", "1.0.0", modules));
+
+  // Replace the empty array closing the last encoded module with an invalid CBOR byte
+  std::string content;
+  {
+    std::ifstream in(path, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  ASSERT_EQ(content.back(), '\x80');
+  content.back() = '\xff';
+  std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+
+  auto cache = ScriptCache::load(path, "script", "1.0.0");
+  ASSERT_NE(cache, nullptr);
+  ASSERT_EQ(cache->get_module("helper"), modules.at("helper"));
+  ASSERT_TRUE(cache->get_module("main").is_null());
+  // Corrupted cache is removed, so that the next load of the script writes it again
+  ASSERT_FALSE(std::ifstream(path).good());
+  ASSERT_EQ(ScriptCache::load(path, "script", "1.0.0"), nullptr);
+}
+
 #endif  // SCRIPTING
@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "tensor_buffer_pool.hpp"
+
+TEST(TensorBufferPoolTest, TensorBufferPoolReusesBuffers) {
+  for (size_t size = 1; size <= TensorBufferPool::MAX_POOLED_SIZE; size += size / 3 + 1) {
+    int sizeClass = TensorBufferPool::get_size_class(size);
+    ASSERT_LT(sizeClass, TensorBufferPool::NUM_CLASSES);
+    ASSERT_GE(TensorBufferPool::get_class_size(sizeClass), size);
+    if (sizeClass > 0) {
+      ASSERT_LT(TensorBufferPool::get_class_size(sizeClass - 1), size);
+    }
+  }
+  ASSERT_EQ(TensorBufferPool::get_size_class(TensorBufferPool::MAX_POOLED_SIZE + 1),
+            TensorBufferPool::NUM_CLASSES);
+
+  TensorBufferPool pool;
+  void* buffer = pool.allocate(1000);
+  ASSERT_EQ((uintptr_t)buffer % TensorBufferPool::ALIGNMENT, 0);
+  ASSERT_GE(TensorBufferPool::capacity(buffer), 1000);
+  ASSERT_EQ(pool.stats().liveBytes, TensorBufferPool::capacity(buffer));
+  pool.release(buffer);
+  // Sizes of the same class get the buffer released
+  ASSERT_EQ(pool.allocate(990), buffer);
+  pool.release(buffer);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&pool, t]() {
+      for (int i = 0; i < 1000; i++) {
+        size_t size = 1 + (i * 7919 + t) % 100000;
+        char* data = (char*)pool.allocate(size);
+        data[0] = data[size - 1] = 1;
+        pool.release(data);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto stats = pool.stats();
+  ASSERT_EQ(stats.liveBytes, 0);
+  ASSERT_GT(stats.pooledBytes, 0);
+  ASSERT_GT(stats.hit_rate(), 0.5);
+
+  void* large = pool.allocate(TensorBufferPool::MAX_POOLED_SIZE + 1);
+  pool.release(large);
+  ASSERT_EQ(pool.stats().pooledBytes, stats.pooledBytes);
+  pool.trim();
+  ASSERT_EQ(pool.stats().pooledBytes, 0);
+
+  pool.set_max_pooled_bytes(1000);
+  pool.release(pool.allocate(2000));
+  ASSERT_EQ(pool.stats().pooledBytes, 0);
+}
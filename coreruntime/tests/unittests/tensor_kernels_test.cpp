@@ -0,0 +1,258 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "elementwise_kernels.hpp"
+#include "reduction_kernels.hpp"
+#include "selection_kernels.hpp"
+#include "single_variable.hpp"
+#include "tensor_data_variable.hpp"
+#include "tensor_operators.hpp"
+#include "thread_pool.hpp"
+
+TEST(TensorKernelsTest, ElementwiseKernelsMatchScalarLoops) {
+  // Inner loops of 37 elements leave a remainder after the vectors of every width
+  const std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>> shapes = {
+      {{37}, {37}}, {{37}, {}}, {{}, {37}}, {{3, 1, 37}, {4, 1}}, {{2, 3, 37}, {37}},
+      {{4, 1, 3, 1}, {1, 5, 1, 7}}};
+  const std::vector<ElementwiseOp> ops = {
+      ElementwiseOp::ADD, ElementwiseOp::SUB, ElementwiseOp::MULT, ElementwiseOp::DIV,
+      ElementwiseOp::MIN, ElementwiseOp::MAX, ElementwiseOp::GT,   ElementwiseOp::EQ};
+  const auto supportedLevel = ElementwiseKernels::get_simd_level();
+  for (const auto& [shapeA, shapeB] : shapes) {
+    auto numElements = [](const std::vector<int64_t>& shape) {
+      int64_t n = 1;
+      for (auto dim : shape) n *= dim;
+      return n;
+    };
+    std::vector<float> a(numElements(shapeA)), b(numElements(shapeB));
+    for (int i = 0; i < a.size(); i++) a[i] = (i * 7) % 11 - 5;
+    for (int i = 0; i < b.size(); i++) b[i] = (i * 5) % 7 + 1;
+    const auto outShape = ElementwiseKernels::broadcast_shapes(shapeA, shapeB);
+    const auto n = numElements(outShape);
+    for (auto op : ops) {
+      std::vector<float> expected(n), actual(n);
+      std::unique_ptr<bool[]> expectedBools(new bool[n]), actualBools(new bool[n]);
+      const bool comparison = ElementwiseKernels::is_comparison(op);
+      for (auto level : {SimdLevel::SCALAR, supportedLevel}) {
+        ElementwiseKernels::set_max_simd_level(level);
+        auto& out = level == SimdLevel::SCALAR ? expected : actual;
+        auto& outBools = level == SimdLevel::SCALAR ? expectedBools : actualBools;
+        if (comparison) {
+          ElementwiseKernels::compute(op, a.data(), shapeA, b.data(), shapeB, outBools.get());
+        } else {
+          ElementwiseKernels::compute(op, a.data(), shapeA, b.data(), shapeB, out.data());
+        }
+      }
+      for (int i = 0; i < n; i++) {
+        if (comparison) {
+          ASSERT_EQ(actualBools[i], expectedBools[i]) << (int)op << " at " << i;
+        } else {
+          ASSERT_EQ(actual[i], expected[i]) << (int)op << " at " << i;
+        }
+      }
+    }
+  }
+  ElementwiseKernels::set_max_simd_level(SimdLevel::AVX2);
+
+  // Broadcasting repeats the middle dimension of the first operand
+  std::vector<int32_t> a = {1, 2, 3, 4, 5, 6}, b = {10, 20, 30}, out(18);
+  ElementwiseKernels::compute(ElementwiseOp::ADD, a.data(), {2, 1, 3}, b.data(), {3, 1},
+                              out.data());
+  ASSERT_EQ(ElementwiseKernels::broadcast_shapes({2, 1, 3}, {3, 1}),
+            (std::vector<int64_t>{2, 3, 3}));
+  ASSERT_EQ(out[0], 11);
+  ASSERT_EQ(out[3], 21);
+  ASSERT_EQ(out[17], 36);
+  ASSERT_THROW(ElementwiseKernels::broadcast_shapes({2, 3}, {2}), std::runtime_error);
+  std::vector<int32_t> zeros = {1, 0, 1};
+  ASSERT_THROW(ElementwiseKernels::compute(ElementwiseOp::DIV, a.data(), {2, 3}, zeros.data(), {3},
+                                           out.data()),
+               std::runtime_error);
+}
+
+TEST(TensorKernelsTest, IntegerScalarOutOfInt32RangePromotesTensor) {
+  int32_t data[3] = {1, 2, 3};
+  auto tensor = std::make_shared<TensorVariable>(data, DATATYPE::INT32, 3, CreateTensorType::COPY);
+
+  // Scalars which fit keep the type of the tensor
+  auto small = OpReturnType(new SingleVariable<int64_t>(5));
+  auto sum = TensorOperators::operate(tensor, small, ElementwiseOp::ADD);
+  ASSERT_EQ(sum->get_dataType_enum(), DATATYPE::INT32);
+  ASSERT_EQ(((int32_t*)sum->get_raw_ptr())[2], 8);
+
+  // Scalars which do not fit make the result int64 instead of wrapping around
+  auto large = OpReturnType(new SingleVariable<int64_t>(3000000000LL));
+  sum = TensorOperators::operate(tensor, large, ElementwiseOp::ADD);
+  ASSERT_EQ(sum->get_dataType_enum(), DATATYPE::INT64);
+  ASSERT_EQ(((int64_t*)sum->get_raw_ptr())[0], 3000000001LL);
+  auto difference = TensorOperators::operate(large, tensor, ElementwiseOp::SUB);
+  ASSERT_EQ(difference->get_dataType_enum(), DATATYPE::INT64);
+  ASSERT_EQ(((int64_t*)difference->get_raw_ptr())[2], 2999999997LL);
+}
+
+TEST(TensorKernelsTest, ReductionKernelsReduceAlongAxes) {
+  // Rows of 37 elements leave a remainder after the vectors of every width
+  const std::vector<int64_t> shape = {3, 37, 5};
+  std::vector<float> in(3 * 37 * 5);
+  for (int i = 0; i < in.size(); i++) in[i] = (i * 7) % 11 - 5;
+  const std::vector<std::vector<bool>> axesList = {{true, false, false}, {false, true, false},
+                                                   {false, false, true}, {true, false, true},
+                                                   {true, true, true}};
+  const auto supportedLevel = ElementwiseKernels::get_simd_level();
+  ThreadPool pool(2);
+  for (const auto& axes : axesList) {
+    std::vector<int64_t> strides(3);
+    int64_t numOut = 1;
+    for (int d = 2; d >= 0; d--) {
+      strides[d] = axes[d] ? 0 : numOut;
+      numOut *= axes[d] ? 1 : shape[d];
+    }
+    for (auto op : {ReduceOp::SUM, ReduceOp::MIN, ReduceOp::MAX}) {
+      const float init = op == ReduceOp::SUM ? 0 : (op == ReduceOp::MIN ? 99 : -99);
+      std::vector<float> expected(numOut, init);
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 37; j++) {
+          for (int k = 0; k < 5; k++) {
+            auto& e = expected[i * strides[0] + j * strides[1] + k * strides[2]];
+            const float x = in[(i * 37 + j) * 5 + k];
+            if (op == ReduceOp::SUM) {
+              e += x;
+            } else {
+              e = op == ReduceOp::MIN ? std::min(e, x) : std::max(e, x);
+            }
+          }
+        }
+      }
+      for (auto level : {SimdLevel::SCALAR, supportedLevel}) {
+        ElementwiseKernels::set_max_simd_level(level);
+        for (ThreadPool* threads : {(ThreadPool*)nullptr, &pool}) {
+          std::vector<float> out(numOut);
+          ReductionKernels::reduce(op, in.data(), shape, axes, out.data(), threads);
+          ASSERT_EQ(out, expected) << (int)op;
+        }
+      }
+    }
+  }
+  ElementwiseKernels::set_max_simd_level(SimdLevel::AVX2);
+
+  // Pairwise and compensated sums of 0.1f stay close to the exact sum, unlike a running sum
+  std::vector<float> tenths(1 << 20, 0.1f);
+  float total;
+  ReductionKernels::reduce(ReduceOp::SUM, tenths.data(), {1 << 20}, {true}, &total, &pool);
+  ASSERT_NEAR(total, 0.1 * (1 << 20), 0.1);
+  std::vector<float> columns(64);
+  ReductionKernels::reduce(ReduceOp::SUM, tenths.data(), {1 << 14, 64}, {true, false},
+                           columns.data(), nullptr);
+  ASSERT_NEAR(columns[63], 0.1 * (1 << 14), 1e-3);
+
+  // Empty reductions
+  std::vector<int32_t> empty, sums(4, -1);
+  ReductionKernels::reduce(ReduceOp::SUM, empty.data(), {0, 4}, {true, false}, sums.data(),
+                           nullptr);
+  ASSERT_EQ(sums, std::vector<int32_t>(4, 0));
+  ASSERT_THROW(ReductionKernels::reduce(ReduceOp::MAX, empty.data(), {0, 4}, {true, false},
+                                        sums.data(), nullptr),
+               std::runtime_error);
+}
+
+TEST(TensorKernelsTest, MinAndMaxKeepBooleanAndStringTensors) {
+  bool flags[4] = {true, false, true, true};
+  auto booleans =
+      std::make_shared<TensorVariable>(flags, DATATYPE::BOOLEAN, 4, CreateTensorType::COPY);
+  auto min = TensorOperators::reduce(TensorReduction::MIN, booleans, nullptr, false, nullptr);
+  ASSERT_EQ(min->get_dataType_enum(), DATATYPE::BOOLEAN);
+  ASSERT_FALSE(min->get_bool());
+  auto max = TensorOperators::reduce(TensorReduction::MAX, booleans, nullptr, true, nullptr);
+  ASSERT_EQ(max->get_dataType_enum(), DATATYPE::BOOLEAN);
+  ASSERT_EQ(max->get_shape(), std::vector<int64_t>{1});
+  ASSERT_TRUE(static_cast<bool*>(max->get_raw_ptr())[0]);
+  // Sums of booleans count the true elements
+  auto sum = TensorOperators::reduce(TensorReduction::SUM, booleans, nullptr, false, nullptr);
+  ASSERT_EQ(sum->get_dataType_enum(), DATATYPE::INT32);
+  ASSERT_EQ(sum->get_int32(), 3);
+
+  auto strings = DataVariable::create_tensor(DATATYPE::STRING, {3});
+  static_cast<std::string*>(strings->get_raw_ptr())[0] = "pear";
+  static_cast<std::string*>(strings->get_raw_ptr())[1] = "apple";
+  static_cast<std::string*>(strings->get_raw_ptr())[2] = "plum";
+  ASSERT_EQ(
+      TensorOperators::reduce(TensorReduction::MIN, strings, nullptr, false, nullptr)->get_string(),
+      "apple");
+  ASSERT_EQ(
+      TensorOperators::reduce(TensorReduction::MAX, strings, nullptr, false, nullptr)->get_string(),
+      "plum");
+  auto axis = OpReturnType(new SingleVariable<int32_t>(0));
+  ASSERT_THROW(TensorOperators::reduce(TensorReduction::MAX, strings, axis, false, nullptr),
+               std::runtime_error);
+  ASSERT_THROW(TensorOperators::reduce(TensorReduction::SUM, strings, nullptr, false, nullptr),
+               std::runtime_error);
+}
+
+TEST(TensorKernelsTest, SelectionKernelsMatchStableSort) {
+  // Few distinct values make ties, which keep their order along the axis
+  const std::vector<int64_t> shape = {6, 300};
+  std::vector<float> in(6 * 300);
+  for (int i = 0; i < in.size(); i++) in[i] = (i * 37) % 23;
+  in[5] = NAN;
+  ThreadPool pool(2);
+  for (int axis : {0, 1}) {
+    const int64_t n = shape[axis], numRows = in.size() / n, inner = axis == 0 ? 300 : 1;
+    for (bool descending : {false, true}) {
+      std::vector<int32_t> sorted(in.size());
+      SelectionKernels::argsort(in.data(), shape, axis, descending, sorted.data(), &pool);
+      for (int64_t k : {int64_t(0), int64_t(3), n / 2, n}) {
+        std::vector<int32_t> indices(numRows * k);
+        std::vector<float> values(numRows * k);
+        SelectionKernels::topk(in.data(), shape, axis, k, descending, indices.data(), (float*)nullptr,
+                               nullptr);
+        SelectionKernels::topk(in.data(), shape, axis, k, descending, nullptr, values.data(),
+                               &pool);
+        for (int64_t r = 0; r < numRows; r++) {
+          const int64_t offset = r / inner * n * inner + r % inner;
+          const int64_t outOffset = r / inner * k * inner + r % inner;
+          std::vector<int32_t> expected(n);
+          std::iota(expected.begin(), expected.end(), 0);
+          std::stable_sort(expected.begin(), expected.end(), [&](int32_t a, int32_t b) {
+            const float x = in[offset + a * inner], y = in[offset + b * inner];
+            // NaNs come last in ascending order
+            if (std::isnan(x) || std::isnan(y)) return descending ? std::isnan(x) && !std::isnan(y)
+                                                                  : std::isnan(y) && !std::isnan(x);
+            return descending ? x > y : x < y;
+          });
+          for (int64_t t = 0; t < n; t++) {
+            ASSERT_EQ(sorted[offset + t * inner], expected[t]) << axis << " " << descending;
+          }
+          for (int64_t t = 0; t < k; t++) {
+            ASSERT_EQ(indices[outOffset + t * inner], expected[t]) << axis << " " << k;
+            const float value = in[offset + expected[t] * inner];
+            ASSERT_TRUE(values[outOffset + t * inner] == value ||
+                        (std::isnan(value) && std::isnan(values[outOffset + t * inner])));
+          }
+        }
+      }
+    }
+  }
+
+  // A single long row is selected from chunks in parallel
+  const int64_t n = 3 * SelectionKernels::ParallelMinElements / 2;
+  std::vector<int64_t> scores(n);
+  for (int64_t i = 0; i < n; i++) scores[i] = (i * 7919) % 100003;
+  std::vector<int32_t> serial(20), parallel(20);
+  SelectionKernels::topk(scores.data(), {n}, 0, 20, true, serial.data(), (int64_t*)nullptr,
+                         nullptr);
+  SelectionKernels::topk(scores.data(), {n}, 0, 20, true, parallel.data(), (int64_t*)nullptr,
+                         &pool);
+  ASSERT_EQ(serial, parallel);
+  ASSERT_EQ(scores[serial[0]], 100002);
+}
@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+TEST(ThreadPoolTest, ThreadPoolJoinsNestedTasks) {
+  // Fewer workers than outer tasks, every outer task has to run its children while joining them
+  ThreadPool pool(2);
+  std::atomic<int> sum = 0;
+  std::vector<std::future<void>> outer;
+  for (int i = 0; i < 8; i++) {
+    outer.push_back(pool.enqueue([&pool, &sum]() {
+      std::vector<std::future<int>> inner;
+      for (int j = 0; j < 100; j++) {
+        inner.push_back(pool.enqueue([j]() { return j; }));
+      }
+      for (auto& future : inner) {
+        pool.join(future);
+        sum += future.get();
+      }
+    }));
+  }
+  for (auto& future : outer) {
+    pool.join(future);
+    future.get();
+  }
+  ASSERT_EQ(sum, 8 * 4950);
+  ASSERT_FALSE(pool.run_threadpool_task());
+}
@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "node.hpp"
+#include "tensor_data_variable.hpp"
+#include "variable_scope.hpp"
+
+namespace {
+
+// Global frame of module 0 holds one variable, frames of function 1 hold another
+constexpr int MODULE_INDEX = 0;
+constexpr int GLOBAL_FUNCTION_INDEX = 0;
+constexpr int FUNCTION_INDEX = 1;
+
+OpReturnType borrowed_tensor(float* data) {
+  return std::make_shared<TensorVariable>(data, DATATYPE::FLOAT, 2, CreateTensorType::BORROW);
+}
+
+// Location of a name assigned or loaded in scope, like the script does with a Name node
+StackLocation name_location(VariableScope* scope, const std::string& name, bool store) {
+  json nameJson = {{"_type", "Name"},
+                   {"id", name},
+                   {"ctx", {{"_type", store ? "Store" : "Load"}}},
+                   {"lineno", 1}};
+  return NameNode(scope, nameJson).get_location();
+}
+
+}  // namespace
+
+TEST(CallStackTest, FrameSharedWhilePushedOnCopiedStack) {
+  VariableScope globalScope(nullptr, MODULE_INDEX);
+  auto functionScope = globalScope.add_function_scope();
+  ASSERT_EQ(functionScope->current_function_index(), FUNCTION_INDEX);
+  auto local = functionScope->add_variable("local");
+
+  CallStack stack(nullptr);
+  stack.enter_function_frame(MODULE_INDEX, GLOBAL_FUNCTION_INDEX, 1);
+  CallStack copy(nullptr);
+  copy = stack;
+  // The copy shares the frame index, so the frame it enters is kept in its pushed frames
+  copy.enter_function_frame(MODULE_INDEX, FUNCTION_INDEX, 1);
+  float data[2] = {1, 2};
+  auto before = borrowed_tensor(data);
+  copy.set_variable(local, before);
+  ASSERT_TRUE(std::static_pointer_cast<TensorVariable>(before)->is_borrowed());
+
+  // Sharing reaches the pushed frame and the values it holds, mark_shared() detaches a tensor
+  copy.share_frames();
+  ASSERT_FALSE(std::static_pointer_cast<TensorVariable>(before)->is_borrowed());
+  auto after = borrowed_tensor(data);
+  copy.set_variable(local, after);
+  ASSERT_FALSE(std::static_pointer_cast<TensorVariable>(after)->is_borrowed());
+
+  // The frame stays shared once it moves from the pushed frames into the private index of the copy
+  for (int i = 0; i < 10; i++) {
+    copy.enter_function_frame(MODULE_INDEX, FUNCTION_INDEX, 1);
+  }
+  for (int i = 0; i < 10; i++) {
+    copy.exit_function_frame();
+  }
+  auto materialized = borrowed_tensor(data);
+  copy.set_variable(local, materialized);
+  ASSERT_FALSE(std::static_pointer_cast<TensorVariable>(materialized)->is_borrowed());
+  ASSERT_EQ(copy.get_variable(local), materialized);
+}
+
+TEST(CallStackTest, RecursionPastPushedFramesOnCopiedStack) {
+  VariableScope globalScope(nullptr, MODULE_INDEX);
+  auto global = globalScope.add_variable("global");
+  auto functionScope = globalScope.add_function_scope();
+  auto local = functionScope->add_variable("local");
+
+  CallStack stack(nullptr);
+  stack.enter_function_frame(MODULE_INDEX, GLOBAL_FUNCTION_INDEX, 1);
+  stack.set_value(global, Value(int32_t(-1)));
+  CallStack copy(nullptr);
+  copy = stack;
+
+  // Frames past MAX_PUSHED_FRAMES move the copy to a private index, each level keeps its own value
+  constexpr int depth = 20;
+  for (int i = 0; i < depth; i++) {
+    copy.enter_function_frame(MODULE_INDEX, FUNCTION_INDEX, 1);
+    copy.set_value(local, Value(int32_t(i)));
+  }
+  for (int i = depth - 1; i >= 0; i--) {
+    ASSERT_EQ(copy.get_value(local).get<int32_t>(), i);
+    copy.exit_function_frame();
+  }
+
+  // The global frame is still the one of the original stack, which never saw the function frames
+  copy.set_value(global, Value(int32_t(depth)));
+  ASSERT_EQ(stack.get_value(global).get<int32_t>(), depth);
+  stack.enter_function_frame(MODULE_INDEX, FUNCTION_INDEX, 1);
+  ASSERT_EQ(stack.get_value(local).tag(), Value::Tag::EMPTY);
+}
+
+TEST(CallStackTest, CopiedStackKeepsCapturedFramesAfterOriginalPushesAndPops) {
+  VariableScope globalScope(nullptr, MODULE_INDEX);
+  auto global = globalScope.add_variable("global");
+  auto functionScope = globalScope.add_function_scope();
+  auto local = functionScope->add_variable("local");
+
+  CallStack stack(nullptr);
+  stack.enter_function_frame(MODULE_INDEX, GLOBAL_FUNCTION_INDEX, 1);
+  stack.enter_function_frame(MODULE_INDEX, FUNCTION_INDEX, 1);
+  stack.set_value(local, Value(int32_t(1)));
+  // Captures the frames like a closure defined in the function does
+  CallStack closure(nullptr);
+  closure = stack;
+
+  // The original returns and calls the function again, past MAX_PUSHED_FRAMES
+  stack.exit_function_frame();
+  for (int i = 0; i < 10; i++) {
+    stack.enter_function_frame(MODULE_INDEX, FUNCTION_INDEX, 1);
+    stack.set_value(local, Value(int32_t(100 + i)));
+  }
+  ASSERT_EQ(closure.get_value(local).get<int32_t>(), 1);
+  for (int i = 0; i < 10; i++) {
+    stack.exit_function_frame();
+  }
+  ASSERT_EQ(closure.get_value(local).get<int32_t>(), 1);
+
+  // Writes through either stack reach the frames they share
+  stack.set_value(global, Value(int32_t(2)));
+  ASSERT_EQ(closure.get_value(global).get<int32_t>(), 2);
+  closure.set_value(local, Value(int32_t(3)));
+  closure.set_value(global, Value(int32_t(4)));
+  ASSERT_EQ(stack.get_value(global).get<int32_t>(), 4);
+  stack.enter_function_frame(MODULE_INDEX, FUNCTION_INDEX, 1);
+  ASSERT_EQ(stack.get_value(local).tag(), Value::Tag::EMPTY);
+  ASSERT_EQ(closure.get_value(local).get<int32_t>(), 3);
+}
+
+TEST(VariableScopeTest, BuiltinShadowedByFunctionAndModuleAssignments) {
+  VariableScope globalScope(nullptr, MODULE_INDEX);
+  auto builtin = globalScope.add_builtin("max");
+
+  // A function assigning the name gets a local variable, other functions still see the builtin
+  auto functionScope = globalScope.add_function_scope();
+  auto local = name_location(functionScope, "max", true);
+  ASSERT_NE(local, builtin);
+  ASSERT_EQ(name_location(functionScope->add_scope(), "max", false), local);
+  ASSERT_EQ(name_location(globalScope.add_function_scope(), "max", false), builtin);
+
+  // A module level function rebinds the builtin for the whole module
+  ASSERT_EQ(globalScope.add_or_shadow_builtin("max"), builtin);
+  ASSERT_FALSE(globalScope.is_builtin(builtin));
+  ASSERT_EQ(name_location(globalScope.add_function_scope(), "max", false), builtin);
+}
+
+TEST(VariableScopeTest, FunctionDefinedTwiceFails) {
+  VariableScope globalScope(nullptr, MODULE_INDEX);
+  globalScope.add_builtin("max");
+  globalScope.add_or_shadow_builtin("f");
+  ASSERT_THROW(globalScope.add_or_shadow_builtin("f"), std::runtime_error);
+  // Shadowing a builtin is allowed once, defining the function again fails as well
+  globalScope.add_or_shadow_builtin("max");
+  ASSERT_THROW(globalScope.add_or_shadow_builtin("max"), std::runtime_error);
+}
+
+TEST(VariableScopeTest, BuiltinAssignedInBlockIsNotVisibleAfterIt) {
+  VariableScope globalScope(nullptr, MODULE_INDEX);
+  auto builtin = globalScope.add_builtin("max");
+  auto functionScope = globalScope.add_function_scope();
+
+  // Loads before the block see the builtin
+  ASSERT_EQ(name_location(functionScope, "max", false), builtin);
+
+  // Assigned only inside an if, the variable belongs to the block like any other variable
+  auto ifScope = functionScope->add_scope();
+  auto inBlock = name_location(ifScope, "max", true);
+  ASSERT_NE(inBlock, builtin);
+  ASSERT_EQ(name_location(ifScope, "max", false), inBlock);
+
+  // Loads after the block fail instead of silently returning the builtin
+  ASSERT_THROW(name_location(functionScope, "max", false), std::runtime_error);
+  ASSERT_THROW(name_location(functionScope->add_scope(), "max", false), std::runtime_error);
+  ASSERT_EQ(name_location(globalScope.add_function_scope(), "max", false), builtin);
+
+  // The same holds for blocks at module level, for the rest of the module
+  auto moduleIfScope = globalScope.add_scope();
+  ASSERT_NE(name_location(moduleIfScope, "max", true), builtin);
+  ASSERT_THROW(name_location(&globalScope, "max", false), std::runtime_error);
+  ASSERT_THROW(name_location(globalScope.add_function_scope(), "max", false), std::runtime_error);
+}
@@ -0,0 +1,30 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+from delitepy import nimblenet as nm
+
+counts = {"refresh": 0, "failing": 0}
+features = {"value": 0}
+
+def refresh():
+    counts["refresh"] = counts["refresh"] + 1
+    features["value"] = features["value"] + 10
+
+def failing():
+    counts["failing"] = counts["failing"] + 1
+    raise Exception("failing background job")
+
+refreshJob = nm.schedule_job(refresh, 60, False, None, True)
+failingJob = nm.schedule_job(failing, 0, True)
+
+def get_state(input):
+    return {"refresh": counts["refresh"], "value": features["value"], "failing": counts["failing"]}
+
+def schedule_with_limit(input):
+    nm.schedule_job(refresh, 60, False, input["maxRunSecs"]).cancel()
+    return {}
+
+def cancel_refresh(input):
+    refreshJob.cancel()
+    return {}
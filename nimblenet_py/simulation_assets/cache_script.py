@@ -0,0 +1,83 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+from delitepy import nimblenet as nm
+
+cache = nm.cache(2)
+ttlCache = nm.cache(10, 5)
+counts = {"computed": 0}
+
+def compute(key):
+    counts["computed"] = counts["computed"] + 1
+    return key * 10
+
+def lru_eviction(input):
+    cache.clear()
+    cache.put("a", 1)
+    cache.put("b", 2)
+    a = cache.get("a")
+    cache.put("c", 3)
+    return {"a": a, "b": cache.get("b", -1), "c": cache.get("c"), "size": len(cache),
+            "hasA": "a" in cache, "hasB": "b" in cache}
+
+def memoize(input):
+    memo = nm.cache(100)
+    total = 0
+    for i in range(input["n"]):
+        total = total + memo.get_or_compute(i % 5, compute)
+    stats = memo.stats()
+    return {"total": total, "computed": counts["computed"], "hits": stats["hits"],
+            "misses": stats["misses"], "hitRate": stats["hitRate"], "entries": stats["entries"]}
+
+def structured_keys(input):
+    keyCache = nm.cache(10)
+    keyCache.put(nm.zeros([2], "float"), "zeros2")
+    keyCache.put(nm.zeros([3], "float"), "zeros3")
+    keyCache.put([1, "x"], "list")
+    keyCache.put("text", "string")
+    keyCache.put(1, "one")
+    popped = keyCache.pop("text")
+    return {"zeros2": keyCache.get(nm.zeros([2], "float")),
+            "zeros3": keyCache.get(nm.zeros([3], "float")),
+            "list": keyCache.get([1, "x"]), "missingList": keyCache.get([1, "y"], "none"),
+            "popped": popped, "one": keyCache.get(1.0), "half": keyCache.get(1.5, "none"),
+            "size": len(keyCache)}
+
+def ttl_put(input):
+    ttlCache.put("a", 1)
+    return {}
+
+def ttl_get(input):
+    value = ttlCache.get("a", -1)
+    stats = ttlCache.stats()
+    return {"value": value, "hasA": "a" in ttlCache, "expirations": stats["expirations"],
+            "entries": stats["entries"]}
+
+def ttl_len(input):
+    return {"size": len(ttlCache)}
+
+def byte_limit(input):
+    smallCache = nm.cache(100, None, 400)
+    for i in range(10):
+        smallCache.put(i, nm.zeros([16], "float"))
+    stats = smallCache.stats()
+    return {"entries": stats["entries"], "bytes": stats["bytes"], "evictions": stats["evictions"]}
+
+@concurrent
+def times_ten(key):
+    return key * 10
+
+@concurrent
+def square_cached(x, sharedCache):
+    return sharedCache.get_or_compute(x % 8, times_ten)
+
+def parallel_memoize(input):
+    sharedCache = nm.cache(8)
+    executor = nm.ConcurrentExecutor()
+    results = executor.run_parallel(square_cached, range(input["n"]), sharedCache)
+    total = 0
+    for r in results:
+        total = total + r
+    stats = sharedCache.stats()
+    return {"total": total, "lookups": stats["hits"] + stats["misses"], "entries": stats["entries"]}
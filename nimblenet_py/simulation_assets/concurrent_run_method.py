@@ -0,0 +1,37 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+from delitepy import nimblenet as nm
+from delitepy import nimblenetInternalTesting as nmi
+
+total = 0
+counts = {"calls": 0}
+
+def increment(input):
+    for i in range(input["n"]):
+        total = total + 1
+        counts["calls"] = counts["calls"] + 1
+    return {"total": total}
+
+@concurrent
+def square(input):
+    x = input["x"]
+    return {"square": x * x}
+
+def get_counts(input):
+    return {"total": total, "calls": counts["calls"]}
+
+# Marked concurrent, so it runs without the script lock
+@concurrent
+def slow(input):
+    started = input["started"]
+    started({})
+    start = nmi.get_chrono_time()
+    end = start
+    while end - start < 1e3 * input["ms"]:
+        end = nmi.get_chrono_time()
+    return {"elapsed": end - start}
+
+def quick(input):
+    return {"total": total}
@@ -0,0 +1,199 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Control flow test script
+Exercises the statements and expressions lowered by the script compiler and rewritten by the
+script optimizer, the outputs should be identical whether the script is interpreted, optimized or
+compiled.
+"""
+
+from delitepy import nimblenet as nm
+
+SECONDS_PER_DAY = 24 * 60 * 60
+DEBUG = False
+
+class Counter:
+    def __init__(self, start):
+        self.value = start
+
+    def increment(self, step):
+        self.value = self.value + step
+        return self.value
+
+def fibonacci(n):
+    if n < 2:
+        return n
+    return fibonacci(n - 1) + fibonacci(n - 2)
+
+def make_adder(base):
+    def adder(x):
+        return base + x
+    return adder
+
+def first_negative(values):
+    for v in values:
+        if v < 0:
+            return v
+    return None
+
+def accumulate(values):
+    count = 0
+    total = 0
+    scaled = 0.0
+    mixed = 0
+    for v in values:
+        count = count + 1
+        total = total + v
+        scaled = scaled + v * 0.5 - (v % 3) ** 2
+        if not (v > 2.5) and -v < 0:
+            mixed = mixed - v
+    return [count, total, scaled, mixed, total / count, -7 % 3, 7 % -3]
+
+def combine(a, b):
+    if a < b:
+        return a + b
+    return b - a
+
+def changing_operand_types():
+    # Operator nodes specialize after a few executions with the same operand types and have to fall
+    # back once the types change
+    results = []
+    for i in range(12):
+        results.append(combine(i, 5))
+    results.append(combine(2.5, 4.0))
+    results.append(combine(7, 2.5))
+    results.append(combine("ab", "cd"))
+    return results
+
+def local_max(values):
+    # Assigning a builtin name inside a function creates a local variable
+    max = values[0]
+    for v in values:
+        if v > max:
+            max = v
+    return max
+
+def reductions():
+    # Reductions consume comprehension arguments element by element
+    xs = [3, -1, 4, -1, 5, -9, 2, 6]
+    weights = [0.5, 1.0, 0.25, 1.0, 0.2, 0.1, 0.5, 1.0]
+    largest = local_max(xs)
+    return [
+        sum([xs[i] * weights[i] for i in range(len(xs))]),
+        sum(x for x in xs if x > 0),
+        min([x * 2 for x in xs]),
+        max(x for x in xs if x < 0),
+        len([x for x in xs if x > 2]),
+        any(x > 5 for x in xs),
+        all([x > -10 for x in xs]),
+        all(x > 0 for x in xs),
+        sum([x for x in xs if x > 100]),
+        sum([x * y for x in range(3) for y in range(3)]),
+        max(3, 7, 5),
+        min(2.5, 1),
+        sum(weights),
+        largest,
+        # Dict comprehensions are built before the call
+        len({k: k for k in ["a", "b", "c"]}),
+    ]
+
+def run_control_flow(input):
+    total = 0
+    evens = []
+    for i in range(20):
+        if i == 15:
+            break
+        if i % 2 == 1:
+            continue
+        evens.append(i)
+        total = total + i
+
+    countdown = 10
+    steps = 0
+    while countdown > 0:
+        countdown = countdown - 3
+        steps = steps + 1
+        if steps > 100:
+            break
+
+    pairs = [(1, "a"), (2, "b"), (3, "c")]
+    keys = []
+    weighted = 0.0
+    for idx, name in pairs:
+        keys.append(name)
+        weighted = weighted + idx * 1.5
+
+    caught = 0
+    for i in range(5):
+        try:
+            if i == 3:
+                raise Exception("three")
+            if i == 4:
+                break
+        except Exception as e:
+            caught = caught + 1
+            continue
+
+    chained = 1 < 2 < 3 and not (3 < 2 < 1)
+    either = (0 and 5) or (2 > 1)
+
+    d = {"x": 1, "y": [1, 2, 3]}
+    d["z"] = d["x"] + 10
+    d["y"][1] = 20
+
+    counter = Counter(5)
+    for i in range(3):
+        counter.increment(i)
+
+    add5 = make_adder(5)
+    fallback = [x * x for x in range(4)]
+
+    window = SECONDS_PER_DAY * 2 - 1
+    checks = 0
+    if DEBUG:
+        checks = 100
+    else:
+        checks = len(evens)
+    assert not DEBUG, "debug enabled"
+
+    return {
+        "total": total,
+        "evens": evens,
+        "steps": steps,
+        "countdown": countdown,
+        "keys": keys,
+        "weighted": weighted,
+        "caught": caught,
+        "chained": chained,
+        "either": either,
+        "dict": d,
+        "counter": counter.value,
+        "fib": fibonacci(12),
+        "adder": add5(10),
+        "negative": first_negative([3, 2, -4, 1]),
+        "fallback": fallback,
+        "minusOne": -1 * total,
+        "accumulate": accumulate([1, 2, 3, 4, 5]),
+        "window": window,
+        "checks": checks,
+        "changingTypes": changing_operand_types(),
+        "reductions": reductions(),
+        "squares": {str(i): i * i for i in range(4) if i > 0},
+    }
+
+def fail_in_nested_loop(input):
+    for i in range(3):
+        for j in range(3):
+            if i * j == 2:
+                x = nm.unknown_member()
+    return {}
+
+def invalid_reductions(input):
+    kind = input["kind"]
+    if kind == "min":
+        return {"result": min([[1, 2], [0, 3]])}
+    if kind == "max":
+        return {"result": max([None, 1])}
+    return {"result": sum([None, None])}
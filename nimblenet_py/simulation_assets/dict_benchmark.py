@@ -0,0 +1,28 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Dict throughput benchmark script
+Builds dicts with new string keys and reads them back, the shape of the per event feature dicts
+built by scripts. Returns the number of dict operations so that the caller can report operations
+per second.
+"""
+
+from delitepy import nimblenet as nm
+
+def run_dict_benchmark(input):
+    iterations = input["iterations"]
+    size = input["size"]
+    keys = [str(i) for i in range(size)]
+    total = 0
+    for it in range(iterations):
+        d = {}
+        for k in keys:
+            d[k] = it
+        for k in keys:
+            total = total + d[k]
+        # Constant keys are interned when the script is parsed
+        d["count"] = size
+        total = total + d["count"]
+    return {"total": total, "operations": iterations * (2 * size + 2)}
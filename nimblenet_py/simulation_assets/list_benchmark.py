@@ -0,0 +1,30 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+List throughput benchmark script
+Appends numbers to lists and reads them back by iteration and by index, the shape of the per event
+feature lists built by scripts. Returns the number of element reads and writes so that the caller
+can report operations per second.
+"""
+
+from delitepy import nimblenet as nm
+
+def run_list_benchmark(input):
+    iterations = input["iterations"]
+    size = input["size"]
+    total = 0
+    for it in range(iterations):
+        ids = []
+        scores = []
+        for i in range(size):
+            ids.append(i + it)
+            scores.append(i * 0.5)
+        for id in ids:
+            total = total + id
+        i = 0
+        while i < size:
+            total = total + scores[i] * 2
+            i = i + 1
+    return {"total": total, "operations": iterations * size * 4}
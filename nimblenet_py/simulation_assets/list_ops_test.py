@@ -7,6 +7,8 @@ List Operations Test Script
 This script tests all the list operations implemented in the nimbleSDK C++ runtime
 """
 
+from delitepy import nimblenet as nm
+
 def test_basic_lists(input):
     """Test basic list creation operations"""
     # Empty list
@@ -339,4 +341,42 @@ def test_concatenation_edge_cases(input):
     except:
         assert True, "Expected TypeError for int + list"
     
-    return {}
\ No newline at end of file
+    return {}
+
+def test_appended_lists(input):
+    """Test lists built element by element, including a heterogeneous append"""
+    scores = []
+    ids = []
+    names = []
+    for i in range(6):
+        scores.append(i * 0.5)
+        ids.append(i * 10)
+        names.append("item" + str(i))
+
+    scores[1] = 7.5
+    removed = ids.pop(0)
+    assert removed == 0, "pop should return the first id"
+    assert 20 in ids, "20 should be in ids"
+    assert not (20.0 in ids), "in only matches elements of the same type"
+    assert not (0 in ids), "0 was popped from ids"
+    assert "item3" in names, "item3 should be in names"
+
+    mixed = [1, 2]
+    mixed.append("three")
+    mixed.append(4.0)
+    assert len(mixed) == 4, "mixed list should have 4 elements"
+    assert mixed[2] == "three", "mixed list should keep the string"
+
+    rows = [[1, 2, 3], [4, 5, 6]]
+    rows[1].append(7)
+    rows[0].append(7.5)
+
+    return {
+        "scores": nm.tensor(scores, "float"),
+        "scoreSlice": scores[::2],
+        "ids": nm.tensor(ids, "int64"),
+        "idsAsDouble": nm.tensor(ids, "double"),
+        "names": nm.tensor(names, "string"),
+        "mixed": mixed,
+        "rows": nm.tensor(rows, "double")
+    }
@@ -0,0 +1,83 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Member call test script
+Calls methods of script classes from the same call sites with receivers of different classes,
+functions shadowing methods and methods replaced on the class, results should not depend on the
+inline caches of the call sites.
+"""
+
+from delitepy import nimblenet as nm
+from delitepy import nimblenetInternalTesting as nmi
+
+class Square:
+    def __init__(self, side):
+        self.side = side
+
+    def area(self):
+        return self.side * self.side
+
+    def scale(self, factor):
+        return Square(self.side * factor)
+
+class Rectangle:
+    def __init__(self, width, height):
+        self.width = width
+        self.height = height
+
+    def area(self):
+        return self.width * self.height
+
+    def scale(self, factor):
+        return Rectangle(self.width * factor, self.height * factor)
+
+class Registry:
+    def name():
+        return "registry"
+
+def triple(x):
+    return 3 * x
+
+def double(self):
+    return 2 * self.side
+
+def total_area(shapes):
+    total = 0
+    for shape in shapes:
+        total = total + shape.scale(2).area()
+    return total
+
+def run_member_calls(input):
+    before = nmi.get_inline_cache_stats()
+    shapes = [Square(1), Rectangle(2, 3), Square(4), Rectangle(1, 1)]
+    areas = []
+    for i in range(10):
+        areas.append(total_area(shapes))
+
+    shadowed = Square(5)
+    shadowed.area = triple
+    shadowedArea = shadowed.area(7)
+
+    replacedBefore = Square(3).area()
+    Square.area = double
+    replacedAfter = Square(3).area()
+
+    missing = "none"
+    try:
+        Square(1).perimeter()
+    except Exception as e:
+        missing = str(e)
+
+    after = nmi.get_inline_cache_stats()
+    return {
+        "areas": areas,
+        "shadowedArea": shadowedArea,
+        "replacedBefore": replacedBefore,
+        "replacedAfter": replacedAfter,
+        "static": Registry.name(),
+        "missing": missing,
+        "hits": after["hits"] - before["hits"],
+        "misses": after["misses"] - before["misses"],
+    }
@@ -70,3 +70,22 @@ def throw_exception_in_parallel(input):
     globalTensor = nm.zeros([n],"int64")
     executor.run_parallel(func_with_throw,range(n),globalTensor)
     return {}
+
+@concurrent
+def square_plus(index, offset):
+    return index**2 + offset
+
+@concurrent
+def add(a, b):
+    return a + b
+
+def test_chunked(inp):
+    n = inp["n"]
+    squares = executor.map_chunked(square_plus, range(n), None, 1)
+    smallChunks = executor.map_chunked(square_plus, range(n), 3, 0)
+    return {
+            "squares": nm.tensor(squares, "int64"),
+            "smallChunks": nm.tensor(smallChunks, "int64"),
+            "sum": executor.parallel_reduce(square_plus, add, range(n), None, 0),
+            "sumOneChunk": executor.parallel_reduce(square_plus, add, range(n), n, 1),
+    }
@@ -0,0 +1,16 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+from delitepy import nimblenet as nm
+
+
+def square(x):
+    return x * x
+
+
+def sum_of_squares(input):
+    total = 0
+    for i in range(input["n"]):
+        total = total + square(i)
+    return {"total": total}
@@ -0,0 +1,35 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Statement throughput benchmark script
+Tight loops of simple statements with break, continue and return, the shape of the per event loops
+in feature scripts. Returns the number of statements executed so that the caller can report
+statements per second.
+"""
+
+from delitepy import nimblenet as nm
+
+def inner(values, limit):
+    total = 0
+    for v in values:
+        if v > limit:
+            break
+        if v % 2 == 0:
+            continue
+        total = total + v
+    return total
+
+def run_statement_benchmark(input):
+    iterations = input["iterations"]
+    values = [i for i in range(20)]
+    total = 0
+    i = 0
+    while i < iterations:
+        i = i + 1
+        total = total + inner(values, 15)
+    # inner() executes 3 statements per value up to the limit (two ifs, then continue or the
+    # assignment), 2 for the value that breaks and 3 outside the loop, the while body executes 2
+    statementsPerIteration = 16 * 3 + 2 + 3 + 2
+    return {"total": total, "statements": iterations * statementsPerIteration}
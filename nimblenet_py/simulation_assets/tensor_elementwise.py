@@ -0,0 +1,24 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+from delitepy import nimblenet as nm
+
+def normalize_features(input):
+    features = input["features"]
+    normalized = (features - input["mean"]) / input["std"]
+    clipped = nm.maximum(nm.minimum(normalized, 3.0), -3.0)
+    return {"normalized": normalized, "clipped": clipped}
+
+def combine_scores(input):
+    combined = input["scores"] * 0.7 + input["priors"] * 0.3
+    counts = input["counts"]
+    return {"combined": combined, "selected": combined >= 0.5, "boosted": counts * 2 + 1,
+            "ratio": counts / 4.0, "weighted": counts * input["priors"],
+            "outer": nm.maximum(input["column"], input["row"]), "equal": counts == input["counts"]}
+
+def mismatched_shapes(input):
+    return {"sum": input["scores"] + input["mean"]}
+
+def min_of_two_tensors(input):
+    return {"min": nm.min(input["scores"], input["priors"])}
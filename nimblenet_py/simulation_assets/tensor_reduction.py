@@ -0,0 +1,14 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+from delitepy import nimblenet as nm
+
+def reduce_scores(input):
+    scores = input["scores"]
+    return {"row_sum": nm.sum(scores, 1), "row_mean": nm.mean(scores, -1),
+            "column_max": nm.max(scores, 0, True), "column_min": nm.min(scores, [0]),
+            "total": nm.sum(scores), "counts_sum": nm.sum(input["counts"], (0, 1))}
+
+def repeated_axis(input):
+    return {"sum": nm.sum(input["scores"], [1, -1])}
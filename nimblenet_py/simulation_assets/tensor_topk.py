@@ -0,0 +1,18 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+from delitepy import nimblenet as nm
+
+def select_scores(input):
+    scores = input["scores"]
+    return {"row_top": scores.topk(3, "desc"), "column_bottom": scores.topk(2, "asc", 0),
+            "row_top_values": scores.topk_values(3, "desc", -1),
+            "row_order": scores.argsort("asc", 1), "column_order": scores.argsort("desc", 0)}
+
+def top_candidates(input):
+    candidates = input["candidates"]
+    return {"indices": candidates.topk(20, "desc"), "values": candidates.topk_values(20, "desc")}
+
+def invalid_axis(input):
+    return {"indices": input["scores"].topk(1, "asc", 2)}
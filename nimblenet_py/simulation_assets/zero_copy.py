@@ -0,0 +1,9 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+from delitepy import nimblenet as nm
+
+def score_features(input):
+    features = input["features"]
+    return {"row_sum": nm.sum(features, 1), "features": features, "count": input["count"]}
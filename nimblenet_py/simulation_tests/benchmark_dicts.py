@@ -0,0 +1,61 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Micro-benchmark of dict operations in the script interpreter.
+
+Runs simulation_assets/dict_benchmark.py, which fills new dicts and reads them back, and reports the
+dict operations per second for small and large dicts, for the tree walking interpreter and for
+compiled functions. Run it on two builds to compare them:
+
+    python3 benchmark_dicts.py [iterations]
+"""
+
+from deliteai import simulator
+import sys
+import time
+
+MODULES = [
+    {
+        "name": "workflow_script",
+        "version": "1.0.0",
+        "type": "script",
+        "location": {
+            "path": "../simulation_assets/dict_benchmark.py"
+        }
+    }
+]
+
+CONFIGS = {
+    "interpreted": '''{"online": false}''',
+    "compiled": '''{"online": false, "compileScript": true}''',
+}
+
+SIZES = [8, 256]
+
+
+def measure(config, size, iterations, repeats=5):
+    assert simulator.initialize(config, MODULES)
+    # Warm up allocators and caches before measuring
+    simulator.run_method("run_dict_benchmark", {"iterations": 10, "size": size})
+    best = float("inf")
+    for _ in range(repeats):
+        start = time.perf_counter()
+        output = simulator.run_method("run_dict_benchmark", {"iterations": iterations, "size": size})
+        best = min(best, time.perf_counter() - start)
+    assert output["total"] == size * (iterations * (iterations - 1) // 2 + iterations)
+    return output["operations"] / best
+
+
+def main():
+    iterations = int(sys.argv[1]) if len(sys.argv) > 1 else 2000
+    for name, config in CONFIGS.items():
+        for size in SIZES:
+            # Keep the number of operations the same for every size
+            sizeIterations = max(1, iterations * SIZES[0] // size)
+            print(f"{name}, {size} keys: {measure(config, size, sizeIterations):,.0f} operations/s")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,60 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Micro-benchmark of list operations in the script interpreter.
+
+Runs simulation_assets/list_benchmark.py, which appends numbers to lists and reads them back by
+iteration and by index, and reports the list operations per second, for the tree walking
+interpreter and for compiled functions. Run it on two builds to compare them:
+
+    python3 benchmark_lists.py [iterations]
+"""
+
+from deliteai import simulator
+import sys
+import time
+
+MODULES = [
+    {
+        "name": "workflow_script",
+        "version": "1.0.0",
+        "type": "script",
+        "location": {
+            "path": "../simulation_assets/list_benchmark.py"
+        }
+    }
+]
+
+CONFIGS = {
+    "interpreted": '''{"online": false}''',
+    "compiled": '''{"online": false, "compileScript": true}''',
+}
+
+SIZE = 64
+
+
+def measure(config, iterations, repeats=5):
+    assert simulator.initialize(config, MODULES)
+    # Warm up allocators and caches before measuring
+    simulator.run_method("run_list_benchmark", {"iterations": 10, "size": SIZE})
+    best = float("inf")
+    for _ in range(repeats):
+        start = time.perf_counter()
+        output = simulator.run_method("run_list_benchmark", {"iterations": iterations, "size": SIZE})
+        best = min(best, time.perf_counter() - start)
+    # ids sum to SIZE * (SIZE - 1) / 2 + SIZE * it, twice the scores to SIZE * (SIZE - 1) / 2
+    expected = iterations * SIZE * (SIZE - 1) + SIZE * iterations * (iterations - 1) // 2
+    assert output["total"] == expected
+    return output["operations"] / best
+
+
+def main():
+    iterations = int(sys.argv[1]) if len(sys.argv) > 1 else 500
+    for name, config in CONFIGS.items():
+        print(f"{name}: {measure(config, iterations):,.0f} operations/s")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,55 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Micro-benchmark of statement execution in the script interpreter.
+
+Runs simulation_assets/statement_benchmark.py and reports the statements executed per second, for
+the tree walking interpreter and for compiled functions. Run it on two builds to compare them:
+
+    python3 benchmark_statements.py [iterations]
+"""
+
+from deliteai import simulator
+import sys
+import time
+
+MODULES = [
+    {
+        "name": "workflow_script",
+        "version": "1.0.0",
+        "type": "script",
+        "location": {
+            "path": "../simulation_assets/statement_benchmark.py"
+        }
+    }
+]
+
+CONFIGS = {
+    "interpreted": '''{"online": false}''',
+    "compiled": '''{"online": false, "compileScript": true}''',
+}
+
+
+def measure(config, iterations, repeats=5):
+    assert simulator.initialize(config, MODULES)
+    # Warm up allocators and caches before measuring
+    simulator.run_method("run_statement_benchmark", {"iterations": 10})
+    best = float("inf")
+    for _ in range(repeats):
+        start = time.perf_counter()
+        output = simulator.run_method("run_statement_benchmark", {"iterations": iterations})
+        best = min(best, time.perf_counter() - start)
+    assert output["total"] == 64 * iterations
+    return output["statements"] / best
+
+
+def main():
+    iterations = int(sys.argv[1]) if len(sys.argv) > 1 else 20000
+    for name, config in CONFIGS.items():
+        print(f"{name}: {measure(config, iterations):,.0f} statements/s")
+
+
+if __name__ == "__main__":
+    main()
@@ -410,6 +410,12 @@ def test_multi_threading():
         assert len(output["map"]) == n
         for k in range(n):
             assert str(k) in output["map"]
+
+        output = simulator.run_method("test_chunked", {"n": n})
+        assert np.all(output["squares"] == squareTensor + 1)
+        assert np.all(output["smallChunks"] == squareTensor)
+        assert output["sum"] == np.sum(squareTensor)
+        assert output["sumOneChunk"] == np.sum(squareTensor) + n
         # sleeping for 50ms between each call so that spinning threads sleep
 
         time.sleep(0.050)
@@ -447,6 +453,248 @@ def test_multi_threading_with_limited_threads():
     test(10)
 
 
+@pytest.mark.skipif("MINIMAL_BUILD" in build_flags, reason = "MultiThreading not supported in minimal build")
+def test_concurrent_run_method():
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/concurrent_run_method.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+
+    from concurrent.futures import ThreadPoolExecutor
+
+    numThreads = 8
+    numCalls = 10
+    n = 100
+
+    # Methods are invoked from several threads at once, updates of module variables must not be lost
+    def invoke(threadIndex):
+        for i in range(numCalls):
+            simulator.run_method("increment", {"n": n})
+            x = threadIndex * numCalls + i
+            assert simulator.run_method("square", {"x": x})["square"] == x * x
+
+    with ThreadPoolExecutor(max_workers=numThreads) as pool:
+        for result in [pool.submit(invoke, i) for i in range(numThreads)]:
+            result.result()
+
+    output = simulator.run_method("get_counts", {})
+    assert output["total"] == numThreads * numCalls * n
+    assert output["calls"] == numThreads * numCalls * n
+
+
+@pytest.mark.skipif("MINIMAL_BUILD" in build_flags, reason = "MultiThreading not supported in minimal build")
+def test_slow_method_does_not_block_quick_one():
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/concurrent_run_method.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+
+    import threading
+    from concurrent.futures import ThreadPoolExecutor
+
+    started = threading.Event()
+
+    def on_started(input):
+        started.set()
+        return {}
+
+    ms = 2000
+    with ThreadPoolExecutor(max_workers=1) as pool:
+        slowResult = pool.submit(simulator.run_method, "slow", {"ms": ms, "started": on_started})
+        assert started.wait(timeout=10)
+        # The quick method takes the script lock, which the concurrent slow one does not hold
+        assert simulator.run_method("quick", {})["total"] == 0
+        assert not slowResult.done()
+        assert slowResult.result()["elapsed"] >= ms * 1e3
+
+
+def test_script_profile():
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/profiled_script.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false, "profileScript": true}''', modules)
+    n = 1000
+    assert simulator.run_method("sum_of_squares", {"n": n})["total"] == sum(i * i for i in range(n))
+
+    profile = json.loads(simulator.get_script_profile("json"))
+    functions = profile["functions"]
+    lines = profile["lines"]
+    assert functions["sum_of_squares"]["calls"] == 1
+    assert functions["square"]["calls"] == n
+    assert lines["sum_of_squares:14"]["calls"] == 1
+    assert lines["sum_of_squares:15"]["calls"] == n
+    assert lines["square:9"]["calls"] == n
+    for stats in list(functions.values()) + list(lines.values()):
+        assert stats["inclusiveUs"] >= stats["exclusiveUs"]
+    assert functions["sum_of_squares"]["inclusiveUs"] >= functions["square"]["inclusiveUs"]
+
+    collapsed = simulator.get_script_profile("collapsed").splitlines()
+    for line in collapsed:
+        stack, micros = line.rsplit(" ", 1)
+        assert int(micros) > 0
+    assert any(line.startswith("sum_of_squares;sum_of_squares:14;sum_of_squares:15;square")
+               for line in collapsed)
+
+    with pytest.raises(RuntimeError):
+        simulator.get_script_profile("svg")
+
+    # Profiling is off by default
+    assert simulator.initialize('''{"online": false}''', modules)
+    simulator.run_method("sum_of_squares", {"n": n})
+    assert json.loads(simulator.get_script_profile("json")) == {"functions": {}, "lines": {}}
+
+def test_cache():
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/cache_script.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+
+    output = simulator.run_method("lru_eviction", {})
+    assert output["a"] == 1
+    assert output["b"] == -1
+    assert output["c"] == 3
+    assert output["size"] == 2
+    assert output["hasA"] and not output["hasB"]
+
+    n = 20
+    output = simulator.run_method("memoize", {"n": n})
+    assert output["total"] == sum((i % 5) * 10 for i in range(n))
+    assert output["computed"] == 5
+    assert output["misses"] == 5
+    assert output["hits"] == n - 5
+    assert output["hitRate"] == pytest.approx((n - 5) / n)
+    assert output["entries"] == 5
+
+    output = simulator.run_method("structured_keys", {})
+    assert output["zeros2"] == "zeros2"
+    assert output["zeros3"] == "zeros3"
+    assert output["list"] == "list"
+    assert output["missingList"] == "none"
+    assert output["popped"] == "string"
+    assert output["one"] == "one"
+    assert output["half"] == "none"
+    assert output["size"] == 4
+
+    output = simulator.run_method("byte_limit", {})
+    assert output["entries"] == 2
+    assert output["bytes"] <= 400
+    assert output["evictions"] == 8
+
+    # Entries expire by the simulated time, 5 seconds after they were stored
+    simulator.run_method("ttl_put", {}, 100)
+    output = simulator.run_method("ttl_get", {}, 104)
+    assert output["value"] == 1
+    assert output["hasA"]
+    assert output["expirations"] == 0
+
+    output = simulator.run_method("ttl_get", {}, 105)
+    assert output["value"] == -1
+    assert not output["hasA"]
+    assert output["expirations"] == 1
+    assert output["entries"] == 0
+
+    # len() drops expired entries like get(), before any lookup
+    simulator.run_method("ttl_put", {}, 200)
+    assert simulator.run_method("ttl_len", {}, 204)["size"] == 1
+    assert simulator.run_method("ttl_len", {}, 205)["size"] == 0
+
+
+@pytest.mark.skipif("MINIMAL_BUILD" in build_flags, reason = "MultiThreading not supported in minimal build")
+def test_cache_run_parallel():
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/cache_script.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+
+    n = 64
+    output = simulator.run_method("parallel_memoize", {"n": n})
+    assert output["total"] == sum((i % 8) * 10 for i in range(n))
+    assert output["lookups"] == n
+    assert output["entries"] == 8
+
+def test_background_jobs():
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/background_job.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+
+    # The jobs run when the script is loaded or on the first timestamp, then when they are due by
+    # the simulated time
+    output = simulator.run_method("get_state", {}, 10)
+    assert output["refresh"] == 1
+    assert output["value"] == 10
+    failingRuns = output["failing"]
+    assert failingRuns >= 1
+
+    for timestamp, refreshRuns in [(200, 2), (230, 2), (300, 3)]:
+        output = simulator.run_method("get_state", {}, timestamp)
+        assert output["refresh"] == refreshRuns
+        assert output["value"] == 10 * refreshRuns
+        # Errors of a job are logged and do not stop it
+        failingRuns += 1
+        assert output["failing"] == failingRuns
+
+    # Without a timestamp the jobs are not run
+    assert simulator.run_method("get_state", {})["failing"] == failingRuns
+
+    simulator.run_method("cancel_refresh", {}, 310)
+    output = simulator.run_method("get_state", {}, 1000)
+    assert output["refresh"] == 3
+    assert output["failing"] == failingRuns + 2
+
+    # 0 disables the limit on the duration of runs, negative limits are rejected
+    simulator.run_method("schedule_with_limit", {"maxRunSecs": 0})
+    with pytest.raises(RuntimeError, match="non negative max_run_secs"):
+        simulator.run_method("schedule_with_limit", {"maxRunSecs": -1})
+
 def test_try_catch():
     modules = [
         {
@@ -589,6 +837,19 @@ def test_list_operations():
     # Test concatenation edge cases - assertions are in the test functions
     simulator.run_method("test_concatenation_edge_cases", {})
 
+    # Test lists built by appending elements, converted to tensors
+    appended = simulator.run_method("test_appended_lists", {})
+    assert np.allclose(appended["scores"], [0.0, 7.5, 1.0, 1.5, 2.0, 2.5])
+    assert np.allclose(appended["scoreSlice"], [0.0, 1.0, 2.0])
+    assert np.all(appended["ids"] == np.array([10, 20, 30, 40, 50]))
+    assert appended["ids"].dtype == np.int64
+    assert np.allclose(appended["idsAsDouble"], [10, 20, 30, 40, 50])
+    assert list(appended["names"]) == ["item0", "item1", "item2", "item3", "item4", "item5"]
+    assert appended["mixed"][0] == 1
+    assert appended["mixed"][2] == "three"
+    assert np.isclose(appended["mixed"][3], 4.0)
+    assert np.allclose(appended["rows"], [[1, 2, 3, 7.5], [4, 5, 6, 7]])
+
     print("All list operation tests passed!")
 
 
@@ -619,7 +880,261 @@ def test_python_modules():
         assert "module1_run not defined in task" in repr(err)
 
     print("All python modules test passed!")
-    
+
+
+def run_control_flow_script(config):
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/control_flow.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize(config, modules)
+    output = simulator.run_method("run_control_flow", {})
+    try:
+        simulator.run_method("fail_in_nested_loop", {})
+        raise Exception("fail_in_nested_loop should raise an error")
+    except RuntimeError as err:
+        error = str(err)
+    return output, error
+
+
+def test_compiled_script():
+    """Compiled functions should behave exactly like interpreted ones, including errors."""
+    interpreted, interpretedError = run_control_flow_script('''{"online": false}''')
+    compiled, compiledError = run_control_flow_script('''{"online": false, "compileScript": true}''')
+
+    assert interpreted["total"] == 56
+    assert interpreted["evens"] == [0, 2, 4, 6, 8, 10, 12, 14]
+    assert interpreted["steps"] == 4
+    assert interpreted["caught"] == 1
+    assert interpreted["fib"] == 144
+    assert interpreted["adder"] == 15
+    assert interpreted["negative"] == -4
+    assert interpreted["dict"] == {"x": 1, "y": [1, 20, 3], "z": 11}
+    assert interpreted["changingTypes"] == [5, 6, 7, 8, 9, 0, -1, -2, -3, -4, -5, -6, 6.5, -4.5, "abcd"]
+    assert np.allclose(interpreted["reductions"],
+                       [7.6, 20, -18, -1, 4, True, True, False, 0, 9, 7, 1, 4.55, 6, 3])
+    assert interpreted["squares"] == {"1": 1, "2": 4, "3": 9}
+    assert "lineNo=" in interpretedError
+
+    assert compiled.keys() == interpreted.keys()
+    for key in interpreted:
+        assert np.all(np.array(compiled[key]) == np.array(interpreted[key])), key
+    assert compiledError == interpretedError
+
+
+def test_invalid_reductions():
+    """min(), max() and sum() raise an error for elements which cannot be compared or added."""
+    run_control_flow_script('''{"online": false}''')
+    with pytest.raises(RuntimeError, match="'<' not supported between instances"):
+        simulator.run_method("invalid_reductions", {"kind": "min"})
+    with pytest.raises(RuntimeError, match="'<' not supported between instances"):
+        simulator.run_method("invalid_reductions", {"kind": "max"})
+    with pytest.raises(RuntimeError, match="sum\\(\\) can't add"):
+        simulator.run_method("invalid_reductions", {"kind": "sum"})
+
+
+def test_optimized_script():
+    """Optimizing the script at load time should not change its outputs or errors."""
+    interpreted, interpretedError = run_control_flow_script('''{"online": false}''')
+    assert interpreted["window"] == 172799
+    assert interpreted["checks"] == 8
+
+    for config in [
+        '''{"online": false, "optimizeScript": true}''',
+        '''{"online": false, "optimizeScript": true, "compileScript": true}''',
+    ]:
+        optimized, optimizedError = run_control_flow_script(config)
+        assert optimized.keys() == interpreted.keys()
+        for key in interpreted:
+            assert np.all(np.array(optimized[key]) == np.array(interpreted[key])), key
+        assert optimizedError == interpretedError
+
+
+def test_member_call_inline_cache():
+    """Method calls from the same call site should hit its inline cache without changing results."""
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/member_calls.py"
+            }
+        }
+    ]
+
+    for config in ['''{"online": false}''', '''{"online": false, "compileScript": true}''']:
+        assert simulator.initialize(config, modules)
+        output = simulator.run_method("run_member_calls", {})
+        assert np.all(np.array(output["areas"]) == 96)
+        assert output["shadowedArea"] == 21
+        assert output["replacedBefore"] == 9
+        assert output["replacedAfter"] == 6
+        assert output["static"] == "registry"
+        assert "perimeter" in output["missing"]
+        # Every call site in total_area sees two classes, so it misses twice and hits afterwards
+        assert output["hits"] >= 70
+        assert output["misses"] < 10
+
+
+def test_tensor_elementwise():
+    """Arithmetic, comparisons and minimum/maximum of tensors broadcast like NumPy."""
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/tensor_elementwise.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+    rng = np.random.default_rng(0)
+    features = rng.normal(size=(1000, 10)).astype(np.float32) * 4
+    mean = rng.normal(size=10).astype(np.float32)
+    std = rng.uniform(0.5, 2, size=10).astype(np.float32)
+    output = simulator.run_method("normalize_features",
+                                  {"features": features, "mean": mean, "std": std})
+    normalized = (features - mean) / std
+    assert output["normalized"].dtype == np.float32
+    assert np.allclose(output["normalized"], normalized, rtol=1e-6)
+    assert np.allclose(output["clipped"], np.clip(normalized, -3, 3), rtol=1e-6)
+
+    scores = rng.uniform(size=10001).astype(np.float32)
+    priors = rng.uniform(size=10001).astype(np.float32)
+    counts = rng.integers(0, 100, size=10001).astype(np.int32)
+    column = rng.integers(0, 10, size=(7, 1)).astype(np.int64)
+    row = rng.integers(0, 10, size=5).astype(np.int64)
+    output = simulator.run_method("combine_scores", {"scores": scores, "priors": priors,
+                                                     "counts": counts, "column": column,
+                                                     "row": row})
+    combined = scores * np.float32(0.7) + priors * np.float32(0.3)
+    assert np.allclose(output["combined"], combined, rtol=1e-6)
+    assert np.array_equal(output["selected"], combined >= 0.5)
+    assert output["boosted"].dtype == np.int32
+    assert np.array_equal(output["boosted"], counts * 2 + 1)
+    assert np.allclose(output["ratio"], counts / 4.0)
+    assert output["weighted"].dtype == np.float32
+    assert np.allclose(output["weighted"], counts * priors, rtol=1e-6)
+    assert np.array_equal(output["outer"], np.maximum(column, row))
+    assert np.all(output["equal"])
+
+    with pytest.raises(RuntimeError, match="could not be broadcast"):
+        simulator.run_method("mismatched_shapes", {"scores": scores, "mean": mean})
+    # nm.min and nm.max only reduce, the elementwise versions are nm.minimum and nm.maximum
+    with pytest.raises(RuntimeError, match="use nm.minimum"):
+        simulator.run_method("min_of_two_tensors", {"scores": scores, "priors": priors})
+
+
+def test_tensor_reduction():
+    """Sums, means, minimums and maximums of tensors along axes like NumPy."""
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/tensor_reduction.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+    rng = np.random.default_rng(0)
+    scores = rng.normal(size=(1000, 300)).astype(np.float32)
+    counts = rng.integers(0, 100, size=(20, 30)).astype(np.int32)
+    output = simulator.run_method("reduce_scores", {"scores": scores, "counts": counts})
+    assert output["row_sum"].dtype == np.float32
+    assert np.allclose(output["row_sum"], scores.sum(axis=1, dtype=np.float64), atol=1e-4)
+    assert output["row_mean"].shape == (1000,)
+    assert np.allclose(output["row_mean"], scores.mean(axis=-1, dtype=np.float64), atol=1e-6)
+    assert output["column_max"].shape == (1, 300)
+    assert np.array_equal(output["column_max"], scores.max(axis=0, keepdims=True))
+    assert np.array_equal(output["column_min"], scores.min(axis=0))
+    assert np.isclose(output["total"], scores.sum(dtype=np.float64), atol=1e-2)
+    assert output["counts_sum"] == counts.sum()
+
+    with pytest.raises(RuntimeError, match="more than once"):
+        simulator.run_method("repeated_axis", {"scores": scores})
+
+
+def test_tensor_topk():
+    """Top k and argsort of tensors along an axis match a stable sort with NumPy."""
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/tensor_topk.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+    rng = np.random.default_rng(0)
+    # Few distinct scores, so that ties keep their order along the axis
+    scores = rng.integers(0, 10, size=(40, 30)).astype(np.float32)
+    output = simulator.run_method("select_scores", {"scores": scores})
+    row_top = np.argsort(-scores, axis=-1, kind="stable")[:, :3]
+    assert output["row_top"].shape == (40, 3)
+    assert np.array_equal(output["row_top"], row_top)
+    assert np.array_equal(output["column_bottom"], np.argsort(scores, axis=0, kind="stable")[:2])
+    assert np.array_equal(output["row_top_values"], np.take_along_axis(scores, row_top, -1))
+    assert np.array_equal(output["row_order"], np.argsort(scores, axis=1, kind="stable"))
+    assert np.array_equal(output["column_order"], np.argsort(-scores, axis=0, kind="stable"))
+
+    candidates = rng.normal(size=50000)
+    output = simulator.run_method("top_candidates", {"candidates": candidates})
+    top = np.argsort(-candidates, kind="stable")[:20]
+    assert np.array_equal(output["indices"], top)
+    assert np.array_equal(output["values"], candidates[top])
+
+    with pytest.raises(RuntimeError, match="axis"):
+        simulator.run_method("invalid_axis", {"scores": scores})
+
+
+def test_zero_copy_run_method():
+    """Inputs are used without copies and outputs returned as read only views with zeroCopy."""
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/zero_copy.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+    features = np.random.default_rng(0).normal(size=(1000, 500)).astype(np.float32)
+    copied = simulator.run_method("score_features", {"features": features, "count": 3})
+    output = simulator.run_method("score_features", {"features": features, "count": 3},
+                                  zeroCopy=True)
+    assert output["count"] == 3
+    assert np.array_equal(output["row_sum"], copied["row_sum"])
+    assert not output["row_sum"].flags.writeable
+    # The returned input got its own copy before run_method returned
+    first = features[0, 0]
+    features[0, 0] = 100
+    assert output["features"][0, 0] == first
+    assert np.array_equal(output["features"][1:], features[1:])
+    del output
+
+    with pytest.raises(RuntimeError, match="timestamp"):
+        simulator.run_method("score_features", {"features": features, "count": 3}, 0, True)
+
+
 if __name__ == "__main__":
     test_simulator()
     test_python_modules()
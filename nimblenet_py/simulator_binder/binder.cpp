@@ -227,6 +227,7 @@ bool deallocFrontendTensors(CTensors cTensors) {
 }
 
 bool freeFrontendContext(void* context) {
+  py::gil_scoped_acquire acquire;
   delete (py::object*)context;
   return true;
 }
@@ -340,6 +341,8 @@ void run_task(py::module_&);
 
 void get_build_flags_simulator(py::module_& m);
 
+void get_script_profile_simulator(py::module_& m);
+
 PYBIND11_MODULE(simulator, m) {
   m.doc() = R"(
       Simulator module which defines the following data type types and functions exposed for simulation.
@@ -350,6 +353,7 @@ PYBIND11_MODULE(simulator, m) {
         - add_user_events
         - get_inference
         - run_method
+        - get_script_profile
         - UserInput
         - InputData
         - UserReturn
@@ -449,4 +453,5 @@ PYBIND11_MODULE(simulator, m) {
   load_task(m);
   run_task(m);
   get_build_flags_simulator(m);
+  get_script_profile_simulator(m);
 }
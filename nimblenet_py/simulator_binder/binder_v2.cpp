@@ -32,8 +32,11 @@ std::map<std::string, DATATYPE> numpyToNimbleType = {
     {"int64", DATATYPE::INT64},   {"double", DATATYPE::DOUBLE}, {"float64", DATATYPE::DOUBLE},
 };
 
+// Copies the data of moved_arr, or points to it if borrowedArrays is given, which then keeps the
+// array alive
 template <typename T>
-CTensor assign_CTensor(const std::string& name, py::array_t<T> moved_arr) {
+CTensor assign_CTensor(const std::string& name, py::array_t<T> moved_arr,
+                       std::vector<py::array>* borrowedArrays) {
   py::buffer_info info = moved_arr.request();
   py::list shapeList;
   int64_t* copiedShape = new int64_t[info.shape.size()];
@@ -48,6 +51,11 @@ CTensor assign_CTensor(const std::string& name, py::array_t<T> moved_arr) {
   py::dtype dt = moved_arr.dtype();
   std::string dtypeName = dt.attr("name").cast<std::string>();
   tensor.dataType = numpyToNimbleType.at(dtypeName);
+  if (borrowedArrays) {
+    tensor.data = const_cast<T*>(moved_arr.data());
+    borrowedArrays->push_back(moved_arr);
+    return tensor;
+  }
   void* newMemory = malloc(moved_arr.nbytes());
   std::memcpy(newMemory, moved_arr.data(), moved_arr.nbytes());
   tensor.data = newMemory;
@@ -115,7 +123,9 @@ bool load_task_in_simulator(const char* taskFilePath) {
   return r;
 }
 
-std::map<std::string, py::object> convert_CTensors_to_pymap(const CTensors& ret) {
+// Numeric arrays copy the data of the tensors, or are read only views of it kept alive by base
+std::map<std::string, py::object> convert_CTensors_to_pymap(const CTensors& ret,
+                                                            py::handle base = py::handle()) {
   CTensor* tensors = ret.tensors;
   int numOutputs = ret.numTensors;
 
@@ -216,7 +226,10 @@ std::map<std::string, py::object> convert_CTensors_to_pymap(const CTensors& ret)
                                  " not supported for key=" + name + " in the output.");
     }
     if (type != DATATYPE::STRING && type != DATATYPE::JSON && type != DATATYPE::JSON_ARRAY) {
-      py::array py_array(dtype, shape_vector, data);
+      py::array py_array(dtype, shape_vector, data, base);
+      if (base) {
+        py_array.attr("setflags")("write"_a = false);
+      }
       py_outputs[name] = py_array;
     }
   }
@@ -240,7 +253,8 @@ py::list get_shape(const py::array_t<T>& array) {
   return shapeList;
 }
 
-CTensors convert_pydict_to_CTensors(const py::dict& inputDict);
+CTensors convert_pydict_to_CTensors(const py::dict& inputDict,
+                                   std::vector<py::array>* borrowedArrays = nullptr);
 
 CTensor construct_singleVariable_input(const std::string& name, py::object item) {
   CTensor cTensor;
@@ -281,6 +295,8 @@ CTensor construct_singleVariable_input(const std::string& name, py::object item)
     // Context should store info related to running the frontend function, or the function itself
     FrontendFunctionPtr myLambda = [](void* context, const CTensors input,
                                       CTensors* output) -> NimbleNetStatus* {
+      // run_method releases the GIL while the script runs
+      py::gil_scoped_acquire acquire;
       auto pythonFunction = py::cast<py::function>(*(py::handle*)context);
       auto inputForPythonFunction = convert_CTensors_to_pymap(input);
       auto returnObject = pythonFunction(inputForPythonFunction);
@@ -294,7 +310,8 @@ CTensor construct_singleVariable_input(const std::string& name, py::object item)
   return cTensor;
 }
 
-CTensors convert_pydict_to_CTensors(const py::dict& inputDict) {
+CTensors convert_pydict_to_CTensors(const py::dict& inputDict,
+                                   std::vector<py::array>* borrowedArrays) {
   CTensors cTensors;
   cTensors.numTensors = inputDict.size();
   cTensors.tensors = new CTensor[cTensors.numTensors];
@@ -309,23 +326,28 @@ CTensors convert_pydict_to_CTensors(const py::dict& inputDict) {
       if (dtype.is(py::dtype::of<float>())) {
         cTensors.tensors[index++] = assign_CTensor<float>(
             inputName,
-            py::array_t<float, py::array::c_style | py::array::forcecast>::ensure(item.second));
+            py::array_t<float, py::array::c_style | py::array::forcecast>::ensure(item.second),
+            borrowedArrays);
       } else if (dtype.is(py::dtype::of<bool>())) {
         cTensors.tensors[index++] = assign_CTensor<bool>(
             inputName,
-            py::array_t<bool, py::array::c_style | py::array::forcecast>::ensure(item.second));
+            py::array_t<bool, py::array::c_style | py::array::forcecast>::ensure(item.second),
+            borrowedArrays);
       } else if (dtype.is(py::dtype::of<int32_t>())) {
         cTensors.tensors[index++] = assign_CTensor<int32_t>(
             inputName,
-            py::array_t<int32_t, py::array::c_style | py::array::forcecast>::ensure(item.second));
+            py::array_t<int32_t, py::array::c_style | py::array::forcecast>::ensure(item.second),
+            borrowedArrays);
       } else if (dtype.is(py::dtype::of<long long>())) {
         cTensors.tensors[index++] = assign_CTensor<int64_t>(
             inputName,
-            py::array_t<int64_t, py::array::c_style | py::array::forcecast>::ensure(item.second));
+            py::array_t<int64_t, py::array::c_style | py::array::forcecast>::ensure(item.second),
+            borrowedArrays);
       } else if (dtype.is(py::dtype::of<double>())) {
         cTensors.tensors[index++] = assign_CTensor<double>(
             inputName,
-            py::array_t<double, py::array::c_style | py::array::forcecast>::ensure(item.second));
+            py::array_t<double, py::array::c_style | py::array::forcecast>::ensure(item.second),
+            borrowedArrays);
       } else {
         throw std::runtime_error("Invalid data type of input.");
       }
@@ -347,20 +369,74 @@ CTensors convert_pydict_to_CTensors(const py::dict& inputDict) {
 class RAIITensors {
  public:
   CTensors t;
+  std::vector<py::array> borrowedArrays; /**< Arrays whose data is used by t without a copy */
 
   RAIITensors(CTensors t_) { t = t_; }
 
-  ~RAIITensors() { globalDeallocate(t); }
+  RAIITensors(const py::dict& inputDict) {
+    t = convert_pydict_to_CTensors(inputDict, &borrowedArrays);
+  }
+
+  ~RAIITensors() {
+    for (const auto& array : borrowedArrays) {
+      for (int i = 0; i < t.numTensors; i++) {
+        if (t.tensors[i].data == array.data()) {
+          t.tensors[i].data = nullptr;
+        }
+      }
+    }
+    globalDeallocate(t);
+  }
+};
+
+/**
+ * @brief Outputs of run_method_zero_copy, released once no numpy array viewing them is alive.
+ */
+struct ZeroCopyOutputs {
+  CTensors t = {nullptr, 0, -1};
+
+  ~ZeroCopyOutputs() { deallocate_output_memory2(&t); }
 };
 
+std::map<std::string, py::object> run_method_zero_copy_in_simulator(const char* functionName,
+                                                                    py::dict taskInputDataDict) {
+  RAIITensors input(taskInputDataDict);
+  auto output = std::make_unique<ZeroCopyOutputs>();
+  NimbleNetStatus* t = nullptr;
+  {
+    py::gil_scoped_release release;
+    t = run_method_zero_copy(functionName, input.t, &output->t);
+  }
+  py::capsule base(output.release(),
+                   [](void* outputs) { delete static_cast<ZeroCopyOutputs*>(outputs); });
+  if (t != nullptr) {
+    std::string message = t->message;
+    deallocate_nimblenet_status(t);
+    throw std::runtime_error(message + "\nError running workflow script.");
+  }
+  return convert_CTensors_to_pymap(static_cast<ZeroCopyOutputs*>(base.get_pointer())->t, base);
+}
+
 std::map<std::string, py::object> run_task_upto_timestamp_in_simulator(const char* functionName,
                                                                        py::dict taskInputDataDict,
-                                                                       py::object timestampArg) {
+                                                                       py::object timestampArg,
+                                                                       bool zeroCopy) {
+  if (zeroCopy) {
+    if (!timestampArg.is_none()) {
+      throw std::runtime_error("zeroCopy is not supported together with timestamp.");
+    }
+    return run_method_zero_copy_in_simulator(functionName, taskInputDataDict);
+  }
   RAIITensors input(convert_pydict_to_CTensors(taskInputDataDict));
   CTensors output;
 
   if (timestampArg.is_none()) {
-    auto t = run_method(functionName, input.t, &output);
+    NimbleNetStatus* t = nullptr;
+    {
+      // Let other python threads run methods of the script meanwhile
+      py::gil_scoped_release release;
+      t = run_method(functionName, input.t, &output);
+    }
     if (t != nullptr) {
       throw std::runtime_error(std::string(t->message) + "\nError running workflow script.");
     }
@@ -368,12 +444,30 @@ std::map<std::string, py::object> run_task_upto_timestamp_in_simulator(const cha
     return ret;
   }
   int64_t timestamp = timestampArg.cast<int64_t>();
-  if (!run_task_upto_timestamp(functionName, input.t, &output, timestamp)) {
+  bool success = false;
+  {
+    py::gil_scoped_release release;
+    success = run_task_upto_timestamp(functionName, input.t, &output, timestamp);
+  }
+  if (!success) {
     throw std::runtime_error("Error running workflow script.");
   }
   return convert_CTensors_to_pymap_and_free_tensors(output);
 }
 
+std::string get_script_profile_in_simulator(const char* format) {
+  char* profile = nullptr;
+  auto status = get_script_profile(format, &profile);
+  if (status != nullptr) {
+    std::string message = status->message;
+    deallocate_nimblenet_status(status);
+    throw std::runtime_error(message);
+  }
+  std::string ret = profile;
+  free(profile);
+  return ret;
+}
+
 std::unordered_set<std::string> get_build_flags_set() {
   static std::unordered_set<std::string> ret;
   static bool firstTime = true;
@@ -419,11 +513,32 @@ void run_task(py::module_& m) {
     functionName : Function to be invoked in the script.
     inputData : Input data to the function.
     timestamp : Timestamp upto which historical events are to be considered.
+    zeroCopy : If true, numpy arrays of the input are used by the script without copying them, and
+    numeric outputs are read only numpy arrays viewing the tensors of the script. Not supported
+    together with timestamp.
 
     Return value :
     WorkflowUserReturn : Output of the invoked function.
   )",
-        py::arg("functionName"), py::arg("inputData"), py::arg("timestamp") = nullptr);
+        py::arg("functionName"), py::arg("inputData"), py::arg("timestamp") = nullptr,
+        py::arg("zeroCopy") = false);
+}
+
+void get_script_profile_simulator(py::module_& m) {
+  m.def("get_script_profile", &get_script_profile_in_simulator,
+        R"(
+    Gets the time spent in the functions and lines of the workflow script, recorded when the
+    script is loaded with "profileScript": true in the config.
+
+    Attributes :
+    format : "collapsed" for one "frame;frame;frame microseconds" line per call path, to be
+    rendered as a flame graph, or "json" for calls, inclusive and exclusive microseconds per
+    function and per line.
+
+    Return value :
+    str : Profile of the script.
+  )",
+        py::arg("format") = "collapsed");
 }
 
 void get_build_flags_simulator(py::module_& m) {